@@ -0,0 +1,184 @@
+#include "lib_xcore"
+#include "../src/xcore/math_module"
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+struct state_t {
+  int64_t                            id;
+  double                             time;
+  xcore::generic_vector<double, 3>   position;
+  xcore::generic_vector<float, 4>    attitude;
+  xcore::generic_matrix<float, 3, 3> covariance;
+  bool                               armed;
+};
+
+template<typename Func>
+void benchmark(const std::string &name, const std::vector<state_t> &samples, const int rounds, Func &&func) {
+  size_t bytes = 0;
+
+  auto start = std::chrono::high_resolution_clock::now();
+
+  for (int r = 0; r < rounds; ++r) {
+    for (size_t i = 0; i < samples.size(); ++i) {
+      bytes += func(i);
+    }
+  }
+
+  auto                          end      = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> duration = end - start;
+  const double                  count    = static_cast<double>(samples.size()) * rounds;
+
+  std::cout << std::setw(24) << name << ": "
+            << std::setw(8) << std::fixed << std::setprecision(2) << count / duration.count() / 1e6 << " M msgs/s"
+            << "  (" << std::setprecision(1) << duration.count() * 1e9 / count << " ns/msg, "
+            << std::setprecision(0) << static_cast<double>(bytes) / duration.count() / 1e6 << " MB/s)\n";
+}
+
+static size_t encode_json(const state_t &s, char *out, const size_t capacity) {
+  xcore::json_writer_t<xcore::json_buffer_sink_t> writer(out, capacity);
+
+  writer.begin_object().member("id", s.id).member("time", s.time);
+
+  writer.key("position").begin_array();
+  for (size_t i = 0; i < 3; ++i) writer.value(s.position[i]);
+  writer.end_array();
+
+  writer.key("attitude").begin_array();
+  for (size_t i = 0; i < 4; ++i) writer.value(s.attitude[i]);
+  writer.end_array();
+
+  writer.key("covariance").begin_array();
+  for (size_t r = 0; r < 3; ++r) {
+    writer.begin_array();
+    for (size_t c = 0; c < 3; ++c) writer.value(s.covariance[r][c]);
+    writer.end_array();
+  }
+  writer.end_array();
+
+  writer.member("armed", s.armed).end_object();
+  return writer.sink().size();
+}
+
+static size_t encode_cbor(const state_t &s, unsigned char *out, const size_t capacity) {
+  xcore::cbor_writer_t<xcore::cbor_buffer_sink_t> writer(out, capacity);
+
+  writer.begin_map(6)
+    .member("id", s.id)
+    .member("time", s.time)
+    .member("position", s.position)
+    .member("attitude", s.attitude)
+    .member("covariance", s.covariance)
+    .member("armed", s.armed);
+  return writer.sink().size();
+}
+
+static xcore::json_parser_t<256>   parser;
+static xcore::json_document_t<128> doc;
+
+static bool decode_json(char *data, const size_t len, state_t &s) {
+  if (doc.parse(parser, data, len) != xcore::json_error::ok) return false;
+
+  const xcore::json_value_t root = doc.root();
+  s.id                           = root["id"].to_integer().value_or(0);
+  s.time                         = root["time"].to_double().value_or(0);
+  for (size_t i = 0; i < 3; ++i) s.position[i] = root["position"][i].to_double().value_or(0);
+  for (size_t i = 0; i < 4; ++i) s.attitude[i] = static_cast<float>(root["attitude"][i].to_double().value_or(0));
+  for (size_t r = 0; r < 3; ++r)
+    for (size_t c = 0; c < 3; ++c) s.covariance[r][c] = static_cast<float>(root["covariance"][r][c].to_double().value_or(0));
+  s.armed = root["armed"].to_bool().value_or(false);
+  return true;
+}
+
+static bool decode_cbor(const unsigned char *data, const size_t len, state_t &s) {
+  xcore::cbor_reader_t reader(data, len);
+
+  for (size_t n = reader.read_map().value_or(0); n--;) {
+    const xcore::string_view key = reader.read_text().value_or("");
+
+    if (key == "id") s.id = reader.read_integer().value_or(0);
+    else if (key == "time") s.time = reader.read_double().value_or(0);
+    else if (key == "position") reader.read(s.position);
+    else if (key == "attitude") reader.read(s.attitude);
+    else if (key == "covariance") reader.read(s.covariance);
+    else if (key == "armed") s.armed = reader.read_bool().value_or(false);
+    else if (!reader.skip()) return false;
+  }
+  return reader.error() == xcore::cbor_error::ok;
+}
+
+int main() {
+  constexpr int num_samples = 10'000;
+  constexpr int rounds      = 50;
+
+  std::mt19937_64                       rng(1);
+  std::uniform_real_distribution<double> coord(-1000.0, 1000.0);
+  std::uniform_real_distribution<float>  unit(-1.0f, 1.0f);
+  std::vector<state_t>                  samples(num_samples);
+
+  for (int i = 0; i < num_samples; ++i) {
+    state_t &s = samples[i];
+    s.id       = i;
+    s.time     = i * 0.01;
+    for (size_t k = 0; k < 3; ++k) s.position[k] = coord(rng);
+    for (size_t k = 0; k < 4; ++k) s.attitude[k] = unit(rng);
+    for (size_t r = 0; r < 3; ++r)
+      for (size_t c = 0; c < 3; ++c) s.covariance[r][c] = unit(rng) * 1e-3f;
+    s.armed = (rng() & 1) != 0;
+  }
+
+  // Encoded messages, kept for the decoding runs
+  std::vector<std::string> json_msgs(num_samples);
+  std::vector<std::string> cbor_msgs(num_samples);
+  size_t                   json_bytes = 0;
+  size_t                   cbor_bytes = 0;
+
+  for (int i = 0; i < num_samples; ++i) {
+    char          jbuf[1024];
+    unsigned char cbuf[512];
+    const size_t  jn = encode_json(samples[i], jbuf, sizeof(jbuf));
+    const size_t  cn = encode_cbor(samples[i], cbuf, sizeof(cbuf));
+    json_msgs[i].assign(jbuf, jn);
+    cbor_msgs[i].assign(reinterpret_cast<const char *>(cbuf), cn);
+    json_bytes += jn;
+    cbor_bytes += cn;
+  }
+
+  std::cout << "Average message size: JSON " << json_bytes / num_samples << " bytes, CBOR "
+            << cbor_bytes / num_samples << " bytes (" << std::setprecision(2) << std::fixed
+            << static_cast<double>(json_bytes) / static_cast<double>(cbor_bytes) << "x smaller)\n\n";
+
+  std::cout << "Encoding " << num_samples << " messages x " << rounds << " rounds:\n";
+
+  benchmark("json_writer_t", samples, rounds, [&](const size_t i) {
+    char out[1024];
+    return encode_json(samples[i], out, sizeof(out));
+  });
+
+  benchmark("cbor_writer_t", samples, rounds, [&](const size_t i) {
+    unsigned char out[512];
+    return encode_cbor(samples[i], out, sizeof(out));
+  });
+
+  std::cout << "\nDecoding " << num_samples << " messages x " << rounds << " rounds:\n";
+
+  benchmark("json_document_t", samples, rounds, [&](const size_t i) {
+    char    buf[1024];
+    state_t s;
+    memcpy(buf, json_msgs[i].data(), json_msgs[i].size());  // Parsed in place
+    return decode_json(buf, json_msgs[i].size(), s) ? json_msgs[i].size() : 0;
+  });
+
+  benchmark("cbor_reader_t", samples, rounds, [&](const size_t i) {
+    state_t s;
+    return decode_cbor(reinterpret_cast<const unsigned char *>(cbor_msgs[i].data()), cbor_msgs[i].size(), s)
+             ? cbor_msgs[i].size()
+             : 0;
+  });
+
+  return 0;
+}
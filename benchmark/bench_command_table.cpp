@@ -0,0 +1,104 @@
+#include "lib_xcore"
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+constexpr size_t max_commands = 500;
+
+static size_t calls = 0;
+
+static void on_command(size_t, const char *const *) { ++calls; }
+
+struct name_pool_t {
+  char names[max_commands][16];
+
+  // Names share a prefix so strcmp has to look past the first characters
+  constexpr name_pool_t() : names{} {
+    constexpr char prefix[] = "cmd_";
+    for (size_t i = 0; i < max_commands; ++i) {
+      for (size_t j = 0; j < 4; ++j) names[i][j] = prefix[j];
+      names[i][4] = static_cast<char>('a' + i / 100);
+      names[i][5] = static_cast<char>('0' + i / 10 % 10);
+      names[i][6] = static_cast<char>('0' + i % 10);
+    }
+  }
+};
+
+constexpr name_pool_t name_pool{};
+
+template<size_t N>
+struct entries_t {
+  xcore::command_entry_t entries[N];
+
+  constexpr entries_t() : entries{} {
+    for (size_t i = 0; i < N; ++i) entries[i] = {name_pool.names[i], on_command};
+  }
+};
+
+template<size_t N>
+constexpr entries_t<N> entries{};
+
+template<size_t N>
+constexpr xcore::command_table_t<N> table(entries<N>.entries);
+
+template<typename Func>
+void benchmark(const std::string &name, const std::vector<std::string> &lines, const int rounds, Func &&func) {
+  xcore::command_parser_t<32, 4> parser;
+  calls = 0;
+
+  auto start = std::chrono::high_resolution_clock::now();
+
+  for (int r = 0; r < rounds; ++r) {
+    for (const auto &line: lines) {
+      parser.parse(line.c_str());
+      func(parser);
+    }
+  }
+
+  auto                          end      = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> duration = end - start;
+  const double                  count    = static_cast<double>(lines.size()) * rounds;
+
+  std::cout << std::setw(28) << name << ": "
+            << std::setw(8) << std::fixed << std::setprecision(2) << count / duration.count() / 1e6 << " M cmds/s"
+            << "  (" << std::setprecision(1) << duration.count() * 1e9 / count << " ns/cmd, " << calls << " calls)\n";
+}
+
+template<size_t N>
+void run(const int rounds) {
+  static_assert(table<N>.valid(), "Command table must be valid");
+
+  std::mt19937             rng(1);
+  std::vector<std::string> lines;
+  for (size_t i = 0; i < 10'000; ++i)
+    lines.push_back(std::string(name_pool.names[rng() % N]) + " 1 2");
+
+  std::cout << N << " commands:\n";
+
+  benchmark("parser.is() chain", lines, rounds, [](const auto &parser) {
+    for (const auto &entry: entries<N>.entries) {
+      if (parser.is(entry.name)) {
+        entry.handler(parser.argc(), parser.argv_data());
+        return;
+      }
+    }
+  });
+  benchmark("command_table_t::dispatch", lines, rounds, [](const auto &parser) {
+    table<N>.dispatch(parser);
+  });
+
+  std::cout << "\n";
+}
+
+int main() {
+  run<10>(200);
+  run<50>(200);
+  run<100>(100);
+  run<500>(20);
+
+  return 0;
+}
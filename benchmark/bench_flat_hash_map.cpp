@@ -0,0 +1,91 @@
+#include "lib_xcore"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct std_api {
+  std::unordered_map<uint64_t, uint64_t> map;
+
+  void            insert(const uint64_t k, const uint64_t v) { map.emplace(k, v); }
+  const uint64_t *get(const uint64_t k) const {
+    const auto it = map.find(k);
+    return it == map.end() ? nullptr : &it->second;
+  }
+  void erase(const uint64_t k) { map.erase(k); }
+};
+
+template<size_t Capacity>
+struct flat_api {
+  xcore::flat_hash_map_t<uint64_t, uint64_t, Capacity> map;
+
+  void            insert(const uint64_t k, const uint64_t v) { map.insert(k, v); }
+  const uint64_t *get(const uint64_t k) const { return map.get(k); }
+  void            erase(const uint64_t k) { map.erase(k); }
+};
+
+static double ns_per_op(const std::chrono::high_resolution_clock::time_point start, const size_t ops) {
+  std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+  return duration.count() * 1e9 / static_cast<double>(ops);
+}
+
+// Inserts n random keys, looks up present and absent keys, then erases half of them
+template<typename Api>
+void run(const std::string &name, const size_t n, const int rounds) {
+  std::mt19937_64       rng(n);
+  std::vector<uint64_t> keys(n), absent(n);
+  for (uint64_t &k: keys) k = rng();
+  for (uint64_t &k: absent) k = rng();
+
+  double   t_insert = 0, t_hit = 0, t_miss = 0, t_erase = 0;
+  uint64_t sum      = 0;
+
+  for (int r = 0; r < rounds; ++r) {
+    auto *api = new Api();
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < n; ++i) api->insert(keys[i], i);
+    t_insert += ns_per_op(start, n);
+
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < n; ++i) sum += *api->get(keys[(i * 7919) % n]);
+    t_hit += ns_per_op(start, n);
+
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < n; ++i) sum += api->get(absent[i]) != nullptr;
+    t_miss += ns_per_op(start, n);
+
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < n; i += 2) api->erase(keys[i]);
+    t_erase += ns_per_op(start, n / 2);
+
+    delete api;
+  }
+
+  std::cout << std::setw(28) << name << std::setw(9) << n << " keys: insert " << std::fixed << std::setprecision(1)
+            << std::setw(6) << t_insert / rounds << "  hit " << std::setw(6) << t_hit / rounds << "  miss " << std::setw(6)
+            << t_miss / rounds << "  erase " << std::setw(6) << t_erase / rounds << " ns/op" << (sum == 1 ? " " : "")
+            << "\n";
+}
+
+int main() {
+  std::cout << "uint64_t -> uint64_t, random keys:\n";
+
+  run<std_api>("std::unordered_map", 1000, 2000);
+  run<flat_api<0>>("flat_hash_map_t (dynamic)", 1000, 2000);
+  run<flat_api<1000>>("flat_hash_map_t (fixed)", 1000, 2000);
+  std::cout << "\n";
+
+  run<std_api>("std::unordered_map", 100000, 20);
+  run<flat_api<0>>("flat_hash_map_t (dynamic)", 100000, 20);
+  run<flat_api<100000>>("flat_hash_map_t (fixed)", 100000, 20);
+  std::cout << "\n";
+
+  run<std_api>("std::unordered_map", 4000000, 1);
+  run<flat_api<0>>("flat_hash_map_t (dynamic)", 4000000, 1);
+
+  return 0;
+}
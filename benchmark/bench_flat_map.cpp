@@ -0,0 +1,88 @@
+#include "lib_xcore"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+static constexpr size_t lookups = 2000000;
+
+template<size_t N, bool Eytzinger>
+struct flat_api {
+  xcore::flat_map_t<uint32_t, uint32_t, N, xcore::less<uint32_t>, Eytzinger> map;
+
+  explicit flat_api(const std::vector<std::pair<uint32_t, uint32_t>> &table) { map.build(table.begin(), table.end()); }
+  uint32_t get(const uint32_t k) const { return *map.get(k); }
+};
+
+struct binary_api {
+  std::vector<uint32_t> keys, values;
+
+  explicit binary_api(std::vector<std::pair<uint32_t, uint32_t>> table) {
+    std::sort(table.begin(), table.end());
+    for (const auto &[k, v]: table) keys.push_back(k), values.push_back(v);
+  }
+  uint32_t get(const uint32_t k) const { return values[std::lower_bound(keys.begin(), keys.end(), k) - keys.begin()]; }
+};
+
+struct std_map_api {
+  std::map<uint32_t, uint32_t> map;
+
+  explicit std_map_api(const std::vector<std::pair<uint32_t, uint32_t>> &table) : map(table.begin(), table.end()) {}
+  uint32_t get(const uint32_t k) const { return map.find(k)->second; }
+};
+
+// Looks up random present keys, first each lookup depending on the previous one (latency), then
+// independent ones the CPU can overlap (throughput)
+template<typename Api>
+void run(const std::string &name, const std::vector<std::pair<uint32_t, uint32_t>> &table, const std::vector<uint32_t> &order) {
+  auto *api = new Api(table);
+
+  uint32_t next  = 0;
+  auto     start = std::chrono::high_resolution_clock::now();
+  for (size_t i = 0; i < lookups; ++i) next = api->get(table[order[i] ^ (next & 1)].first);
+  std::chrono::duration<double> latency = std::chrono::high_resolution_clock::now() - start;
+
+  uint32_t sum = 0;
+  start        = std::chrono::high_resolution_clock::now();
+  for (size_t i = 0; i < lookups; ++i) sum += api->get(table[order[i]].first);
+  std::chrono::duration<double> throughput = std::chrono::high_resolution_clock::now() - start;
+
+  std::cout << std::setw(20) << name << std::setw(9) << table.size() << ":  dependent " << std::fixed << std::setprecision(1)
+            << std::setw(7) << latency.count() * 1e9 / lookups << " ns  independent " << std::setw(7)
+            << throughput.count() * 1e9 / lookups << " ns" << (next + sum == 1 ? " " : "") << "\n";
+  delete api;
+}
+
+template<size_t N>
+void run_size() {
+  std::mt19937                               rng(N);
+  std::vector<std::pair<uint32_t, uint32_t>> table;
+  for (uint32_t i = 0; i < N; ++i) table.emplace_back((static_cast<uint32_t>(rng()) & ~1u) | (i & 1), i);
+  std::sort(table.begin(), table.end());
+  table.erase(std::unique(table.begin(), table.end(), [](const auto &a, const auto &b) { return a.first == b.first; }), table.end());
+  std::shuffle(table.begin(), table.end(), rng);
+  table.resize(table.size() & ~size_t(1));
+
+  std::vector<uint32_t> order(lookups);
+  for (uint32_t &o: order) o = static_cast<uint32_t>(rng() % table.size()) & ~1u;
+
+  run<flat_api<N, false>>("flat_map_t", table, order);
+  run<flat_api<N, true>>("flat_map_t<Eytz.>", table, order);
+  run<binary_api>("std::lower_bound", table, order);
+  run<std_map_api>("std::map", table, order);
+  std::cout << "\n";
+}
+
+int main() {
+  std::cout << "random lookups of present keys:\n";
+  run_size<64>();
+  run_size<1024>();
+  run_size<65536>();
+  run_size<1 << 20>();
+  return 0;
+}
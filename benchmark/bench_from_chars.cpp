@@ -0,0 +1,81 @@
+#include "lib_xcore"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+template<typename Func>
+void benchmark(const std::string &name, const std::vector<std::string> &inputs, const int rounds, Func &&func) {
+  double sink = 0;
+
+  auto start = std::chrono::high_resolution_clock::now();
+
+  for (int r = 0; r < rounds; ++r) {
+    for (const auto &s: inputs) {
+      sink += func(s.c_str(), s.size());
+    }
+  }
+
+  auto                          end      = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> duration = end - start;
+  const double                  count    = static_cast<double>(inputs.size()) * rounds;
+
+  std::cout << std::setw(32) << name << ": "
+            << std::setw(8) << std::fixed << std::setprecision(2) << count / duration.count() / 1e6 << " M args/s"
+            << "  (" << std::setprecision(1) << duration.count() * 1e9 / count << " ns/arg, sink " << sink << ")\n";
+}
+
+int main() {
+  constexpr int num_inputs = 100'000;
+  constexpr int rounds     = 20;
+
+  std::mt19937_64          rng(1);
+  std::vector<std::string> ints, floats, lines;
+  char                     buf[64];
+
+  for (int i = 0; i < num_inputs; ++i) {
+    snprintf(buf, sizeof(buf), "%lld", static_cast<long long>(rng() >> (rng() % 40)) * (i % 2 ? 1 : -1));
+    ints.emplace_back(buf);
+    snprintf(buf, sizeof(buf), "%.*g", static_cast<int>(3 + rng() % 15), std::uniform_real_distribution<double>(-1e4, 1e4)(rng));
+    floats.emplace_back(buf);
+    lines.push_back("set " + ints.back() + " " + floats.back());
+  }
+
+  std::cout << "Parsing " << num_inputs << " numeric arguments x " << rounds << " rounds:\n\n";
+
+  benchmark("atoll", ints, rounds, [](const char *s, size_t) { return static_cast<double>(atoll(s)); });
+  benchmark("strtoll", ints, rounds, [](const char *s, size_t) { return static_cast<double>(strtoll(s, nullptr, 10)); });
+  benchmark("xcore::from_chars<int64_t>", ints, rounds, [](const char *s, const size_t n) {
+    int64_t v = 0;
+    xcore::from_chars(s, s + n, v);
+    return static_cast<double>(v);
+  });
+
+  std::cout << "\n";
+
+  benchmark("strtod", floats, rounds, [](const char *s, size_t) { return strtod(s, nullptr); });
+  benchmark("xcore::from_chars<double>", floats, rounds, [](const char *s, const size_t n) {
+    double v = 0;
+    xcore::from_chars(s, s + n, v);
+    return v;
+  });
+
+  std::cout << "\n";
+
+  xcore::command_parser_t<64, 4> parser;
+
+  benchmark("parse + atoll + strtod", lines, rounds, [&](const char *s, size_t) {
+    parser.parse(s);
+    return static_cast<double>(atoll(parser.argv[1])) + strtod(parser.argv[2], nullptr);
+  });
+  benchmark("parse + arg<int64_t> + arg<double>", lines, rounds, [&](const char *s, size_t) {
+    parser.parse(s);
+    return static_cast<double>(parser.arg<int64_t>(1).value_or(0)) + parser.arg<double>(2).value_or(0.0);
+  });
+
+  return 0;
+}
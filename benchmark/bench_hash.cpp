@@ -0,0 +1,70 @@
+#include "lib_xcore"
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct xcore_api {
+  static uint64_t hash(const char *p, const size_t n) { return xcore::hash_bytes(p, n); }
+};
+
+struct std_api {
+  static uint64_t hash(const char *p, const size_t n) { return std::hash<std::string_view>{}(std::string_view(p, n)); }
+};
+
+struct fnv1a_api {
+  static uint64_t hash(const char *p, const size_t n) {
+    uint64_t h = 0xCBF29CE484222325ull;
+    for (size_t i = 0; i < n; ++i) h = (h ^ static_cast<uint8_t>(p[i])) * 0x100000001B3ull;
+    return h;
+  }
+};
+
+// Hashes consecutive inputs of n bytes from a 1 MiB buffer (warm in cache for small n)
+template<typename Api>
+void throughput(const std::string &name, const std::vector<char> &buffer, const size_t n) {
+  const size_t total  = size_t(256) << 20;
+  const size_t count  = total / n;
+  const size_t stride = buffer.size() - n;
+  uint64_t     sum    = 0;
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for (size_t i = 0, offset = 0; i < count; ++i) {
+    sum += Api::hash(buffer.data() + offset, n);
+    offset += n + 8;
+    if (offset > stride) offset = i & 63;
+  }
+  auto                          end      = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> duration = end - start;
+
+  std::cout << std::setw(14) << name << std::setw(7) << n << " B: " << std::fixed << std::setprecision(2) << std::setw(7)
+            << static_cast<double>(count * n) / duration.count() / 1e9 << " GB/s " << std::setw(9)
+            << duration.count() * 1e9 / static_cast<double>(count) << " ns/hash" << (sum == 1 ? " " : "") << "\n";
+}
+
+int main() {
+  std::vector<char> buffer(size_t(1) << 20);
+  std::mt19937_64   rng(5);
+  for (char &c: buffer) c = static_cast<char>(rng());
+
+  std::cout << "hash throughput:\n";
+  for (const size_t n: {8, 16, 32, 64, 256, 1024, 4096, 65536}) {
+    throughput<xcore_api>("xcore::hash", buffer, n);
+    throughput<std_api>("std::hash", buffer, n);
+    throughput<fnv1a_api>("FNV-1a", buffer, n);
+    std::cout << "\n";
+  }
+
+  uint64_t sum   = 0;
+  auto     start = std::chrono::high_resolution_clock::now();
+  for (uint64_t k = 0; k < 100'000'000; ++k) sum += xcore::hash<uint64_t>{}(k);
+  std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+  std::cout << "xcore::hash<uint64_t>: " << std::setprecision(2) << duration.count() * 1e9 / 1e8 << " ns/hash"
+            << (sum == 1 ? " " : "") << "\n";
+
+  return 0;
+}
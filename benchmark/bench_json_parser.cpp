@@ -0,0 +1,105 @@
+#include "lib_xcore"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Large enough for the generated document, kept out of the stack
+static xcore::json_parser_t<1 << 21>   parser;
+static xcore::json_document_t<1 << 21> doc;
+
+struct count_handler_t : xcore::json_sax_handler_t {
+  size_t values = 0;
+
+  bool on_null() { return ++values; }
+  bool on_bool(bool) { return ++values; }
+  bool on_integer(int64_t) { return ++values; }
+  bool on_floating(double) { return ++values; }
+  bool on_string(xcore::string_view) { return ++values; }
+};
+
+template<typename Func>
+void benchmark(const std::string &name, const std::string &json, const int rounds, Func &&func) {
+  std::vector<char> buffer(json.begin(), json.end());
+  size_t            sink = 0;
+
+  auto start = std::chrono::high_resolution_clock::now();
+
+  for (int r = 0; r < rounds; ++r) {
+    sink += func(buffer.data(), buffer.size());
+  }
+
+  auto                          end      = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> duration = end - start;
+  const double                  bytes    = static_cast<double>(json.size()) * rounds;
+
+  std::cout << std::setw(28) << name << ": "
+            << std::setw(6) << std::fixed << std::setprecision(2) << bytes / duration.count() / 1e9 << " GB/s"
+            << "  (" << std::setprecision(2) << duration.count() * 1e3 / rounds << " ms/doc, sink " << sink / rounds << ")\n";
+}
+
+// Telemetry log: an array of flat records, numbers and short strings
+static std::string make_records(const size_t count) {
+  std::mt19937_64 rng(1);
+  std::string     json = "[";
+  char            buf[256];
+
+  for (size_t i = 0; i < count; ++i) {
+    snprintf(buf, sizeof(buf),
+             R"({"id":%zu,"name":"sensor_%zu","lat":%.7f,"lon":%.7f,"alt":%.2f,"ok":%s,"tags":["imu","gps"],"err":null},)",
+             i, rng() % 100, (rng() % 1800000) / 1e4 - 90, (rng() % 3600000) / 1e4 - 180, (rng() % 100000) / 100.0,
+             rng() & 1 ? "true" : "false");
+    json += buf;
+  }
+
+  json.back() = ']';
+  return json;
+}
+
+// Configuration-like document: nesting, whitespace and longer strings
+static std::string make_config(const size_t count) {
+  std::string json = "{\n";
+  char        buf[512];
+
+  for (size_t i = 0; i < count; ++i) {
+    snprintf(buf, sizeof(buf),
+             "  \"node_%zu\": {\n    \"description\": \"controller parameters for the node number %zu of the fleet\",\n"
+             "    \"pid\": {\"kp\": 1.25, \"ki\": 0.05, \"kd\": 0.001},\n    \"limits\": [-100, 100],\n    \"enabled\": true\n  }%s\n",
+             i, i, i + 1 == count ? "" : ",");
+    json += buf;
+  }
+
+  json += "}";
+  return json;
+}
+
+int main() {
+  const std::string records = make_records(20'000);
+  const std::string config  = make_config(8'000);
+
+  for (const auto &[label, json]: {std::pair<const char *, const std::string &>{"records", records}, {"config", config}}) {
+    std::cout << label << " (" << json.size() / 1024 << " KiB):\n";
+
+    benchmark("stage 1 (structural index)", json, 50, [](const char *data, const size_t len) {
+      parser.index(data, len);
+      return parser.size();
+    });
+    benchmark("SAX (count values)", json, 50, [](char *data, const size_t len) {
+      count_handler_t handler;
+      parser.parse(data, len, handler);
+      return handler.values;
+    });
+    benchmark("DOM (tape)", json, 50, [](char *data, const size_t len) {
+      doc.parse(parser, data, len);
+      return doc.size();
+    });
+
+    std::cout << "\n";
+  }
+
+  return 0;
+}
@@ -0,0 +1,106 @@
+#include "lib_xcore"
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+struct telemetry_t {
+  int    id;
+  double lat, lon, alt;
+  float  roll, pitch, yaw;
+  int    satellites;
+  bool   armed;
+};
+
+template<typename Func>
+void benchmark(const std::string &name, const std::vector<telemetry_t> &samples, const int rounds, Func &&func) {
+  size_t bytes = 0;
+
+  auto start = std::chrono::high_resolution_clock::now();
+
+  for (int r = 0; r < rounds; ++r) {
+    for (const auto &s: samples) {
+      bytes += func(s);
+    }
+  }
+
+  auto                          end      = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> duration = end - start;
+  const double                  count    = static_cast<double>(samples.size()) * rounds;
+
+  std::cout << std::setw(36) << name << ": "
+            << std::setw(8) << std::fixed << std::setprecision(2) << count / duration.count() / 1e6 << " M docs/s"
+            << "  (" << std::setprecision(1) << duration.count() * 1e9 / count << " ns/doc, "
+            << std::setprecision(0) << static_cast<double>(bytes) / duration.count() / 1e6 << " MB/s)\n";
+}
+
+int main() {
+  constexpr int num_samples = 10'000;
+  constexpr int rounds      = 50;
+
+  std::mt19937_64                        rng(1);
+  std::uniform_real_distribution<double> angle(-180.0, 180.0);
+  std::vector<telemetry_t>               samples;
+
+  for (int i = 0; i < num_samples; ++i) {
+    samples.push_back({i, angle(rng) / 2, angle(rng), angle(rng) + 500,
+                       static_cast<float>(angle(rng)), static_cast<float>(angle(rng)), static_cast<float>(angle(rng)),
+                       static_cast<int>(rng() % 20), (rng() & 1) != 0});
+  }
+
+  std::cout << "Serializing " << num_samples << " telemetry objects x " << rounds << " rounds:\n\n";
+
+  benchmark("json<string_t<512>> (6 decimals)", samples, rounds, [](const telemetry_t &s) {
+    xcore::json<xcore::string_t<512>> payload;
+    payload["id"]    = s.id;
+    payload["lat"]   = xcore::string_t<32>(s.lat, 6);
+    payload["lon"]   = xcore::string_t<32>(s.lon, 6);
+    payload["alt"]   = xcore::string_t<32>(s.alt, 6);
+    payload["roll"]  = xcore::string_t<32>(s.roll, 6);
+    payload["pitch"] = xcore::string_t<32>(s.pitch, 6);
+    payload["yaw"]   = xcore::string_t<32>(s.yaw, 6);
+    payload["sats"]  = s.satellites;
+    payload["armed"] = s.armed ? "true" : "false";
+    return strlen(payload);
+  });
+
+  char                                              out[512];
+  xcore::json_writer_t<xcore::json_buffer_sink_t> writer(out, sizeof(out));
+
+  benchmark("json_writer_t (shortest round-trip)", samples, rounds, [&](const telemetry_t &s) {
+    writer.reset();
+    writer.sink().clear();
+    writer.begin_object()
+      .member("id", s.id)
+      .member("lat", s.lat)
+      .member("lon", s.lon)
+      .member("alt", s.alt)
+      .member("roll", s.roll)
+      .member("pitch", s.pitch)
+      .member("yaw", s.yaw)
+      .member("sats", s.satellites)
+      .member("armed", s.armed)
+      .end_object();
+    return writer.sink().size();
+  });
+
+  std::cout << "\n";
+
+  std::string text;
+  for (int i = 0; i < 64; ++i) text += "telemetry label with a \"quote\" now and then, ";
+
+  std::vector<char>                                 big(text.size() * 2 + 16);
+  xcore::json_writer_t<xcore::json_buffer_sink_t> string_writer(big.data(), big.size());
+
+  benchmark("json_writer_t long string escape", std::vector<telemetry_t>(1000), rounds * 10, [&](const telemetry_t &) {
+    string_writer.reset();
+    string_writer.sink().clear();
+    string_writer.value(text.c_str(), text.size());
+    return string_writer.sink().size();
+  });
+
+  return 0;
+}
@@ -0,0 +1,91 @@
+#include "lib_xcore"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct packet_t {
+  uint64_t id;
+  uint8_t  payload[56];
+};
+
+constexpr size_t capacity = 4096;
+
+static xcore::lockfree_pool_t<packet_t, capacity>  lockfree_pool;
+static xcore::bitmap_allocator<packet_t, capacity> locked_pool;
+static std::mutex                                  locked_pool_mutex;
+
+struct lockfree_api {
+  static packet_t *acquire() { return lockfree_pool.acquire(); }
+  static void      release(packet_t *p) { lockfree_pool.release(p); }
+};
+
+struct locked_bitmap_api {
+  static packet_t *acquire() {
+    std::lock_guard<std::mutex> lock(locked_pool_mutex);
+    return locked_pool.acquire();
+  }
+
+  static void release(packet_t *p) {
+    std::lock_guard<std::mutex> lock(locked_pool_mutex);
+    locked_pool.release(p);
+  }
+};
+
+struct malloc_api {
+  static packet_t *acquire() { return static_cast<packet_t *>(malloc(sizeof(packet_t))); }
+  static void      release(packet_t *p) { free(p); }
+};
+
+// Every thread acquires a burst of slots, touches them and releases them, all on the same pool
+template<typename Api>
+void contention(const std::string &name, const int num_threads, const int rounds, const size_t burst) {
+  std::vector<std::thread> threads;
+
+  auto start = std::chrono::high_resolution_clock::now();
+
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([=] {
+      std::vector<packet_t *> held(burst);
+      for (int r = 0; r < rounds; ++r) {
+        for (packet_t *&p: held) {
+          p = Api::acquire();
+          if (p) p->id = static_cast<uint64_t>(r);
+        }
+        for (packet_t *p: held)
+          if (p) Api::release(p);
+      }
+    });
+  }
+  for (std::thread &thread: threads) thread.join();
+
+  auto                          end      = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> duration = end - start;
+  const double                  count    = 2.0 * static_cast<double>(burst) * rounds * num_threads;
+
+  std::cout << std::setw(24) << name << " x" << num_threads << " burst " << std::setw(2) << burst << ": "
+            << std::setw(8) << std::fixed << std::setprecision(2) << count / duration.count() / 1e6 << " M ops/s"
+            << "  (" << std::setprecision(1) << duration.count() * 1e9 / count << " ns/op)\n";
+}
+
+int main() {
+  constexpr int ops = 4'000'000;
+
+  std::cout << "acquire/release pairs on a shared pool (" << std::thread::hardware_concurrency() << " hardware threads):\n";
+
+  for (const size_t burst: {size_t(1), size_t(32)}) {
+    for (const int threads: {1, 2, 4, 8}) {
+      const int rounds = ops / static_cast<int>(burst) / threads;
+      contention<lockfree_api>("lockfree_pool_t", threads, rounds, burst);
+      contention<locked_bitmap_api>("locked bitmap_allocator", threads, rounds, burst);
+      contention<malloc_api>("malloc", threads, rounds, burst);
+    }
+    std::cout << "\n";
+  }
+
+  return 0;
+}
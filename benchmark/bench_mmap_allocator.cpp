@@ -0,0 +1,80 @@
+#include "lib_xcore"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+constexpr size_t num_words = size_t(256) << 17;  // 256 MiB of uint64_t
+
+using plain_mmap    = xcore::mmap_allocator_form_t<xcore::mmap_flags::none>::type<uint64_t>;
+using thp_mmap      = xcore::mmap_allocator_form_t<xcore::mmap_flags::transparent_huge>::type<uint64_t>;
+using hugetlb_mmap  = xcore::mmap_allocator_form_t<xcore::mmap_flags::huge_tlb>::type<uint64_t>;
+using populate_mmap = xcore::mmap_allocator_form_t<xcore::mmap_flags::populate>::type<uint64_t>;
+using thp_populate  = xcore::mmap_allocator_form_t<xcore::mmap_flags::transparent_huge | xcore::mmap_flags::populate>::type<uint64_t>;
+
+struct malloc_api {
+  static uint64_t *allocate(const size_t n) { return static_cast<uint64_t *>(calloc(n, sizeof(uint64_t))); }
+  static void      deallocate(uint64_t *p) { free(p); }
+};
+
+template<typename Alloc>
+struct mmap_api {
+  static uint64_t *allocate(const size_t n) { return Alloc::allocate(n); }
+  static void      deallocate(uint64_t *p) { Alloc::deallocate(p); }
+};
+
+static double seconds_since(const std::chrono::high_resolution_clock::time_point start) {
+  std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+  return duration.count();
+}
+
+// Allocation, first touch of every page, then a dependent pointer chase through a single random
+// cycle: every step lands on another page, so the walk is bound by TLB misses and page walks
+template<typename Api>
+void chase(const std::string &name, const size_t steps) {
+  auto         start = std::chrono::high_resolution_clock::now();
+  uint64_t    *words = Api::allocate(num_words);
+  const double t_map = seconds_since(start);
+
+  // Sattolo's shuffle over the words: one cycle through all of them
+  start = std::chrono::high_resolution_clock::now();
+  for (size_t i = 0; i < num_words; ++i) words[i] = i;
+  const double t_touch = seconds_since(start);
+
+  std::mt19937_64 rng(42);
+  for (size_t i = num_words - 1; i > 0; --i) {
+    const size_t   j   = rng() % i;
+    const uint64_t tmp = words[i];
+    words[i]           = words[j];
+    words[j]           = tmp;
+  }
+
+  start          = std::chrono::high_resolution_clock::now();
+  uint64_t index = 0;
+  for (size_t i = 0; i < steps; ++i) index = words[index];
+  const double t_chase = seconds_since(start);
+
+  Api::deallocate(words);
+
+  std::cout << std::setw(22) << name << ": allocate " << std::setw(7) << std::fixed << std::setprecision(2)
+            << t_map * 1e3 << " ms, first touch " << std::setw(7) << t_touch * 1e3 << " ms, chase " << std::setw(6)
+            << std::setprecision(1) << t_chase * 1e9 / static_cast<double>(steps) << " ns/step"
+            << (index == ~uint64_t(0) ? " " : "") << "\n";
+}
+
+int main() {
+  constexpr size_t steps = 20'000'000;
+
+  std::cout << "pointer chase over " << (num_words * sizeof(uint64_t) >> 20) << " MiB:\n";
+
+  chase<malloc_api>("calloc", steps);
+  chase<mmap_api<plain_mmap>>("mmap 4 KiB pages", steps);
+  chase<mmap_api<thp_mmap>>("mmap transparent huge", steps);
+  chase<mmap_api<hugetlb_mmap>>("mmap MAP_HUGETLB", steps);
+  chase<mmap_api<populate_mmap>>("mmap populate", steps);
+  chase<mmap_api<thp_populate>>("mmap THP + populate", steps);
+
+  return 0;
+}
@@ -0,0 +1,87 @@
+#include "lib_xcore"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+struct std_api {
+  std::priority_queue<uint64_t> queue;
+
+  void     push(const uint64_t v) { queue.push(v); }
+  uint64_t pop() {
+    const uint64_t v = queue.top();
+    queue.pop();
+    return v;
+  }
+};
+
+template<size_t Capacity, size_t Arity>
+struct xcore_api {
+  xcore::priority_queue_t<uint64_t, Capacity, xcore::less<uint64_t>, Arity> queue;
+
+  void     push(const uint64_t v) { queue.push(v); }
+  uint64_t pop() { return *queue.pop(); }
+};
+
+static double ns_per_op(const std::chrono::high_resolution_clock::time_point start, const size_t ops) {
+  std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+  return duration.count() * 1e9 / static_cast<double>(ops);
+}
+
+// Fills the queue with n random keys, runs the hold model (pop, then push a key below the popped
+// one, as an event queue does) for 4n operations, then drains the queue
+template<typename Api>
+void run(const std::string &name, const size_t n, const int rounds) {
+  std::mt19937_64       rng(n);
+  std::vector<uint64_t> keys(n), steps(4 * n);
+  for (uint64_t &k: keys) k = rng() >> 1;
+  for (uint64_t &s: steps) s = rng() % 1000000;
+
+  double   t_push = 0, t_hold = 0, t_pop = 0;
+  uint64_t sum    = 0;
+
+  for (int r = 0; r < rounds; ++r) {
+    auto *api = new Api();
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < n; ++i) api->push(keys[i]);
+    t_push += ns_per_op(start, n);
+
+    start = std::chrono::high_resolution_clock::now();
+    for (const uint64_t s: steps) {
+      const uint64_t v = api->pop();
+      api->push(v > s ? v - s : 0);
+    }
+    t_hold += ns_per_op(start, steps.size());
+
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < n; ++i) sum += api->pop();
+    t_pop += ns_per_op(start, n);
+
+    delete api;
+  }
+
+  std::cout << std::setw(24) << name << std::setw(8) << n << ":  push " << std::fixed << std::setprecision(1)
+            << std::setw(6) << t_push / rounds << " ns  hold " << std::setw(6) << t_hold / rounds << " ns  pop "
+            << std::setw(6) << t_pop / rounds << " ns" << (sum == 1 ? " " : "") << "\n";
+}
+
+int main() {
+  std::cout << "priority queue, ns per operation:\n";
+
+  run<std_api>("std::priority_queue", 1024, 200);
+  run<xcore_api<1024, 2>>("priority_queue_t<2>", 1024, 200);
+  run<xcore_api<1024, 4>>("priority_queue_t<4>", 1024, 200);
+  run<xcore_api<1024, 8>>("priority_queue_t<8>", 1024, 200);
+  std::cout << "\n";
+
+  run<std_api>("std::priority_queue", 1 << 20, 3);
+  run<xcore_api<1 << 20, 2>>("priority_queue_t<2>", 1 << 20, 3);
+  run<xcore_api<1 << 20, 4>>("priority_queue_t<4>", 1 << 20, 3);
+  run<xcore_api<1 << 20, 8>>("priority_queue_t<8>", 1 << 20, 3);
+
+  return 0;
+}
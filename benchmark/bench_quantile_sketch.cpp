@@ -0,0 +1,130 @@
+#include "lib_xcore"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+static constexpr size_t sample_count = 4000000;
+
+static double ns_per_op(const std::chrono::high_resolution_clock::time_point start, const size_t ops) {
+  std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+  return duration.count() * 1e9 / static_cast<double>(ops);
+}
+
+static std::vector<double> samples;
+static std::vector<double> sorted;
+
+// Quantile that an estimate actually is among the samples
+static double rank_of(const double estimate) {
+  const auto lo = std::lower_bound(sorted.begin(), sorted.end(), estimate) - sorted.begin();
+  const auto hi = std::upper_bound(sorted.begin(), sorted.end(), estimate) - sorted.begin();
+  return static_cast<double>(lo + hi) / 2 / static_cast<double>(sorted.size());
+}
+
+static void report(const char *name, const double insert, const double p50, const double p99, const double p999, const size_t bytes) {
+  const auto error = [](const double estimate, const double q) { return std::fabs(rank_of(estimate) - q) * 100; };
+  std::cout << std::setw(26) << name << ":  " << std::fixed << std::setprecision(1) << std::setw(6) << insert << " ns/op  rank error p50 "
+            << std::setprecision(3) << std::setw(6) << error(p50, 0.5) << " %  p99 " << std::setw(6) << error(p99, 0.99) << " %  p999 "
+            << std::setw(6) << error(p999, 0.999) << " %  " << std::setw(8) << bytes << " B\n";
+}
+
+static void run_p2() {
+  xcore::p2_quantile_t p50(0.5), p99(0.99), p999(0.999);
+
+  // Each estimator tracks one quantile: the cost of one is the time of all three over 3
+  const auto start = std::chrono::high_resolution_clock::now();
+  for (const double x: samples) {
+    p50.push(x);
+    p99.push(x);
+    p999.push(x);
+  }
+  const double t = ns_per_op(start, 3 * samples.size());
+
+  report("p2_quantile_t (each)", t, p50.value(), p99.value(), p999.value(), sizeof(p50));
+}
+
+template<size_t Compression>
+static void run_t_digest(const char *name) {
+  auto *digest = new xcore::t_digest_t<Compression>();
+
+  const auto start = std::chrono::high_resolution_clock::now();
+  for (const double x: samples) digest->push(x);
+  digest->flush();
+  const double t = ns_per_op(start, samples.size());
+
+  report(name, t, digest->quantile(0.5), digest->quantile(0.99), digest->quantile(0.999), sizeof(*digest));
+  delete digest;
+}
+
+// Latencies as integer microseconds
+using histogram_t = xcore::hdr_histogram_t<7, 40>;
+
+static void run_hdr() {
+  auto *h = new histogram_t();
+
+  const auto start = std::chrono::high_resolution_clock::now();
+  for (const double x: samples) h->record(static_cast<uint64_t>(x));
+  const double t = ns_per_op(start, samples.size());
+
+  report("hdr_histogram_t", t, static_cast<double>(h->quantile(0.5)), static_cast<double>(h->quantile(0.99)),
+         static_cast<double>(h->quantile(0.999)), sizeof(*h));
+  delete h;
+}
+
+static void run_hdr_threads(const size_t thread_count) {
+  auto                    *h = new histogram_t();
+  std::vector<std::thread> threads;
+
+  const auto start = std::chrono::high_resolution_clock::now();
+  for (size_t t = 0; t < thread_count; ++t) {
+    threads.emplace_back([h, t, thread_count]() {
+      for (size_t i = t; i < samples.size(); i += thread_count) h->record(static_cast<uint64_t>(samples[i]));
+    });
+  }
+  for (auto &thread: threads) thread.join();
+  const double t = ns_per_op(start, samples.size());
+
+  report("hdr_histogram_t (4 thr.)", t, static_cast<double>(h->quantile(0.5)), static_cast<double>(h->quantile(0.99)),
+         static_cast<double>(h->quantile(0.999)), sizeof(*h));
+  delete h;
+}
+
+// Keeping every sample and selecting, what sampler_t would need
+static void run_vector() {
+  std::vector<double> kept;
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for (const double x: samples) kept.push_back(x);
+  const auto select = [&kept](const double q) {
+    const auto nth = kept.begin() + static_cast<long>(q * static_cast<double>(kept.size() - 1));
+    std::nth_element(kept.begin(), nth, kept.end());
+    return *nth;
+  };
+  const double p50 = select(0.5), p99 = select(0.99), p999 = select(0.999);
+  const double t   = ns_per_op(start, samples.size());
+
+  report("std::vector + nth_element", t, p50, p99, p999, kept.capacity() * sizeof(double));
+}
+
+int main() {
+  // Latencies in us: lognormal, median about 150 us, long tail
+  std::mt19937                        rng(1);
+  std::lognormal_distribution<double> dist(5, 1);
+  samples.resize(sample_count);
+  for (double &x: samples) x = dist(rng);
+  sorted = samples;
+  std::sort(sorted.begin(), sorted.end());
+
+  std::cout << "4M lognormal latencies, insertion cost and accuracy:\n";
+  run_p2();
+  run_t_digest<100>("t_digest_t<100>");
+  run_t_digest<200>("t_digest_t<200>");
+  run_hdr();
+  run_hdr_threads(4);
+  run_vector();
+  return 0;
+}
@@ -0,0 +1,151 @@
+#include "lib_xcore"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct message_t {
+  uint64_t id;
+  double   values[7];
+};
+
+constexpr size_t pool_capacity = 16384;
+
+static xcore::bitmap_cache_backend_t<message_t, pool_capacity> pool;
+
+using message_cache = xcore::thread_cache_t<pool>;
+
+// The baseline: a shared bitmap_allocator behind one global lock
+static xcore::bitmap_allocator<message_t, pool_capacity> locked_pool;
+static std::mutex                                        locked_pool_mutex;
+
+struct malloc_api {
+  static void *allocate(const size_t n) { return malloc(n); }
+  static void  deallocate(void *p) { free(p); }
+};
+
+struct locked_bitmap_api {
+  static void *allocate(size_t) {
+    std::lock_guard<std::mutex> lock(locked_pool_mutex);
+    return locked_pool.acquire();
+  }
+
+  static void deallocate(void *p) {
+    std::lock_guard<std::mutex> lock(locked_pool_mutex);
+    locked_pool.release(static_cast<message_t *>(p));
+  }
+};
+
+template<typename Func>
+void run_threads(const std::string &name, const int num_threads, const double ops_per_thread, Func &&func) {
+  std::vector<std::thread> threads;
+
+  auto start = std::chrono::high_resolution_clock::now();
+
+  for (int t = 0; t < num_threads; ++t) threads.emplace_back(func, t);
+  for (std::thread &thread: threads) thread.join();
+
+  auto                          end      = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> duration = end - start;
+  const double                  count    = ops_per_thread * num_threads;
+
+  std::cout << std::setw(28) << name << " x" << num_threads << ": "
+            << std::setw(8) << std::fixed << std::setprecision(2) << count / duration.count() / 1e6 << " M ops/s"
+            << "  (" << std::setprecision(1) << duration.count() * 1e9 / count << " ns/op)\n";
+}
+
+// Each thread allocates a batch of blocks of mixed sizes, then frees them
+template<typename Api>
+void local_churn(const std::string &name, const int num_threads, const int rounds, const bool fixed_size) {
+  constexpr int batch = 64;
+
+  run_threads(name, num_threads, 2.0 * rounds * batch, [&](const int t) {
+    void    *blocks[batch];
+    uint32_t seed = 12345u + static_cast<uint32_t>(t);
+
+    for (int r = 0; r < rounds; ++r) {
+      for (void *&block: blocks) {
+        seed           = seed * 1664525u + 1013904223u;
+        const size_t n = fixed_size ? sizeof(message_t) : 16 + (seed >> 24);
+        block          = Api::allocate(n);
+        *static_cast<unsigned char *>(block) = 1;
+      }
+      for (void *block: blocks) Api::deallocate(block);
+    }
+  });
+}
+
+// Half of the threads allocate, the other half free what they receive
+template<typename Api>
+void producer_consumer(const std::string &name, const int num_threads, const int messages) {
+  struct channel_t {
+    std::mutex          mutex;
+    std::vector<void *> queue;
+    bool                done = false;
+  };
+
+  std::vector<channel_t> channels(static_cast<size_t>(num_threads / 2));
+
+  run_threads(name, num_threads, static_cast<double>(messages), [&](const int t) {
+    channel_t &channel = channels[static_cast<size_t>(t / 2)];
+
+    if (t % 2 == 0) {
+      std::vector<void *> batch;
+      for (int i = 0; i < 2 * messages; ++i) {
+        batch.push_back(Api::allocate(sizeof(message_t)));
+        if (batch.size() == 64 || i == 2 * messages - 1) {
+          for (bool sent = false; !sent; std::this_thread::yield()) {
+            std::lock_guard<std::mutex> lock(channel.mutex);
+            if ((sent = channel.queue.size() < 4096)) channel.queue.insert(channel.queue.end(), batch.begin(), batch.end());
+          }
+          batch.clear();
+        }
+      }
+      std::lock_guard<std::mutex> lock(channel.mutex);
+      channel.done = true;
+    } else {
+      std::vector<void *> received;
+      for (bool done = false; !done;) {
+        {
+          std::lock_guard<std::mutex> lock(channel.mutex);
+          received.swap(channel.queue);
+          done = channel.done && received.empty();
+        }
+        for (void *block: received) Api::deallocate(block);
+        received.clear();
+        std::this_thread::yield();
+      }
+    }
+  });
+}
+
+int main() {
+  constexpr int rounds   = 20'000;
+  constexpr int messages = 200'000;
+
+  std::cout << "Local allocate/free of 16..271 bytes (" << std::thread::hardware_concurrency() << " hardware threads):\n";
+  for (const int threads: {1, 2, 4, 8}) {
+    local_churn<malloc_api>("malloc", threads, rounds, false);
+    local_churn<xcore::malloc_thread_cache_t>("malloc_thread_cache_t", threads, rounds, false);
+  }
+
+  std::cout << "\nLocal allocate/free of " << sizeof(message_t) << "-byte messages:\n";
+  for (const int threads: {1, 2, 4, 8}) {
+    local_churn<malloc_api>("malloc", threads, rounds, true);
+    local_churn<locked_bitmap_api>("locked bitmap_allocator", threads, rounds, true);
+    local_churn<message_cache>("thread_cache_t<bitmap>", threads, rounds, true);
+  }
+
+  std::cout << "\nCross-thread frees (producer/consumer pairs):\n";
+  for (const int threads: {2, 4, 8}) {
+    producer_consumer<malloc_api>("malloc", threads, messages);
+    producer_consumer<locked_bitmap_api>("locked bitmap_allocator", threads, messages);
+    producer_consumer<message_cache>("thread_cache_t<bitmap>", threads, messages);
+  }
+
+  return 0;
+}
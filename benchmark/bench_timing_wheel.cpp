@@ -0,0 +1,126 @@
+#include "lib_xcore"
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+static uint32_t fake_now = 0;
+static uint32_t fake_millis() { return fake_now; }
+
+static size_t fired = 0;
+static void   on_fire(void *) { ++fired; }
+
+static constexpr size_t   timer_count = 1000000;
+static constexpr uint32_t max_delay   = 60000;  // One minute of 1 ms ticks
+
+static double ns_per_op(const std::chrono::high_resolution_clock::time_point start, const size_t ops) {
+  std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+  return duration.count() * 1e9 / static_cast<double>(ops);
+}
+
+static void report(const char *name, const double schedule, const double cancel, const double tick) {
+  std::cout << std::setw(22) << name << ":  schedule " << std::fixed << std::setprecision(1) << std::setw(6) << schedule
+            << " ns  cancel " << std::setw(6) << cancel << " ns  update " << std::setw(8) << tick << " ns/tick\n";
+}
+
+// Schedules 1M timers over a minute, cancels half of them (acknowledged retransmits), then runs
+// the clock until all others fired
+static void run_wheel() {
+  using wheel_t = xcore::timing_wheel_t<timer_count, 3, fake_millis>;
+  fake_now      = 0;
+  fired         = 0;
+
+  std::mt19937                    rng(1);
+  auto                           *wheel = new wheel_t();
+  std::vector<wheel_t::handle_t>  handles(timer_count);
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for (auto &h: handles) h = wheel->schedule(1 + rng() % max_delay, on_fire);
+  const double t_schedule = ns_per_op(start, timer_count);
+
+  start = std::chrono::high_resolution_clock::now();
+  for (size_t i = 0; i < timer_count; i += 2) wheel->cancel(handles[i]);
+  const double t_cancel = ns_per_op(start, timer_count / 2);
+
+  start = std::chrono::high_resolution_clock::now();
+  for (fake_now = 1; fake_now <= max_delay; ++fake_now) wheel->update();
+  const double t_tick = ns_per_op(start, max_delay);
+
+  report("timing_wheel_t", t_schedule, t_cancel, t_tick);
+  if (fired != timer_count / 2) std::cout << "  fired " << fired << " timers!\n";
+  delete wheel;
+}
+
+// Min-heap of (expiry, id), cancelled entries are skipped when popped
+static void run_heap() {
+  using entry_t = std::pair<uint32_t, uint32_t>;
+  fake_now      = 0;
+  fired         = 0;
+
+  std::mt19937                                                          rng(1);
+  std::priority_queue<entry_t, std::vector<entry_t>, std::greater<entry_t>> heap;
+  std::vector<bool>                                                     cancelled(timer_count);
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for (uint32_t id = 0; id < timer_count; ++id) heap.emplace(fake_now + 1 + rng() % max_delay, id);
+  const double t_schedule = ns_per_op(start, timer_count);
+
+  start = std::chrono::high_resolution_clock::now();
+  for (size_t i = 0; i < timer_count; i += 2) cancelled[i] = true;
+  const double t_cancel = ns_per_op(start, timer_count / 2);
+
+  start = std::chrono::high_resolution_clock::now();
+  for (fake_now = 1; fake_now <= max_delay; ++fake_now) {
+    while (!heap.empty() && heap.top().first <= fake_now) {
+      if (!cancelled[heap.top().second]) on_fire(nullptr);
+      heap.pop();
+    }
+  }
+  const double t_tick = ns_per_op(start, max_delay);
+
+  report("std::priority_queue", t_schedule, t_cancel, t_tick);
+}
+
+// One deadline per timer compared on every tick, as with a nonblocking_delay per timeout
+static void run_polling(const size_t count) {
+  fake_now = 0;
+  fired    = 0;
+
+  std::mt19937          rng(1);
+  std::vector<uint32_t> deadlines(count);
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for (uint32_t &d: deadlines) d = fake_now + 1 + rng() % max_delay;
+  const double t_schedule = ns_per_op(start, count);
+
+  start = std::chrono::high_resolution_clock::now();
+  for (size_t i = 0; i < count; i += 2) deadlines[i] = 0;
+  const double t_cancel = ns_per_op(start, count / 2);
+
+  const uint32_t ticks = 2000;
+  start                = std::chrono::high_resolution_clock::now();
+  for (fake_now = 1; fake_now <= ticks; ++fake_now) {
+    for (uint32_t &d: deadlines) {
+      if (d != 0 && static_cast<int32_t>(fake_now - d) >= 0) {
+        d = 0;
+        on_fire(nullptr);
+      }
+    }
+  }
+  const double t_tick = ns_per_op(start, ticks);
+
+  report(count == timer_count ? "polling" : "polling (10k timers)", t_schedule, t_cancel, t_tick);
+}
+
+int main() {
+  std::cout << "1M timers over 60000 ticks, half cancelled:\n";
+  run_wheel();
+  run_heap();
+  run_polling(timer_count);
+  run_polling(10000);
+  return 0;
+}
@@ -18,10 +18,10 @@ namespace container {
   }  // namespace utils
 
   namespace detail {
-    template<template<typename, size_t, template<typename> class> class ArrayForm, typename Tp, size_t Size>
-    struct array_container_t {
+    template<typename ConcreteArray, typename Tp, size_t Size>
+    struct array_container_t {  // CRTP
     private:
-      using concrete_array_t = ArrayForm<Tp, Size, unused_allocator_t>;
+      using concrete_array_t = ConcreteArray;
 
       constexpr concrete_array_t *derived() {
         return static_cast<concrete_array_t *>(this);
@@ -170,11 +170,16 @@ namespace container {
 
   /**
    * Static region-allocated data container
+   *
+   * @tparam Alignment  Alignment of the storage (a power of 2), e.g. cache_line_size so that SIMD
+   *                    kernels can use aligned loads. Never less than alignof(Tp).
    */
-  template<typename Tp, size_t Size, template<typename> class = unused_allocator_t>
-  struct array_t : detail::array_container_t<array_t, Tp, Size> {
+  template<typename Tp, size_t Size, template<typename> class BaseAllocator = unused_allocator_t, size_t Alignment = alignof(Tp)>
+  struct array_t : detail::array_container_t<array_t<Tp, Size, BaseAllocator, Alignment>, Tp, Size> {
+    static_assert(Alignment > 0 && (Alignment & (Alignment - 1)) == 0, "Alignment must be a power of 2.");
+
   protected:
-    c_array<Tp, Size> arr_ = {};
+    alignas(Tp) alignas(Alignment) c_array<Tp, Size> arr_ = {};
 
   public:
     // Default Constructor
@@ -231,9 +236,13 @@ namespace container {
 
   /**
    * Static heap-allocated data container
+   *
+   * The default allocator zero-fills the storage but only guarantees malloc() alignment. Pass
+   * aligned_allocator_t (cache line) or aligned_allocator_form_t<N>::type for SIMD-aligned
+   * storage, which is left uninitialized.
    */
   template<typename Tp, size_t Size, template<typename> class BaseAllocator = default_allocator_t>
-  struct heap_array_t : detail::array_container_t<heap_array_t, Tp, Size> {
+  struct heap_array_t : detail::array_container_t<heap_array_t<Tp, Size, BaseAllocator>, Tp, Size> {
   private:
     using array_type      = array_t<Tp, Size>;
     using array_allocator = BaseAllocator<array_type>;
@@ -302,9 +311,12 @@ namespace container {
   * Simple heap-allocated dynamic array.
   * This is not a ported version of std::vector.
   * NOT INTENDED FOR DIRECT USAGE.
+  *
+  * As with heap_array_t, the default allocator zero-fills with malloc() alignment; aligned
+  * storage takes aligned_allocator_t, and is then uninitialized.
   */
-  template<typename Tp, size_t, template<typename> class BaseAllocator = default_allocator_t>
-  struct dynamic_array_t : detail::array_container_t<dynamic_array_t, Tp, 0> {
+  template<typename Tp, size_t Size, template<typename> class BaseAllocator = default_allocator_t>
+  struct dynamic_array_t : detail::array_container_t<dynamic_array_t<Tp, Size, BaseAllocator>, Tp, 0> {
   private:
     using array_allocator = BaseAllocator<Tp>;
 
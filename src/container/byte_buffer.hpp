@@ -2,6 +2,7 @@
 #define LIB_XCORE_CONTAINER_BYTE_BUFFER_HPP
 
 #include "internal/macros.hpp"
+#include "core/ported_pair.hpp"
 #include "container/deque.hpp"
 #include <cstring>
 #include <cstdlib>
@@ -87,6 +88,26 @@ namespace container {
       return ret_opt;
     }
 
+    /**
+     * Contiguous readable region at the front of the buffer, without copying.
+     * When the content wraps around, the rest is exposed after consume().
+     */
+    [[nodiscard]] pair<const unsigned char *, size_t> read_span() const {
+      const size_t len = min(this->size_, Capacity - this->pos_front_);
+      return {this->arr_ + this->pos_front_, len};
+    }
+
+    /**
+     * Drops n bytes from the front, typically after processing a read_span().
+     */
+    bool consume(const size_t n) {
+      if (n > this->size_)
+        return false;
+      this->pos_front_ = utils::cyclic<Capacity>(this->pos_front_ + n);
+      this->size_ -= n;
+      return true;
+    }
+
   protected:
     void _internal_push(const unsigned char *src, const size_t n) {
       const size_t pos_to_insert = this->pos_back_;
@@ -95,8 +116,8 @@ namespace container {
         // No wraparound
         memcpy(this->arr_ + pos_to_insert, src, n);
       } else {
-        // Wraparound
-        const size_t first_part_len = Capacity - pos_to_insert;
+        // Wraparound; the bound by n, true here, lets the compiler see the copy stays within src
+        const size_t first_part_len = min(n, Capacity - pos_to_insert);
         memcpy(this->arr_ + pos_to_insert, src, first_part_len);
         memcpy(this->arr_, src + first_part_len, n - first_part_len);
       }
@@ -0,0 +1,527 @@
+#ifndef LIB_XCORE_CONTAINER_FLAT_HASH_MAP_HPP
+#define LIB_XCORE_CONTAINER_FLAT_HASH_MAP_HPP
+
+#include "internal/macros.hpp"
+#include "core/hash.hpp"
+#include "core/ported_std.hpp"
+#include "core/ported_pair.hpp"
+#include "core/ported_type_traits.hpp"
+#include "core/swar.hpp"
+#include "../xcore/memory"
+#include <cstdint>
+#include <cstring>
+#include <new>
+#if defined(__SSE2__)
+#  include <emmintrin.h>
+#endif
+
+LIB_XCORE_BEGIN_NAMESPACE
+
+namespace container {
+  namespace detail {
+    /**
+     * 16 control bytes of flat_hash_map_t, compared at once: one SSE2 compare, two SWAR words, or
+     * a loop. A control byte is flat_hash_empty, or the 7 low bits of the hash of a full slot.
+     */
+    constexpr uint8_t flat_hash_empty = 0x80;
+
+#if !defined(__SSE2__) && XCORE_SWAR_ENABLED
+    using LIB_XCORE_NAMESPACE::detail::swar_byte_mask;
+    using LIB_XCORE_NAMESPACE::detail::swar_highs;
+    using LIB_XCORE_NAMESPACE::detail::swar_load;
+    using LIB_XCORE_NAMESPACE::detail::swar_movemask;
+#endif
+
+    struct flat_hash_group_t {
+      static constexpr size_t width = 16;
+
+#if defined(__SSE2__)
+      __m128i ctrl;
+
+      explicit flat_hash_group_t(const uint8_t *p) noexcept
+          : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p))) {}
+
+      /** Bit i is set if byte i equals h2. */
+      [[nodiscard]] FORCE_INLINE uint32_t match(const uint8_t h2) const noexcept {
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(static_cast<char>(h2)))));
+      }
+
+      /** Bit i is set if slot i is empty (the only control byte with its high bit set). */
+      [[nodiscard]] FORCE_INLINE uint32_t match_empty() const noexcept {
+        return static_cast<uint32_t>(_mm_movemask_epi8(ctrl));
+      }
+#elif XCORE_SWAR_ENABLED
+      uint64_t lo, hi;
+
+      explicit flat_hash_group_t(const uint8_t *p) noexcept
+          : lo(swar_load(p)), hi(swar_load(p + 8)) {}
+
+      [[nodiscard]] FORCE_INLINE uint32_t match(const uint8_t h2) const noexcept {
+        return swar_movemask(swar_byte_mask(lo, static_cast<char>(h2))) |
+               static_cast<uint32_t>(swar_movemask(swar_byte_mask(hi, static_cast<char>(h2)))) << 8;
+      }
+
+      [[nodiscard]] FORCE_INLINE uint32_t match_empty() const noexcept {
+        return swar_movemask(lo & swar_highs) | static_cast<uint32_t>(swar_movemask(hi & swar_highs)) << 8;
+      }
+#else
+      uint8_t bytes[width];
+
+      explicit flat_hash_group_t(const uint8_t *p) noexcept {
+        memcpy(bytes, p, width);
+      }
+
+      [[nodiscard]] uint32_t match(const uint8_t h2) const noexcept {
+        uint32_t mask = 0;
+        for (size_t i = 0; i < width; ++i) mask |= static_cast<uint32_t>(bytes[i] == h2) << i;
+        return mask;
+      }
+
+      [[nodiscard]] uint32_t match_empty() const noexcept {
+        uint32_t mask = 0;
+        for (size_t i = 0; i < width; ++i) mask |= static_cast<uint32_t>(bytes[i] >> 7) << i;
+        return mask;
+      }
+#endif
+    };
+
+    /**
+     * Number of slots of a fixed flat_hash_map_t: a power of 2 keeping the load under 7/8.
+     */
+    constexpr size_t flat_hash_slots(const size_t capacity) {
+      size_t slots = flat_hash_group_t::width;
+      while (slots - slots / 8 < capacity) slots *= 2;
+      return slots;
+    }
+
+    // Storage of a fixed map: everything inline, the mask is a constant
+    template<typename Slot, size_t Capacity, template<typename> class>
+    struct flat_hash_storage_t {
+      static constexpr size_t num_slots = flat_hash_slots(Capacity);
+
+      uint8_t ctrl_[num_slots + flat_hash_group_t::width - 1];
+      typename aligned_storage<sizeof(Slot), alignof(Slot)>::type slots_[num_slots];
+
+      flat_hash_storage_t() noexcept {
+        memset(ctrl_, flat_hash_empty, sizeof(ctrl_));
+      }
+
+      [[nodiscard]] FORCE_INLINE uint8_t *ctrl() noexcept { return ctrl_; }
+      [[nodiscard]] FORCE_INLINE const uint8_t *ctrl() const noexcept { return ctrl_; }
+      [[nodiscard]] FORCE_INLINE Slot *slots() noexcept { return reinterpret_cast<Slot *>(slots_); }
+      [[nodiscard]] FORCE_INLINE const Slot *slots() const noexcept { return reinterpret_cast<const Slot *>(slots_); }
+      [[nodiscard]] FORCE_INLINE static constexpr size_t mask() noexcept { return num_slots - 1; }
+      [[nodiscard]] FORCE_INLINE static constexpr size_t max_size() noexcept { return Capacity; }
+    };
+
+    // Storage of a dynamic map: arrays from BaseAllocator, grown by rehashing
+    template<typename Slot, template<typename> class BaseAllocator>
+    struct flat_hash_storage_t<Slot, 0, BaseAllocator> {
+      using storage_t      = typename aligned_storage<sizeof(Slot), alignof(Slot)>::type;
+      using ctrl_allocator = BaseAllocator<uint8_t>;
+      using slot_allocator = BaseAllocator<storage_t>;
+
+      // Control bytes of a table without slots: every lookup misses at once
+      alignas(16) static constexpr uint8_t empty_group[flat_hash_group_t::width] = {
+          flat_hash_empty, flat_hash_empty, flat_hash_empty, flat_hash_empty, flat_hash_empty, flat_hash_empty,
+          flat_hash_empty, flat_hash_empty, flat_hash_empty, flat_hash_empty, flat_hash_empty, flat_hash_empty,
+          flat_hash_empty, flat_hash_empty, flat_hash_empty, flat_hash_empty};
+
+      uint8_t   *ctrl_  = const_cast<uint8_t *>(empty_group);
+      storage_t *slots_ = nullptr;
+      size_t     mask_  = 0;
+
+      ~flat_hash_storage_t() noexcept {
+        release();
+      }
+
+      [[nodiscard]] FORCE_INLINE uint8_t *ctrl() noexcept { return ctrl_; }
+      [[nodiscard]] FORCE_INLINE const uint8_t *ctrl() const noexcept { return ctrl_; }
+      [[nodiscard]] FORCE_INLINE Slot *slots() noexcept { return reinterpret_cast<Slot *>(slots_); }
+      [[nodiscard]] FORCE_INLINE const Slot *slots() const noexcept { return reinterpret_cast<const Slot *>(slots_); }
+      [[nodiscard]] FORCE_INLINE size_t mask() const noexcept { return mask_; }
+      [[nodiscard]] FORCE_INLINE size_t max_size() const noexcept { return slots_ ? mask_ + 1 - (mask_ + 1) / 8 : 0; }
+
+      /** Replaces the arrays with empty ones of num_slots (a power of 2, >= 16). */
+      bool allocate(const size_t num_slots) noexcept {
+        uint8_t   *ctrl  = ctrl_allocator::allocate(num_slots + flat_hash_group_t::width - 1);
+        storage_t *slots = slot_allocator::allocate(num_slots);
+        if (is_nullptr(ctrl) || is_nullptr(slots)) {
+          ctrl_allocator::deallocate(ctrl);
+          slot_allocator::deallocate(slots);
+          return false;
+        }
+
+        memset(ctrl, flat_hash_empty, num_slots + flat_hash_group_t::width - 1);
+        ctrl_  = ctrl;
+        slots_ = slots;
+        mask_  = num_slots - 1;
+        return true;
+      }
+
+      void release() noexcept {
+        if (slots_) {
+          ctrl_allocator::deallocate(ctrl_);
+          slot_allocator::deallocate(slots_);
+        }
+        ctrl_  = const_cast<uint8_t *>(empty_group);
+        slots_ = nullptr;
+        mask_  = 0;
+      }
+    };
+  }  // namespace detail
+
+  /**
+   * Open-addressing hash map in the style of SwissTable: keys and values live in one flat array
+   * of slots, and a parallel array holds one control byte per slot, either empty or 7 bits of
+   * the hash of its key. A lookup starts at the slot given by the other hash bits and compares
+   * the control bytes 16 at a time (SSE2, else SWAR, else a loop), so that keys are only
+   * compared on a 7-bit match, about one false match in 128 slots.
+   * \n
+   * Probing is linear, slot by slot, so that erase() needs no tombstone: it shifts the following
+   * keys of the cluster back into the hole (backward-shift deletion). A lookup thus ends at the
+   * first empty slot, and the table never degrades after many erasures. The load is kept under 7/8.
+   * \n
+   * With Capacity > 0, the map holds up to Capacity keys inline, without any heap allocation, and
+   * insertion fails once full:
+   *
+   *   flat_hash_map_t<uint32_t, sensor_t, 64> sensors;  // Fixed, no heap
+   *   sensors.insert(id, sensor);
+   *   if (sensor_t *s = sensors.get(id)) ...
+   *
+   * With Capacity = 0 (like dynamic_array_t), the slots come from BaseAllocator and the table
+   * doubles as needed.
+   * \n
+   * Iterators and pointers to values are invalidated by insertion into a dynamic map (rehash) and
+   * by erase() (backward shift). Keys must not be modified through iterators.
+   *
+   * @tparam K              Key Type, compared with ==
+   * @tparam V              Value Type
+   * @tparam Capacity       Maximum number of keys of a fixed map, 0 for a dynamic map
+   * @tparam Hash           Function object returning 64 well-mixed bits for a key, xcore::hash by default
+   * @tparam BaseAllocator  Memory allocator of a dynamic map
+   */
+  template<typename K, typename V, size_t Capacity = 0, typename Hash = hash<K>,
+           template<typename> class BaseAllocator = default_allocator_t>
+  class flat_hash_map_t {
+  public:
+    using key_type    = K;
+    using mapped_type = V;
+    using value_type  = pair<const K, V>;
+
+  protected:
+    using group_t   = detail::flat_hash_group_t;
+    using storage_t = detail::flat_hash_storage_t<value_type, Capacity, BaseAllocator>;
+
+    static constexpr size_t  width      = group_t::width;
+    static constexpr uint8_t ctrl_empty = detail::flat_hash_empty;
+
+    storage_t storage_;
+    size_t    size_ = 0;
+
+    template<typename Map, typename Value>
+    class basic_iterator {
+      friend class flat_hash_map_t;
+
+      Map   *map_;
+      size_t index_;
+
+      basic_iterator(Map *map, const size_t index) noexcept : map_(map), index_(index) {
+        skip();
+      }
+
+      void skip() noexcept {
+        const size_t n = map_->bucket_count();
+        while (index_ < n && map_->storage_.ctrl()[index_] == ctrl_empty) ++index_;
+      }
+
+    public:
+      basic_iterator() noexcept : map_(nullptr), index_(0) {}
+
+      Value &operator*() const noexcept {
+        return map_->storage_.slots()[index_];
+      }
+
+      Value *operator->() const noexcept {
+        return map_->storage_.slots() + index_;
+      }
+
+      basic_iterator &operator++() noexcept {
+        ++index_;
+        skip();
+        return *this;
+      }
+
+      bool operator==(const basic_iterator &other) const noexcept {
+        return index_ == other.index_;
+      }
+
+      bool operator!=(const basic_iterator &other) const noexcept {
+        return index_ != other.index_;
+      }
+    };
+
+  public:
+    using iterator       = basic_iterator<flat_hash_map_t, value_type>;
+    using const_iterator = basic_iterator<const flat_hash_map_t, const value_type>;
+
+    flat_hash_map_t() noexcept = default;
+
+    flat_hash_map_t(const flat_hash_map_t &)            = delete;
+    flat_hash_map_t &operator=(const flat_hash_map_t &) = delete;
+
+    ~flat_hash_map_t() noexcept {
+      _destroy_all();
+    }
+
+    // Methods
+
+    /**
+     * Inserts key with a value constructed from args, unless key is present.
+     *
+     * @return The element of key, and true if it was inserted; end() and false if a fixed map is
+     *         full or a dynamic map cannot grow
+     */
+    template<typename... Args>
+    pair<iterator, bool> try_emplace(const K &key, Args &&...args) {
+      const uint64_t h     = Hash{}(key);
+      size_t         index = _find(key, h);
+      if (index != npos) return {iterator(this, index), false};
+
+      if (size_ >= storage_.max_size()) {
+        if constexpr (Capacity == 0) {
+          if (!_rehash(storage_.mask() ? 2 * (storage_.mask() + 1) : width)) return {end(), false};
+        } else {
+          return {end(), false};
+        }
+      }
+
+      index = _find_empty(h);
+      new (storage_.slots() + index) value_type(K(key), V(forward<Args>(args)...));
+      _set_ctrl(index, _h2(h));
+      ++size_;
+      return {iterator(this, index), true};
+    }
+
+    /**
+     * @return true if inserted, false if key was present (its value is kept) or no room is left
+     */
+    bool insert(const K &key, const V &value) {
+      return try_emplace(key, value).second;
+    }
+
+    /**
+     * Inserts key, or assigns value to it if present.
+     *
+     * @return false if no room is left
+     */
+    bool insert_or_assign(const K &key, const V &value) {
+      auto [it, inserted] = try_emplace(key, value);
+      if (it == end()) return false;
+      if (!inserted) it->second = value;
+      return true;
+    }
+
+    /**
+     * The value of key, default-constructed if absent. The map must have room for it.
+     */
+    V &operator[](const K &key) {
+      return try_emplace(key).first->second;
+    }
+
+    [[nodiscard]] iterator find(const K &key) noexcept {
+      const size_t index = _find(key, Hash{}(key));
+      return iterator(this, index == npos ? bucket_count() : index);
+    }
+
+    [[nodiscard]] const_iterator find(const K &key) const noexcept {
+      const size_t index = _find(key, Hash{}(key));
+      return const_iterator(this, index == npos ? bucket_count() : index);
+    }
+
+    /**
+     * @return The value of key, or nullptr if absent
+     */
+    [[nodiscard]] V *get(const K &key) noexcept {
+      const size_t index = _find(key, Hash{}(key));
+      return index == npos ? nullptr : &storage_.slots()[index].second;
+    }
+
+    [[nodiscard]] const V *get(const K &key) const noexcept {
+      const size_t index = _find(key, Hash{}(key));
+      return index == npos ? nullptr : &storage_.slots()[index].second;
+    }
+
+    [[nodiscard]] bool contains(const K &key) const noexcept {
+      return _find(key, Hash{}(key)) != npos;
+    }
+
+    /**
+     * Erases key, shifting the rest of its cluster back.
+     *
+     * @return false if key was absent
+     */
+    bool erase(const K &key) {
+      size_t hole = _find(key, Hash{}(key));
+      if (hole == npos) return false;
+
+      const size_t mask  = storage_.mask();
+      value_type  *slots = storage_.slots();
+      slots[hole].~value_type();
+
+      // Move back every following key of the cluster whose home is not after the hole
+      for (size_t next = (hole + 1) & mask; storage_.ctrl()[next] != ctrl_empty; next = (next + 1) & mask) {
+        const size_t home = static_cast<size_t>(Hash{}(slots[next].first) >> 7) & mask;
+        if (((next - home) & mask) < ((next - hole) & mask)) continue;
+
+        new (slots + hole) value_type(move(slots[next]));
+        slots[next].~value_type();
+        _set_ctrl(hole, storage_.ctrl()[next]);
+        hole = next;
+      }
+
+      _set_ctrl(hole, ctrl_empty);
+      --size_;
+      return true;
+    }
+
+    void clear() noexcept {
+      _destroy_all();
+      memset(storage_.ctrl(), ctrl_empty, bucket_count() ? bucket_count() + width - 1 : 0);
+      size_ = 0;
+    }
+
+    /**
+     * Grows a dynamic map to hold n keys without rehashing.
+     *
+     * @return false if the allocation failed, or if a fixed map cannot hold n keys
+     */
+    bool reserve(const size_t n) {
+      if constexpr (Capacity == 0) {
+        if (n <= storage_.max_size()) return true;
+        return _rehash(detail::flat_hash_slots(n));
+      } else {
+        return n <= Capacity;
+      }
+    }
+
+    [[nodiscard]] iterator begin() noexcept {
+      return iterator(this, 0);
+    }
+
+    [[nodiscard]] iterator end() noexcept {
+      return iterator(this, bucket_count());
+    }
+
+    [[nodiscard]] const_iterator begin() const noexcept {
+      return const_iterator(this, 0);
+    }
+
+    [[nodiscard]] const_iterator end() const noexcept {
+      return const_iterator(this, bucket_count());
+    }
+
+    [[nodiscard]] constexpr size_t size() const noexcept {
+      return size_;
+    }
+
+    [[nodiscard]] constexpr bool empty() const noexcept {
+      return size_ == 0;
+    }
+
+    /** Number of keys the map holds before it is full (fixed) or rehashes (dynamic). */
+    [[nodiscard]] size_t capacity() const noexcept {
+      return storage_.max_size();
+    }
+
+    /** Number of slots. */
+    [[nodiscard]] size_t bucket_count() const noexcept {
+      return storage_.slots() ? storage_.mask() + 1 : 0;
+    }
+
+  protected:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    FORCE_INLINE static constexpr uint8_t _h2(const uint64_t h) noexcept {
+      return static_cast<uint8_t>(h & 0x7F);
+    }
+
+    // Control bytes are followed by a copy of the first width - 1, so that a group can be loaded
+    // at any slot without wrapping
+    FORCE_INLINE void _set_ctrl(const size_t index, const uint8_t c) noexcept {
+      storage_.ctrl()[index] = c;
+      if (index < width - 1) storage_.ctrl()[storage_.mask() + 1 + index] = c;
+    }
+
+    size_t _find(const K &key, const uint64_t h) const noexcept {
+      const size_t       mask  = storage_.mask();
+      const uint8_t      h2    = _h2(h);
+      const value_type  *slots = storage_.slots();
+
+      for (size_t pos = static_cast<size_t>(h >> 7) & mask;; pos = (pos + width) & mask) {
+        const group_t group(storage_.ctrl() + pos);
+
+        for (uint32_t match = group.match(h2); match; match &= match - 1) {
+          const size_t index = (pos + static_cast<size_t>(__builtin_ctz(match))) & mask;
+          if (LIKELY(slots[index].first == key)) return index;
+        }
+
+        if (LIKELY(group.match_empty())) return npos;
+      }
+    }
+
+    size_t _find_empty(const uint64_t h) const noexcept {
+      const size_t mask = storage_.mask();
+
+      for (size_t pos = static_cast<size_t>(h >> 7) & mask;; pos = (pos + width) & mask) {
+        if (const uint32_t match = group_t(storage_.ctrl() + pos).match_empty())
+          return (pos + static_cast<size_t>(__builtin_ctz(match))) & mask;
+      }
+    }
+
+    void _destroy_all() noexcept {
+      if (size_ == 0) return;
+
+      const size_t n = bucket_count();
+      for (size_t i = 0; i < n; ++i) {
+        if (storage_.ctrl()[i] != ctrl_empty) storage_.slots()[i].~value_type();
+      }
+    }
+
+    bool _rehash(const size_t num_slots) {
+      storage_t old;
+      old.ctrl_  = storage_.ctrl_;
+      old.slots_ = storage_.slots_;
+      old.mask_  = storage_.mask_;
+      storage_.ctrl_  = const_cast<uint8_t *>(storage_t::empty_group);
+      storage_.slots_ = nullptr;
+
+      if (!storage_.allocate(num_slots)) {
+        storage_.ctrl_  = old.ctrl_;
+        storage_.slots_ = old.slots_;
+        storage_.mask_  = old.mask_;
+        old.slots_      = nullptr;
+        return false;
+      }
+
+      const size_t n = old.slots_ ? old.mask_ + 1 : 0;
+      for (size_t i = 0; i < n; ++i) {
+        if (old.ctrl_[i] == ctrl_empty) continue;
+
+        value_type  &entry = old.slots()[i];
+        const uint64_t h   = Hash{}(entry.first);
+        const size_t index = _find_empty(h);
+        new (storage_.slots() + index) value_type(move(entry));
+        entry.~value_type();
+        _set_ctrl(index, _h2(h));
+      }
+      return true;  // old releases the previous arrays
+    }
+  };
+}  // namespace container
+
+using namespace container;
+
+LIB_XCORE_END_NAMESPACE
+
+#endif  //LIB_XCORE_CONTAINER_FLAT_HASH_MAP_HPP
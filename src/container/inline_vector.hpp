@@ -0,0 +1,306 @@
+#ifndef LIB_XCORE_CONTAINER_INLINE_VECTOR_HPP
+#define LIB_XCORE_CONTAINER_INLINE_VECTOR_HPP
+
+#include "internal/macros.hpp"
+#include "core/ported_std.hpp"
+#include "core/ported_type_traits.hpp"
+#include <cstring>
+#include <new>
+
+LIB_XCORE_BEGIN_NAMESPACE
+
+namespace container {
+  /**
+   * Vector of up to Capacity elements stored inline, without heap allocation. Unlike array_t,
+   * whose size() is always its capacity, the slots past size() hold no object: nothing is
+   * constructed until it is pushed, and erasing destroys.
+   *
+   *   inline_vector_t<peer_t, 16> peers;
+   *
+   *   peers.emplace_back(address, port);  // nullptr if full
+   *   peers.insert(0, first);             // Shifts the others, O(n)
+   *   peers.swap_erase(i);                // The last one takes its place, O(1)
+   *
+   * For trivially copyable types, shifts and copies are a single memmove()/memcpy() and erasing
+   * destroys nothing.
+   *
+   * @tparam Tp        Element Type
+   * @tparam Capacity  Storage Capacity
+   */
+  template<typename Tp, size_t Capacity>
+  class inline_vector_t {
+    static_assert(Capacity > 0, "Capacity must be greater than zero.");
+
+  public:
+    using value_type     = Tp;
+    using iterator       = Tp *;
+    using const_iterator = const Tp *;
+
+  protected:
+    static constexpr bool trivial = is_trivially_copyable_v<Tp>;
+
+    using storage_t = typename aligned_storage<sizeof(Tp), alignof(Tp)>::type;
+
+    // Raw, uninitialized: array_t would zero-fill every slot at construction
+    alignas(Tp) storage_t values_[Capacity];
+    size_t                size_ = 0;
+
+    void destroy(Tp *first, Tp *last) noexcept {
+      if constexpr (!is_trivially_destructible_v<Tp>) {
+        for (; first != last; ++first) first->~Tp();
+      }
+    }
+
+    void copy_from(const inline_vector_t &other) {
+      if constexpr (trivial) {
+        memcpy(static_cast<void *>(data()), other.data(), other.size_ * sizeof(Tp));
+      } else {
+        for (size_t i = 0; i < other.size_; ++i) new (data() + i) Tp(other.data()[i]);
+      }
+      size_ = other.size_;
+    }
+
+    void move_from(inline_vector_t &other) {
+      if constexpr (trivial) {
+        memcpy(static_cast<void *>(data()), other.data(), other.size_ * sizeof(Tp));
+      } else {
+        for (size_t i = 0; i < other.size_; ++i) new (data() + i) Tp(move(other.data()[i]));
+      }
+      size_ = other.size_;
+      other.clear();
+    }
+
+  public:
+    inline_vector_t() noexcept {}  // Not defaulted: inline_vector_t{} would zero the storage
+
+    inline_vector_t(const inline_vector_t &other) {
+      copy_from(other);
+    }
+
+    inline_vector_t(inline_vector_t &&other) noexcept {
+      move_from(other);
+    }
+
+    inline_vector_t &operator=(const inline_vector_t &other) {
+      if (this != &other) {
+        clear();
+        copy_from(other);
+      }
+      return *this;
+    }
+
+    inline_vector_t &operator=(inline_vector_t &&other) noexcept {
+      if (this != &other) {
+        clear();
+        move_from(other);
+      }
+      return *this;
+    }
+
+    ~inline_vector_t() noexcept {
+      destroy(begin(), end());
+    }
+
+    // Methods
+
+    /**
+     * Constructs an element from args at the end.
+     *
+     * @return The element, or nullptr if full
+     */
+    template<typename... Args>
+    Tp *emplace_back(Args &&...args) {
+      if (full()) return nullptr;
+      Tp *p = new (data() + size_) Tp(forward<Args>(args)...);
+      ++size_;
+      return p;
+    }
+
+    /** @return false if full */
+    bool push_back(const Tp &value) {
+      return emplace_back(value) != nullptr;
+    }
+
+    bool push_back(Tp &&value) {
+      return emplace_back(move(value)) != nullptr;
+    }
+
+    /**
+     * Constructs an element from args before element pos, shifting the following ones, O(n).
+     * args may refer to an element of the vector.
+     *
+     * @return false if full or pos > size()
+     */
+    template<typename... Args>
+    bool emplace(const size_t pos, Args &&...args) {
+      if (full() || pos > size_) return false;
+      if (pos == size_) return emplace_back(forward<Args>(args)...) != nullptr;
+
+      Tp  value(forward<Args>(args)...);
+      Tp *p = data();
+
+      if constexpr (trivial) {
+        memmove(static_cast<void *>(p + pos + 1), p + pos, (size_ - pos) * sizeof(Tp));
+        new (p + pos) Tp(move(value));
+      } else {
+        new (p + size_) Tp(move(p[size_ - 1]));
+        for (size_t i = size_ - 1; i > pos; --i) p[i] = move(p[i - 1]);
+        p[pos] = move(value);
+      }
+      ++size_;
+      return true;
+    }
+
+    bool insert(const size_t pos, const Tp &value) {
+      return emplace(pos, value);
+    }
+
+    bool insert(const size_t pos, Tp &&value) {
+      return emplace(pos, move(value));
+    }
+
+    void pop_back() noexcept {
+      if (size_ > 0) data()[--size_].~Tp();
+    }
+
+    /** Removes element pos, keeping the order of the others, O(n). */
+    void erase(const size_t pos) {
+      erase(pos, pos + 1);
+    }
+
+    /** Removes elements [first, last), keeping the order of the others, O(n). */
+    void erase(const size_t first, size_t last) {
+      if (last > size_) last = size_;
+      if (first >= last) return;
+
+      Tp *p = data();
+      if constexpr (trivial) {
+        memmove(static_cast<void *>(p + first), p + last, (size_ - last) * sizeof(Tp));
+      } else {
+        move(p + last, p + size_, p + first);
+        destroy(p + size_ - (last - first), p + size_);
+      }
+      size_ -= last - first;
+    }
+
+    /** Removes element pos by moving the last element into its place, O(1). */
+    void swap_erase(const size_t pos) {
+      if (pos >= size_) return;
+
+      Tp *p = data();
+      if (pos != --size_) {
+        if constexpr (trivial) memcpy(static_cast<void *>(p + pos), p + size_, sizeof(Tp));
+        else p[pos] = move(p[size_]);
+      }
+      destroy(p + size_, p + size_ + 1);
+    }
+
+    /**
+     * Removes the elements satisfying pred, keeping the order of the others, in one pass.
+     *
+     * @return The number of elements removed
+     */
+    template<typename Pred>
+    size_t erase_if(Pred &&pred) {
+      Tp    *p    = data();
+      size_t kept = 0;
+      for (size_t i = 0; i < size_; ++i) {
+        if (pred(static_cast<const Tp &>(p[i]))) continue;
+        if (kept != i) p[kept] = move(p[i]);
+        ++kept;
+      }
+
+      const size_t removed = size_ - kept;
+      destroy(p + kept, p + size_);
+      size_ = kept;
+      return removed;
+    }
+
+    /** Grows to n elements (at most Capacity), value-initializing the new ones, or shrinks to n. */
+    void resize(size_t n) {
+      if (n > Capacity) n = Capacity;
+      if (n < size_) {
+        destroy(data() + n, data() + size_);
+      } else {
+        for (size_t i = size_; i < n; ++i) new (data() + i) Tp();
+      }
+      size_ = n;
+    }
+
+    void clear() noexcept {
+      destroy(begin(), end());
+      size_ = 0;
+    }
+
+    /** Unchecked access: i must be below size(). */
+    [[nodiscard]] Tp &operator[](const size_t i) noexcept {
+      return data()[i];
+    }
+
+    [[nodiscard]] const Tp &operator[](const size_t i) const noexcept {
+      return data()[i];
+    }
+
+    [[nodiscard]] Tp &front() noexcept {
+      return data()[0];
+    }
+
+    [[nodiscard]] const Tp &front() const noexcept {
+      return data()[0];
+    }
+
+    [[nodiscard]] Tp &back() noexcept {
+      return data()[size_ - 1];
+    }
+
+    [[nodiscard]] const Tp &back() const noexcept {
+      return data()[size_ - 1];
+    }
+
+    [[nodiscard]] Tp *data() noexcept {
+      return reinterpret_cast<Tp *>(values_);
+    }
+
+    [[nodiscard]] const Tp *data() const noexcept {
+      return reinterpret_cast<const Tp *>(values_);
+    }
+
+    [[nodiscard]] iterator begin() noexcept {
+      return data();
+    }
+
+    [[nodiscard]] iterator end() noexcept {
+      return data() + size_;
+    }
+
+    [[nodiscard]] const_iterator begin() const noexcept {
+      return data();
+    }
+
+    [[nodiscard]] const_iterator end() const noexcept {
+      return data() + size_;
+    }
+
+    [[nodiscard]] constexpr size_t size() const noexcept {
+      return size_;
+    }
+
+    [[nodiscard]] constexpr bool empty() const noexcept {
+      return size_ == 0;
+    }
+
+    [[nodiscard]] constexpr bool full() const noexcept {
+      return size_ == Capacity;
+    }
+
+    [[nodiscard]] constexpr size_t capacity() const noexcept {
+      return Capacity;
+    }
+  };
+}  // namespace container
+
+using namespace container;
+
+LIB_XCORE_END_NAMESPACE
+
+#endif  //LIB_XCORE_CONTAINER_INLINE_VECTOR_HPP
@@ -0,0 +1,352 @@
+#ifndef LIB_XCORE_CONTAINER_PRIORITY_QUEUE_HPP
+#define LIB_XCORE_CONTAINER_PRIORITY_QUEUE_HPP
+
+#include "internal/macros.hpp"
+#include "core/ported_std.hpp"
+#include "core/ported_optional.hpp"
+#include "container/array.hpp"
+#include <cstdint>
+
+LIB_XCORE_BEGIN_NAMESPACE
+
+namespace container {
+  /**
+   * Priority queue of up to Capacity elements in a d-ary heap, with handles to reorder an element
+   * after its priority changed. Like std::priority_queue, top() is the greatest element under
+   * Compare: less gives a max-heap, greater a min-heap.
+   * \n
+   * With 4 children per node the heap is half as deep as a binary one, and the children of a node
+   * are adjacent, usually in one cache line: pop() does fewer levels of dependent loads for a few
+   * more comparisons per level. Every element sits next to its slot, and a table indexed by slot
+   * gives its position in the heap, kept up to date as elements move.
+   *
+   *   priority_queue_t<event_t, 256, greater<event_t>> events;  // Earliest first
+   *
+   *   auto h = events.push(event);
+   *   events.decrease_key(h, sooner);                          // Moves it towards the top
+   *   while (auto e = events.pop()) ...
+   *
+   * A handle is valid until its element leaves the queue. As in slot_map_t, a handle holds the
+   * generation of its slot, incremented when an element takes the slot and when it leaves: a
+   * handle kept after pop() (a timer that already fired) is rejected rather than reaching the
+   * element pushed into the slot since.
+   *
+   * @tparam Tp        Element Type, default-constructible
+   * @tparam Capacity  Storage Capacity, at most 2^24, so that handles keep 8 bits of generation
+   * @tparam Compare   Strict weak order, Compare(a, b) if a goes below b
+   * @tparam Arity     Children per node
+   */
+  template<typename Tp, size_t Capacity, typename Compare = less<Tp>, size_t Arity = 4>
+  class priority_queue_t {
+    static_assert(Capacity > 0 && Capacity <= (size_t(1) << 24), "Capacity must be in [1, 2^24].");
+    static_assert(Arity >= 2, "Arity must be at least 2.");
+
+  public:
+    /** Bits of a handle holding the slot, the others hold its generation. */
+    static constexpr uint32_t index_bits = []() {
+      uint32_t bits = 1;
+      while ((size_t(1) << bits) < Capacity) ++bits;
+      return bits;
+    }();
+
+    static constexpr uint32_t index_mask      = (uint32_t(1) << index_bits) - 1;
+    static constexpr uint32_t generation_mask = 0xFFFFFFFFu >> index_bits;
+
+    /**
+     * Identifies an element while it is in the queue: its slot and the generation of the slot.
+     * The default handle is null and never valid.
+     */
+    struct handle_t {
+      uint32_t value = 0;
+
+      [[nodiscard]] constexpr uint32_t index() const noexcept {
+        return value & index_mask;
+      }
+
+      [[nodiscard]] constexpr uint32_t generation() const noexcept {
+        return value >> index_bits;
+      }
+
+      constexpr explicit operator bool() const noexcept {
+        return value != 0;
+      }
+
+      constexpr bool operator==(const handle_t &other) const noexcept {
+        return value == other.value;
+      }
+
+      constexpr bool operator!=(const handle_t &other) const noexcept {
+        return value != other.value;
+      }
+    };
+
+    static constexpr handle_t null_handle = {};
+
+  protected:
+    struct entry_t {
+      Tp       value;
+      uint32_t slot;
+    };
+
+    array_t<entry_t, Capacity>  heap_        = {};
+    array_t<uint32_t, Capacity> position_    = {};  // Slot -> heap index
+    array_t<uint32_t, Capacity> generations_ = {};  // Odd while the slot holds an element
+    array_t<uint32_t, Capacity> free_        = {};  // Stack of slots given back by pop()
+    uint32_t                    size_        = 0;
+    uint32_t                    free_size_   = 0;
+    uint32_t                    carved_      = 0;   // Slots used at least once
+    Compare                     compare_     = {};
+
+    FORCE_INLINE static constexpr size_t parent(const size_t i) noexcept {
+      return (i - 1) / Arity;
+    }
+
+    FORCE_INLINE static constexpr size_t first_child(const size_t i) noexcept {
+      return i * Arity + 1;
+    }
+
+    FORCE_INLINE void place(const size_t i, entry_t &&entry) noexcept {
+      position_[entry.slot] = static_cast<uint32_t>(i);
+      heap_[i]              = move(entry);
+    }
+
+    /** Moves the entry at i up while it goes above its parent, shifting parents down into the hole. */
+    void sift_up(size_t i) {
+      entry_t entry = move(heap_[i]);
+
+      while (i > 0) {
+        const size_t p = parent(i);
+        if (!compare_(heap_[p].value, entry.value)) break;
+        place(i, move(heap_[p]));
+        i = p;
+      }
+      place(i, move(entry));
+    }
+
+    /** Moves the entry at i down while a child goes above it, shifting children up into the hole. */
+    void sift_down(size_t i) {
+      entry_t entry = move(heap_[i]);
+
+      for (;;) {
+        const size_t first = first_child(i);
+        if (first >= size_) break;
+
+        const size_t last = first + Arity < size_ ? first + Arity : size_;
+        size_t       best = first;
+        for (size_t c = first + 1; c < last; ++c) {
+          if (compare_(heap_[best].value, heap_[c].value)) best = c;
+        }
+
+        if (!compare_(entry.value, heap_[best].value)) break;
+        place(i, move(heap_[best]));
+        i = best;
+      }
+      place(i, move(entry));
+    }
+
+    /** Takes a free slot and makes it live, with the next (odd) generation. */
+    handle_t acquire_handle() noexcept {
+      const uint32_t slot       = free_size_ > 0 ? free_[--free_size_] : carved_++;
+      const uint32_t generation = (generations_[slot] + 1) & generation_mask;
+      generations_[slot]        = generation;
+      return handle_t{generation << index_bits | slot};
+    }
+
+    /** Gives a slot back, with the next (even) generation, so that its handles become stale. */
+    FORCE_INLINE void release_slot(const uint32_t slot) noexcept {
+      generations_[slot] = (generations_[slot] + 1) & generation_mask;
+    }
+
+  public:
+    priority_queue_t() = default;
+
+    explicit priority_queue_t(const Compare &compare) : compare_(compare) {}
+
+    // Methods
+
+    /**
+     * Inserts a copy of value, O(log n).
+     *
+     * @return Its handle, or null_handle if the queue is full
+     */
+    handle_t push(const Tp &value) {
+      return emplace(value);
+    }
+
+    handle_t push(Tp &&value) {
+      return emplace(move(value));
+    }
+
+    template<typename... Args>
+    handle_t emplace(Args &&...args) {
+      if (full()) return null_handle;
+
+      const handle_t handle     = acquire_handle();
+      heap_[size_]              = entry_t{Tp(forward<Args>(args)...), handle.index()};
+      position_[handle.index()] = size_;
+      sift_up(size_++);
+      return handle;
+    }
+
+    /**
+     * Removes the top element, O(log n).
+     *
+     * @return The element, or nullopt if the queue is empty
+     */
+    optional<Tp> pop() {
+      if (empty()) return nullopt;
+
+      Tp value = move(heap_[0].value);
+      remove_at(0);
+      return value;
+    }
+
+    /** @return A copy of the top element, or nullopt if the queue is empty */
+    [[nodiscard]] optional<Tp> peek() const {
+      if (empty()) return nullopt;
+      return heap_[0].value;
+    }
+
+    /** Unchecked access to the top element: the queue must not be empty. */
+    [[nodiscard]] const Tp &top() const noexcept {
+      return heap_[0].value;
+    }
+
+    /** @return The handle of the top element, or null_handle if the queue is empty */
+    [[nodiscard]] handle_t top_handle() const noexcept {
+      return empty() ? null_handle : handle_of(heap_[0].slot);
+    }
+
+    /**
+     * Replaces the element of a handle with value, which must not go below it, and moves it
+     * towards the top, O(log n). With greater (a min-heap) this lowers its key, as in Dijkstra.
+     *
+     * @return false if the handle is not in the queue
+     */
+    bool decrease_key(const handle_t handle, const Tp &value) {
+      if (!contains(handle)) return false;
+
+      const uint32_t i = position_[handle.index()];
+      heap_[i].value   = value;
+      sift_up(i);
+      return true;
+    }
+
+    /**
+     * Replaces the element of a handle with value and moves it up or down, O(log n).
+     *
+     * @return false if the handle is not in the queue
+     */
+    bool update(const handle_t handle, const Tp &value) {
+      if (!contains(handle)) return false;
+
+      const uint32_t i  = position_[handle.index()];
+      const bool     up = compare_(heap_[i].value, value);
+      heap_[i].value   = value;
+      if (up) sift_up(i);
+      else sift_down(i);
+      return true;
+    }
+
+    /**
+     * Removes the element of a handle wherever it is, O(log n).
+     *
+     * @return false if the handle is not in the queue
+     */
+    bool erase(const handle_t handle) {
+      if (!contains(handle)) return false;
+
+      remove_at(position_[handle.index()]);
+      return true;
+    }
+
+    /** @return The element of a handle, or nullptr if it is not in the queue */
+    [[nodiscard]] const Tp *get(const handle_t handle) const noexcept {
+      return contains(handle) ? &heap_[position_[handle.index()]].value : nullptr;
+    }
+
+    /** @return true if the handle is not null and its element is still in the queue */
+    [[nodiscard]] bool contains(const handle_t handle) const noexcept {
+      const uint32_t slot = handle.index();
+      return handle && slot < carved_ && generations_[slot] == handle.generation();
+    }
+
+    /**
+     * Replaces the content with the elements of [first, last), up to Capacity of them, and orders
+     * them bottom-up in O(n), rather than O(n log n) with n push(). Handles from before become
+     * stale.
+     *
+     * @param handles  If not nullptr, receives the handle of the k-th element at handles[k]
+     * @return The number of elements taken
+     */
+    template<typename InputIt>
+    size_t make_heap(InputIt first, InputIt last, handle_t *handles = nullptr) {
+      clear();
+
+      for (; first != last && size_ < Capacity; ++first, ++size_) {
+        const handle_t handle = acquire_handle();
+        heap_[size_]          = entry_t{Tp(*first), size_};
+        position_[size_]      = size_;
+        if (handles) handles[size_] = handle;
+      }
+
+      if (size_ > 1) {
+        for (size_t i = parent(size_ - 1) + 1; i-- > 0;) sift_down(i);
+      }
+      return size_;
+    }
+
+    /** Removes every element; all handles become stale. */
+    void clear() noexcept {
+      for (uint32_t i = 0; i < size_; ++i) release_slot(heap_[i].slot);
+      size_      = 0;
+      free_size_ = 0;
+      carved_    = 0;
+    }
+
+    [[nodiscard]] constexpr size_t size() const noexcept {
+      return size_;
+    }
+
+    [[nodiscard]] constexpr bool empty() const noexcept {
+      return size_ == 0;
+    }
+
+    [[nodiscard]] constexpr bool full() const noexcept {
+      return size_ == Capacity;
+    }
+
+    [[nodiscard]] constexpr size_t capacity() const noexcept {
+      return Capacity;
+    }
+
+  protected:
+    [[nodiscard]] FORCE_INLINE handle_t handle_of(const uint32_t slot) const noexcept {
+      return handle_t{generations_[slot] << index_bits | slot};
+    }
+
+    /**
+     * Fills the hole at i with the last entry, which then goes up or down. Not bottom-up (hole to
+     * a leaf, then up): in an event queue the last entry is often a recent push near the top, and
+     * walking it back up from a leaf cost twice as much in bench_priority_queue.
+     */
+    void remove_at(const size_t i) {
+      const uint32_t slot = heap_[i].slot;
+      release_slot(slot);
+      free_[free_size_++] = slot;
+
+      if (i == --size_) return;
+
+      // The removed value may be moved-from (pop()): compare the last entry with the parent instead
+      place(i, move(heap_[size_]));
+      if (i > 0 && compare_(heap_[parent(i)].value, heap_[i].value)) sift_up(i);
+      else sift_down(i);
+    }
+  };
+}  // namespace container
+
+using namespace container;
+
+LIB_XCORE_END_NAMESPACE
+
+#endif  //LIB_XCORE_CONTAINER_PRIORITY_QUEUE_HPP
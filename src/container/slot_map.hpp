@@ -0,0 +1,260 @@
+#ifndef LIB_XCORE_CONTAINER_SLOT_MAP_HPP
+#define LIB_XCORE_CONTAINER_SLOT_MAP_HPP
+
+#include "internal/macros.hpp"
+#include "core/ported_std.hpp"
+#include "core/ported_type_traits.hpp"
+#include "container/array.hpp"
+#include <cstdint>
+#include <new>
+
+LIB_XCORE_BEGIN_NAMESPACE
+
+namespace container {
+  /**
+   * Table of up to Capacity objects addressed by 32-bit handles that detect reuse: a handle to an
+   * erased object never reaches the object inserted in its slot afterwards.
+   * \n
+   * Objects are packed at the front of a dense array, so that iterating them touches no hole.
+   * A sparse array indexed by slot gives the dense position of each object; erase() moves the
+   * last object into the hole and updates its slot. Every slot also carries a generation,
+   * incremented on insert and on erase (odd while the slot is live), which handles must match.
+   * insert(), erase() and get() are O(1) and never allocate.
+   *
+   *   slot_map_t<entity_t, 1024> entities;
+   *
+   *   auto id = entities.insert(entity);       // Keep the handle, not a pointer
+   *   if (entity_t *e = entities.get(id)) ...  // nullptr once erased
+   *   for (entity_t &e: entities) ...          // Live objects only, packed
+   *   entities.erase(id);
+   *
+   * Pointers to objects are invalidated by erase(), as the last object moves; handles are not.
+   *
+   * @tparam Tp        Element Type
+   * @tparam Capacity  Storage Capacity, at most 2^24, so that handles keep 8 bits of generation
+   */
+  template<typename Tp, size_t Capacity>
+  class slot_map_t {
+    static_assert(Capacity > 0 && Capacity <= (size_t(1) << 24), "Capacity must be in [1, 2^24].");
+
+  public:
+    /** Bits of a handle holding the slot, the others hold its generation. */
+    static constexpr uint32_t index_bits = []() {
+      uint32_t bits = 1;
+      while ((size_t(1) << bits) < Capacity) ++bits;
+      return bits;
+    }();
+
+    static constexpr uint32_t index_mask      = (uint32_t(1) << index_bits) - 1;
+    static constexpr uint32_t generation_mask = 0xFFFFFFFFu >> index_bits;
+
+    /**
+     * Slot and generation of an object. The default handle is null and never valid.
+     */
+    struct handle_t {
+      uint32_t value = 0;
+
+      [[nodiscard]] constexpr uint32_t index() const noexcept {
+        return value & index_mask;
+      }
+
+      [[nodiscard]] constexpr uint32_t generation() const noexcept {
+        return value >> index_bits;
+      }
+
+      constexpr explicit operator bool() const noexcept {
+        return value != 0;
+      }
+
+      constexpr bool operator==(const handle_t &other) const noexcept {
+        return value == other.value;
+      }
+
+      constexpr bool operator!=(const handle_t &other) const noexcept {
+        return value != other.value;
+      }
+    };
+
+    using iterator       = Tp *;
+    using const_iterator = const Tp *;
+
+  protected:
+    static constexpr uint32_t nil = 0xFFFFFFFFu;
+
+    using storage_t = typename aligned_storage<sizeof(Tp), alignof(Tp)>::type;
+
+    alignas(Tp) storage_t       values_[Capacity];  // Dense, objects in [0, size_), uninitialized
+    array_t<uint32_t, Capacity> dense_slot_;        // Dense position -> slot
+    array_t<uint32_t, Capacity> sparse_;            // Slot -> dense position, or next free slot
+    array_t<uint32_t, Capacity> generations_;       // Odd while the slot is live
+    uint32_t                    size_      = 0;
+    uint32_t                    free_head_ = nil;   // Slots given back by erase()
+    uint32_t                    carved_    = 0;     // Slots used at least once
+
+  public:
+    slot_map_t() noexcept {}  // Not defaulted: slot_map_t{} would zero values_
+
+    slot_map_t(const slot_map_t &)            = delete;
+    slot_map_t &operator=(const slot_map_t &) = delete;
+
+    ~slot_map_t() noexcept {
+      for (uint32_t i = 0; i < size_; ++i) data()[i].~Tp();
+    }
+
+    // Methods
+
+    /**
+     * Constructs an object from args in a free slot.
+     *
+     * @return Its handle, or a null handle if the map is full
+     */
+    template<typename... Args>
+    handle_t emplace(Args &&...args) {
+      uint32_t slot;
+
+      if (free_head_ != nil) {
+        slot = free_head_;
+      } else if (carved_ < Capacity) {
+        slot = carved_;
+      } else {
+        return handle_t{};
+      }
+
+      new (&values_[size_]) Tp(forward<Args>(args)...);
+
+      if (slot == free_head_) free_head_ = sparse_[slot];
+      else ++carved_;
+
+      const uint32_t generation = (generations_[slot] + 1) & generation_mask;
+      generations_[slot]        = generation;
+      sparse_[slot]             = size_;
+      dense_slot_[size_]        = slot;
+      ++size_;
+
+      return handle_t{generation << index_bits | slot};
+    }
+
+    handle_t insert(const Tp &value) {
+      return emplace(value);
+    }
+
+    handle_t insert(Tp &&value) {
+      return emplace(move(value));
+    }
+
+    /**
+     * Destroys the object of a handle, moving the last object into its place.
+     *
+     * @return false if the handle is null or stale
+     */
+    bool erase(const handle_t handle) {
+      if (!contains(handle)) return false;
+
+      const uint32_t slot = handle.index();
+      const uint32_t pos  = sparse_[slot];
+      const uint32_t last = size_ - 1;
+
+      Tp *objects = data();
+      objects[pos].~Tp();
+
+      if (pos != last) {
+        new (objects + pos) Tp(move(objects[last]));
+        objects[last].~Tp();
+        dense_slot_[pos]          = dense_slot_[last];
+        sparse_[dense_slot_[pos]] = pos;
+      }
+      --size_;
+
+      generations_[slot] = (generations_[slot] + 1) & generation_mask;
+      sparse_[slot]      = free_head_;
+      free_head_         = slot;
+      return true;
+    }
+
+    /**
+     * @return The object of a handle, or nullptr if the handle is null or stale
+     */
+    [[nodiscard]] Tp *get(const handle_t handle) noexcept {
+      return contains(handle) ? data() + sparse_[handle.index()] : nullptr;
+    }
+
+    [[nodiscard]] const Tp *get(const handle_t handle) const noexcept {
+      return contains(handle) ? data() + sparse_[handle.index()] : nullptr;
+    }
+
+    /** Unchecked access: the handle must be valid. */
+    [[nodiscard]] Tp &operator[](const handle_t handle) noexcept {
+      return data()[sparse_[handle.index()]];
+    }
+
+    [[nodiscard]] const Tp &operator[](const handle_t handle) const noexcept {
+      return data()[sparse_[handle.index()]];
+    }
+
+    [[nodiscard]] bool contains(const handle_t handle) const noexcept {
+      const uint32_t slot = handle.index();
+      return slot < carved_ && (generations_[slot] & 1) && generations_[slot] == handle.generation();
+    }
+
+    /**
+     * @return The handle of the object at dense position pos (pos < size()), e.g. while iterating
+     */
+    [[nodiscard]] handle_t handle_at(const size_t pos) const noexcept {
+      const uint32_t slot = dense_slot_[pos];
+      return handle_t{generations_[slot] << index_bits | slot};
+    }
+
+    /** Erases every object; all handles become stale. */
+    void clear() {
+      while (size_ > 0) erase(handle_at(size_ - 1));
+    }
+
+    // Iteration over live objects, in dense order
+
+    [[nodiscard]] Tp *data() noexcept {
+      return reinterpret_cast<Tp *>(values_);
+    }
+
+    [[nodiscard]] const Tp *data() const noexcept {
+      return reinterpret_cast<const Tp *>(values_);
+    }
+
+    [[nodiscard]] iterator begin() noexcept {
+      return data();
+    }
+
+    [[nodiscard]] iterator end() noexcept {
+      return data() + size_;
+    }
+
+    [[nodiscard]] const_iterator begin() const noexcept {
+      return data();
+    }
+
+    [[nodiscard]] const_iterator end() const noexcept {
+      return data() + size_;
+    }
+
+    [[nodiscard]] constexpr size_t size() const noexcept {
+      return size_;
+    }
+
+    [[nodiscard]] constexpr bool empty() const noexcept {
+      return size_ == 0;
+    }
+
+    [[nodiscard]] constexpr bool full() const noexcept {
+      return size_ == Capacity;
+    }
+
+    [[nodiscard]] constexpr size_t capacity() const noexcept {
+      return Capacity;
+    }
+  };
+}  // namespace container
+
+using namespace container;
+
+LIB_XCORE_END_NAMESPACE
+
+#endif  //LIB_XCORE_CONTAINER_SLOT_MAP_HPP
@@ -0,0 +1,325 @@
+#ifndef LIB_XCORE_CONTAINER_SOA_VECTOR_HPP
+#define LIB_XCORE_CONTAINER_SOA_VECTOR_HPP
+
+#include "internal/macros.hpp"
+#include "core/ported_std.hpp"
+#include "core/ported_pair.hpp"
+#include "core/ported_tuple.hpp"
+#include "container/array.hpp"
+#include "../xcore/memory"
+
+LIB_XCORE_BEGIN_NAMESPACE
+
+namespace container {
+  /**
+   * Up to Capacity rows of fields Ts..., stored column by column (structure of arrays): each
+   * field has its own array, aligned to a cache line, instead of each row being a struct.
+   * \n
+   * A loop updating one field over every row then reads only that field, contiguously, and the
+   * compiler can vectorize it with aligned loads, which an array of structs prevents:
+   *
+   *   soa_vector_t<1024, vec3_t, vec3_t, uint8_t> entities;  // Position, velocity, flags
+   *
+   *   entities.push_back(p, v, 0);
+   *   auto [x, n]    = entities.column_span<0>();            // Contiguous positions
+   *   const auto *dx = entities.column<1>();
+   *   for (size_t i = 0; i < n; ++i) x[i] += dx[i] * dt;
+   *
+   *   auto [pos, vel, flags] = entities[i];                   // Row of references
+   *
+   * Insertion and erasure act on every column at once, so rows stay aligned across columns.
+   * Every slot is default-constructed, as in array_t.
+   *
+   * @tparam Capacity  Storage Capacity
+   * @tparam Ts        Field Types, default-constructible
+   */
+  template<size_t Capacity, typename... Ts>
+  class soa_vector_t {
+    static_assert(Capacity > 0, "Capacity must be greater than zero.");
+    static_assert(sizeof...(Ts) > 0, "At least one field is required.");
+
+  public:
+    using value_type      = tuple<Ts...>;
+    using reference       = tuple<Ts &...>;
+    using const_reference = tuple<const Ts &...>;
+
+    template<size_t I>
+    using field_t = typename tuple_element<I, value_type>::type;
+
+    static constexpr size_t fields = sizeof...(Ts);
+
+    template<bool Const>
+    class basic_iterator {
+      friend class soa_vector_t;
+
+      using vector_t = conditional_t<Const, const soa_vector_t, soa_vector_t>;
+
+      vector_t *vector_ = nullptr;
+      size_t    pos_    = 0;
+
+      basic_iterator(vector_t *vector, const size_t pos) : vector_(vector), pos_(pos) {}
+
+    public:
+      basic_iterator() = default;
+
+      conditional_t<Const, const_reference, reference> operator*() const {
+        return (*vector_)[pos_];
+      }
+
+      [[nodiscard]] size_t index() const noexcept {
+        return pos_;
+      }
+
+      basic_iterator &operator++() noexcept {
+        ++pos_;
+        return *this;
+      }
+
+      basic_iterator operator++(int) noexcept {
+        basic_iterator it = *this;
+        ++pos_;
+        return it;
+      }
+
+      bool operator==(const basic_iterator &other) const noexcept {
+        return pos_ == other.pos_;
+      }
+
+      bool operator!=(const basic_iterator &other) const noexcept {
+        return pos_ != other.pos_;
+      }
+    };
+
+    using iterator       = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+  protected:
+    template<typename T>
+    using column_t = array_t<T, Capacity, unused_allocator_t, cache_line_size>;
+
+    tuple<column_t<Ts>...> columns_ = {};
+    size_t                 size_    = 0;
+
+    template<size_t... I>
+    reference row(const size_t i, index_sequence<I...>) noexcept {
+      return reference(column<I>()[i]...);
+    }
+
+    template<size_t... I>
+    const_reference row(const size_t i, index_sequence<I...>) const noexcept {
+      return const_reference(column<I>()[i]...);
+    }
+
+    template<typename... Args, size_t... I>
+    void assign(const size_t i, index_sequence<I...>, Args &&...values) {
+      ((column<I>()[i] = forward<Args>(values)), ...);
+    }
+
+    template<size_t... I>
+    void move_row(const size_t to, const size_t from, index_sequence<I...>) {
+      ((column<I>()[to] = move(column<I>()[from])), ...);
+    }
+
+    template<size_t... I>
+    void move_rows(const size_t to, const size_t first, const size_t last, index_sequence<I...>) {
+      (move(column<I>() + first, column<I>() + last, column<I>() + to), ...);
+    }
+
+    template<size_t... I>
+    void move_rows_backward(const size_t to_last, const size_t first, const size_t last, index_sequence<I...>) {
+      const auto shift = [](auto *begin, auto *end, auto *d_end) {
+        while (end != begin) *--d_end = move(*--end);
+      };
+      (shift(column<I>() + first, column<I>() + last, column<I>() + to_last), ...);
+    }
+
+    template<size_t... I>
+    void copy_rows(const size_t to, const size_t count, index_sequence<I...>, const Ts *...sources) {
+      (copy(sources, sources + count, column<I>() + to), ...);
+    }
+
+  public:
+    soa_vector_t() = default;
+
+    // Methods
+
+    /**
+     * Appends a row.
+     *
+     * @return false if full
+     */
+    template<typename... Args, typename = enable_if_t<sizeof...(Args) == sizeof...(Ts)>>
+    bool push_back(Args &&...values) {
+      if (full()) return false;
+      assign(size_++, make_index_sequence<fields>{}, forward<Args>(values)...);
+      return true;
+    }
+
+    /**
+     * Appends count rows read from one array per field, column by column.
+     *
+     * @return The number of rows appended, fewer than count if Capacity is reached
+     */
+    size_t push_back_n(size_t count, const Ts *...sources) {
+      if (count > Capacity - size_) count = Capacity - size_;
+      copy_rows(size_, count, make_index_sequence<fields>{}, sources...);
+      size_ += count;
+      return count;
+    }
+
+    /**
+     * Inserts a row before row pos, shifting the following ones, O(n).
+     *
+     * @return false if full or pos > size()
+     */
+    template<typename... Args, typename = enable_if_t<sizeof...(Args) == sizeof...(Ts)>>
+    bool insert(const size_t pos, Args &&...values) {
+      if (full() || pos > size_) return false;
+      move_rows_backward(size_ + 1, pos, size_, make_index_sequence<fields>{});
+      assign(pos, make_index_sequence<fields>{}, forward<Args>(values)...);
+      ++size_;
+      return true;
+    }
+
+    void pop_back() noexcept {
+      if (size_ > 0) --size_;
+    }
+
+    /** Removes row pos, keeping the order of the others, O(n). */
+    void erase(const size_t pos) {
+      erase(pos, pos + 1);
+    }
+
+    /** Removes rows [first, last), keeping the order of the others, O(n). */
+    void erase(const size_t first, size_t last) {
+      if (last > size_) last = size_;
+      if (first >= last) return;
+
+      move_rows(first, last, size_, make_index_sequence<fields>{});
+      size_ -= last - first;
+    }
+
+    /** Removes row pos by moving the last row into its place, O(1). */
+    void swap_erase(const size_t pos) {
+      if (pos >= size_) return;
+      if (pos != --size_) move_row(pos, size_, make_index_sequence<fields>{});
+    }
+
+    /**
+     * Removes the rows whose reference satisfies pred, keeping the order of the others, in one
+     * pass over the columns.
+     *
+     * @return The number of rows removed
+     */
+    template<typename Pred>
+    size_t erase_if(Pred &&pred) {
+      size_t kept = 0;
+      for (size_t i = 0; i < size_; ++i) {
+        if (pred(static_cast<const soa_vector_t &>(*this)[i])) continue;
+        if (kept != i) move_row(kept, i, make_index_sequence<fields>{});
+        ++kept;
+      }
+
+      const size_t removed = size_ - kept;
+      size_                = kept;
+      return removed;
+    }
+
+    /**
+     * Grows or shrinks to n rows (at most Capacity); new rows keep whatever their slots held.
+     */
+    void resize(const size_t n) noexcept {
+      size_ = n < Capacity ? n : Capacity;
+    }
+
+    void clear() noexcept {
+      size_ = 0;
+    }
+
+    /** Row i as a tuple of references, usable with structured bindings. */
+    [[nodiscard]] reference operator[](const size_t i) noexcept {
+      return row(i, make_index_sequence<fields>{});
+    }
+
+    [[nodiscard]] const_reference operator[](const size_t i) const noexcept {
+      return row(i, make_index_sequence<fields>{});
+    }
+
+    /** Field I of row i. */
+    template<size_t I>
+    [[nodiscard]] field_t<I> &at(const size_t i) noexcept {
+      return column<I>()[i];
+    }
+
+    template<size_t I>
+    [[nodiscard]] const field_t<I> &at(const size_t i) const noexcept {
+      return column<I>()[i];
+    }
+
+    /** Replaces the fields of row i. */
+    template<typename... Args, typename = enable_if_t<sizeof...(Args) == sizeof...(Ts)>>
+    void set(const size_t i, Args &&...values) {
+      assign(i, make_index_sequence<fields>{}, forward<Args>(values)...);
+    }
+
+    /** Array of field I, aligned to a cache line, rows [0, size()) in use. */
+    template<size_t I>
+    [[nodiscard]] field_t<I> *column() noexcept {
+      return LIB_XCORE_NAMESPACE::get<I>(columns_);
+    }
+
+    template<size_t I>
+    [[nodiscard]] const field_t<I> *column() const noexcept {
+      return LIB_XCORE_NAMESPACE::get<I>(columns_);
+    }
+
+    /** Array of field I and the number of rows, e.g. for a vectorized loop. */
+    template<size_t I>
+    [[nodiscard]] pair<field_t<I> *, size_t> column_span() noexcept {
+      return {column<I>(), size_};
+    }
+
+    template<size_t I>
+    [[nodiscard]] pair<const field_t<I> *, size_t> column_span() const noexcept {
+      return {column<I>(), size_};
+    }
+
+    [[nodiscard]] iterator begin() noexcept {
+      return {this, 0};
+    }
+
+    [[nodiscard]] iterator end() noexcept {
+      return {this, size_};
+    }
+
+    [[nodiscard]] const_iterator begin() const noexcept {
+      return {this, 0};
+    }
+
+    [[nodiscard]] const_iterator end() const noexcept {
+      return {this, size_};
+    }
+
+    [[nodiscard]] constexpr size_t size() const noexcept {
+      return size_;
+    }
+
+    [[nodiscard]] constexpr bool empty() const noexcept {
+      return size_ == 0;
+    }
+
+    [[nodiscard]] constexpr bool full() const noexcept {
+      return size_ == Capacity;
+    }
+
+    [[nodiscard]] constexpr size_t capacity() const noexcept {
+      return Capacity;
+    }
+  };
+}  // namespace container
+
+using namespace container;
+
+LIB_XCORE_END_NAMESPACE
+
+#endif  //LIB_XCORE_CONTAINER_SOA_VECTOR_HPP
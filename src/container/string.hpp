@@ -2,6 +2,7 @@
 #define LIB_XCORE_CONTAINER_STRING_HPP
 
 #include "internal/macros.hpp"
+#include "core/hash.hpp"
 #include "core/string_format.hpp"
 #include "container/array.hpp"
 #include "core/custom_numeric.hpp"
@@ -240,7 +241,33 @@ namespace container {
       }
 
       // Comparison
-      // todo: ==, !=, >, >=, <, <=
+      // todo: >, >=, <, <=
+
+      template<size_t OCapacity, template<typename, size_t> class OContainer>
+      [[nodiscard]] bool operator==(const basic_string_t<CharT, OCapacity, OContainer> &other) const {
+        return this->size() == other.size() && memcmp(this->c_str(), other.c_str(), this->size() * sizeof(CharT)) == 0;
+      }
+
+      template<size_t OCapacity, template<typename, size_t> class OContainer>
+      [[nodiscard]] bool operator!=(const basic_string_t<CharT, OCapacity, OContainer> &other) const {
+        return !(*this == other);
+      }
+
+      [[nodiscard]] bool operator==(const CharT *c_str) const {
+        return c_str && strcmp(this->c_str(), c_str) == 0;
+      }
+
+      [[nodiscard]] bool operator!=(const CharT *c_str) const {
+        return !(*this == c_str);
+      }
+
+      [[nodiscard]] friend bool operator==(const CharT *lhs, const basic_string_t &rhs) {
+        return rhs == lhs;
+      }
+
+      [[nodiscard]] friend bool operator!=(const CharT *lhs, const basic_string_t &rhs) {
+        return !(rhs == lhs);
+      }
 
       // Capacity
 
@@ -345,6 +372,16 @@ namespace container {
 
 using namespace container;
 
+/**
+ * Hash of the characters of a string, equal to the hash of a string_view of them.
+ */
+template<size_t Capacity, template<typename, size_t> class Container>
+struct hash<container::impl::basic_string_t<char, Capacity, Container>> {
+  FORCE_INLINE uint64_t operator()(const container::impl::basic_string_t<char, Capacity, Container> &str) const noexcept {
+    return hash_bytes(str.c_str(), str.size());
+  }
+};
+
 LIB_XCORE_END_NAMESPACE
 
 #endif  //LIB_XCORE_CONTAINER_STRING_HPP
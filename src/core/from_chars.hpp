@@ -0,0 +1,194 @@
+#ifndef LIB_XCORE_CORE_FROM_CHARS_HPP
+#define LIB_XCORE_CORE_FROM_CHARS_HPP
+
+#include "internal/macros.hpp"
+#include "core/ported_std.hpp"
+#include "core/custom_numeric.hpp"
+#include <cstdint>
+#include <cstring>
+
+/*
+ * Set to 0 to drop the Eisel-Lemire power-of-five table (~10 KiB of flash) and
+ * parse floating points with strtod only.
+ */
+#ifndef XCORE_FROM_CHARS_EISEL_LEMIRE
+#  define XCORE_FROM_CHARS_EISEL_LEMIRE 1
+#endif
+
+LIB_XCORE_BEGIN_NAMESPACE
+
+/**
+ * Mimic std::errc (only the values reported by from_chars and to_chars)
+ */
+enum class errc : uint8_t {
+  ok = 0,
+  invalid_argument,
+  result_out_of_range,
+  value_too_large
+};
+
+/**
+ * Mimic std::from_chars_result
+ */
+struct from_chars_result {
+  const char *ptr;
+  errc        ec;
+
+  [[nodiscard]] constexpr explicit operator bool() const noexcept { return ec == errc::ok; }
+};
+
+namespace detail {
+  FORCE_INLINE constexpr uint8_t char_to_digit(const char c) {
+    if (c >= '0' && c <= '9') return static_cast<uint8_t>(c - '0');
+    if (c >= 'a' && c <= 'z') return static_cast<uint8_t>(c - 'a' + 10);
+    if (c >= 'A' && c <= 'Z') return static_cast<uint8_t>(c - 'A' + 10);
+    return 0xFF;
+  }
+
+  FORCE_INLINE constexpr bool is_digit(const char c) {
+    return static_cast<unsigned char>(c - '0') < 10;
+  }
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#  define XCORE_FROM_CHARS_SWAR 1
+
+  FORCE_INLINE uint64_t read_u64(const char *p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+  }
+
+  /**
+   * Checks whether all 8 bytes of a little-endian word are ASCII digits.
+   */
+  FORCE_INLINE constexpr bool is_eight_digits(const uint64_t v) {
+    return (((v & 0xF0F0F0F0F0F0F0F0ull) |
+             (((v + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) == 0x3333333333333333ull);
+  }
+
+  /**
+   * Converts 8 ASCII digits packed in a little-endian word to their value
+   * using 3 multiplications instead of 8 multiply-adds.
+   */
+  FORCE_INLINE constexpr uint32_t parse_eight_digits(uint64_t v) {
+    constexpr uint64_t mask = 0x000000FF000000FFull;
+    constexpr uint64_t mul1 = 100 + (1000000ull << 32);
+    constexpr uint64_t mul2 = 1 + (10000ull << 32);
+    v -= 0x3030303030303030ull;
+    v = (v * 10) + (v >> 8);
+    v = (((v & mask) * mul1) + (((v >> 16) & mask) * mul2)) >> 32;
+    return static_cast<uint32_t>(v);
+  }
+#else
+#  define XCORE_FROM_CHARS_SWAR 0
+#endif
+
+  /**
+   * Accumulates base-10 digits into acc. Consumes every digit even on overflow.
+   *
+   * @return Pointer past the last digit consumed
+   */
+  inline const char *accumulate_decimal(const char *p, const char *last, uint64_t &acc, bool &overflow) {
+#if XCORE_FROM_CHARS_SWAR
+    // 2 chunks of 8 digits always fit in 64 bits: 10^16 < 2^64
+    for (int chunk = 0; chunk < 2 && last - p >= 8; ++chunk) {
+      const uint64_t v = read_u64(p);
+      if (!is_eight_digits(v)) break;
+      acc = acc * 100000000ull + parse_eight_digits(v);
+      p += 8;
+    }
+#endif
+    for (; p != last && is_digit(*p); ++p) {
+      const uint64_t d = static_cast<uint64_t>(*p - '0');
+      if (__builtin_mul_overflow(acc, 10ull, &acc) || __builtin_add_overflow(acc, d, &acc))
+        overflow = true;
+    }
+    return p;
+  }
+
+  inline const char *accumulate_radix(const char *p, const char *last, const int base, uint64_t &acc, bool &overflow) {
+    for (; p != last; ++p) {
+      const uint8_t d = char_to_digit(*p);
+      if (d >= base) break;
+      if (__builtin_mul_overflow(acc, static_cast<uint64_t>(base), &acc) ||
+          __builtin_add_overflow(acc, static_cast<uint64_t>(d), &acc))
+        overflow = true;
+    }
+    return p;
+  }
+}  // namespace detail
+
+/**
+ * Mimic std::from_chars for integral types.
+ *
+ * Locale-independent and non-allocating. Base 10 consumes 8 digits per step (SWAR)
+ * on little-endian targets. As in the standard, a leading '-' is accepted only for
+ * signed types, and neither '+' nor radix prefixes ("0x") are accepted.
+ *
+ * @tparam T Integral type
+ * @param first Beginning of the character range
+ * @param last End of the character range
+ * @param value Result, only modified on success
+ * @param base Radix (2-36)
+ * @return Pointer past the consumed characters and an error code
+ */
+template<typename T>
+enable_if_t<is_integral_v<T> && !is_same_v<remove_cv_t<T>, bool>, from_chars_result>
+from_chars(const char *first, const char *last, T &value, const int base = 10) {
+  if (base < 2 || base > 36 || first == last)
+    return {first, errc::invalid_argument};
+
+  const char *p        = first;
+  bool        negative = false;
+
+  if constexpr (is_signed_v<T>) {
+    if (*p == '-') {
+      negative = true;
+      ++p;
+    }
+  }
+
+  const char *digits_begin = p;
+  uint64_t    acc          = 0;
+  bool        overflow     = false;
+
+  p = base == 10 ? detail::accumulate_decimal(p, last, acc, overflow)
+                 : detail::accumulate_radix(p, last, base, acc, overflow);
+
+  if (p == digits_begin)
+    return {first, errc::invalid_argument};
+
+  using U                = make_unsigned_t<T>;
+  constexpr uint64_t max = static_cast<uint64_t>(max_integral<T>());
+
+  if constexpr (is_signed_v<T>) {
+    if (overflow || acc > max + (negative ? 1u : 0u))
+      return {p, errc::result_out_of_range};
+    value = negative ? static_cast<T>(U(0) - static_cast<U>(acc)) : static_cast<T>(acc);
+  } else {
+    if (overflow || acc > max)
+      return {p, errc::result_out_of_range};
+    value = static_cast<T>(acc);
+  }
+
+  return {p, errc::ok};
+}
+
+/**
+ * Mimic std::from_chars for floating points (fixed and scientific format, "inf" and "nan").
+ *
+ * Up to 19 significant digits are converted with the Clinger fast path or the
+ * Eisel-Lemire algorithm, correctly rounded and without touching the C locale.
+ * Longer or halfway-ambiguous inputs, and long double, fall back to strtod under the "C"
+ * locale, whatever the current one. Such a number of 512 characters or more is not
+ * approximated: it reports errc::value_too_large.
+ */
+from_chars_result from_chars(const char *first, const char *last, float &value);
+
+from_chars_result from_chars(const char *first, const char *last, double &value);
+
+from_chars_result from_chars(const char *first, const char *last, long double &value);
+
+LIB_XCORE_END_NAMESPACE
+
+#endif  //LIB_XCORE_CORE_FROM_CHARS_HPP
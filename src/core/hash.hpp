@@ -0,0 +1,189 @@
+#ifndef LIB_XCORE_CORE_HASH_HPP
+#define LIB_XCORE_CORE_HASH_HPP
+
+#include "internal/macros.hpp"
+#include "core/ported_string_view.hpp"
+#include "core/ported_type_traits.hpp"
+#include <cfloat>
+#include <cstdint>
+#include <cstring>
+
+/*
+ * Non-cryptographic 64-bit hashing for hashed containers, after wyhash (Wang Yi, final version 4):
+ * input is folded 16 bytes at a time with 64x64->128-bit multiplications, which mix every input
+ * bit into the whole result at a few cycles per 16 bytes, and keys up to 16 bytes take a single
+ * multiplication. Not resistant to deliberate collisions: seed it if keys come from the outside.
+ *
+ * hash_bytes(), hash_int() and the hash of integers and string views are constexpr, so that the
+ * hash of a key known at compile time is a constant:
+ *
+ *   switch (hash_bytes(name, len)) {
+ *     case hash_bytes("imu", 3): ...
+ */
+
+LIB_XCORE_BEGIN_NAMESPACE
+
+namespace detail {
+  constexpr uint64_t hash_secret[4] = {0x2D358DCCAA6C78A5ull, 0x8BB84B93962EACC9ull, 0x4B33A62ED433D4A3ull,
+                                       0x4D5A2DA51DE1AA47ull};
+
+  /** 128-bit product of a and b: low half in a, high half in b. */
+  FORCE_INLINE constexpr void hash_mum(uint64_t &a, uint64_t &b) {
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+    a                         = static_cast<uint64_t>(r);
+    b                         = static_cast<uint64_t>(r >> 64);
+#else
+    const uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<uint32_t>(a), lb = static_cast<uint32_t>(b);
+    const uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb, t = rl + (rm0 << 32);
+    const uint64_t lo = t + (rm1 << 32);
+    const uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + (t < rl) + (lo < t);
+    a                 = lo;
+    b                 = hi;
+#endif
+  }
+
+  /** Folds a and b into 64 bits: low XOR high half of their product. */
+  FORCE_INLINE constexpr uint64_t hash_mix(uint64_t a, uint64_t b) {
+    hash_mum(a, b);
+    return a ^ b;
+  }
+
+  // Little-endian loads written byte by byte, which stays constexpr; compilers merge them into
+  // a single load at run time
+  FORCE_INLINE constexpr uint64_t hash_byte(const char *p, const int i) {
+    return static_cast<uint64_t>(static_cast<uint8_t>(p[i])) << (i * 8);
+  }
+
+  FORCE_INLINE constexpr uint64_t hash_read4(const char *p) {
+    return hash_byte(p, 0) | hash_byte(p, 1) | hash_byte(p, 2) | hash_byte(p, 3);
+  }
+
+  FORCE_INLINE constexpr uint64_t hash_read8(const char *p) {
+    return hash_read4(p) | hash_byte(p, 4) | hash_byte(p, 5) | hash_byte(p, 6) | hash_byte(p, 7);
+  }
+
+  // 1 to 3 bytes
+  FORCE_INLINE constexpr uint64_t hash_read3(const char *p, const size_t n) {
+    return static_cast<uint64_t>(static_cast<uint8_t>(p[0])) << 16 |
+           static_cast<uint64_t>(static_cast<uint8_t>(p[n >> 1])) << 8 | static_cast<uint8_t>(p[n - 1]);
+  }
+}  // namespace detail
+
+/**
+ * Hash of n bytes.
+ */
+constexpr uint64_t hash_bytes(const char *p, size_t n, uint64_t seed = 0) {
+  using namespace detail;
+
+  seed ^= hash_mix(seed ^ hash_secret[0], hash_secret[1]);
+  uint64_t a = 0, b = 0;
+
+  if (LIKELY(n <= 16)) {
+    if (LIKELY(n >= 4)) {
+      const size_t shift = (n >> 3) << 2;  // 4 if n >= 8: the two reads of each half do not overlap
+      a                  = hash_read4(p) << 32 | hash_read4(p + shift);
+      b                  = hash_read4(p + n - 4) << 32 | hash_read4(p + n - 4 - shift);
+    } else if (n > 0) {
+      a = hash_read3(p, n);
+    }
+  } else {
+    size_t i = n;
+    if (UNLIKELY(i >= 48)) {
+      uint64_t seed1 = seed, seed2 = seed;
+      do {
+        seed  = hash_mix(hash_read8(p) ^ hash_secret[1], hash_read8(p + 8) ^ seed);
+        seed1 = hash_mix(hash_read8(p + 16) ^ hash_secret[2], hash_read8(p + 24) ^ seed1);
+        seed2 = hash_mix(hash_read8(p + 32) ^ hash_secret[3], hash_read8(p + 40) ^ seed2);
+        p += 48;
+        i -= 48;
+      } while (LIKELY(i >= 48));
+      seed ^= seed1 ^ seed2;
+    }
+    while (UNLIKELY(i > 16)) {
+      seed = hash_mix(hash_read8(p) ^ hash_secret[1], hash_read8(p + 8) ^ seed);
+      i -= 16;
+      p += 16;
+    }
+    a = hash_read8(p + i - 16);
+    b = hash_read8(p + i - 8);
+  }
+
+  a ^= hash_secret[1];
+  b ^= seed;
+  hash_mum(a, b);
+  return hash_mix(a ^ hash_secret[0] ^ n, b ^ hash_secret[1]);
+}
+
+inline uint64_t hash_bytes(const void *p, const size_t n, const uint64_t seed = 0) {
+  return hash_bytes(static_cast<const char *>(p), n, seed);
+}
+
+/**
+ * Hash of a 64-bit integer, every output bit depending on every input bit.
+ */
+FORCE_INLINE constexpr uint64_t hash_int(uint64_t x, uint64_t seed = 0) {
+  x ^= detail::hash_secret[0];
+  seed ^= detail::hash_secret[1];
+  detail::hash_mum(x, seed);
+  return detail::hash_mix(x ^ detail::hash_secret[0], seed ^ detail::hash_secret[1]);
+}
+
+/**
+ * Hash of a sequence: folds h into seed, in an order-dependent way.
+ */
+FORCE_INLINE constexpr uint64_t hash_combine(const uint64_t seed, const uint64_t h) {
+  return detail::hash_mix(seed ^ detail::hash_secret[2], h ^ detail::hash_secret[3]);
+}
+
+/**
+ * Hash function object, the default of hashed containers. Defined for integers, enums, pointers,
+ * floating-point numbers and string views here; headers of other types specialize it (strings in
+ * container/string.hpp, vectors in math/numeric_vector.hpp). Equal keys hash equally, e.g. 0.0
+ * and -0.0, or a string_t and a string_view of the same characters.
+ */
+template<typename T, typename = void>
+struct hash;
+
+template<typename T>
+struct hash<T, enable_if_t<is_integral_v<T> || is_enum_v<T>>> {
+  FORCE_INLINE constexpr uint64_t operator()(const T value) const noexcept {
+    return hash_int(static_cast<uint64_t>(value));
+  }
+};
+
+template<typename T>
+struct hash<T *> {
+  FORCE_INLINE uint64_t operator()(const T *ptr) const noexcept {
+    return hash_int(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr)));
+  }
+};
+
+template<typename T>
+struct hash<T, enable_if_t<is_floating_point_v<T>>> {
+  // x87 long double holds 10 bytes of value (the mantissa first) in 12 or 16, the rest padding
+  static constexpr size_t value_bytes = is_same_v<T, long double> && LDBL_MANT_DIG == 64 ? 10 : sizeof(T);
+
+  FORCE_INLINE uint64_t operator()(const T value) const noexcept {
+    if (value == T(0)) return hash_int(0);  // -0.0 == 0.0
+
+    if constexpr (value_bytes > sizeof(uint64_t)) {
+      return hash_bytes(&value, value_bytes);
+    } else {
+      uint64_t bits = 0;
+      memcpy(&bits, &value, sizeof(T));
+      return hash_int(bits);
+    }
+  }
+};
+
+template<>
+struct hash<string_view> {
+  FORCE_INLINE constexpr uint64_t operator()(const string_view str) const noexcept {
+    return hash_bytes(str.data(), str.size());
+  }
+};
+
+LIB_XCORE_END_NAMESPACE
+
+#endif  //LIB_XCORE_CORE_HASH_HPP
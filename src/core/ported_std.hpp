@@ -118,6 +118,22 @@ constexpr OutputIt move(InputIt first, InputIt last, OutputIt d_first) {
   return d_first;
 }
 
+/**
+  * Mimic std::less
+  */
+template<typename T>
+struct less {
+  FORCE_INLINE constexpr bool operator()(const T &a, const T &b) const { return a < b; }
+};
+
+/**
+  * Mimic std::greater
+  */
+template<typename T>
+struct greater {
+  FORCE_INLINE constexpr bool operator()(const T &a, const T &b) const { return b < a; }
+};
+
 template<size_t...>
 struct index_sequence {};
 
@@ -0,0 +1,107 @@
+#ifndef LIB_XCORE_CORE_PORTED_STRING_VIEW_HPP
+#define LIB_XCORE_CORE_PORTED_STRING_VIEW_HPP
+
+#include "internal/macros.hpp"
+#include "core/ported_config.hpp"
+#include <cstring>
+
+LIB_XCORE_BEGIN_NAMESPACE
+
+/**
+ * Mimic std::basic_string_view (non-owning view over a character range)
+ */
+template<typename CharT>
+class basic_string_view {
+  const CharT *data_ = nullptr;
+  size_t       size_ = 0;
+
+  static constexpr size_t _length(const CharT *s) {
+    size_t n = 0;
+    while (s[n] != CharT()) ++n;
+    return n;
+  }
+
+public:
+  static constexpr size_t npos = static_cast<size_t>(-1);
+
+  constexpr basic_string_view() noexcept = default;
+
+  constexpr basic_string_view(const CharT *s, const size_t n) noexcept : data_(s), size_(n) {}
+
+  constexpr basic_string_view(const CharT *s) noexcept  // Implicit
+      : data_(s), size_(s ? _length(s) : 0) {}
+
+  [[nodiscard]] constexpr const CharT *data() const noexcept { return data_; }
+  [[nodiscard]] constexpr size_t       size() const noexcept { return size_; }
+  [[nodiscard]] constexpr size_t       length() const noexcept { return size_; }
+  [[nodiscard]] constexpr bool         empty() const noexcept { return size_ == 0; }
+
+  [[nodiscard]] constexpr const CharT *begin() const noexcept { return data_; }
+  [[nodiscard]] constexpr const CharT *end() const noexcept { return data_ + size_; }
+
+  [[nodiscard]] constexpr const CharT &operator[](const size_t i) const { return data_[i]; }
+  [[nodiscard]] constexpr const CharT &front() const { return data_[0]; }
+  [[nodiscard]] constexpr const CharT &back() const { return data_[size_ - 1]; }
+
+  constexpr void remove_prefix(const size_t n) {
+    data_ += n;
+    size_ -= n;
+  }
+
+  constexpr void remove_suffix(const size_t n) { size_ -= n; }
+
+  /** Clamps pos and count to the view, unlike std which throws. */
+  [[nodiscard]] constexpr basic_string_view substr(size_t pos, const size_t count = npos) const {
+    if (pos > size_) pos = size_;
+    const size_t rest = size_ - pos;
+    return {data_ + pos, count < rest ? count : rest};
+  }
+
+  [[nodiscard]] constexpr int compare(const basic_string_view other) const {
+    const size_t n = size_ < other.size_ ? size_ : other.size_;
+    for (size_t i = 0; i < n; ++i) {
+      if (data_[i] != other.data_[i]) return data_[i] < other.data_[i] ? -1 : 1;
+    }
+    return size_ == other.size_ ? 0 : (size_ < other.size_ ? -1 : 1);
+  }
+
+  [[nodiscard]] constexpr bool starts_with(const basic_string_view prefix) const {
+    return size_ >= prefix.size_ && substr(0, prefix.size_) == prefix;
+  }
+
+  [[nodiscard]] constexpr bool ends_with(const basic_string_view suffix) const {
+    return size_ >= suffix.size_ && substr(size_ - suffix.size_) == suffix;
+  }
+
+  [[nodiscard]] constexpr size_t find(const CharT c, const size_t pos = 0) const {
+    for (size_t i = pos; i < size_; ++i)
+      if (data_[i] == c) return i;
+    return npos;
+  }
+
+  [[nodiscard]] constexpr size_t rfind(const CharT c, const size_t pos = npos) const {
+    if (size_ == 0) return npos;
+    for (size_t i = pos < size_ ? pos + 1 : size_; i-- > 0;)
+      if (data_[i] == c) return i;
+    return npos;
+  }
+
+  friend constexpr bool operator==(const basic_string_view a, const basic_string_view b) {
+    if (a.size_ != b.size_) return false;
+    for (size_t i = 0; i < a.size_; ++i)
+      if (a.data_[i] != b.data_[i]) return false;
+    return true;
+  }
+
+  friend constexpr bool operator!=(const basic_string_view a, const basic_string_view b) { return !(a == b); }
+  friend constexpr bool operator<(const basic_string_view a, const basic_string_view b) { return a.compare(b) < 0; }
+  friend constexpr bool operator>(const basic_string_view a, const basic_string_view b) { return a.compare(b) > 0; }
+  friend constexpr bool operator<=(const basic_string_view a, const basic_string_view b) { return a.compare(b) <= 0; }
+  friend constexpr bool operator>=(const basic_string_view a, const basic_string_view b) { return a.compare(b) >= 0; }
+};
+
+using string_view = basic_string_view<char>;
+
+LIB_XCORE_END_NAMESPACE
+
+#endif  //LIB_XCORE_CORE_PORTED_STRING_VIEW_HPP
@@ -102,7 +102,7 @@ constexpr auto get(const tuple<T, Ts...> &t) -> enable_if_t<I != 0, const typena
 
 template<size_t I, typename T, typename... Ts>
 constexpr auto get(tuple<T, Ts...> &&t) -> enable_if_t<I == 0, T &&> {
-  return move(t.value);
+  return static_cast<T &&>(t.value);  // Not move(): a reference element stays an lvalue
 }
 
 template<size_t I, typename T, typename... Ts>
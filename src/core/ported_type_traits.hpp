@@ -418,12 +418,32 @@ namespace detail {
 template<typename T>
 struct is_null_pointer : detail::is_null_pointer_impl<remove_cv_t<T>>::type {};
 
+namespace detail {
+  template<typename>
+  struct is_pointer_impl : false_type {};
+
+  template<typename T>
+  struct is_pointer_impl<T *> : true_type {};
+}  // namespace detail
+
+template<typename T>
+struct is_pointer : detail::is_pointer_impl<remove_cv_t<T>>::type {};
+
+template<typename T>
+struct is_enum : bool_constant<__is_enum(T)> {};
+
 template<typename T>
 inline constexpr bool is_void_v = is_void<T>::value;
 
 template<typename T>
 inline constexpr bool is_null_pointer_v = is_null_pointer<T>::value;
 
+template<typename T>
+inline constexpr bool is_pointer_v = is_pointer<T>::value;
+
+template<typename T>
+inline constexpr bool is_enum_v = is_enum<T>::value;
+
 template<typename T>
 inline constexpr bool is_integral_v = is_integral<T>::value;
 
@@ -519,6 +539,24 @@ struct is_default_constructible<T, void_t<decltype(T())>> : true_type {};
 template<typename T>
 inline constexpr bool is_default_constructible_v = is_default_constructible<T>::value;
 
+template<typename T>
+struct is_trivially_copyable : bool_constant<__is_trivially_copyable(T)> {};
+
+// __has_trivial_destructor is deprecated where __is_trivially_destructible exists (clang, GCC 14)
+#if __has_builtin(__is_trivially_destructible)
+template<typename T>
+struct is_trivially_destructible : bool_constant<__is_trivially_destructible(T)> {};
+#else
+template<typename T>
+struct is_trivially_destructible : bool_constant<__has_trivial_destructor(T)> {};
+#endif
+
+template<typename T>
+inline constexpr bool is_trivially_copyable_v = is_trivially_copyable<T>::value;
+
+template<typename T>
+inline constexpr bool is_trivially_destructible_v = is_trivially_destructible<T>::value;
+
 // IS_FUNCTION
 
 template<typename>
@@ -0,0 +1,65 @@
+#ifndef LIB_XCORE_CORE_SWAR_HPP
+#define LIB_XCORE_CORE_SWAR_HPP
+
+#include "internal/macros.hpp"
+#include <cstdint>
+#include <cstring>
+
+/*
+ * Byte-parallel helpers on 64-bit words ("SIMD within a register"). The masks
+ * are exact: the high bit of a byte is set if and only if the byte matches.
+ * Byte i of a word is at bits 8i..8i+7 on little-endian targets only, which is
+ * what XCORE_SWAR_ENABLED tells.
+ */
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#  define XCORE_SWAR_ENABLED 1
+#else
+#  define XCORE_SWAR_ENABLED 0
+#endif
+
+LIB_XCORE_BEGIN_NAMESPACE
+
+namespace detail {
+  constexpr uint64_t swar_ones  = 0x0101010101010101ull;
+  constexpr uint64_t swar_highs = 0x8080808080808080ull;
+  constexpr uint64_t swar_lows  = 0x7F7F7F7F7F7F7F7Full;
+
+  FORCE_INLINE uint64_t swar_load(const void *p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+  }
+
+  /**
+   * Sets the high bit of every byte of v equal to c.
+   */
+  FORCE_INLINE constexpr uint64_t swar_byte_mask(const uint64_t v, const char c) {
+    const uint64_t x = v ^ (swar_ones * static_cast<unsigned char>(c));
+    return ~(((x & swar_lows) + swar_lows) | x | swar_lows);
+  }
+
+  /**
+   * Sets the high bit of every byte of v lower than n (n <= 0x80).
+   */
+  FORCE_INLINE constexpr uint64_t swar_less_mask(const uint64_t v, const unsigned char n) {
+    return ~(((v & swar_lows) + swar_ones * (0x80u - n)) | v) & swar_highs;
+  }
+
+  /**
+   * Packs the high bit of each byte into an 8-bit mask (bit i = byte i).
+   */
+  FORCE_INLINE constexpr uint8_t swar_movemask(const uint64_t byte_mask) {
+    return static_cast<uint8_t>(((byte_mask >> 7) * 0x0102040810204080ull) >> 56);
+  }
+
+  /**
+   * Index of the first flagged byte of a non-zero mask.
+   */
+  FORCE_INLINE constexpr size_t swar_first(const uint64_t byte_mask) {
+    return static_cast<size_t>(__builtin_ctzll(byte_mask)) / 8;
+  }
+}  // namespace detail
+
+LIB_XCORE_END_NAMESPACE
+
+#endif  //LIB_XCORE_CORE_SWAR_HPP
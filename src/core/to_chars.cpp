@@ -0,0 +1,352 @@
+#include "to_chars.hpp"
+
+LIB_XCORE_BEGIN_NAMESPACE
+
+namespace {
+  /**
+   * Normalized 64-bit powers of ten, rounded to nearest, for 1e-348 to 1e340
+   * in steps of 8 (significand, binary exponent).
+   */
+  struct cached_power_t {
+    uint64_t f;
+    int      e;
+  };
+
+  const cached_power_t cached_powers[] = {
+    {0xFA8FD5A0081C0288ull, -1220},  // 1e-348
+    {0xBAAEE17FA23EBF76ull, -1193},  // 1e-340
+    {0x8B16FB203055AC76ull, -1166},  // 1e-332
+    {0xCF42894A5DCE35EAull, -1140},  // 1e-324
+    {0x9A6BB0AA55653B2Dull, -1113},  // 1e-316
+    {0xE61ACF033D1A45DFull, -1087},  // 1e-308
+    {0xAB70FE17C79AC6CAull, -1060},  // 1e-300
+    {0xFF77B1FCBEBCDC4Full, -1034},  // 1e-292
+    {0xBE5691EF416BD60Cull, -1007},  // 1e-284
+    {0x8DD01FAD907FFC3Cull, -980},  // 1e-276
+    {0xD3515C2831559A83ull, -954},  // 1e-268
+    {0x9D71AC8FADA6C9B5ull, -927},  // 1e-260
+    {0xEA9C227723EE8BCBull, -901},  // 1e-252
+    {0xAECC49914078536Dull, -874},  // 1e-244
+    {0x823C12795DB6CE57ull, -847},  // 1e-236
+    {0xC21094364DFB5637ull, -821},  // 1e-228
+    {0x9096EA6F3848984Full, -794},  // 1e-220
+    {0xD77485CB25823AC7ull, -768},  // 1e-212
+    {0xA086CFCD97BF97F4ull, -741},  // 1e-204
+    {0xEF340A98172AACE5ull, -715},  // 1e-196
+    {0xB23867FB2A35B28Eull, -688},  // 1e-188
+    {0x84C8D4DFD2C63F3Bull, -661},  // 1e-180
+    {0xC5DD44271AD3CDBAull, -635},  // 1e-172
+    {0x936B9FCEBB25C996ull, -608},  // 1e-164
+    {0xDBAC6C247D62A584ull, -582},  // 1e-156
+    {0xA3AB66580D5FDAF6ull, -555},  // 1e-148
+    {0xF3E2F893DEC3F126ull, -529},  // 1e-140
+    {0xB5B5ADA8AAFF80B8ull, -502},  // 1e-132
+    {0x87625F056C7C4A8Bull, -475},  // 1e-124
+    {0xC9BCFF6034C13053ull, -449},  // 1e-116
+    {0x964E858C91BA2655ull, -422},  // 1e-108
+    {0xDFF9772470297EBDull, -396},  // 1e-100
+    {0xA6DFBD9FB8E5B88Full, -369},  // 1e-92
+    {0xF8A95FCF88747D94ull, -343},  // 1e-84
+    {0xB94470938FA89BCFull, -316},  // 1e-76
+    {0x8A08F0F8BF0F156Bull, -289},  // 1e-68
+    {0xCDB02555653131B6ull, -263},  // 1e-60
+    {0x993FE2C6D07B7FACull, -236},  // 1e-52
+    {0xE45C10C42A2B3B06ull, -210},  // 1e-44
+    {0xAA242499697392D3ull, -183},  // 1e-36
+    {0xFD87B5F28300CA0Eull, -157},  // 1e-28
+    {0xBCE5086492111AEBull, -130},  // 1e-20
+    {0x8CBCCC096F5088CCull, -103},  // 1e-12
+    {0xD1B71758E219652Cull, -77},  // 1e-4
+    {0x9C40000000000000ull, -50},  // 1e4
+    {0xE8D4A51000000000ull, -24},  // 1e12
+    {0xAD78EBC5AC620000ull, 3},  // 1e20
+    {0x813F3978F8940984ull, 30},  // 1e28
+    {0xC097CE7BC90715B3ull, 56},  // 1e36
+    {0x8F7E32CE7BEA5C70ull, 83},  // 1e44
+    {0xD5D238A4ABE98068ull, 109},  // 1e52
+    {0x9F4F2726179A2245ull, 136},  // 1e60
+    {0xED63A231D4C4FB27ull, 162},  // 1e68
+    {0xB0DE65388CC8ADA8ull, 189},  // 1e76
+    {0x83C7088E1AAB65DBull, 216},  // 1e84
+    {0xC45D1DF942711D9Aull, 242},  // 1e92
+    {0x924D692CA61BE758ull, 269},  // 1e100
+    {0xDA01EE641A708DEAull, 295},  // 1e108
+    {0xA26DA3999AEF774Aull, 322},  // 1e116
+    {0xF209787BB47D6B85ull, 348},  // 1e124
+    {0xB454E4A179DD1877ull, 375},  // 1e132
+    {0x865B86925B9BC5C2ull, 402},  // 1e140
+    {0xC83553C5C8965D3Dull, 428},  // 1e148
+    {0x952AB45CFA97A0B3ull, 455},  // 1e156
+    {0xDE469FBD99A05FE3ull, 481},  // 1e164
+    {0xA59BC234DB398C25ull, 508},  // 1e172
+    {0xF6C69A72A3989F5Cull, 534},  // 1e180
+    {0xB7DCBF5354E9BECEull, 561},  // 1e188
+    {0x88FCF317F22241E2ull, 588},  // 1e196
+    {0xCC20CE9BD35C78A5ull, 614},  // 1e204
+    {0x98165AF37B2153DFull, 641},  // 1e212
+    {0xE2A0B5DC971F303Aull, 667},  // 1e220
+    {0xA8D9D1535CE3B396ull, 694},  // 1e228
+    {0xFB9B7CD9A4A7443Cull, 720},  // 1e236
+    {0xBB764C4CA7A44410ull, 747},  // 1e244
+    {0x8BAB8EEFB6409C1Aull, 774},  // 1e252
+    {0xD01FEF10A657842Cull, 800},  // 1e260
+    {0x9B10A4E5E9913129ull, 827},  // 1e268
+    {0xE7109BFBA19C0C9Dull, 853},  // 1e276
+    {0xAC2820D9623BF429ull, 880},  // 1e284
+    {0x80444B5E7AA7CF85ull, 907},  // 1e292
+    {0xBF21E44003ACDD2Dull, 933},  // 1e300
+    {0x8E679C2F5E44FF8Full, 960},  // 1e308
+    {0xD433179D9C8CB841ull, 986},  // 1e316
+    {0x9E19DB92B4E31BA9ull, 1013},  // 1e324
+    {0xEB96BF6EBADF77D9ull, 1039},  // 1e332
+    {0xAF87023B9BF0EE6Bull, 1066},  // 1e340
+  };
+
+  constexpr uint32_t pow10_u32[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+
+  /**
+   * Floating point value f * 2^e with a 64-bit significand.
+   */
+  struct diy_fp_t {
+    uint64_t f;
+    int      e;
+  };
+
+  FORCE_INLINE diy_fp_t normalize(const diy_fp_t x) {
+    const int s = __builtin_clzll(x.f);
+    return {x.f << s, x.e - s};
+  }
+
+  /**
+   * Product of the significands rounded to 64 bits.
+   */
+  FORCE_INLINE diy_fp_t multiply(const diy_fp_t x, const diy_fp_t y) {
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 r = static_cast<unsigned __int128>(x.f) * y.f;
+    const auto              h = static_cast<uint64_t>(r >> 64);
+    const auto              l = static_cast<uint64_t>(r);
+    return {h + (l >> 63), x.e + y.e + 64};
+#else
+    const uint64_t a = x.f >> 32, b = x.f & 0xFFFFFFFFu;
+    const uint64_t c = y.f >> 32, d = y.f & 0xFFFFFFFFu;
+    const uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+    const uint64_t mid = (bd >> 32) + (ad & 0xFFFFFFFFu) + (bc & 0xFFFFFFFFu) + (1u << 31);
+    return {ac + (ad >> 32) + (bc >> 32) + (mid >> 32), x.e + y.e + 64};
+#endif
+  }
+
+  /**
+   * Picks 10^-K such that multiplying a significand of binary exponent e
+   * lands in the exponent window [-60, -32] required by the digit generation.
+   */
+  FORCE_INLINE diy_fp_t cached_power(const int e, int &k) {
+    // ceil((-61 - e) * log10(2)) + 347, log10(2) ~ 78913 / 2^18
+    const int      x     = (-61 - e) * 78913;
+    const int      dk    = (x >> 18) + ((x & ((1 << 18) - 1)) != 0) + 347;
+    const unsigned index = static_cast<unsigned>((dk >> 3) + 1);
+
+    k = -(-348 + static_cast<int>(index << 3));
+    return {cached_powers[index].f, cached_powers[index].e};
+  }
+
+  FORCE_INLINE void grisu_round(char *buffer, const int len, const uint64_t delta, uint64_t rest,
+                                const uint64_t ten_kappa, const uint64_t wp_w) {
+    while (rest < wp_w && delta - rest >= ten_kappa &&
+           (rest + ten_kappa < wp_w || wp_w - rest > rest + ten_kappa - wp_w)) {
+      --buffer[len - 1];
+      rest += ten_kappa;
+    }
+  }
+
+  /**
+   * Generates the digits of w, the scaled value, within the bounds [mp - delta, mp].
+   */
+  void digit_gen(const diy_fp_t w, const diy_fp_t mp, uint64_t delta, char *buffer, int &len, int &k) {
+    const diy_fp_t one{1ull << -mp.e, mp.e};
+    const uint64_t wp_w = mp.f - w.f;
+
+    auto     p1    = static_cast<uint32_t>(mp.f >> -one.e);
+    uint64_t p2    = mp.f & (one.f - 1);
+    int      kappa = detail::count_decimal_digits(p1);
+
+    len = 0;
+    while (kappa > 0) {
+      // Constant divisors compile to multiplications
+      uint32_t d;
+      switch (kappa) {
+        case 10: d = p1 / 1000000000; p1 %= 1000000000; break;
+        case 9: d = p1 / 100000000; p1 %= 100000000; break;
+        case 8: d = p1 / 10000000; p1 %= 10000000; break;
+        case 7: d = p1 / 1000000; p1 %= 1000000; break;
+        case 6: d = p1 / 100000; p1 %= 100000; break;
+        case 5: d = p1 / 10000; p1 %= 10000; break;
+        case 4: d = p1 / 1000; p1 %= 1000; break;
+        case 3: d = p1 / 100; p1 %= 100; break;
+        case 2: d = p1 / 10; p1 %= 10; break;
+        default: d = p1; p1 = 0; break;
+      }
+      if (d || len) buffer[len++] = static_cast<char>('0' + d);
+      --kappa;
+
+      const uint64_t rest = (static_cast<uint64_t>(p1) << -one.e) + p2;
+      if (rest <= delta) {
+        k += kappa;
+        grisu_round(buffer, len, delta, rest, static_cast<uint64_t>(pow10_u32[kappa]) << -one.e, wp_w);
+        return;
+      }
+    }
+
+    for (;;) {
+      p2 *= 10;
+      delta *= 10;
+      const auto d = static_cast<char>(p2 >> -one.e);
+      if (d || len) buffer[len++] = static_cast<char>('0' + d);
+      p2 &= one.f - 1;
+      --kappa;
+
+      if (p2 < delta) {
+        k += kappa;
+        grisu_round(buffer, len, delta, p2, one.f, -kappa < 10 ? wp_w * pow10_u32[-kappa] : 0);
+        return;
+      }
+    }
+  }
+
+  /**
+   * Shortest digits of significand * 2^exponent (Grisu2, Loitsch 2010).
+   * On return, the value is buffer[0, len) * 10^k.
+   */
+  void grisu2(const uint64_t significand, const int exponent, const bool lower_boundary_closer,
+              char *buffer, int &len, int &k) {
+    const diy_fp_t v{significand, exponent};
+
+    // Boundaries halfway to the neighbouring values, with the exponent of the upper one
+    const diy_fp_t plus  = normalize({(v.f << 1) + 1, v.e - 1});
+    diy_fp_t       minus = lower_boundary_closer ? diy_fp_t{(v.f << 2) - 1, v.e - 2}
+                                                 : diy_fp_t{(v.f << 1) - 1, v.e - 1};
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
+
+    const diy_fp_t c_mk = cached_power(plus.e, k);
+    const diy_fp_t w    = multiply(normalize(v), c_mk);
+    diy_fp_t       wp   = multiply(plus, c_mk);
+    diy_fp_t       wm   = multiply(minus, c_mk);
+
+    // Stay strictly inside the rounding interval despite the truncated products
+    ++wm.f;
+    --wp.f;
+
+    digit_gen(w, wp, wp.f - wm.f, buffer, len, k);
+  }
+
+  /**
+   * Lays out the digits of buffer[0, len) * 10^k in ECMAScript notation.
+   *
+   * @return Number of characters written to out (at most 26)
+   */
+  int format_shortest(const char *digits, const int len, const int k, char *out) {
+    const int point = len + k;  // Position of the decimal point relative to the digits
+    char     *p     = out;
+
+    if (k >= 0 && point <= 21) {
+      // Integer: 1234e5 -> 123400000
+      memcpy(p, digits, len);
+      p += len;
+      memset(p, '0', k);
+      p += k;
+    } else if (point > 0 && point <= 21) {
+      // 1234e-2 -> 12.34
+      memcpy(p, digits, point);
+      p += point;
+      *p++ = '.';
+      memcpy(p, digits + point, len - point);
+      p += len - point;
+    } else if (point > -6 && point <= 0) {
+      // 1234e-6 -> 0.001234
+      *p++ = '0';
+      *p++ = '.';
+      memset(p, '0', -point);
+      p += -point;
+      memcpy(p, digits, len);
+      p += len;
+    } else {
+      // 1234e30 -> 1.234e+33
+      *p++ = digits[0];
+      if (len > 1) {
+        *p++ = '.';
+        memcpy(p, digits + 1, len - 1);
+        p += len - 1;
+      }
+      *p++ = 'e';
+
+      int exp = point - 1;
+      if (exp < 0) {
+        *p++ = '-';
+        exp  = -exp;
+      } else {
+        *p++ = '+';
+      }
+
+      const int n = detail::count_decimal_digits(static_cast<uint64_t>(exp));
+      detail::write_decimal_digits(p + n, static_cast<uint64_t>(exp));
+      p += n;
+    }
+
+    return static_cast<int>(p - out);
+  }
+
+  to_chars_result copy_out(char *first, char *last, const char *src, const size_t n) {
+    if (static_cast<size_t>(last - first) < n) return {last, errc::value_too_large};
+    memcpy(first, src, n);
+    return {first + n, errc::ok};
+  }
+
+  template<typename T, typename Bits, int MantissaBits, int ExponentBias>
+  to_chars_result to_chars_float(char *first, char *last, const T value) {
+    Bits bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    constexpr Bits mantissa_mask = (Bits(1) << MantissaBits) - 1;
+    constexpr int  exponent_mask = (1 << (sizeof(Bits) * 8 - 1 - MantissaBits)) - 1;
+
+    const bool negative = bits >> (sizeof(Bits) * 8 - 1);
+    const auto mantissa = static_cast<uint64_t>(bits & mantissa_mask);
+    const int  biased   = static_cast<int>(bits >> MantissaBits) & exponent_mask;
+
+    char  out[32];
+    char *p = out;
+    if (negative) *p++ = '-';
+
+    if (biased == exponent_mask) {
+      if (mantissa) return copy_out(first, last, "nan", 3);
+      memcpy(p, "inf", 3);
+      return copy_out(first, last, out, static_cast<size_t>(p - out) + 3);
+    }
+
+    if (biased == 0 && mantissa == 0) {
+      *p++ = '0';
+      return copy_out(first, last, out, static_cast<size_t>(p - out));
+    }
+
+    // value = significand * 2^exponent
+    const uint64_t significand = biased ? mantissa | (1ull << MantissaBits) : mantissa;
+    const int      exponent    = (biased ? biased : 1) - ExponentBias - MantissaBits;
+
+    char digits[20];
+    int  len = 0, k = 0;
+    grisu2(significand, exponent, mantissa == 0 && biased > 1, digits, len, k);
+
+    p += format_shortest(digits, len, k, p);
+    return copy_out(first, last, out, static_cast<size_t>(p - out));
+  }
+}  // namespace
+
+to_chars_result to_chars(char *first, char *last, const float value) {
+  return to_chars_float<float, uint32_t, 23, 127>(first, last, value);
+}
+
+to_chars_result to_chars(char *first, char *last, const double value) {
+  return to_chars_float<double, uint64_t, 52, 1023>(first, last, value);
+}
+
+LIB_XCORE_END_NAMESPACE
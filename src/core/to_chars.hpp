@@ -0,0 +1,123 @@
+#ifndef LIB_XCORE_CORE_TO_CHARS_HPP
+#define LIB_XCORE_CORE_TO_CHARS_HPP
+
+#include "internal/macros.hpp"
+#include "core/ported_std.hpp"
+#include "core/from_chars.hpp"
+#include <cstdint>
+#include <cstring>
+
+LIB_XCORE_BEGIN_NAMESPACE
+
+/**
+ * Mimic std::to_chars_result
+ */
+struct to_chars_result {
+  char *ptr;
+  errc  ec;
+
+  [[nodiscard]] constexpr explicit operator bool() const noexcept { return ec == errc::ok; }
+};
+
+namespace detail {
+  inline constexpr char digit_pairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+  FORCE_INLINE constexpr int count_decimal_digits(uint64_t v) {
+    int n = 1;
+    for (;;) {
+      if (v < 10) return n;
+      if (v < 100) return n + 1;
+      if (v < 1000) return n + 2;
+      if (v < 10000) return n + 3;
+      v /= 10000;
+      n += 4;
+    }
+  }
+
+  /**
+   * Writes the decimal digits of v backwards from end, two digits per step.
+   */
+  FORCE_INLINE void write_decimal_digits(char *end, uint64_t v) {
+    while (v >= 100) {
+      end -= 2;
+      memcpy(end, digit_pairs + (v % 100) * 2, 2);
+      v /= 100;
+    }
+    if (v >= 10) {
+      memcpy(end - 2, digit_pairs + v * 2, 2);
+    } else {
+      *--end = static_cast<char>('0' + v);
+    }
+  }
+}  // namespace detail
+
+/**
+ * Mimic std::to_chars for integral types.
+ *
+ * Base 10 writes two digits per division. Other bases use lowercase letters.
+ *
+ * @return Pointer past the last character written, or last and
+ *         errc::value_too_large if the range is too small
+ */
+template<typename T>
+enable_if_t<is_integral_v<T> && !is_same_v<remove_cv_t<T>, bool>, to_chars_result>
+to_chars(char *first, char *last, const T value, const int base = 10) {
+  if (base < 2 || base > 36)
+    return {last, errc::invalid_argument};
+
+  using U = make_unsigned_t<T>;
+  auto uv = static_cast<uint64_t>(static_cast<U>(value));
+
+  if constexpr (is_signed_v<T>) {
+    if (value < 0) {
+      if (first == last) return {last, errc::value_too_large};
+      *first++ = '-';
+      uv       = static_cast<U>(U(0) - static_cast<U>(value));
+    }
+  }
+
+  if (base == 10) {
+    const int n = LIB_XCORE_NAMESPACE::detail::count_decimal_digits(uv);
+    if (last - first < n) return {last, errc::value_too_large};
+    LIB_XCORE_NAMESPACE::detail::write_decimal_digits(first + n, uv);
+    return {first + n, errc::ok};
+  }
+
+  int n = 1;
+  for (uint64_t v = uv / base; v; v /= base) ++n;
+  if (last - first < n) return {last, errc::value_too_large};
+
+  for (char *p = first + n; p != first; uv /= base) {
+    const auto d = static_cast<char>(uv % base);
+    *--p         = static_cast<char>(d < 10 ? '0' + d : 'a' + d - 10);
+  }
+
+  return {first + n, errc::ok};
+}
+
+/**
+ * Mimic std::to_chars for floating points, in a short form that reads back to
+ * the same value with from_chars.
+ *
+ * Digits come from the Grisu2 algorithm (integer arithmetic only, no locale),
+ * which yields the shortest representation for more than 99.9% of the inputs.
+ * The notation follows ECMAScript: fixed for decimal exponents in [-6, 21),
+ * scientific ("1.5e+300") otherwise. Special values are "inf", "-inf" and "nan".
+ */
+to_chars_result to_chars(char *first, char *last, float value);
+
+to_chars_result to_chars(char *first, char *last, double value);
+
+LIB_XCORE_END_NAMESPACE
+
+#endif  //LIB_XCORE_CORE_TO_CHARS_HPP
@@ -216,6 +216,18 @@ namespace impl {
       return at(r_index, c_index);
     }
 
+    /**
+     * Returns a pointer to the entries, stored contiguously in row-major order.
+     *
+     * @return Pointer to the first entry
+     */
+    FORCE_INLINE T *data() {
+      static_assert(sizeof(vector_) == sizeof(T) * Row * Col, "Rows must be stored without padding.");
+      return reinterpret_cast<T *>(&vector_);
+    }
+
+    FORCE_INLINE const T *data() const { return reinterpret_cast<const T *>(&vector_); }
+
     numeric_matrix_static_t &operator=(const numeric_matrix_static_t &other) {
       if (this != &other) allocate_from(other);
       return *this;
@@ -647,7 +659,7 @@ namespace impl {
           else {
             T sum_ = 0;
             for (size_t j = 0; j < i; ++j) sum_ += lower[k][j] * upper[j][i];
-            lower[k][i] = abs(upper[i][i]) > XCORE_FLOAT_THRESHOLD
+            lower[k][i] = ::std::abs(upper[i][i]) > XCORE_FLOAT_THRESHOLD
                             ? (vector_[k][i] - sum_) / upper[i][i]
                             : T{};
           }
@@ -1013,7 +1025,7 @@ namespace impl {
     void fix_zero() {
       for (size_t i = 0; i < Row; ++i)
         for (size_t j = 0; j < Col; ++j)
-          if (abs(vector_[i][j]) < XCORE_FLOAT_THRESHOLD)
+          if (::std::abs(vector_[i][j]) < XCORE_FLOAT_THRESHOLD)
             vector_[i][j] = T{};
     }
 
@@ -1348,6 +1360,9 @@ namespace impl {
 template<typename T, size_t Row, size_t Col = Row>
 using generic_matrix = LIB_XCORE_NAMESPACE::impl::numeric_matrix_static_t<T, Row, Col>;
 
+template<typename T, size_t Row, size_t Col = Row, size_t Alignment = cache_line_size>
+using aligned_generic_matrix = aligned_t<generic_matrix<T, Row, Col>, Alignment>;
+
 template<typename T, size_t Row, size_t Col = Row>
 constexpr generic_matrix<T, Row, Col> make_generic_matrix() {
   return generic_matrix<T, Row, Col>();
@@ -1377,6 +1392,18 @@ constexpr generic_matrix<T, Row, Col> make_generic_matrix(const generic_matrix<T
 template<size_t Row, size_t Col = Row>
 using numeric_matrix = LIB_XCORE_NAMESPACE::impl::numeric_matrix_static_t<real_t, Row, Col>;
 
+/**
+ * Numeric matrix whose storage (rows stored contiguously) starts on an Alignment boundary, so SIMD
+ * kernels can use aligned loads. It converts to numeric_matrix everywhere; operations return plain
+ * numeric_matrix values.
+ *
+ * @tparam Row       Row dimension
+ * @tparam Col       Column dimension
+ * @tparam Alignment Storage alignment (power of 2)
+ */
+template<size_t Row, size_t Col = Row, size_t Alignment = cache_line_size>
+using aligned_numeric_matrix = aligned_t<numeric_matrix<Row, Col>, Alignment>;
+
 template<size_t OSize>
 using numeric_matrix_lu = LIB_XCORE_NAMESPACE::impl::numeric_matrix_static_lu_t<real_t, OSize>;
 
@@ -1,8 +1,11 @@
 #ifndef LIB_XCORE_LINALG_NUMERIC_VECTOR_HPP
 #define LIB_XCORE_LINALG_NUMERIC_VECTOR_HPP
 
+#include "core/hash.hpp"
 #include "core/ported_std.hpp"
 #include "core/basic_iterator.hpp"
+#include "memory/generic.hpp"
+#include <cmath>
 
 LIB_XCORE_BEGIN_NAMESPACE
 
@@ -148,6 +151,15 @@ namespace impl {
 
     FORCE_INLINE constexpr const T &operator()(const size_t index) const { return at(index); }
 
+    /**
+     * Returns a pointer to the contiguous entries.
+     *
+     * @return Pointer to the first entry
+     */
+    FORCE_INLINE T *data() { return arr_; }
+
+    FORCE_INLINE constexpr const T *data() const { return arr_; }
+
     numeric_vector_static_t &operator=(const numeric_vector_static_t &other) {
       if (this != &other) allocate_from(other);
       return *this;
@@ -429,7 +441,7 @@ namespace impl {
       else {
         if (this == &other) return true;
         for (size_t i = 0; i < Size; ++i)
-          if (abs(arr_[i] - other.arr_[i]) > threshold) return false;
+          if (::std::abs(arr_[i] - other.arr_[i]) > threshold) return false;
         return true;
       }
     }
@@ -447,7 +459,7 @@ namespace impl {
     bool float_equals(const T (&array)[OSize], real_t threshold = XCORE_FLOAT_THRESHOLD) const {
       if (Size != OSize) return false;
       for (size_t i = 0; i < Size; ++i)
-        if (abs(arr_[i] - array[i]) > threshold) return false;
+        if (::std::abs(arr_[i] - array[i]) > threshold) return false;
       return true;
     }
 
@@ -711,9 +723,24 @@ namespace detail {
   };
 }  // namespace detail
 
+/**
+ * Hash of the elements of a vector, in order.
+ */
+template<typename T, size_t Size>
+struct hash<LIB_XCORE_NAMESPACE::impl::numeric_vector_static_t<T, Size>> {
+  FORCE_INLINE constexpr uint64_t operator()(const LIB_XCORE_NAMESPACE::impl::numeric_vector_static_t<T, Size> &v) const noexcept {
+    uint64_t h = Size;
+    for (size_t i = 0; i < Size; ++i) h = hash_combine(h, hash<T>{}(v[i]));
+    return h;
+  }
+};
+
 template<typename T, size_t N>
 using generic_vector = LIB_XCORE_NAMESPACE::impl::numeric_vector_static_t<T, N>;
 
+template<typename T, size_t N, size_t Alignment = cache_line_size>
+using aligned_generic_vector = aligned_t<generic_vector<T, N>, Alignment>;
+
 template<typename T, size_t Size>
 constexpr generic_vector<T, Size> make_generic_vector() {
   return generic_vector<T, Size>();
@@ -755,6 +782,16 @@ make_generic_vector(const generic_vector<T, S1> &v1, const generic_vector<T, S2>
 template<size_t Size>
 using numeric_vector = LIB_XCORE_NAMESPACE::impl::numeric_vector_static_t<real_t, Size>;
 
+/**
+ * Numeric vector whose storage starts on an Alignment boundary, so SIMD kernels can use aligned
+ * loads. It converts to numeric_vector everywhere; operations return plain numeric_vector values.
+ *
+ * @tparam Size      Vector dimension
+ * @tparam Alignment Storage alignment (power of 2)
+ */
+template<size_t Size, size_t Alignment = cache_line_size>
+using aligned_numeric_vector = aligned_t<numeric_vector<Size>, Alignment>;
+
 /**
  *
  * @tparam Size Vector dimension
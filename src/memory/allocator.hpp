@@ -4,9 +4,13 @@
 #include "internal/macros.hpp"
 
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <new>
+#if defined(_WIN32)
+#  include <malloc.h>
+#endif
 #include "memory/generic.hpp"
 
 LIB_XCORE_BEGIN_NAMESPACE
@@ -96,28 +100,131 @@ namespace memory {
   template<typename Tp>
   class malloc_clear_allocator_t : public malloc_allocator_t<Tp> {
   public:
+    // The CRTP base is bound to malloc_allocator_t: its allocate() would skip the clearing
+    FORCE_INLINE static constexpr Tp *allocate(const size_t n = 1) noexcept {
+      return impl_allocate(n);
+    }
+
     FORCE_INLINE static constexpr Tp *impl_allocate(const size_t n) noexcept {
       void *p_mem = malloc(n * sizeof(Tp));
-      memset(p_mem, 0, n * sizeof(Tp));
+      if (p_mem) memset(p_mem, 0, n * sizeof(Tp));
       return static_cast<Tp *>(p_mem);
     }
   };
 
-  template<typename Tp>
-  class aligned_allocator_t : public allocator_t<aligned_allocator_t, Tp> {
+  template<typename Tp, size_t Alignment>
+  class basic_aligned_allocator_t;
+
+  /**
+   * Binds the alignment of basic_aligned_allocator_t, for parameters expecting
+   * template<typename> class, e.g. heap_array_t<float, 8, aligned_allocator_form_t<32>::type>.
+   */
+  template<size_t Alignment>
+  struct aligned_allocator_form_t {
+    template<typename Tp>
+    using type = basic_aligned_allocator_t<Tp, Alignment>;
+  };
+
+  /**
+   * Allocator returning memory aligned to max(Alignment, alignof(Tp)). Memory is not initialized,
+   * unlike default_allocator_t which zero-fills: a container switched to it must not rely on
+   * zeroed storage.
+   *
+   * Reallocation tries realloc() first, which may grow the block in place, and moves the content
+   * to a fresh aligned block only when the result lost the alignment.
+   *
+   * @tparam Alignment  Power of 2
+   */
+  template<typename Tp, size_t Alignment>
+  class basic_aligned_allocator_t : public allocator_t<aligned_allocator_form_t<Alignment>::template type, Tp> {
   protected:
-    friend class allocator_t<aligned_allocator_t, Tp>;
+    friend class allocator_t<aligned_allocator_form_t<Alignment>::template type, Tp>;
+
+    static_assert(Alignment > 0 && (Alignment & (Alignment - 1)) == 0, "Alignment must be a power of 2.");
+
+    static constexpr size_t alignment = Alignment > alignof(Tp) ? Alignment : alignof(Tp);
+
+    /**
+     * Rounds n elements up to a whole number of alignments (at least one), as aligned_alloc() requires.
+     *
+     * @return Number of bytes, 0 on overflow
+     */
+    FORCE_INLINE static constexpr size_t bytes_for(const size_t n) noexcept {
+      if (n > (static_cast<size_t>(-1) - alignment) / sizeof(Tp)) return 0;
+      const size_t bytes = n * sizeof(Tp);
+      return bytes ? (bytes + alignment - 1) & ~(alignment - 1) : alignment;
+    }
+
+    FORCE_INLINE static void *aligned_malloc(const size_t bytes) noexcept {
+#if defined(_WIN32)
+      return _aligned_malloc(bytes, alignment);
+#elif defined(__unix__) || defined(__APPLE__)
+      void *p_mem = nullptr;
+      return posix_memalign(&p_mem, alignment < sizeof(void *) ? sizeof(void *) : alignment, bytes) == 0 ? p_mem : nullptr;
+#else
+      return aligned_alloc(alignment, bytes);
+#endif
+    }
 
   public:
-    FORCE_INLINE static constexpr Tp *impl_allocate(const size_t n = 1) noexcept {
-      // todo: Implement aligned allocation
-      return nullptr;
+    FORCE_INLINE static Tp *impl_allocate(const size_t n = 1) noexcept {
+      const size_t bytes = bytes_for(n);
+      return bytes ? static_cast<Tp *>(aligned_malloc(bytes)) : nullptr;
     }
 
-    FORCE_INLINE static constexpr void impl_deallocate(Tp *object) noexcept {
+    FORCE_INLINE static constexpr Tp *impl_allocate_inplace(Tp &dst, const size_t) noexcept {
+      return &dst;
+    }
+
+    FORCE_INLINE static constexpr Tp *impl_allocate_inplace(Tp *dst, const size_t) noexcept {
+      return dst;
+    }
+
+    /**
+     * Resizes a block to n elements, keeping the alignment and the first min(old, n) elements.
+     * A size of 0 frees the block and returns nullptr. On failure, returns nullptr; the block is
+     * kept if realloc() failed, and freed if only the aligned copy failed.
+     */
+    static Tp *impl_reallocate(Tp *object, const size_t n) noexcept {
+      if (!object) return impl_allocate(n);
+
+      if (n == 0) {
+        impl_deallocate(object);
+        return nullptr;
+      }
+
+      const size_t bytes = bytes_for(n);
+      if (!bytes) return nullptr;
+
+#if defined(_WIN32)
+      return static_cast<Tp *>(_aligned_realloc(object, bytes, alignment));
+#else
+      void *p_mem = realloc(object, bytes);
+      if (!p_mem) return nullptr;
+
+      if ((reinterpret_cast<uintptr_t>(p_mem) & (alignment - 1)) == 0)
+        return static_cast<Tp *>(p_mem);
+
+      // The allocator moved the block to a less aligned address
+      void *p_aligned = aligned_malloc(bytes);
+      if (p_aligned) memcpy(p_aligned, p_mem, bytes);
+      free(p_mem);
+      return static_cast<Tp *>(p_aligned);
+#endif
+    }
+
+    FORCE_INLINE static void impl_deallocate(Tp *object) noexcept {
+#if defined(_WIN32)
+      _aligned_free(object);
+#else
+      free(object);
+#endif
     }
   };
 
+  template<typename Tp>
+  using aligned_allocator_t = basic_aligned_allocator_t<Tp, cache_line_size>;
+
   template<typename Tp>
   class unused_allocator_t : public allocator_t<unused_allocator_t, Tp> {
   protected:
@@ -134,6 +241,7 @@ namespace memory {
     }
   };
 
+  /** Zero-filled, malloc()-aligned; see aligned_allocator_t for over-aligned storage. */
   template<typename Tp>
   using default_allocator_t = malloc_clear_allocator_t<Tp>;
 
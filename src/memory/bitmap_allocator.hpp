@@ -30,7 +30,7 @@ namespace memory {
     using const_pointer = const Tp *;
 
   protected:
-    aligned_storage<sizeof(Tp), alignof(Tp)> arena_[Capacity]{};
+    typename aligned_storage<sizeof(Tp), alignof(Tp)>::type arena_[Capacity]{};
     bitset_t<Capacity>                       book_{};  // False = free, True = occupied
     size_t                                   size_{};
 
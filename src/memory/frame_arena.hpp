@@ -0,0 +1,115 @@
+#ifndef LIB_XCORE_MEMORY_FRAME_ARENA_HPP
+#define LIB_XCORE_MEMORY_FRAME_ARENA_HPP
+
+#include "internal/macros.hpp"
+#include "memory/allocator.hpp"
+#include "memory/virtual_memory.hpp"
+
+LIB_XCORE_BEGIN_NAMESPACE
+
+namespace memory {
+  /**
+   * Scratch memory for one iteration of a loop (a frame), made of two virtual_stack_region_t used
+   * in turns. flip() starts a new frame: the region of the frame before the previous one is
+   * cleared and becomes current, so that what was allocated during the previous frame stays
+   * readable for one more frame (e.g. to compare a result with the last one).
+   * \n
+   * Allocation is a pointer bump and nothing is ever freed individually. In chained mode (the
+   * default), a frame larger than NumBytes spills into extra blocks, which are kept once the
+   * largest frame has been seen: in steady state, frames do not call base_allocator_t.
+   * \n
+   * A task_dispatcher resets the arena at the start of each pass once attached:
+   *
+   *   static frame_arena_t<4096> arena;
+   *   static Dispatcher<8>       dispatcher;
+   *
+   *   void filter(frame_arena_t<4096> *frame) {
+   *     float *window = frame->allocate_ptr<float>(64);  // Valid until the end of the next pass
+   *     ...
+   *   }
+   *
+   *   dispatcher.attach_frame_arena(arena);
+   *   dispatcher << Task(filter, &arena, 10, millis);
+   *
+   * @tparam NumBytes             Bytes of each of the two regions
+   * @tparam Alignment            Alignment of every allocation (power of 2)
+   * @tparam base_allocator_t     Memory allocator of the regions and of the extra blocks
+   * @tparam Chained              Grow with extra blocks instead of returning nullptr when a frame is full
+   */
+  template<size_t NumBytes, size_t Alignment = sizeof(void *), template<typename> class base_allocator_t = malloc_allocator_t,
+           bool Chained = true>
+  class frame_arena_t {
+  public:
+    using region_t = virtual_stack_region_t<NumBytes, Alignment, base_allocator_t, Chained>;
+
+  protected:
+    region_t regions_[2];
+    size_t   current_ = 0;
+    size_t   frame_   = 0;
+
+  public:
+    frame_arena_t() noexcept = default;
+
+    frame_arena_t(const frame_arena_t &)            = delete;
+    frame_arena_t &operator=(const frame_arena_t &) = delete;
+
+    [[nodiscard]] bool valid() const noexcept {
+      return regions_[0].valid() && regions_[1].valid();
+    }
+
+    /**
+     * Starts a new frame, releasing everything allocated two frames ago.
+     */
+    void flip() noexcept {
+      current_ ^= 1;
+      regions_[current_].clear();
+      regions_[current_].reset_stats();
+      ++frame_;
+    }
+
+    template<typename T>
+    [[nodiscard]] FORCE_INLINE T *allocate_ptr(const size_t n = 1) noexcept {
+      return regions_[current_].template allocate_ptr<T>(n);
+    }
+
+    template<typename T>
+    [[nodiscard]] FORCE_INLINE T &allocate(const size_t n = 1) noexcept {
+      return *allocate_ptr<T>(n);
+    }
+
+    template<typename T>
+    [[nodiscard]] FORCE_INLINE T *construct_ptr(const size_t n = 1) noexcept {
+      return regions_[current_].template construct_ptr<T>(n);
+    }
+
+    template<typename T>
+    [[nodiscard]] FORCE_INLINE T &construct(const size_t n = 1) noexcept {
+      return *construct_ptr<T>(n);
+    }
+
+    /** Region of the current frame, e.g. for scope() within a task. */
+    [[nodiscard]] FORCE_INLINE region_t &current() noexcept {
+      return regions_[current_];
+    }
+
+    /** Region of the previous frame, still holding its allocations and statistics. */
+    [[nodiscard]] FORCE_INLINE region_t &previous() noexcept {
+      return regions_[current_ ^ 1];
+    }
+
+    [[nodiscard]] FORCE_INLINE const region_t &previous() const noexcept {
+      return regions_[current_ ^ 1];
+    }
+
+    /** Number of flip() calls so far. */
+    [[nodiscard]] constexpr size_t frame() const noexcept {
+      return frame_;
+    }
+  };
+}  // namespace memory
+
+using namespace memory;
+
+LIB_XCORE_END_NAMESPACE
+
+#endif  //LIB_XCORE_MEMORY_FRAME_ARENA_HPP
@@ -27,6 +27,30 @@ namespace memory {
   FORCE_INLINE constexpr size_t nearest_alignment(const size_t n = 1) {
     return nearest_alignment<Tp, sizeof(AlignT)>(n);
   }
+
+  /**
+   * Size of a cache line, and the default alignment for SIMD storage: enough for any load up to
+   * 512 bits, and no access split across two lines.
+   */
+  constexpr size_t cache_line_size = 64;
+
+  /**
+   * Over-aligned Base, e.g. aligned_t<numeric_vector<8>, 32>. It is a Base in every other way,
+   * so it passes anywhere a Base is expected; results of operations on it are plain Base values.
+   *
+   * @tparam Alignment  Power of 2, never less than alignof(Base)
+   */
+  template<typename Base, size_t Alignment = cache_line_size>
+  struct alignas(Base) alignas(Alignment) aligned_t : Base {
+    static_assert(Alignment > 0 && (Alignment & (Alignment - 1)) == 0, "Alignment must be a power of 2.");
+
+    using Base::Base;
+    using Base::operator=;
+
+    constexpr aligned_t() = default;
+
+    constexpr aligned_t(const Base &other) : Base(other) {}  // Implicit
+  };
 }  // namespace memory
 
 LIB_XCORE_END_NAMESPACE
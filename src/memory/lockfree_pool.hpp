@@ -0,0 +1,143 @@
+#ifndef LIB_XCORE_MEMORY_LOCKFREE_POOL_HPP
+#define LIB_XCORE_MEMORY_LOCKFREE_POOL_HPP
+
+#include "internal/macros.hpp"
+#include "core/ported_type_traits.hpp"
+#include "memory/allocator.hpp"
+#include "memory/generic.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+LIB_XCORE_BEGIN_NAMESPACE
+
+namespace memory {
+  /**
+   * Fixed-size object pool over a static arena, like bitmap_allocator, safe to share between
+   * threads and signal handlers without locks.
+   *
+   * Free slots form a Treiber stack linked by slot index. The head packs the index of the first
+   * free slot with a tag incremented on every change, so that a thread whose compare-and-swap was
+   * delayed cannot succeed on a head that was popped and pushed back in the meantime (ABA). Links
+   * are kept in an array beside the arena, never inside a slot, so a delayed reader never touches
+   * an object in use. Slots never used yet are taken from a counter first, so construction is free.
+   * \n
+   * acquire() and release() are lock-free: a call only retries when another one succeeded.
+   *
+   *   static lockfree_pool_t<packet_t, 256> packets;
+   *
+   *   packet_t *p = packets.construct(id, payload);  // From any thread or signal handler
+   *   packets.destroy(p);
+   *
+   * @tparam Tp        Element Type
+   * @tparam Capacity  Storage Capacity, less than 2^32 - 1
+   */
+  template<typename Tp, size_t Capacity>
+  class lockfree_pool_t {
+    static_assert(Capacity > 0 && Capacity < 0xFFFFFFFFu, "Capacity must fit in a 32-bit index.");
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "The tagged head needs lock-free 64-bit atomics.");
+
+    using pointer       = Tp *;
+    using const_pointer = const Tp *;
+
+  protected:
+    static constexpr uint32_t nil = 0xFFFFFFFFu;
+
+    alignas(cache_line_size) std::atomic<uint64_t>          head_;    // Tag (high half), first free index (low half)
+    alignas(cache_line_size) std::atomic<size_t>            carved_;  // Slots handed out at least once
+    std::atomic<uint32_t>                                   next_[Capacity];
+    typename aligned_storage<sizeof(Tp), alignof(Tp)>::type arena_[Capacity];
+
+  public:
+    constexpr lockfree_pool_t() noexcept : head_(nil), carved_(0), next_{}, arena_{} {}
+
+    lockfree_pool_t(const lockfree_pool_t &)            = delete;
+    lockfree_pool_t &operator=(const lockfree_pool_t &) = delete;
+
+    /**
+     * @return A pointer to a free slot (uninitialized storage), or nullptr if every slot is in use
+     */
+    pointer acquire() noexcept {
+      uint64_t head = head_.load(std::memory_order_acquire);
+
+      for (uint32_t index; (index = static_cast<uint32_t>(head)) != nil;) {
+        const uint64_t next = (head & ~uint64_t(0xFFFFFFFFu)) + (uint64_t(1) << 32) +
+                              next_[index].load(std::memory_order_relaxed);
+
+        if (head_.compare_exchange_weak(head, next, std::memory_order_acquire, std::memory_order_acquire))
+          return arena_base() + index;
+      }
+
+      // Freelist empty: take a slot never used yet
+      size_t carved = carved_.load(std::memory_order_relaxed);
+      while (carved < Capacity) {
+        if (carved_.compare_exchange_weak(carved, carved + 1, std::memory_order_relaxed, std::memory_order_relaxed))
+          return arena_base() + carved;
+      }
+
+      return nullptr;
+    }
+
+    /**
+     * Gives a slot from acquire() back to the pool. Pointers outside the arena are ignored.
+     */
+    void release(const_pointer ptr) noexcept {
+      const auto index = static_cast<size_t>(ptr - arena_base());
+      if (index >= Capacity) return;
+
+      uint64_t head = head_.load(std::memory_order_relaxed);
+      uint64_t next;
+
+      do {
+        next_[index].store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+        next = (head & ~uint64_t(0xFFFFFFFFu)) + (uint64_t(1) << 32) + index;
+      } while (!head_.compare_exchange_weak(head, next, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    /**
+     * Acquires a slot and constructs a Tp in it from args.
+     *
+     * @return The new object, or nullptr if every slot is in use
+     */
+    template<typename... Args>
+    pointer construct(Args &&...args) noexcept(noexcept(Tp(forward<Args>(args)...))) {
+      pointer slot = acquire();
+      return is_nullptr(slot) ? nullptr : new (slot) Tp(forward<Args>(args)...);
+    }
+
+    /**
+     * Destroys an object from construct() and releases its slot; nullptr is ignored.
+     */
+    void destroy(pointer object) noexcept {
+      if (is_nullptr(object)) return;
+
+      object->~Tp();
+      release(object);
+    }
+
+    /** Returns true if ptr points into the arena. */
+    [[nodiscard]] bool owns(const_pointer ptr) const noexcept {
+      return static_cast<size_t>(ptr - arena_base()) < Capacity;
+    }
+
+    [[nodiscard]] constexpr size_t capacity() const noexcept {
+      return Capacity;
+    }
+
+  protected:
+    pointer arena_base() noexcept {
+      return reinterpret_cast<pointer>(arena_);
+    }
+
+    const_pointer arena_base() const noexcept {
+      return reinterpret_cast<const_pointer>(arena_);
+    }
+  };
+}  // namespace memory
+
+using namespace memory;
+
+LIB_XCORE_END_NAMESPACE
+
+#endif  //LIB_XCORE_MEMORY_LOCKFREE_POOL_HPP
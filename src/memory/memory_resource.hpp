@@ -0,0 +1,390 @@
+#ifndef LIB_XCORE_MEMORY_MEMORY_RESOURCE_HPP
+#define LIB_XCORE_MEMORY_MEMORY_RESOURCE_HPP
+
+#include "internal/macros.hpp"
+#include "memory/allocator.hpp"
+#include "memory/generic.hpp"
+#include "memory/slab_allocator.hpp"
+#include "memory/virtual_memory.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+LIB_XCORE_BEGIN_NAMESPACE
+
+namespace memory {
+  /**
+   * Allocator chosen at run time, behind a virtual interface, for code that should not be
+   * re-instantiated for every allocator: a subsystem allocates through a memory_resource *, and
+   * the program decides at startup which resource it points to.
+   * \n
+   * Like the allocators, deallocate() and reallocate() need no size, and nullptr reports a failure.
+   * release() frees at once everything a resource handed out, where the resource supports it
+   * (monotonic_resource_t, arena_resource_t); blocks must not be used afterwards.
+   */
+  class memory_resource {
+  public:
+    /** Default alignment of allocate(), the one malloc() guarantees. */
+    static constexpr size_t max_align = alignof(max_align_t);
+
+    virtual ~memory_resource() = default;
+
+    /**
+     * @return A block of bytes aligned to alignment (power of 2), or nullptr
+     */
+    [[nodiscard]] FORCE_INLINE void *allocate(const size_t bytes, const size_t alignment = max_align) noexcept {
+      return do_allocate(bytes, alignment);
+    }
+
+    /**
+     * Resizes a block to bytes, keeping its first min(old, bytes) bytes. nullptr allocates; a size
+     * of 0 frees the block and returns nullptr. On failure, returns nullptr and the block is kept.
+     */
+    [[nodiscard]] FORCE_INLINE void *reallocate(void *ptr, const size_t bytes, const size_t alignment = max_align) noexcept {
+      return do_reallocate(ptr, bytes, alignment);
+    }
+
+    /** Frees a block from allocate() or reallocate(); nullptr is ignored. */
+    FORCE_INLINE void deallocate(void *ptr) noexcept {
+      if (ptr) do_deallocate(ptr);
+    }
+
+    /** Frees every block at once, if the resource supports it. */
+    FORCE_INLINE void release() noexcept {
+      do_release();
+    }
+
+  protected:
+    virtual void *do_allocate(size_t bytes, size_t alignment) noexcept              = 0;
+    virtual void *do_reallocate(void *ptr, size_t bytes, size_t alignment) noexcept = 0;
+    virtual void  do_deallocate(void *ptr) noexcept                                 = 0;
+
+    virtual void do_release() noexcept {}
+  };
+
+  /**
+   * memory_resource over malloc(), realloc() and free(), or posix_memalign() for alignments
+   * above max_align. The default resource. On Windows, every block comes from _aligned_malloc(),
+   * since _aligned_free() cannot free a malloc() block nor free() an aligned one.
+   */
+  class malloc_resource_t : public memory_resource {
+  public:
+    constexpr malloc_resource_t() noexcept = default;
+
+  protected:
+    static void *aligned_malloc(const size_t bytes, const size_t alignment) noexcept {
+#if defined(_WIN32)
+      return _aligned_malloc(bytes, alignment);
+#elif defined(__unix__) || defined(__APPLE__)
+      void *p_mem = nullptr;
+      return posix_memalign(&p_mem, alignment, bytes) == 0 ? p_mem : nullptr;
+#else
+      return aligned_alloc(alignment, (bytes + alignment - 1) & ~(alignment - 1));
+#endif
+    }
+
+    void *do_allocate(const size_t bytes, const size_t alignment) noexcept override {
+#if defined(_WIN32)
+      return aligned_malloc(bytes ? bytes : 1, alignment > max_align ? alignment : max_align);
+#else
+      return alignment <= max_align ? malloc(bytes ? bytes : 1) : aligned_malloc(bytes ? bytes : 1, alignment);
+#endif
+    }
+
+    void *do_reallocate(void *ptr, const size_t bytes, const size_t alignment) noexcept override {
+      if (!ptr) return do_allocate(bytes, alignment);
+
+      if (bytes == 0) {
+        do_deallocate(ptr);
+        return nullptr;
+      }
+
+#if defined(_WIN32)
+      return _aligned_realloc(ptr, bytes, alignment > max_align ? alignment : max_align);
+#else
+      void *p_mem = realloc(ptr, bytes);
+      if (!p_mem || (reinterpret_cast<uintptr_t>(p_mem) & (alignment - 1)) == 0) return p_mem;
+
+      // realloc() moved the block to a less aligned address, see basic_aligned_allocator_t
+      void *p_aligned = aligned_malloc(bytes, alignment);
+      if (p_aligned) memcpy(p_aligned, p_mem, bytes);
+      free(p_mem);
+      return p_aligned;
+#endif
+    }
+
+    void do_deallocate(void *ptr) noexcept override {
+#if defined(_WIN32)
+      _aligned_free(ptr);
+#else
+      free(ptr);
+#endif
+    }
+  };
+
+  /**
+   * Bump allocation over a virtual_stack_region_t: every block records its size and offset in a
+   * 16-byte header, so that a block can be reallocated, and given back by the region when it is
+   * the last one. Shared by monotonic_resource_t and arena_resource_t.
+   */
+  template<typename region_t>
+  class region_resource_t : public memory_resource {
+  protected:
+    using byte_t = uint8_t;
+
+    struct header_t {
+      size_t   size;    // Bytes requested by allocate() or the last growing reallocate()
+      uint32_t offset;  // From the start of the region block to the payload
+      uint32_t align;   // Alignment of the payload, at least max_align
+    };
+
+    static_assert(sizeof(header_t) == max_align, "The header must keep the payload aligned.");
+
+    region_t region_;
+
+  public:
+    region_resource_t() noexcept = default;
+
+    region_resource_t(const region_resource_t &)            = delete;
+    region_resource_t &operator=(const region_resource_t &) = delete;
+
+    [[nodiscard]] bool valid() const noexcept {
+      return region_.valid();
+    }
+
+    /** The underlying region, for its statistics, markers and scopes. */
+    [[nodiscard]] region_t &region() noexcept {
+      return region_;
+    }
+
+    [[nodiscard]] const region_t &region() const noexcept {
+      return region_;
+    }
+
+    /** Size of a block from allocate(), kept by a shrinking reallocate(). */
+    [[nodiscard]] static size_t block_size(const void *ptr) noexcept {
+      return header_of(ptr)->size;
+    }
+
+  protected:
+    FORCE_INLINE static header_t *header_of(const void *ptr) noexcept {
+      return reinterpret_cast<header_t *>(const_cast<byte_t *>(static_cast<const byte_t *>(ptr))) - 1;
+    }
+
+    // The region block spans the header, the padding up to the payload alignment, and the payload
+    FORCE_INLINE static constexpr size_t span_of(const size_t bytes, const size_t align) noexcept {
+      return align + bytes;
+    }
+
+    void *do_allocate(const size_t bytes, const size_t alignment) noexcept override {
+      const size_t align = alignment > max_align ? alignment : max_align;
+      if (bytes > static_cast<size_t>(-1) / 2 - align) return nullptr;
+
+      byte_t *raw = region_.template allocate_ptr<byte_t>(span_of(bytes, align));
+      if (is_nullptr(raw)) return nullptr;
+
+      auto *payload = reinterpret_cast<byte_t *>((reinterpret_cast<uintptr_t>(raw) + max_align + align - 1) & ~(align - 1));
+      header_t *header = header_of(payload);
+      header->size     = bytes;
+      header->offset   = static_cast<uint32_t>(payload - raw);
+      header->align    = static_cast<uint32_t>(align);
+      return payload;
+    }
+
+    void *do_reallocate(void *ptr, const size_t bytes, const size_t alignment) noexcept override {
+      if (!ptr) return do_allocate(bytes, alignment);
+
+      if (bytes == 0) {
+        do_deallocate(ptr);
+        return nullptr;
+      }
+
+      // The size also gives the span deallocate() hands back to the region: a shrinking block
+      // keeps it, or the rest of the span would be lost until release()
+      header_t *header = header_of(ptr);
+      if (bytes <= header->size) return ptr;
+
+      // The region grows downwards: the last block cannot grow in place
+      void *block = do_allocate(bytes, alignment);
+      if (block) {
+        memcpy(block, ptr, header->size);
+        do_deallocate(ptr);
+      }
+      return block;
+    }
+
+    /**
+     * Gives the block back to the region if it is the last one (LIFO use), otherwise keeps it
+     * until release().
+     */
+    void do_deallocate(void *ptr) noexcept override {
+      const header_t *header = header_of(ptr);
+      const byte_t   *raw    = static_cast<const byte_t *>(ptr) - header->offset;
+
+      if (raw == region_.marker().sp) region_.template deallocate<byte_t>(span_of(header->size, header->align));
+    }
+
+    void do_release() noexcept override {
+      region_.clear();
+    }
+  };
+
+  /**
+   * memory_resource that only ever bumps a pointer, for allocations sharing one lifetime (a
+   * request, a frame, a parse): deallocate() frees nothing (except the last block), release()
+   * frees everything. Grows with blocks twice as large from base_allocator_t when BlockBytes is
+   * exhausted, and keeps the largest one across release().
+   *
+   * @tparam BlockBytes        Bytes of the first block
+   * @tparam base_allocator_t  Memory allocator of the blocks
+   */
+  template<size_t BlockBytes = 4096, template<typename> class base_allocator_t = malloc_allocator_t>
+  class monotonic_resource_t
+      : public region_resource_t<virtual_stack_region_t<BlockBytes, memory_resource::max_align, base_allocator_t, true>> {};
+
+  /**
+   * memory_resource over a single region of NumBytes, reserved up front: allocate() fails rather
+   * than calling base_allocator_t again. Blocks freed in LIFO order are given back, and
+   * region().scope() or release() free a whole phase at once.
+   *
+   * @tparam NumBytes          Bytes of the region
+   * @tparam base_allocator_t  Memory allocator of the region
+   */
+  template<size_t NumBytes, template<typename> class base_allocator_t = malloc_allocator_t>
+  class arena_resource_t
+      : public region_resource_t<virtual_stack_region_t<NumBytes, memory_resource::max_align, base_allocator_t, false>> {};
+
+  /**
+   * memory_resource over a slab_allocator_t, for many small blocks of mixed sizes freed in any
+   * order. Alignments above max_align, and requests the slabs cannot serve, go to
+   * malloc_resource_t, which frees every block that is not in a slab.
+   * release() is not supported: blocks are freed one by one.
+   *
+   * @tparam NumSlabs  Number of slabs in the arena
+   * @tparam SlabSize  Bytes per slab
+   */
+  template<size_t NumSlabs, size_t SlabSize = 16384>
+  class pool_resource_t : public malloc_resource_t {
+  protected:
+    slab_allocator_t<NumSlabs, SlabSize> slab_;
+
+  public:
+    pool_resource_t() noexcept = default;
+
+    pool_resource_t(const pool_resource_t &)            = delete;
+    pool_resource_t &operator=(const pool_resource_t &) = delete;
+
+    /** The underlying slab allocator. */
+    [[nodiscard]] slab_allocator_t<NumSlabs, SlabSize> &slab() noexcept {
+      return slab_;
+    }
+
+  protected:
+    void *do_allocate(const size_t bytes, const size_t alignment) noexcept override {
+      void *block = alignment <= max_align ? slab_.try_allocate(bytes ? bytes : 1) : nullptr;
+      return block ? block : malloc_resource_t::do_allocate(bytes, alignment);
+    }
+
+    void *do_reallocate(void *ptr, const size_t bytes, const size_t alignment) noexcept override {
+      if (!ptr || !slab_.owns(ptr)) return malloc_resource_t::do_reallocate(ptr, bytes, alignment);
+
+      if (bytes == 0) {
+        slab_.deallocate(ptr);
+        return nullptr;
+      }
+
+      // Stays in place when the size class does not change, as slab_allocator_t::reallocate()
+      const size_t old_size = slab_.block_size(ptr);
+      if (bytes <= old_size && slab_size_class::size(slab_size_class::index(bytes)) == old_size) return ptr;
+
+      void *block = do_allocate(bytes, alignment);
+      if (block) {
+        memcpy(block, ptr, bytes < old_size ? bytes : old_size);
+        slab_.deallocate(ptr);
+      }
+      return block;
+    }
+
+    void do_deallocate(void *ptr) noexcept override {
+      if (slab_.owns(ptr)) slab_.deallocate(ptr);
+      else malloc_resource_t::do_deallocate(ptr);
+    }
+  };
+
+  /**
+   * The resource behind default_memory_resource until the program picks another one.
+   */
+  inline malloc_resource_t malloc_resource;
+
+  /**
+   * Resource of resource_allocator_t. Meant to be set once at startup, before any allocation:
+   * a block must be freed by the resource that allocated it.
+   */
+  inline memory_resource *default_memory_resource = &malloc_resource;
+
+  /**
+   * Binds a memory_resource * variable (with static storage duration) as an allocator for
+   * template<typename> class parameters, so that every container instantiated with it allocates
+   * from the resource the variable points to at run time:
+   *
+   *   static memory_resource *telemetry_resource = &malloc_resource;
+   *   template<typename Tp> using telemetry_alloc = resource_allocator_form_t<telemetry_resource>::type<Tp>;
+   *
+   *   static monotonic_resource_t<65536> arena;
+   *   telemetry_resource = &arena;                        // At startup
+   *   dynamic_array_t<float, 0, telemetry_alloc> samples(100);
+   *   ...
+   *   arena.release();                                   // Once the containers are gone
+   *
+   * Like default_allocator_t, allocations are zero-filled, and aligned to alignof(Tp).
+   */
+  template<auto &Resource>
+  struct resource_allocator_form_t {
+    template<typename Tp>
+    class type : public allocator_t<type, Tp> {
+    protected:
+      friend class allocator_t<type, Tp>;
+
+      static constexpr size_t alignment = alignof(Tp) > memory_resource::max_align ? alignof(Tp) : memory_resource::max_align;
+
+    public:
+      FORCE_INLINE static Tp *impl_allocate(const size_t n = 1) noexcept {
+        if (n > static_cast<size_t>(-1) / sizeof(Tp)) return nullptr;
+
+        void *p_mem = Resource->allocate(n * sizeof(Tp), alignment);
+        if (p_mem) memset(p_mem, 0, n * sizeof(Tp));
+        return static_cast<Tp *>(p_mem);
+      }
+
+      FORCE_INLINE static constexpr Tp *impl_allocate_inplace(Tp &dst, const size_t) noexcept {
+        return &dst;
+      }
+
+      FORCE_INLINE static constexpr Tp *impl_allocate_inplace(Tp *dst, const size_t) noexcept {
+        return dst;
+      }
+
+      FORCE_INLINE static Tp *impl_reallocate(Tp *object, const size_t n) noexcept {
+        if (n > static_cast<size_t>(-1) / sizeof(Tp)) return nullptr;
+        return static_cast<Tp *>(Resource->reallocate(object, n * sizeof(Tp), alignment));
+      }
+
+      FORCE_INLINE static void impl_deallocate(Tp *object) noexcept {
+        Resource->deallocate(object);
+      }
+    };
+  };
+
+  /**
+   * Allocator over default_memory_resource.
+   */
+  template<typename Tp>
+  using resource_allocator_t = typename resource_allocator_form_t<default_memory_resource>::template type<Tp>;
+}  // namespace memory
+
+using namespace memory;
+
+LIB_XCORE_END_NAMESPACE
+
+#endif  //LIB_XCORE_MEMORY_MEMORY_RESOURCE_HPP
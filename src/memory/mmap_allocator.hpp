@@ -0,0 +1,204 @@
+#ifndef LIB_XCORE_MEMORY_MMAP_ALLOCATOR_HPP
+#define LIB_XCORE_MEMORY_MMAP_ALLOCATOR_HPP
+
+#include "internal/macros.hpp"
+#include "memory/allocator.hpp"
+#include "memory/generic.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <sys/mman.h>
+#include <unistd.h>
+
+LIB_XCORE_BEGIN_NAMESPACE
+
+namespace memory {
+  /**
+   * Options of mmap_allocator_t, to be combined with |.
+   */
+  struct mmap_flags {
+    /** Plain anonymous mapping, faulted in page by page at first touch. */
+    static constexpr unsigned none             = 0;
+    /** Explicit huge pages (MAP_HUGETLB) from the reserved pool, transparent huge pages if none is left. */
+    static constexpr unsigned huge_tlb         = 1;
+    /** Transparent huge pages (madvise(MADV_HUGEPAGE)) on a mapping aligned to 2 MiB. */
+    static constexpr unsigned transparent_huge = 2;
+    /** Fault every page in on allocation (MAP_POPULATE) rather than at first touch. */
+    static constexpr unsigned populate         = 4;
+    /** Lock the pages in memory (mlock), best effort: RLIMIT_MEMLOCK may refuse it. */
+    static constexpr unsigned lock             = 8;
+  };
+
+  /**
+   * Allocator mapping every allocation with mmap() instead of taking it from malloc(), for large
+   * arenas (virtual_stack_region_t, heap_array_t of several MiB) that should be backed by huge
+   * pages, faulted in up front, or locked in memory before real-time operation:
+   *
+   *   using arena_t = virtual_stack_region_t<64 << 20, 16, mmap_allocator_form_t<mmap_flags::transparent_huge |
+   *                                                                               mmap_flags::populate>::type>;
+   *
+   * The mapping starts with a 64-byte header holding its length, so blocks are aligned to a cache
+   * line. Memory is zero-filled, like default_allocator_t. Each allocation costs a system call and
+   * at least a page, so small allocations belong elsewhere.
+   *
+   * @tparam Flags  Combination of mmap_flags
+   */
+  template<typename Tp, unsigned Flags>
+  class basic_mmap_allocator_t;
+
+  /**
+   * Binds the flags of basic_mmap_allocator_t, for parameters expecting template<typename> class.
+   */
+  template<unsigned Flags>
+  struct mmap_allocator_form_t {
+    template<typename Tp>
+    using type = basic_mmap_allocator_t<Tp, Flags>;
+  };
+
+  template<typename Tp, unsigned Flags>
+  class basic_mmap_allocator_t : public allocator_t<mmap_allocator_form_t<Flags>::template type, Tp> {
+  protected:
+    friend class allocator_t<mmap_allocator_form_t<Flags>::template type, Tp>;
+
+    static_assert(alignof(Tp) <= cache_line_size, "Tp is over-aligned for the mapping header.");
+
+    static constexpr size_t header_size    = cache_line_size;
+    static constexpr size_t huge_page_size = size_t(2) << 20;
+
+    // Most elements one mapping can hold without its length overflowing
+    static constexpr size_t max_count = (static_cast<size_t>(-1) - header_size - huge_page_size) / sizeof(Tp);
+
+    FORCE_INLINE static size_t page_size() noexcept {
+      static const auto size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+      return size;
+    }
+
+    FORCE_INLINE static constexpr size_t round_up(const size_t n, const size_t multiple) noexcept {
+      return (n + multiple - 1) & ~(multiple - 1);
+    }
+
+    /**
+     * Maps at least bytes, following Flags, and records the length of the mapping at its start.
+     *
+     * @return The start of the mapping, or nullptr
+     */
+    static unsigned char *map(const size_t bytes) noexcept {
+      int extra = 0;
+#if defined(MAP_POPULATE)
+      if (Flags & mmap_flags::populate) extra |= MAP_POPULATE;
+#endif
+
+      void  *base   = MAP_FAILED;
+      size_t length = 0;
+
+#if defined(MAP_HUGETLB)
+      if (Flags & mmap_flags::huge_tlb) {
+        length = round_up(bytes, huge_page_size);
+        base   = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | extra, -1, 0);
+      }
+#endif
+
+      if (base == MAP_FAILED) {
+        length = round_up(bytes, page_size());
+
+        if ((Flags & (mmap_flags::huge_tlb | mmap_flags::transparent_huge)) && length >= huge_page_size) {
+          // Over-map, then trim both ends to a 2 MiB-aligned range that huge pages can back
+          length = round_up(bytes, huge_page_size);
+          base   = mmap(nullptr, length + huge_page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+          if (base == MAP_FAILED) return nullptr;
+
+          auto *const raw     = static_cast<unsigned char *>(base);
+          auto *const aligned = reinterpret_cast<unsigned char *>(round_up(reinterpret_cast<uintptr_t>(raw), huge_page_size));
+          if (aligned != raw) munmap(raw, static_cast<size_t>(aligned - raw));
+          munmap(aligned + length, static_cast<size_t>(raw + huge_page_size - aligned));
+          base = aligned;
+
+#if defined(MADV_HUGEPAGE)
+          madvise(base, length, MADV_HUGEPAGE);
+#endif
+          // MAP_POPULATE would fault in before the advice, with regular pages; mlock() faults in too
+          if ((Flags & mmap_flags::populate) && !(Flags & mmap_flags::lock)) touch(base, length);
+        } else {
+          base = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | extra, -1, 0);
+          if (base == MAP_FAILED) return nullptr;
+        }
+      }
+
+      if (Flags & mmap_flags::lock) mlock(base, length);
+
+      *static_cast<size_t *>(base) = length;
+      return static_cast<unsigned char *>(base);
+    }
+
+    FORCE_INLINE static unsigned char *mapping_of(Tp *object) noexcept {
+      return reinterpret_cast<unsigned char *>(object) - header_size;
+    }
+
+    /** Faults pages in by writing a zero in each, for mappings MAP_POPULATE cannot apply to. */
+    static void touch(void *base, const size_t length) noexcept {
+      auto *p = static_cast<volatile unsigned char *>(base);
+      for (size_t i = 0; i < length; i += page_size()) p[i] = 0;
+    }
+
+  public:
+    FORCE_INLINE static Tp *impl_allocate(const size_t n = 1) noexcept {
+      if (n > max_count) return nullptr;
+
+      unsigned char *mapping = map(header_size + n * sizeof(Tp));
+      return is_nullptr(mapping) ? nullptr : reinterpret_cast<Tp *>(mapping + header_size);
+    }
+
+    FORCE_INLINE static constexpr Tp *impl_allocate_inplace(Tp &dst, const size_t) noexcept {
+      return &dst;
+    }
+
+    FORCE_INLINE static constexpr Tp *impl_allocate_inplace(Tp *dst, const size_t) noexcept {
+      return dst;
+    }
+
+    /**
+     * Resizes a block to n elements, keeping the first min(old, n). Stays in place while the
+     * mapping is large enough. A size of 0 frees the block and returns nullptr; on failure,
+     * returns nullptr and the block is kept.
+     */
+    static Tp *impl_reallocate(Tp *object, const size_t n) noexcept {
+      if (is_nullptr(object)) return impl_allocate(n);
+
+      if (n == 0) {
+        impl_deallocate(object);
+        return nullptr;
+      }
+
+      if (n > max_count) return nullptr;  // n * sizeof(Tp) would wrap below old_size
+
+      const size_t old_size = *reinterpret_cast<size_t *>(mapping_of(object)) - header_size;
+      if (n * sizeof(Tp) <= old_size) return object;
+
+      Tp *block = impl_allocate(n);
+      if (block) {
+        memcpy(block, object, old_size);
+        impl_deallocate(object);
+      }
+      return block;
+    }
+
+    FORCE_INLINE static void impl_deallocate(Tp *object) noexcept {
+      if (is_nullptr(object)) return;
+
+      unsigned char *mapping = mapping_of(object);
+      munmap(mapping, *reinterpret_cast<size_t *>(mapping));
+    }
+  };
+
+  /**
+   * mmap() allocator backed by transparent huge pages for mappings of 2 MiB or more.
+   */
+  template<typename Tp>
+  using mmap_allocator_t = basic_mmap_allocator_t<Tp, mmap_flags::transparent_huge>;
+}  // namespace memory
+
+using namespace memory;
+
+LIB_XCORE_END_NAMESPACE
+
+#endif  //LIB_XCORE_MEMORY_MMAP_ALLOCATOR_HPP
@@ -0,0 +1,328 @@
+#ifndef LIB_XCORE_MEMORY_SLAB_ALLOCATOR_HPP
+#define LIB_XCORE_MEMORY_SLAB_ALLOCATOR_HPP
+
+#include "internal/macros.hpp"
+#include "memory/allocator.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+LIB_XCORE_BEGIN_NAMESPACE
+
+namespace memory {
+  /**
+   * Size classes of slab_allocator_t, spaced like jemalloc: 16-byte steps up to 64 bytes, then four
+   * classes per power of two (80, 96, 112, 128, 160, 192, ...), so that at most 20% of a block is
+   * lost to rounding above 64 bytes.
+   */
+  struct slab_size_class {
+    /** Index of the smallest class holding n bytes (n > 0). */
+    FORCE_INLINE static constexpr size_t index(const size_t n) {
+      const size_t s = n - 1;
+      if (s < 64) return s >> 4;
+      const auto k = static_cast<size_t>(63 - __builtin_clzll(s));
+      return 4 + (k - 6) * 4 + ((s >> (k - 2)) & 3);
+    }
+
+    /** Block size of a class. */
+    FORCE_INLINE static constexpr size_t size(const size_t index) {
+      if (index < 4) return (index + 1) * 16;
+      const size_t group = (index - 4) / 4;
+      return (size_t(64) << group) + ((index - 4) % 4 + 1) * (size_t(16) << group);
+    }
+  };
+
+  /**
+   * Allocator for variable sizes, serving blocks from slabs of one size class each.
+   *
+   * The arena holds NumSlabs slabs of SlabSize bytes, aligned to SlabSize, and is handed out one
+   * slab at a time to the size class that needs it. Every slab starts with a header holding its
+   * class and a two-level bitmap of free blocks (one summary bit per 64-block word), so that:
+   *  - allocate(bytes) looks up the class, takes the first slab with room and finds a free block
+   *    with two count-trailing-zeros;
+   *  - deallocate(ptr) finds the header by masking the pointer, and the block index with a
+   *    multiplication instead of a division.
+   * Slabs of a class with room are kept in a list; a slab that becomes empty goes back to the
+   * arena, so it can serve another class, unless it is the last one of its class. Such reserved
+   * slabs are reclaimed once the arena runs out.
+   *
+   * Requests larger than the largest class (SlabSize / 8) and requests arriving once the arena is
+   * exhausted fall back to malloc(); deallocate() tells them apart by address. The allocator is not
+   * thread-safe.
+   *
+   * The instance is large (NumSlabs * SlabSize bytes) and is meant to live in static storage:
+   *   static slab_allocator_t<64> slab;  // 1 MiB
+   *   void *msg = slab.allocate(n);
+   *   slab.deallocate(msg);
+   *
+   * @tparam NumSlabs  Number of slabs in the arena
+   * @tparam SlabSize  Bytes per slab, a power of 2 in [1 KiB, 64 KiB]
+   */
+  template<size_t NumSlabs, size_t SlabSize = 16384>
+  class slab_allocator_t {
+    static_assert(NumSlabs > 0, "The arena needs at least one slab.");
+    static_assert(SlabSize >= 1024 && SlabSize <= 65536 && (SlabSize & (SlabSize - 1)) == 0,
+                  "SlabSize must be a power of 2 in [1 KiB, 64 KiB].");
+
+  public:
+    static constexpr size_t max_block_size = SlabSize / 8;
+    static constexpr size_t num_classes    = slab_size_class::index(max_block_size) + 1;
+
+  protected:
+    static constexpr size_t num_words = SlabSize / 16 / 64;  // Bitmap words for the smallest class
+
+    struct slab_header_t {
+      slab_header_t *next;
+      slab_header_t *prev;
+      uint32_t       block_size;
+      uint32_t       inverse;  // 2^32 / block_size + 1: offset * inverse >> 32 == offset / block_size
+      uint16_t       class_index;
+      uint16_t       capacity;
+      uint16_t       used;
+      uint64_t       summary;           // Bit w set: free_[w] has a free block
+      uint64_t       free_[num_words];  // Bit set: free block
+    };
+
+    static constexpr size_t header_size = (sizeof(slab_header_t) + 63) & ~size_t(63);
+
+    alignas(SlabSize) unsigned char arena_[NumSlabs][SlabSize];
+    slab_header_t *partial_[num_classes];  // Slabs with at least one free block
+    slab_header_t *empty_;                 // Slabs given back to the arena
+    size_t         carved_;                // Slabs taken from the arena so far
+    size_t         slabs_in_use_;
+
+  public:
+    constexpr slab_allocator_t() noexcept : arena_{}, partial_{}, empty_(nullptr), carved_(0), slabs_in_use_(0) {}
+
+    slab_allocator_t(const slab_allocator_t &)            = delete;
+    slab_allocator_t &operator=(const slab_allocator_t &) = delete;
+
+    /**
+     * @return A block of at least n bytes aligned to 16 bytes, or nullptr if n is 0 or the
+     *         malloc() fallback fails
+     */
+    void *allocate(const size_t n) noexcept {
+      if (n == 0) return nullptr;
+
+      void *block = try_allocate(n);
+      return block ? block : malloc(n);
+    }
+
+    /**
+     * @return A block of at least n bytes from a slab, or nullptr where allocate() would fall
+     *         back to malloc(), for callers with their own fallback
+     */
+    void *try_allocate(const size_t n) noexcept {
+      if (n == 0 || n > max_block_size) return nullptr;
+
+      const size_t   c    = slab_size_class::index(n);
+      slab_header_t *slab = partial_[c];
+
+      if (!slab) {
+        slab = _new_slab(c);
+        if (!slab) return nullptr;
+      }
+
+      const auto w = static_cast<size_t>(__builtin_ctzll(slab->summary));
+      const auto b = static_cast<size_t>(__builtin_ctzll(slab->free_[w]));
+
+      slab->free_[w] &= slab->free_[w] - 1;
+      if (!slab->free_[w]) slab->summary &= ~(uint64_t(1) << w);
+
+      if (++slab->used == slab->capacity) _unlink(slab);
+
+      return reinterpret_cast<unsigned char *>(slab) + header_size + (w * 64 + b) * slab->block_size;
+    }
+
+    /**
+     * Frees a block from allocate() or reallocate(); nullptr is ignored.
+     */
+    void deallocate(void *ptr) noexcept {
+      if (!ptr) return;
+
+      if (!owns(ptr)) {
+        free(ptr);
+        return;
+      }
+
+      auto *slab = reinterpret_cast<slab_header_t *>(reinterpret_cast<uintptr_t>(ptr) & ~uintptr_t(SlabSize - 1));
+
+      const auto offset = static_cast<uint64_t>(static_cast<unsigned char *>(ptr) - reinterpret_cast<unsigned char *>(slab) - header_size);
+      const auto index  = static_cast<size_t>((offset * slab->inverse) >> 32);
+
+      slab->free_[index / 64] |= uint64_t(1) << (index % 64);
+      slab->summary |= uint64_t(1) << (index / 64);
+
+      if (slab->used-- == slab->capacity) _link(slab);
+
+      // Give an empty slab back, but keep the last one of its class
+      if (slab->used == 0 && (partial_[slab->class_index] != slab || slab->next)) {
+        _unlink(slab);
+        slab->next = empty_;
+        empty_     = slab;
+        --slabs_in_use_;
+      }
+    }
+
+    /**
+     * Resizes a block, keeping min(old, n) bytes. Stays in place when the size class does not
+     * change. A size of 0 frees the block and returns nullptr; on failure, returns nullptr and
+     * the block is kept.
+     */
+    void *reallocate(void *ptr, const size_t n) noexcept {
+      if (!ptr) return allocate(n);
+
+      if (n == 0) {
+        deallocate(ptr);
+        return nullptr;
+      }
+
+      if (!owns(ptr)) return realloc(ptr, n);  // Fallback blocks stay in the fallback
+
+      const size_t old_size = block_size(ptr);
+      if (n <= old_size && slab_size_class::size(slab_size_class::index(n)) == old_size)
+        return ptr;
+
+      void *block = allocate(n);
+      if (block) {
+        memcpy(block, ptr, n < old_size ? n : old_size);
+        deallocate(ptr);
+      }
+      return block;
+    }
+
+    /** Returns true if ptr was served by a slab (rather than by the malloc() fallback). */
+    [[nodiscard]] bool owns(const void *ptr) const noexcept {
+      const auto p = reinterpret_cast<uintptr_t>(ptr);
+      const auto b = reinterpret_cast<uintptr_t>(arena_);
+      return p >= b && p < b + sizeof(arena_);
+    }
+
+    /** Usable size of a block served by a slab. */
+    [[nodiscard]] size_t block_size(const void *ptr) const noexcept {
+      return reinterpret_cast<const slab_header_t *>(reinterpret_cast<uintptr_t>(ptr) & ~uintptr_t(SlabSize - 1))->block_size;
+    }
+
+    /** Number of slabs currently assigned to a size class. */
+    [[nodiscard]] size_t slabs_in_use() const noexcept { return slabs_in_use_; }
+
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return NumSlabs; }
+
+  protected:
+    slab_header_t *_new_slab(const size_t c) noexcept {
+      slab_header_t *slab;
+
+      if (empty_) {
+        slab   = empty_;
+        empty_ = slab->next;
+      } else if (carved_ < NumSlabs) {
+        slab = reinterpret_cast<slab_header_t *>(arena_[carved_++]);
+      } else if ((slab = _steal_empty_slab())) {
+        --slabs_in_use_;
+      } else {
+        return nullptr;
+      }
+
+      const size_t size     = slab_size_class::size(c);
+      const size_t capacity = (SlabSize - header_size) / size;
+
+      slab->block_size  = static_cast<uint32_t>(size);
+      slab->inverse     = static_cast<uint32_t>((uint64_t(1) << 32) / size + 1);
+      slab->class_index = static_cast<uint16_t>(c);
+      slab->capacity    = static_cast<uint16_t>(capacity);
+      slab->used        = 0;
+      slab->summary     = 0;
+
+      for (size_t w = 0; w < num_words; ++w) {
+        const size_t first = w * 64;
+        const size_t count = capacity > first ? capacity - first : 0;
+
+        slab->free_[w] = count >= 64 ? ~uint64_t(0) : (uint64_t(1) << count) - 1;
+        if (count) slab->summary |= uint64_t(1) << w;
+      }
+
+      ++slabs_in_use_;
+      _link(slab);
+      return slab;
+    }
+
+    /**
+     * Takes back the empty slab a class keeps in reserve. Only runs once the arena is exhausted.
+     */
+    slab_header_t *_steal_empty_slab() noexcept {
+      for (slab_header_t *head: partial_) {
+        for (slab_header_t *slab = head; slab; slab = slab->next) {
+          if (slab->used == 0) {
+            _unlink(slab);
+            return slab;
+          }
+        }
+      }
+      return nullptr;
+    }
+
+    void _link(slab_header_t *slab) noexcept {
+      slab_header_t *&head = partial_[slab->class_index];
+
+      slab->prev = nullptr;
+      slab->next = head;
+      if (head) head->prev = slab;
+      head = slab;
+    }
+
+    void _unlink(slab_header_t *slab) noexcept {
+      if (slab->prev) slab->prev->next = slab->next;
+      else partial_[slab->class_index] = slab->next;
+      if (slab->next) slab->next->prev = slab->prev;
+    }
+  };
+
+  /**
+   * Binds a slab_allocator_t instance (with static storage duration) as an allocator for
+   * template<typename> class parameters, a drop-in replacement for default_allocator_t:
+   *
+   *   static slab_allocator_t<64> slab;
+   *   template<typename Tp> using slab_alloc = slab_allocator_form_t<slab>::type<Tp>;
+   *   dynamic_array_t<float, 0, slab_alloc> samples(100);
+   *
+   * Like default_allocator_t, allocations are zero-filled.
+   */
+  template<auto &Slab>
+  struct slab_allocator_form_t {
+    template<typename Tp>
+    class type : public allocator_t<type, Tp> {
+    protected:
+      friend class allocator_t<type, Tp>;
+
+    public:
+      FORCE_INLINE static Tp *impl_allocate(const size_t n = 1) noexcept {
+        void *p_mem = Slab.allocate(n * sizeof(Tp));
+        if (p_mem) memset(p_mem, 0, n * sizeof(Tp));
+        return static_cast<Tp *>(p_mem);
+      }
+
+      FORCE_INLINE static constexpr Tp *impl_allocate_inplace(Tp &dst, const size_t) noexcept {
+        return &dst;
+      }
+
+      FORCE_INLINE static constexpr Tp *impl_allocate_inplace(Tp *dst, const size_t) noexcept {
+        return dst;
+      }
+
+      FORCE_INLINE static Tp *impl_reallocate(Tp *object, const size_t n) noexcept {
+        return static_cast<Tp *>(Slab.reallocate(object, n * sizeof(Tp)));
+      }
+
+      FORCE_INLINE static void impl_deallocate(Tp *object) noexcept {
+        Slab.deallocate(object);
+      }
+    };
+  };
+}  // namespace memory
+
+using namespace memory;
+
+LIB_XCORE_END_NAMESPACE
+
+#endif  //LIB_XCORE_MEMORY_SLAB_ALLOCATOR_HPP
@@ -0,0 +1,443 @@
+#ifndef LIB_XCORE_MEMORY_THREAD_CACHE_HPP
+#define LIB_XCORE_MEMORY_THREAD_CACHE_HPP
+
+#include "internal/macros.hpp"
+#include "memory/allocator.hpp"
+#include "memory/bitmap_allocator.hpp"
+#include "memory/slab_allocator.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+
+LIB_XCORE_BEGIN_NAMESPACE
+
+namespace memory {
+  /**
+   * Header in front of every block served by thread_cache_t.
+   */
+  struct alignas(16) thread_cache_header_t {
+    void  *owner;       // Thread cache holding the block, nullptr if it bypasses the caches
+    size_t size_class;  // Byte count instead for blocks bypassing the caches
+  };
+
+  /**
+   * Backend of thread_cache_t over malloc_allocator_t: blocks up to 1 KiB are cached in the size
+   * classes of slab_allocator_t, larger ones go to malloc() directly.
+   */
+  struct malloc_cache_backend_t {
+    using byte_allocator                   = malloc_allocator_t<unsigned char>;
+
+    static constexpr size_t max_size       = 1024;
+    static constexpr size_t num_classes    = slab_size_class::index(max_size) + 1;
+
+    FORCE_INLINE static constexpr size_t class_of(const size_t n) noexcept {
+      return slab_size_class::index(n);
+    }
+
+    FORCE_INLINE static constexpr size_t class_size(const size_t c) noexcept {
+      return slab_size_class::size(c);
+    }
+
+    size_t refill(const size_t c, void **blocks, const size_t n) noexcept {
+      for (size_t i = 0; i < n; ++i) {
+        blocks[i] = byte_allocator::allocate(sizeof(thread_cache_header_t) + class_size(c));
+        if (is_nullptr(blocks[i])) return i;
+      }
+      return n;
+    }
+
+    void flush(const size_t, void *const *blocks, const size_t n) noexcept {
+      for (size_t i = 0; i < n; ++i) byte_allocator::deallocate(static_cast<unsigned char *>(blocks[i]));
+    }
+
+    void *allocate_uncached(const size_t n) noexcept {
+      return byte_allocator::allocate(sizeof(thread_cache_header_t) + n);
+    }
+
+    void deallocate_uncached(void *block) noexcept {
+      byte_allocator::deallocate(static_cast<unsigned char *>(block));
+    }
+  };
+
+  /**
+   * Backend of thread_cache_t over a bitmap_allocator of Capacity objects of type Tp, shared by
+   * all threads behind a mutex. Every cell carries a thread_cache_header_t in front of the object.
+   */
+  template<typename Tp, size_t Capacity>
+  class bitmap_cache_backend_t {
+    static_assert(alignof(Tp) <= alignof(thread_cache_header_t), "Tp is over-aligned for the cell header.");
+
+  protected:
+    struct cell_t {
+      thread_cache_header_t                                   header;
+      typename aligned_storage<sizeof(Tp), alignof(Tp)>::type storage;
+    };
+
+    bitmap_allocator<cell_t, Capacity> pool_;
+    std::mutex                         mutex_;
+
+  public:
+    static constexpr size_t max_size    = sizeof(Tp);
+    static constexpr size_t num_classes = 1;
+
+    FORCE_INLINE static constexpr size_t class_of(const size_t) noexcept {
+      return 0;
+    }
+
+    FORCE_INLINE static constexpr size_t class_size(const size_t) noexcept {
+      return sizeof(Tp);
+    }
+
+    size_t refill(const size_t, void **blocks, const size_t n) noexcept {
+      std::lock_guard<std::mutex> lock(mutex_);
+
+      for (size_t i = 0; i < n; ++i) {
+        blocks[i] = pool_.acquire();
+        if (is_nullptr(blocks[i])) return i;
+      }
+      return n;
+    }
+
+    void flush(const size_t, void *const *blocks, const size_t n) noexcept {
+      std::lock_guard<std::mutex> lock(mutex_);
+
+      for (size_t i = 0; i < n; ++i) pool_.release(static_cast<const cell_t *>(blocks[i]));
+    }
+
+    void *allocate_uncached(const size_t n) noexcept {
+      void *block = nullptr;
+      return n <= sizeof(Tp) && refill(0, &block, 1) ? block : nullptr;
+    }
+
+    void deallocate_uncached(void *block) noexcept {
+      flush(0, &block, 1);
+    }
+
+    /** Cells taken from the pool, whether in use or held by a thread cache. */
+    [[nodiscard]] size_t in_use() noexcept {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return pool_.size();
+    }
+
+    [[nodiscard]] static constexpr size_t capacity() noexcept {
+      return Capacity;
+    }
+  };
+
+  /**
+   * Thread-local caching front-end for a shared allocator backend (malloc_cache_backend_t,
+   * bitmap_cache_backend_t), bound to a Backend instance with static storage duration:
+   *
+   *   static bitmap_cache_backend_t<message_t, 4096> pool;
+   *   using message_cache = thread_cache_t<pool>;
+   *
+   *   void *msg = message_cache::allocate(sizeof(message_t));
+   *   message_cache::deallocate(msg);  // From any thread
+   *
+   * Each thread keeps one freelist per size class. An empty freelist is refilled with a batch of
+   * blocks from the backend, and a freelist holding more than two batches gives one back, so the
+   * backend (and its lock) is reached once per batch rather than once per call.
+   * \n
+   * A block freed by a thread other than its owner is pushed onto the owner's remote-free queue, a
+   * lock-free multiple-producer single-consumer stack, which the owner drains into its freelists
+   * when one of them runs empty. Freelists of a thread that exits go back to the backend; its
+   * cache stays registered, so that blocks freed remotely afterwards are taken over by the next
+   * thread. Caches are never released: their number is the peak number of threads.
+   * \n
+   * Every block has a 16-byte thread_cache_header_t in front of it, and blocks are 16-byte aligned.
+   */
+  template<auto &Backend>
+  class thread_cache_t {
+    using backend_t = remove_reference_t<decltype(Backend)>;
+
+  public:
+    static constexpr size_t header_size = sizeof(thread_cache_header_t);
+    static constexpr size_t num_classes = backend_t::num_classes;
+    static constexpr size_t max_batch   = 64;
+
+  protected:
+    struct node_t {
+      node_t *next;
+    };
+
+    struct local_t {
+      node_t               *bins[num_classes];
+      uint32_t              counts[num_classes];
+      std::atomic<node_t *> remote;  // Blocks freed by other threads
+      local_t              *next;    // Next abandoned cache
+    };
+
+    struct registry_t {
+      std::mutex mutex;
+      local_t   *abandoned = nullptr;
+    };
+
+    struct holder_t {
+      local_t *local;
+
+      holder_t() noexcept : local(_adopt()) {}
+
+      ~holder_t() noexcept {
+        current = nullptr;
+        exited  = true;
+        _abandon(local);
+      }
+    };
+
+    static inline thread_local local_t *current = nullptr;
+    static inline thread_local bool     exited  = false;
+
+  public:
+    /**
+     * @return A 16-byte aligned block of at least n bytes, or nullptr if n is 0 or the backend is exhausted
+     */
+    [[nodiscard]] static void *allocate(const size_t n) noexcept {
+      if (n == 0) return nullptr;
+
+      local_t *local = _local();
+      if (UNLIKELY(n > backend_t::max_size || is_nullptr(local))) return _allocate_uncached(n);
+
+      const size_t c    = backend_t::class_of(n);
+      node_t      *node = local->bins[c];
+
+      if (UNLIKELY(is_nullptr(node))) {
+        node = _refill(local, c);
+        if (is_nullptr(node)) return nullptr;
+      }
+
+      local->bins[c] = node->next;
+      --local->counts[c];
+      return node;
+    }
+
+    /**
+     * Frees a block from allocate() or reallocate(), from any thread; nullptr is ignored.
+     */
+    static void deallocate(void *ptr) noexcept {
+      if (is_nullptr(ptr)) return;
+
+      thread_cache_header_t *header = _header(ptr);
+      auto                  *owner  = static_cast<local_t *>(header->owner);
+      auto                  *node   = static_cast<node_t *>(ptr);
+
+      if (UNLIKELY(is_nullptr(owner))) {
+        Backend.deallocate_uncached(header);
+      } else if (LIKELY(owner == current)) {
+        _push(owner, header->size_class, node);
+      } else {
+        node_t *head = owner->remote.load(std::memory_order_relaxed);
+        do {
+          node->next = head;
+        } while (!owner->remote.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+      }
+    }
+
+    /**
+     * Resizes a block, keeping min(old, n) bytes. Stays in place when the size class does not
+     * change. A size of 0 frees the block and returns nullptr; on failure, returns nullptr and
+     * the block is kept.
+     */
+    [[nodiscard]] static void *reallocate(void *ptr, const size_t n) noexcept {
+      if (is_nullptr(ptr)) return allocate(n);
+
+      if (n == 0) {
+        deallocate(ptr);
+        return nullptr;
+      }
+
+      const size_t old_size = usable_size(ptr);
+      if (n <= old_size && n <= backend_t::max_size && !is_nullptr(_header(ptr)->owner) &&
+          backend_t::class_of(n) == _header(ptr)->size_class)
+        return ptr;
+
+      void *block = allocate(n);
+      if (block) {
+        memcpy(block, ptr, n < old_size ? n : old_size);
+        deallocate(ptr);
+      }
+      return block;
+    }
+
+    /** Usable size of a block from allocate(). */
+    [[nodiscard]] static size_t usable_size(const void *ptr) noexcept {
+      const thread_cache_header_t *header = _header(ptr);
+      return is_nullptr(header->owner) ? header->size_class : backend_t::class_size(header->size_class);
+    }
+
+    /** Blocks held by the freelists of the calling thread. */
+    [[nodiscard]] static size_t cached() noexcept {
+      size_t count = 0;
+      if (current)
+        for (const uint32_t n: current->counts) count += n;
+      return count;
+    }
+
+    /**
+     * Allocator for template<typename> class parameters, a drop-in replacement for
+     * default_allocator_t. Like default_allocator_t, allocations are zero-filled.
+     */
+    template<typename Tp>
+    class type : public allocator_t<type, Tp> {
+    protected:
+      friend class allocator_t<type, Tp>;
+
+    public:
+      FORCE_INLINE static Tp *impl_allocate(const size_t n = 1) noexcept {
+        void *p_mem = thread_cache_t::allocate(n * sizeof(Tp));
+        if (p_mem) memset(p_mem, 0, n * sizeof(Tp));
+        return static_cast<Tp *>(p_mem);
+      }
+
+      FORCE_INLINE static constexpr Tp *impl_allocate_inplace(Tp &dst, const size_t) noexcept {
+        return &dst;
+      }
+
+      FORCE_INLINE static constexpr Tp *impl_allocate_inplace(Tp *dst, const size_t) noexcept {
+        return dst;
+      }
+
+      FORCE_INLINE static Tp *impl_reallocate(Tp *object, const size_t n) noexcept {
+        return static_cast<Tp *>(thread_cache_t::reallocate(object, n * sizeof(Tp)));
+      }
+
+      FORCE_INLINE static void impl_deallocate(Tp *object) noexcept {
+        thread_cache_t::deallocate(object);
+      }
+    };
+
+  protected:
+    FORCE_INLINE static thread_cache_header_t *_header(const void *ptr) noexcept {
+      return reinterpret_cast<thread_cache_header_t *>(const_cast<unsigned char *>(static_cast<const unsigned char *>(ptr)) - header_size);
+    }
+
+    FORCE_INLINE static void *_payload(void *block) noexcept {
+      return static_cast<unsigned char *>(block) + header_size;
+    }
+
+    static constexpr size_t _batch(const size_t c) noexcept {
+      const size_t n = 8192 / backend_t::class_size(c);
+      return n < 4 ? 4 : n > max_batch ? max_batch : n;
+    }
+
+    static registry_t &_registry() noexcept {
+      static registry_t registry;
+      return registry;
+    }
+
+    FORCE_INLINE static local_t *_local() noexcept {
+      if (LIKELY(!is_nullptr(current)) || exited) return current;
+
+      static thread_local holder_t holder;
+      current = holder.local;
+      return current;
+    }
+
+    static void *_allocate_uncached(const size_t n) noexcept {
+      void *block = Backend.allocate_uncached(n);
+      if (is_nullptr(block)) return nullptr;
+
+      auto *header       = static_cast<thread_cache_header_t *>(block);
+      header->owner      = nullptr;
+      header->size_class = n;
+      return _payload(block);
+    }
+
+    FORCE_INLINE static void _push(local_t *local, const size_t c, node_t *node) noexcept {
+      node->next      = local->bins[c];
+      local->bins[c]  = node;
+
+      if (UNLIKELY(++local->counts[c] > 2 * _batch(c))) _flush(local, c, _batch(c));
+    }
+
+    static node_t *_refill(local_t *local, const size_t c) noexcept {
+      if (!is_nullptr(local->remote.load(std::memory_order_relaxed))) {
+        _drain(local);
+        if (!is_nullptr(local->bins[c])) return local->bins[c];
+      }
+
+      void        *blocks[max_batch];
+      const size_t n = Backend.refill(c, blocks, _batch(c));
+
+      for (size_t i = 0; i < n; ++i) {
+        auto *header       = static_cast<thread_cache_header_t *>(blocks[i]);
+        header->owner      = local;
+        header->size_class = c;
+
+        auto *node         = static_cast<node_t *>(_payload(blocks[i]));
+        node->next         = local->bins[c];
+        local->bins[c]     = node;
+      }
+
+      local->counts[c] += static_cast<uint32_t>(n);
+      return local->bins[c];
+    }
+
+    static void _flush(local_t *local, const size_t c, size_t n) noexcept {
+      void *blocks[max_batch];
+
+      while (n && local->bins[c]) {
+        size_t k = 0;
+        for (; k < n && k < max_batch && local->bins[c]; ++k) {
+          blocks[k]      = _header(local->bins[c]);
+          local->bins[c] = local->bins[c]->next;
+        }
+
+        local->counts[c] -= static_cast<uint32_t>(k);
+        Backend.flush(c, blocks, k);
+        n -= k;
+      }
+    }
+
+    static void _drain(local_t *local) noexcept {
+      node_t *node = local->remote.exchange(nullptr, std::memory_order_acquire);
+
+      while (node) {
+        node_t *next = node->next;
+        _push(local, _header(node)->size_class, node);
+        node = next;
+      }
+    }
+
+    static local_t *_adopt() noexcept {
+      registry_t &registry = _registry();
+      local_t    *local    = nullptr;
+
+      {
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        if ((local = registry.abandoned)) registry.abandoned = local->next;
+      }
+
+      if (is_nullptr(local)) {
+        local = new local_t{};
+      } else {
+        _drain(local);
+      }
+      return local;
+    }
+
+    static void _abandon(local_t *local) noexcept {
+      _drain(local);
+      for (size_t c = 0; c < num_classes; ++c) _flush(local, c, local->counts[c]);
+
+      registry_t                 &registry = _registry();
+      std::lock_guard<std::mutex> lock(registry.mutex);
+      local->next        = registry.abandoned;
+      registry.abandoned = local;
+    }
+  };
+
+  inline malloc_cache_backend_t malloc_cache_backend;
+
+  /**
+   * thread_cache_t in front of malloc(), for blocks of any size.
+   */
+  using malloc_thread_cache_t = thread_cache_t<malloc_cache_backend>;
+}  // namespace memory
+
+using namespace memory;
+
+LIB_XCORE_END_NAMESPACE
+
+#endif  //LIB_XCORE_MEMORY_THREAD_CACHE_HPP
@@ -0,0 +1,334 @@
+#ifndef LIB_XCORE_MEMORY_TRACKING_ALLOCATOR_HPP
+#define LIB_XCORE_MEMORY_TRACKING_ALLOCATOR_HPP
+
+#include "internal/macros.hpp"
+#include "core/ported_type_traits.hpp"
+#include "memory/allocator.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/*
+ * Set to 0 to compile tracking out: tracking_allocator_form_t<Base, Tag>::type is then Base
+ * itself, and no statistics are collected.
+ */
+#ifndef XCORE_ALLOCATION_TRACKING
+#  define XCORE_ALLOCATION_TRACKING 1
+#endif
+
+LIB_XCORE_BEGIN_NAMESPACE
+
+namespace memory {
+  template<typename Tp, template<typename> class Base, typename Tag>
+  class tracking_allocator_t;
+}  // namespace memory
+
+namespace detail {
+  template<typename Allocator>
+  struct allocator_alignment : integral_constant<size_t, 16> {};
+
+  template<typename Tp, size_t Alignment>
+  struct allocator_alignment<memory::basic_aligned_allocator_t<Tp, Alignment>> : integral_constant<size_t, Alignment> {};
+
+  template<template<typename> class Base, typename Tag>
+  struct tracking_allocator_bind_t {
+    template<typename Tp>
+    using type = memory::tracking_allocator_t<Tp, Base, Tag>;
+  };
+}  // namespace detail
+
+namespace memory {
+  /**
+   * Tag of allocations made through tracking_allocator_form_t without a tag of their own. A tag
+   * is any type with a static name, e.g.:
+   *
+   *   struct telemetry_tag { static constexpr const char *name = "telemetry"; };
+   */
+  struct default_allocation_tag {
+    static constexpr const char *name = "default";
+  };
+
+  /**
+   * Plain copy of the counters of an allocation_stats_t.
+   */
+  struct allocation_snapshot_t {
+    static constexpr size_t num_buckets = 16;
+
+    const char *name;
+    size_t      live_bytes;
+    size_t      peak_bytes;
+    size_t      live_blocks;
+    size_t      allocations;
+    size_t      reallocations;
+    size_t      deallocations;
+    size_t      failures;
+    size_t      histogram[num_buckets];  // Allocations by size, see bucket_limit()
+
+    /** Largest size counted in bucket b (the last bucket has no limit). */
+    [[nodiscard]] static constexpr size_t bucket_limit(const size_t b) noexcept {
+      return b + 1 < num_buckets ? size_t(16) << b : static_cast<size_t>(-1);
+    }
+
+    /** Bucket of an allocation of n bytes: up to 16 bytes, then one per power of 2. */
+    [[nodiscard]] static constexpr size_t bucket_of(const size_t n) noexcept {
+      if (n <= 16) return 0;
+      const auto b = static_cast<size_t>(64 - __builtin_clzll(static_cast<unsigned long long>(n - 1)) - 4);
+      return b < num_buckets ? b : num_buckets - 1;
+    }
+
+    /**
+     * Writes the snapshot as a JSON object through a json_writer_t.
+     */
+    template<typename Writer>
+    Writer &to_json(Writer &writer) const {
+      writer.begin_object()
+        .member("name", name)
+        .member("live_bytes", live_bytes)
+        .member("peak_bytes", peak_bytes)
+        .member("live_blocks", live_blocks)
+        .member("allocations", allocations)
+        .member("reallocations", reallocations)
+        .member("deallocations", deallocations)
+        .member("failures", failures);
+
+      writer.key("histogram").begin_array();
+      for (size_t b = 0; b < num_buckets; ++b) {
+        if (!histogram[b]) continue;
+        writer.begin_object();
+        if (b + 1 < num_buckets) writer.member("le", bucket_limit(b));
+        else writer.member("le", nullptr);
+        writer.member("count", histogram[b]).end_object();
+      }
+      writer.end_array();
+
+      return writer.end_object();
+    }
+  };
+
+  /**
+   * Counters of the allocations of one tag, updated with relaxed atomic operations. Every
+   * instance registers itself on construction, see for_each() and write_allocation_stats().
+   */
+  class allocation_stats_t {
+  protected:
+    const char                       *name_;
+    std::atomic<size_t>               live_bytes_{0};
+    std::atomic<size_t>               peak_bytes_{0};
+    std::atomic<size_t>               live_blocks_{0};
+    std::atomic<size_t>               allocations_{0};
+    std::atomic<size_t>               reallocations_{0};
+    std::atomic<size_t>               deallocations_{0};
+    std::atomic<size_t>               failures_{0};
+    std::atomic<size_t>               histogram_[allocation_snapshot_t::num_buckets]{};
+    allocation_stats_t               *next_;
+
+    static inline std::atomic<allocation_stats_t *> registry_{nullptr};
+
+  public:
+    explicit allocation_stats_t(const char *name) noexcept : name_(name), next_(registry_.load(std::memory_order_relaxed)) {
+      while (!registry_.compare_exchange_weak(next_, this, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    allocation_stats_t(const allocation_stats_t &)            = delete;
+    allocation_stats_t &operator=(const allocation_stats_t &) = delete;
+
+    void record_allocate(const size_t bytes) noexcept {
+      allocations_.fetch_add(1, std::memory_order_relaxed);
+      live_blocks_.fetch_add(1, std::memory_order_relaxed);
+      histogram_[allocation_snapshot_t::bucket_of(bytes)].fetch_add(1, std::memory_order_relaxed);
+      _grow(bytes);
+    }
+
+    void record_reallocate(const size_t old_bytes, const size_t new_bytes) noexcept {
+      reallocations_.fetch_add(1, std::memory_order_relaxed);
+      histogram_[allocation_snapshot_t::bucket_of(new_bytes)].fetch_add(1, std::memory_order_relaxed);
+
+      if (new_bytes >= old_bytes) _grow(new_bytes - old_bytes);
+      else live_bytes_.fetch_sub(old_bytes - new_bytes, std::memory_order_relaxed);
+    }
+
+    void record_deallocate(const size_t bytes) noexcept {
+      deallocations_.fetch_add(1, std::memory_order_relaxed);
+      live_blocks_.fetch_sub(1, std::memory_order_relaxed);
+      live_bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+    void record_failure() noexcept {
+      failures_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] const char *name() const noexcept {
+      return name_;
+    }
+
+    [[nodiscard]] size_t live_bytes() const noexcept {
+      return live_bytes_.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] size_t peak_bytes() const noexcept {
+      return peak_bytes_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @return A copy of the counters; each counter is exact, but they are read one after another
+     */
+    [[nodiscard]] allocation_snapshot_t snapshot() const noexcept {
+      allocation_snapshot_t s{};
+      s.name          = name_;
+      s.live_bytes    = live_bytes_.load(std::memory_order_relaxed);
+      s.peak_bytes    = peak_bytes_.load(std::memory_order_relaxed);
+      s.live_blocks   = live_blocks_.load(std::memory_order_relaxed);
+      s.allocations   = allocations_.load(std::memory_order_relaxed);
+      s.reallocations = reallocations_.load(std::memory_order_relaxed);
+      s.deallocations = deallocations_.load(std::memory_order_relaxed);
+      s.failures      = failures_.load(std::memory_order_relaxed);
+      for (size_t b = 0; b < allocation_snapshot_t::num_buckets; ++b)
+        s.histogram[b] = histogram_[b].load(std::memory_order_relaxed);
+      return s;
+    }
+
+    /**
+     * Starts a new measurement: the peak restarts from the live bytes, the other counters from 0.
+     */
+    void reset() noexcept {
+      peak_bytes_.store(live_bytes_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      allocations_.store(0, std::memory_order_relaxed);
+      reallocations_.store(0, std::memory_order_relaxed);
+      deallocations_.store(0, std::memory_order_relaxed);
+      failures_.store(0, std::memory_order_relaxed);
+      for (auto &bucket: histogram_) bucket.store(0, std::memory_order_relaxed);
+    }
+
+    /** Calls func(const allocation_stats_t &) for every registered tag, most recent first. */
+    template<typename Func>
+    static void for_each(Func &&func) {
+      for (const allocation_stats_t *s = registry_.load(std::memory_order_acquire); s; s = s->next_) func(*s);
+    }
+
+  protected:
+    void _grow(const size_t bytes) noexcept {
+      const size_t live = live_bytes_.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+      size_t       peak = peak_bytes_.load(std::memory_order_relaxed);
+      while (live > peak && !peak_bytes_.compare_exchange_weak(peak, live, std::memory_order_relaxed));
+    }
+  };
+
+  /**
+   * Counters of a tag, registered on first use.
+   */
+  template<typename Tag = default_allocation_tag>
+  allocation_stats_t &allocation_stats() noexcept {
+    static allocation_stats_t stats(Tag::name);
+    return stats;
+  }
+
+  /**
+   * Writes the snapshots of every registered tag as a JSON array through a json_writer_t.
+   */
+  template<typename Writer>
+  Writer &write_allocation_stats(Writer &writer) {
+    writer.begin_array();
+    allocation_stats_t::for_each([&](const allocation_stats_t &stats) { stats.snapshot().to_json(writer); });
+    return writer.end_array();
+  }
+
+  /**
+   * Allocator counting the allocations of Base under Tag. Each block carries a header with its
+   * size in front of it (16 bytes, or the alignment of Tp or of an aligned Base if larger), so
+   * that deallocation knows how many bytes go away. Use it through tracking_allocator_form_t.
+   *
+   *   struct telemetry_tag { static constexpr const char *name = "telemetry"; };
+   *   template<typename Tp> using tracked = tracking_allocator_form_t<default_allocator_t, telemetry_tag>::type<Tp>;
+   *
+   *   dynamic_array_t<float, 0, tracked> samples(1000);
+   *   allocation_stats<telemetry_tag>().live_bytes();  // 4000
+   */
+  template<typename Tp, template<typename> class Base, typename Tag>
+  class tracking_allocator_t
+      : public allocator_t<LIB_XCORE_NAMESPACE::detail::tracking_allocator_bind_t<Base, Tag>::template type, Tp> {
+  protected:
+    friend class allocator_t<LIB_XCORE_NAMESPACE::detail::tracking_allocator_bind_t<Base, Tag>::template type, Tp>;
+
+    using byte_allocator = Base<unsigned char>;
+
+    static constexpr size_t base_alignment = LIB_XCORE_NAMESPACE::detail::allocator_alignment<byte_allocator>::value;
+    static constexpr size_t header_size    = base_alignment > alignof(Tp) ? base_alignment : alignof(Tp);
+
+    FORCE_INLINE static unsigned char *_block(Tp *object) noexcept {
+      return reinterpret_cast<unsigned char *>(object) - header_size;
+    }
+
+    FORCE_INLINE static size_t &_size(unsigned char *block) noexcept {
+      return *reinterpret_cast<size_t *>(block);
+    }
+
+  public:
+    FORCE_INLINE static Tp *impl_allocate(const size_t n = 1) noexcept {
+      const size_t   bytes = n * sizeof(Tp);
+      unsigned char *block = byte_allocator::allocate(header_size + bytes);
+
+      if (is_nullptr(block)) {
+        allocation_stats<Tag>().record_failure();
+        return nullptr;
+      }
+
+      _size(block) = bytes;
+      allocation_stats<Tag>().record_allocate(bytes);
+      return reinterpret_cast<Tp *>(block + header_size);
+    }
+
+    FORCE_INLINE static constexpr Tp *impl_allocate_inplace(Tp &dst, const size_t) noexcept {
+      return &dst;
+    }
+
+    FORCE_INLINE static constexpr Tp *impl_allocate_inplace(Tp *dst, const size_t) noexcept {
+      return dst;
+    }
+
+    static Tp *impl_reallocate(Tp *object, const size_t n) noexcept {
+      if (is_nullptr(object)) return impl_allocate(n);
+
+      const size_t   old_bytes = _size(_block(object));
+      const size_t   bytes     = n * sizeof(Tp);
+      unsigned char *block     = byte_allocator::reallocate(_block(object), header_size + bytes);
+
+      if (is_nullptr(block)) {
+        allocation_stats<Tag>().record_failure();
+        return nullptr;
+      }
+
+      _size(block) = bytes;
+      allocation_stats<Tag>().record_reallocate(old_bytes, bytes);
+      return reinterpret_cast<Tp *>(block + header_size);
+    }
+
+    FORCE_INLINE static void impl_deallocate(Tp *object) noexcept {
+      if (is_nullptr(object)) return;
+
+      allocation_stats<Tag>().record_deallocate(_size(_block(object)));
+      byte_allocator::deallocate(_block(object));
+    }
+  };
+
+  /**
+   * Binds Base and Tag of tracking_allocator_t, for parameters expecting template<typename> class,
+   * e.g. heap_array_t<float, 8, tracking_allocator_form_t<aligned_allocator_t, dsp_tag>::type>.
+   * With XCORE_ALLOCATION_TRACKING set to 0, type is Base itself.
+   */
+  template<template<typename> class Base = default_allocator_t, typename Tag = default_allocation_tag>
+  struct tracking_allocator_form_t {
+#if XCORE_ALLOCATION_TRACKING
+    template<typename Tp>
+    using type = tracking_allocator_t<Tp, Base, Tag>;
+#else
+    template<typename Tp>
+    using type = Base<Tp>;
+#endif
+  };
+}  // namespace memory
+
+using namespace memory;
+
+LIB_XCORE_END_NAMESPACE
+
+#endif  //LIB_XCORE_MEMORY_TRACKING_ALLOCATOR_HPP
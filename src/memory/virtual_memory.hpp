@@ -19,7 +19,13 @@ namespace memory {
      * The region will not check for illegal accesses for the sake of performance only but not safety.
      * \n
      * Also, it is easier to clear the region if you know that any memory tied to the region
-     * will not be used later in the program.
+     * will not be used later in the program, or to rewind it to a marker taken earlier:
+     *
+     *   {
+     *     auto scope = region.scope();  // Everything allocated below is released at the end of the block
+     *     char *line = region.allocate_ptr<char>(256);
+     *     ...
+     *   }
      *
      * +--------------------------+ <--- bp (begin, high address)
      * |                          |
@@ -31,32 +37,104 @@ namespace memory {
      * |                          |
      * +--------------------------+ <--- region_limit (end, low address)
      *
+     * In chained mode, an allocation that does not fit in the region goes to an extra block of
+     * twice the size of the previous one (or more, if the allocation needs it) taken from
+     * base_allocator_t, instead of failing. Blocks are given back when the region is rewound
+     * below them, except for the largest one, which is kept for the next overflow: a region
+     * cleared every frame stops calling the allocator once it has seen its largest frame.
+     * \n
+     * The region also counts, until reset_stats(), the largest size() reached (high_water_mark())
+     * and the number of allocations that did not fit in the current block (overflow_count()),
+     * which is the hint for sizing NumBytes.
+     *
      * @tparam NumBytes             Number of total bytes to be allocated (will be aligned to alignment)
      * @tparam Alignment            Alignment of allocation/de-allocation (should be >= machine's alignment and
      *                              is a power of 2.)
-     * @tparam base_allocator_t     Memory allocator to be used to pre-allocate
+     * @tparam base_allocator_t     Memory allocator to be used to pre-allocate (use aligned_allocator_t when
+     *                              Alignment exceeds the alignment guaranteed by malloc)
+     * @tparam Chained              Grow with extra blocks instead of returning nullptr when the region is full
      */
-  template<size_t NumBytes, size_t Alignment = sizeof(void *), template<typename, size_t = 0> class base_allocator_t = malloc_allocator_t>
+  template<size_t NumBytes, size_t Alignment = sizeof(void *), template<typename> class base_allocator_t = malloc_allocator_t,
+           bool Chained = false>
   class virtual_stack_region_t {
   protected:
     using byte_t                          = uint8_t;
-    using byte_allocator                  = base_allocator_t<byte_t, Alignment>;
+    using byte_allocator                  = base_allocator_t<byte_t>;
 
     static constexpr size_t SizeRequested = NumBytes;
     static constexpr size_t SizeActual    = nearest_alignment<byte_t, Alignment>(NumBytes);
     static constexpr size_t NumAlignments = SizeActual / Alignment;
 
+    // Header of an extra block in chained mode, followed by the block's own stack
+    struct block_t {
+      block_t *prev;
+      byte_t  *prev_sp;  // sp in the previous block when this one was entered
+      size_t   size;     // Bytes of the block, header included
+      size_t   base;     // size() when this one was entered
+    };
+
+    static constexpr size_t HeaderSize = nearest_alignment<block_t, Alignment>();
+
     byte_t                 *bp;
     byte_t                 *sp;
     byte_t                 *region_limit;
 
+    // Bounds of the current block, the region itself unless chained
+    byte_t                 *top;
+    byte_t                 *limit;
+    block_t                *block;
+    block_t                *spare;
+    size_t                  base;
+
+    size_t                  high_water;
+    size_t                  overflows;
+
   public:
+    /**
+     * A position of the region, see marker() and rewind().
+     */
+    struct marker_t {
+      byte_t  *sp;
+      block_t *block;
+    };
+
+    /**
+     * Rewinds the region, on destruction, to where it was on construction.
+     */
+    class scope_marker {
+    protected:
+      virtual_stack_region_t &region_;
+      const marker_t          marker_;
+
+    public:
+      explicit scope_marker(virtual_stack_region_t &region) noexcept : region_(region), marker_(region.marker()) {}
+
+      scope_marker(const scope_marker &)            = delete;
+      scope_marker &operator=(const scope_marker &) = delete;
+
+      ~scope_marker() noexcept {
+        region_.rewind(marker_);
+      }
+    };
+
     virtual_stack_region_t() noexcept : region_limit{byte_allocator::allocate(SizeActual)} {
-      bp = region_limit + SizeActual;
-      sp = bp;
+      bp         = region_limit + SizeActual;
+      sp         = bp;
+      top        = bp;
+      limit      = region_limit;
+      block      = nullptr;
+      spare      = nullptr;
+      base       = 0;
+      high_water = 0;
+      overflows  = 0;
     }
 
+    virtual_stack_region_t(const virtual_stack_region_t &)            = delete;
+    virtual_stack_region_t &operator=(const virtual_stack_region_t &) = delete;
+
     ~virtual_stack_region_t() noexcept {
+      clear();
+      if (spare) byte_allocator::deallocate(reinterpret_cast<byte_t *>(spare));
       byte_allocator::deallocate(region_limit);
     }
 
@@ -66,7 +144,7 @@ namespace memory {
 
     template<typename T>
     [[nodiscard]] T *construct_ptr(const size_t n = 1) noexcept {
-      const T *ptr = allocate_ptr<T>(n);
+      T *ptr = allocate_ptr<T>(n);
       return is_nullptr(ptr) ? nullptr : new_allocator_t<T>::allocate_inplace(ptr, n);
     }
 
@@ -87,12 +165,13 @@ namespace memory {
 
     template<typename T>
     [[nodiscard]] T *allocate_ptr(const size_t n = 1) noexcept {
-      byte_t *nsp = sp - nearest_alignment<T, Alignment>(n);
+      const size_t to_incr = nearest_alignment<T, Alignment>(n);
 
       // Check for region overflow
-      if (nsp < region_limit) return nullptr;
+      if (UNLIKELY(static_cast<size_t>(sp - limit) < to_incr)) return reinterpret_cast<T *>(_overflow(to_incr));
 
-      sp = nsp;
+      sp -= to_incr;
+      _update_high_water();
       return reinterpret_cast<T *>(sp);
     }
 
@@ -101,6 +180,9 @@ namespace memory {
       return *allocate_ptr<T>(n);
     }
 
+    /**
+     * Allocates without any check nor statistics: the caller knows that the current block has room.
+     */
     template<typename T>
     [[nodiscard]] T *allocate_ptr_unsafe(const size_t n = 1) noexcept {
       sp -= nearest_alignment<T, Alignment>(n);
@@ -116,12 +198,17 @@ namespace memory {
     void deallocate(const size_t n = 1) noexcept {
       const size_t to_decr = nearest_alignment<T, Alignment>(n);
 
-      ASSUME(bp >= sp);
+      ASSUME(top >= sp);
 
-      if (bp - sp < to_decr) {
+      if (static_cast<size_t>(top - sp) < to_decr) {
         clear();
       } else {
         sp += to_decr;
+
+        // The first allocation of an extra block is gone: go back to the previous block
+        if constexpr (Chained) {
+          if (block && sp == top) _pop_block();
+        }
       }
     }
 
@@ -130,20 +217,154 @@ namespace memory {
       sp += nearest_alignment<T, Alignment>(n);
     }
 
-    FORCE_INLINE void              clear() noexcept { sp = bp; }
+    /**
+     * @return The current position, to be given back to rewind()
+     */
+    [[nodiscard]] FORCE_INLINE marker_t marker() const noexcept {
+      return {sp, block};
+    }
+
+    /**
+     * Releases at once everything allocated since marker m was taken. Markers must be rewound
+     * in LIFO order; a marker taken after m is invalid afterwards.
+     */
+    FORCE_INLINE void rewind(const marker_t &m) noexcept {
+      if constexpr (Chained) {
+        while (block != m.block) _pop_block();
+      }
+      sp = m.sp;
+    }
+
+    /**
+     * @return A scope_marker rewinding the region at the end of the enclosing scope
+     */
+    [[nodiscard]] scope_marker scope() noexcept {
+      return scope_marker(*this);
+    }
+
+    FORCE_INLINE void clear() noexcept {
+      if constexpr (Chained) {
+        while (block) _pop_block();
+      }
+      sp = bp;
+    }
+
+    /**
+     * Starts a new statistics period (e.g. a frame) from the current size().
+     */
+    void reset_stats() noexcept {
+      high_water = size();
+      overflows  = 0;
+    }
+
+    /** Largest size() since construction or the last reset_stats(). */
+    [[nodiscard]] constexpr size_t high_water_mark() const noexcept {
+      return high_water;
+    }
+
+    /** Allocations that did not fit in the current block since construction or the last reset_stats(). */
+    [[nodiscard]] constexpr size_t overflow_count() const noexcept {
+      return overflows;
+    }
+
+    /** Extra blocks currently chained to the region. */
+    [[nodiscard]] size_t chained_blocks() const noexcept {
+      size_t count = 0;
+      for (const block_t *b = block; b; b = b->prev) ++count;
+      return count;
+    }
 
     [[nodiscard]] constexpr size_t size() const noexcept {
-      return bp - sp;
+      return base + (top - sp);
     }
 
+    /** Bytes allocated plus bytes left in the current block. */
     [[nodiscard]] constexpr size_t capacity() const noexcept {
-      return bp - region_limit;
+      return size() + remaining();
     }
 
+    /** Bytes left in the current block. */
     [[nodiscard]] constexpr size_t remaining() const noexcept {
-      return sp - region_limit;
+      return sp - limit;
+    }
+
+  protected:
+    FORCE_INLINE void _update_high_water() noexcept {
+      const size_t used = size();
+      if (used > high_water) high_water = used;
+    }
+
+    NO_INLINE byte_t *_overflow(const size_t to_incr) noexcept {
+      ++overflows;
+
+      if constexpr (Chained) {
+        return _push_block(to_incr);
+      } else {
+        return nullptr;
+      }
+    }
+
+    byte_t *_push_block(const size_t to_incr) noexcept {
+      block_t *next = spare;
+
+      if (next && next->size - HeaderSize >= to_incr) {
+        spare = nullptr;
+      } else {
+        const size_t grown = 2 * (block ? block->size : SizeActual);
+        const size_t needed = nearest_alignment<byte_t, Alignment>(HeaderSize + to_incr);
+        const size_t bytes  = needed > grown ? needed : grown;
+
+        next = reinterpret_cast<block_t *>(byte_allocator::allocate(bytes));
+        if (is_nullptr(next)) return nullptr;
+
+        next->size = bytes;
+      }
+
+      next->prev    = block;
+      next->prev_sp = sp;
+      next->base    = size();
+
+      block         = next;
+      base          = next->base;
+      top           = reinterpret_cast<byte_t *>(next) + next->size;
+      limit         = reinterpret_cast<byte_t *>(next) + HeaderSize;
+      sp            = top - to_incr;
+
+      _update_high_water();
+      return sp;
+    }
+
+    void _pop_block() noexcept {
+      block_t *last = block;
+
+      block         = last->prev;
+      sp            = last->prev_sp;
+
+      if (block) {
+        base  = block->base;
+        top   = reinterpret_cast<byte_t *>(block) + block->size;
+        limit = reinterpret_cast<byte_t *>(block) + HeaderSize;
+      } else {
+        base  = 0;
+        top   = bp;
+        limit = region_limit;
+      }
+
+      // Keep the largest block for the next overflow
+      if (spare && spare->size >= last->size) {
+        byte_allocator::deallocate(reinterpret_cast<byte_t *>(last));
+      } else {
+        if (spare) byte_allocator::deallocate(reinterpret_cast<byte_t *>(spare));
+        spare = last;
+      }
     }
   };
+
+  /**
+   * A virtual_stack_region_t growing with extra blocks instead of failing once full.
+   */
+  template<size_t NumBytes, size_t Alignment = sizeof(void *), template<typename> class base_allocator_t = malloc_allocator_t>
+  using chained_stack_region_t = virtual_stack_region_t<NumBytes, Alignment, base_allocator_t, true>;
 }  // namespace memory
 
 using namespace memory;
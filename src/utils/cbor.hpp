@@ -0,0 +1,736 @@
+#ifndef LIB_XCORE_UTILS_CBOR_HPP
+#define LIB_XCORE_UTILS_CBOR_HPP
+
+#include "internal/macros.hpp"
+#include "core/ported_config.hpp"
+#include "core/ported_std.hpp"
+#include "core/ported_optional.hpp"
+#include "core/ported_string_view.hpp"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+LIB_XCORE_BEGIN_NAMESPACE
+
+namespace impl {
+  template<typename T, size_t Size>
+  class numeric_vector_static_t;
+
+  template<typename T, size_t Row, size_t Col>
+  class numeric_matrix_static_t;
+}  // namespace impl
+
+namespace detail {
+  constexpr uint8_t cbor_unsigned = 0;
+  constexpr uint8_t cbor_negative = 1;
+  constexpr uint8_t cbor_bytes    = 2;
+  constexpr uint8_t cbor_text     = 3;
+  constexpr uint8_t cbor_array    = 4;
+  constexpr uint8_t cbor_map      = 5;
+  constexpr uint8_t cbor_tag      = 6;
+  constexpr uint8_t cbor_simple   = 7;
+
+  /** Tag of a row-major multi-dimensional array [[dims...], elements] (RFC 8746). */
+  constexpr uint64_t cbor_tag_row_major = 40;
+
+  constexpr bool cbor_host_little_endian = __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
+
+  /**
+   * RFC 8746 typed array tag for elements of type T in host byte order:
+   * 0b010 f s e ll with f = floating point, s = signed, e = little-endian
+   * and ll = log2 of the size (minus one for floating points).
+   */
+  template<typename T>
+  constexpr uint8_t cbor_typed_array_tag() {
+    static_assert((is_integral_v<T> || is_floating_point_v<T>) && !is_same_v<T, bool>, "Typed arrays hold integers or floating points.");
+    static_assert(!is_floating_point_v<T> || sizeof(T) == 4 || sizeof(T) == 8, "Only float and double are supported.");
+
+    constexpr uint8_t ll = sizeof(T) == 1 ? 0 : sizeof(T) == 2 ? 1 : sizeof(T) == 4 ? 2 : 3;
+    constexpr uint8_t e  = sizeof(T) > 1 && cbor_host_little_endian ? 4 : 0;
+
+    if constexpr (is_floating_point_v<T>)
+      return static_cast<uint8_t>(0x50 | e | (ll - 1));
+    else
+      return static_cast<uint8_t>(0x40 | (is_signed_v<T> ? 8 : 0) | e | ll);
+  }
+
+  /** Element size of a typed array tag in [64, 87], 0 for other tags. */
+  constexpr size_t cbor_typed_array_element_size(const uint64_t tag) {
+    if (tag < 64 || tag > 87 || tag == 76) return 0;
+    const auto ll = static_cast<size_t>(tag & 3);
+    return tag & 0x10 ? size_t(2) << ll : size_t(1) << ll;
+  }
+
+  FORCE_INLINE uint16_t cbor_byteswap(const uint16_t v) { return __builtin_bswap16(v); }
+  FORCE_INLINE uint32_t cbor_byteswap(const uint32_t v) { return __builtin_bswap32(v); }
+  FORCE_INLINE uint64_t cbor_byteswap(const uint64_t v) { return __builtin_bswap64(v); }
+
+  template<typename U>
+  FORCE_INLINE U cbor_load_be(const unsigned char *p) {
+    U v;
+    memcpy(&v, p, sizeof(U));
+    if constexpr (cbor_host_little_endian) v = cbor_byteswap(v);
+    return v;
+  }
+
+  template<typename U>
+  FORCE_INLINE void cbor_store_be(unsigned char *p, U v) {
+    if constexpr (cbor_host_little_endian) v = cbor_byteswap(v);
+    memcpy(p, &v, sizeof(U));
+  }
+
+  inline double cbor_half_to_double(const uint16_t h) {
+    const int    exp  = (h >> 10) & 0x1F;
+    const int    mant = h & 0x3FF;
+    const double mag  = exp == 0    ? ldexp(mant, -24)
+                      : exp == 31 ? (mant ? NAN : INFINITY)
+                                  : ldexp(mant + 1024, exp - 25);
+    return h & 0x8000 ? -mag : mag;
+  }
+
+  /**
+   * Converts a float to half precision when no information is lost.
+   *
+   * @return false if the value has no exact half representation
+   */
+  inline bool cbor_float_to_half(const float f, uint16_t &out) {
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+
+    const auto     sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+    const int      exp  = static_cast<int>((bits >> 23) & 0xFF);
+    const uint32_t mant = bits & 0x7FFFFF;
+
+    if (exp == 0xFF) {
+      out = static_cast<uint16_t>(sign | 0x7C00 | (mant ? 0x200 : 0));
+      return true;
+    }
+
+    if (exp == 0 && mant == 0) {
+      out = sign;
+      return true;
+    }
+
+    const int e = exp - 127;
+    if (exp == 0 || e > 15 || e < -24) return false;
+
+    if (e >= -14) {
+      if (mant & 0x1FFF) return false;
+      out = static_cast<uint16_t>(sign | ((e + 15) << 10) | (mant >> 13));
+      return true;
+    }
+
+    // Half subnormal: m * 2^-24 == (1.mant) * 2^e
+    const uint32_t full  = mant | 0x800000;
+    const int      shift = -(e + 1);
+    if (full & ((1u << shift) - 1)) return false;
+    out = static_cast<uint16_t>(sign | (full >> shift));
+    return true;
+  }
+}  // namespace detail
+
+/**
+ * Streaming CBOR (RFC 8949) encoder. Every item goes straight to the sink: one
+ * write for its head (at most 9 bytes) and one for its payload, no heap
+ * allocation. Floating points use the shortest of half, single and double
+ * precision that preserves the value, and cost no formatting: no digits to
+ * generate on the way out, none to parse on the way in.
+ *
+ * Arrays of numbers, numeric_vector and numeric_matrix are written as RFC 8746
+ * typed arrays in host byte order: a tag, a byte string head and one memcpy of
+ * the elements. Matrices are wrapped in the row-major tag 40 with their shape.
+ *
+ * Arrays and maps have definite lengths given up front; the writer does not
+ * check that the announced number of items follows. Sink failures clear ok()
+ * and stop further output.
+ *
+ * Usage:
+ *   unsigned char out[64];
+ *   cbor_writer_t<cbor_buffer_sink_t> writer(out, sizeof(out));
+ *   writer.begin_map(2).member("id", 7).member("pos", position);
+ *
+ * @tparam Sink  Type with bool write(const char *, size_t) and bool flush(),
+ *               e.g. cbor_buffer_sink_t, json_byte_buffer_sink_t or json_fd_sink_t
+ */
+template<typename Sink>
+class cbor_writer_t {
+  Sink sink_;
+  bool ok_ = true;
+
+public:
+  template<typename... Args>
+  explicit cbor_writer_t(Args &&...args) : sink_(forward<Args>(args)...) {}
+
+  /** Starts an array; the next n items are its elements. */
+  cbor_writer_t &begin_array(const size_t n) { return _head(LIB_XCORE_NAMESPACE::detail::cbor_array, n); }
+
+  /** Starts a map; the next n pairs of items are its keys and values. */
+  cbor_writer_t &begin_map(const size_t n) { return _head(LIB_XCORE_NAMESPACE::detail::cbor_map, n); }
+
+  /** Tags the next item. */
+  cbor_writer_t &tag(const uint64_t number) { return _head(LIB_XCORE_NAMESPACE::detail::cbor_tag, number); }
+
+  cbor_writer_t &key(const char *name, const size_t len) { return value(name, len); }
+
+  cbor_writer_t &key(const char *name) { return value(name, strlen(name)); }
+
+  /** Writes a text string, which is expected to be valid UTF-8. */
+  cbor_writer_t &value(const char *str, const size_t len) {
+    _head(LIB_XCORE_NAMESPACE::detail::cbor_text, len);
+    return _write(str, len);
+  }
+
+  /** Writes a text string, or null for a null pointer. */
+  cbor_writer_t &value(const char *str) {
+    if (!str) return value(nullptr);
+    return value(str, strlen(str));
+  }
+
+  cbor_writer_t &value(const string_view str) { return value(str.data(), str.size()); }
+
+  cbor_writer_t &value(nullptr_t) { return _byte(0xF6); }
+
+  cbor_writer_t &value(const bool b) { return _byte(b ? 0xF5 : 0xF4); }
+
+  template<typename T>
+  enable_if_t<is_integral_v<T> && !is_same_v<T, bool>, cbor_writer_t &> value(const T v) {
+    if constexpr (is_signed_v<T>) {
+      if (v < 0) return _head(LIB_XCORE_NAMESPACE::detail::cbor_negative, ~static_cast<uint64_t>(static_cast<int64_t>(v)));
+    }
+    return _head(LIB_XCORE_NAMESPACE::detail::cbor_unsigned, static_cast<uint64_t>(v));
+  }
+
+  template<typename T>
+  enable_if_t<is_floating_point_v<T>, cbor_writer_t &> value(const T v) {
+    unsigned char buf[9];
+
+    const auto f = static_cast<float>(v);
+    uint16_t   half;
+
+    if (v != v) {
+      buf[0] = 0xF9;  // Canonical NaN
+      LIB_XCORE_NAMESPACE::detail::cbor_store_be<uint16_t>(buf + 1, 0x7E00);
+      return _write(buf, 3);
+    }
+
+    if (static_cast<T>(f) != v) {
+      const auto d = static_cast<double>(v);
+      uint64_t   bits;
+      memcpy(&bits, &d, sizeof(bits));
+      buf[0] = 0xFB;
+      LIB_XCORE_NAMESPACE::detail::cbor_store_be(buf + 1, bits);
+      return _write(buf, 9);
+    }
+
+    if (LIB_XCORE_NAMESPACE::detail::cbor_float_to_half(f, half)) {
+      buf[0] = 0xF9;
+      LIB_XCORE_NAMESPACE::detail::cbor_store_be(buf + 1, half);
+      return _write(buf, 3);
+    }
+
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    buf[0] = 0xFA;
+    LIB_XCORE_NAMESPACE::detail::cbor_store_be(buf + 1, bits);
+    return _write(buf, 5);
+  }
+
+  /** Writes a byte string. */
+  cbor_writer_t &bytes(const void *data, const size_t n) {
+    _head(LIB_XCORE_NAMESPACE::detail::cbor_bytes, n);
+    return _write(data, n);
+  }
+
+  /**
+   * Writes n numbers as a typed array: the elements are copied as they are in
+   * memory, the tag telling their type and byte order.
+   */
+  template<typename T>
+  cbor_writer_t &typed_array(const T *data, const size_t n) {
+    tag(LIB_XCORE_NAMESPACE::detail::cbor_typed_array_tag<T>());
+    return bytes(data, n * sizeof(T));
+  }
+
+  template<typename T, size_t Size>
+  cbor_writer_t &value(const LIB_XCORE_NAMESPACE::impl::numeric_vector_static_t<T, Size> &v) {
+    return typed_array(v.data(), Size);
+  }
+
+  /** Writes 40([[Row, Col], typed array of the entries in row-major order]). */
+  template<typename T, size_t Row, size_t Col>
+  cbor_writer_t &value(const LIB_XCORE_NAMESPACE::impl::numeric_matrix_static_t<T, Row, Col> &m) {
+    tag(LIB_XCORE_NAMESPACE::detail::cbor_tag_row_major).begin_array(2);
+    begin_array(2).value(Row).value(Col);
+    return typed_array(m.data(), Row * Col);
+  }
+
+  /** Shorthand for key(name).value(v). */
+  template<typename T>
+  cbor_writer_t &member(const char *name, T &&v) {
+    return key(name).value(forward<T>(v));
+  }
+
+  bool flush() {
+    if (!sink_.flush()) ok_ = false;
+    return ok_;
+  }
+
+  /** Clears the error state, e.g. to start a new message. */
+  void reset() { ok_ = true; }
+
+  /** Returns false after a sink failure. */
+  [[nodiscard]] bool ok() const { return ok_; }
+
+  [[nodiscard]] Sink       &sink() { return sink_; }
+  [[nodiscard]] const Sink &sink() const { return sink_; }
+
+private:
+  cbor_writer_t &_write(const void *src, const size_t n) {
+    if (ok_ && n && !sink_.write(static_cast<const char *>(src), n)) ok_ = false;
+    return *this;
+  }
+
+  cbor_writer_t &_byte(const unsigned char b) { return _write(&b, 1); }
+
+  cbor_writer_t &_head(const uint8_t major, const uint64_t arg) {
+    unsigned char buf[9];
+    const auto    ib = static_cast<unsigned char>(major << 5);
+
+    if (arg < 24) {
+      buf[0] = static_cast<unsigned char>(ib | arg);
+      return _write(buf, 1);
+    }
+    if (arg <= 0xFF) {
+      buf[0] = ib | 24;
+      buf[1] = static_cast<unsigned char>(arg);
+      return _write(buf, 2);
+    }
+    if (arg <= 0xFFFF) {
+      buf[0] = ib | 25;
+      LIB_XCORE_NAMESPACE::detail::cbor_store_be(buf + 1, static_cast<uint16_t>(arg));
+      return _write(buf, 3);
+    }
+    if (arg <= 0xFFFFFFFF) {
+      buf[0] = ib | 26;
+      LIB_XCORE_NAMESPACE::detail::cbor_store_be(buf + 1, static_cast<uint32_t>(arg));
+      return _write(buf, 5);
+    }
+    buf[0] = ib | 27;
+    LIB_XCORE_NAMESPACE::detail::cbor_store_be(buf + 1, arg);
+    return _write(buf, 9);
+  }
+};
+
+/**
+ * CBOR sink writing into a caller-provided byte array.
+ */
+class cbor_buffer_sink_t {
+  unsigned char *data_;
+  size_t         capacity_;
+  size_t         size_ = 0;
+
+public:
+  cbor_buffer_sink_t(unsigned char *data, const size_t capacity) : data_(data), capacity_(capacity) {}
+
+  bool write(const char *src, const size_t n) {
+    if (n > capacity_ - size_) return false;
+    memcpy(data_ + size_, src, n);
+    size_ += n;
+    return true;
+  }
+
+  bool flush() { return true; }
+
+  void clear() { size_ = 0; }
+
+  [[nodiscard]] const unsigned char *data() const { return data_; }
+  [[nodiscard]] size_t               size() const { return size_; }
+};
+
+enum class cbor_type : uint8_t {
+  invalid,
+  unsigned_int,
+  negative_int,
+  bytes,
+  text,
+  array,
+  map,
+  tag,
+  boolean,
+  null,
+  undefined,
+  floating,
+  simple,
+  typed_array,
+};
+
+enum class cbor_error : uint8_t {
+  ok,
+  truncated,   // Item runs past the end of the input
+  indefinite,  // Indefinite-length items are not supported
+  invalid,     // Malformed item
+};
+
+/**
+ * One decoded CBOR item. Strings and typed arrays point into the input, which
+ * must outlive the item. Arrays and maps only carry their number of entries:
+ * the entries are the next items of the reader.
+ */
+struct cbor_item_t {
+  cbor_type            type = cbor_type::invalid;
+  uint8_t              tag  = 0;  // Typed array tag
+  uint64_t             arg  = 0;  // Integer magnitude, byte length, entry count, tag number or simple value
+  double               number = 0;
+  const unsigned char *data   = nullptr;
+
+  [[nodiscard]] bool is_integer() const { return type == cbor_type::unsigned_int || type == cbor_type::negative_int; }
+
+  [[nodiscard]] bool is_number() const { return is_integer() || type == cbor_type::floating; }
+
+  /**
+   * Returns the entry count of an array or a map, the byte length of a string
+   * or the element count of a typed array.
+   */
+  [[nodiscard]] size_t size() const {
+    if (type == cbor_type::typed_array) return static_cast<size_t>(arg) / LIB_XCORE_NAMESPACE::detail::cbor_typed_array_element_size(tag);
+    return static_cast<size_t>(arg);
+  }
+
+  [[nodiscard]] optional<int64_t> to_integer() const {
+    if (!is_integer() || arg > static_cast<uint64_t>(INT64_MAX)) return nullopt;
+    const auto v = static_cast<int64_t>(arg);
+    return type == cbor_type::unsigned_int ? v : -1 - v;
+  }
+
+  [[nodiscard]] optional<uint64_t> to_unsigned() const {
+    if (type != cbor_type::unsigned_int) return nullopt;
+    return arg;
+  }
+
+  /** Returns floating points and integers as a double. */
+  [[nodiscard]] optional<double> to_double() const {
+    if (type == cbor_type::floating) return number;
+    if (type == cbor_type::unsigned_int) return static_cast<double>(arg);
+    if (type == cbor_type::negative_int) return -1.0 - static_cast<double>(arg);
+    return nullopt;
+  }
+
+  [[nodiscard]] optional<bool> to_bool() const {
+    if (type != cbor_type::boolean) return nullopt;
+    return arg != 0;
+  }
+
+  [[nodiscard]] optional<string_view> to_string() const {
+    if (type != cbor_type::text) return nullopt;
+    return string_view(reinterpret_cast<const char *>(data), static_cast<size_t>(arg));
+  }
+
+  /**
+   * Returns true for a typed array of T, in either byte order
+   * (uint8_t also matches the clamped variant).
+   */
+  template<typename T>
+  [[nodiscard]] bool is_typed_array_of() const {
+    constexpr uint8_t native = LIB_XCORE_NAMESPACE::detail::cbor_typed_array_tag<T>();
+    if (type != cbor_type::typed_array) return false;
+    if constexpr (sizeof(T) == 1)
+      return tag == native || (native == 64 && tag == 68);
+    else
+      return (tag | 4) == (native | 4);
+  }
+
+  /**
+   * Copies up to n elements of a typed array of T into out: one memcpy in host
+   * byte order, a byte swap per element otherwise.
+   *
+   * @return Number of elements copied, 0 if this is not a typed array of T
+   */
+  template<typename T>
+  size_t copy_to(T *out, const size_t n) const {
+    if (!is_typed_array_of<T>()) return 0;
+
+    const size_t count = min(size(), n);
+
+    if constexpr (sizeof(T) > 1) {
+      if (tag != LIB_XCORE_NAMESPACE::detail::cbor_typed_array_tag<T>()) {
+        using U = conditional_t<sizeof(T) == 2, uint16_t, conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>;
+        for (size_t i = 0; i < count; ++i) {
+          U bits;
+          memcpy(&bits, data + i * sizeof(U), sizeof(U));
+          bits = LIB_XCORE_NAMESPACE::detail::cbor_byteswap(bits);
+          memcpy(&out[i], &bits, sizeof(U));
+        }
+        return count;
+      }
+    }
+
+    memcpy(out, data, count * sizeof(T));
+    return count;
+  }
+};
+
+/**
+ * Zero-copy CBOR decoder pulling one item at a time out of a byte range.
+ *
+ * next() decodes the head of the next item; string and typed array payloads
+ * are exposed in place, and the entries of an array or a map follow as the
+ * next items. skip() jumps over a whole item, nested content included, with no
+ * recursion. The read_*() helpers decode an item of the expected type, or
+ * leave the position unchanged and return nullopt/false on a type mismatch.
+ *
+ * Indefinite-length items are rejected, every other well-formed item is
+ * accepted. Lengths are checked against the remaining input before use.
+ *
+ * Usage:
+ *   cbor_reader_t reader(data, size);
+ *   for (auto n = reader.read_map().value_or(0); n--;) {
+ *     const auto key = reader.read_text();
+ *     if (key && *key == "pos") reader.read(position);
+ *     else reader.skip();
+ *   }
+ */
+class cbor_reader_t {
+  const unsigned char *begin_;
+  const unsigned char *pos_;
+  const unsigned char *end_;
+  cbor_error           error_ = cbor_error::ok;
+
+public:
+  cbor_reader_t(const void *data, const size_t size)
+      : begin_(static_cast<const unsigned char *>(data)), pos_(begin_), end_(begin_ + size) {}
+
+  /**
+   * Decodes the next item. A typed array tag and its byte string are returned
+   * as one cbor_type::typed_array item; other tags come as cbor_type::tag
+   * followed by the tagged item.
+   *
+   * @return false at the end of the input or on error (see error())
+   */
+  bool next(cbor_item_t &item) {
+    if (error_ != cbor_error::ok || pos_ == end_) return false;
+
+    const unsigned char *start = pos_;
+    if (!_head(item)) {
+      pos_ = start;
+      return false;
+    }
+    return true;
+  }
+
+  /**
+   * Skips the next item, including the entries of arrays and maps.
+   */
+  bool skip() {
+    const unsigned char *start   = pos_;
+    uint64_t             pending = 1;
+    cbor_item_t          item;
+
+    while (pending--) {
+      if (!next(item)) {
+        if (error_ == cbor_error::ok) error_ = cbor_error::truncated;
+        pos_ = start;
+        return false;
+      }
+
+      if (item.type == cbor_type::array) pending += item.arg;
+      else if (item.type == cbor_type::map) pending += 2 * item.arg;
+      else if (item.type == cbor_type::tag) pending += 1;
+    }
+    return true;
+  }
+
+  optional<int64_t> read_integer() { return _read<int64_t>(&cbor_item_t::to_integer); }
+
+  optional<uint64_t> read_unsigned() { return _read<uint64_t>(&cbor_item_t::to_unsigned); }
+
+  optional<double> read_double() { return _read<double>(&cbor_item_t::to_double); }
+
+  optional<bool> read_bool() { return _read<bool>(&cbor_item_t::to_bool); }
+
+  optional<string_view> read_text() { return _read<string_view>(&cbor_item_t::to_string); }
+
+  /** Reads an array head and returns its number of entries. */
+  optional<size_t> read_array() { return _read_count(cbor_type::array); }
+
+  /** Reads a map head and returns its number of key/value pairs. */
+  optional<size_t> read_map() { return _read_count(cbor_type::map); }
+
+  /** Reads a typed array of exactly Size elements of T. */
+  template<typename T, size_t Size>
+  bool read(LIB_XCORE_NAMESPACE::impl::numeric_vector_static_t<T, Size> &v) {
+    const unsigned char *start = pos_;
+    cbor_item_t          item;
+
+    if (next(item) && item.is_typed_array_of<T>() && item.size() == Size) {
+      item.copy_to(v.data(), Size);
+      return true;
+    }
+    pos_ = start;
+    return false;
+  }
+
+  /** Reads a matrix written by cbor_writer_t, which must have the same shape. */
+  template<typename T, size_t Row, size_t Col>
+  bool read(LIB_XCORE_NAMESPACE::impl::numeric_matrix_static_t<T, Row, Col> &m) {
+    const unsigned char *start = pos_;
+    cbor_item_t          item;
+
+    if (next(item) && item.type == cbor_type::tag && item.arg == LIB_XCORE_NAMESPACE::detail::cbor_tag_row_major &&
+        read_array().value_or(0) == 2 && read_array().value_or(0) == 2 &&
+        read_unsigned().value_or(0) == Row && read_unsigned().value_or(0) == Col &&
+        next(item) && item.is_typed_array_of<T>() && item.size() == Row * Col) {
+      item.copy_to(m.data(), Row * Col);
+      return true;
+    }
+    pos_ = start;
+    return false;
+  }
+
+  [[nodiscard]] bool       at_end() const { return pos_ == end_; }
+  [[nodiscard]] size_t     offset() const { return static_cast<size_t>(pos_ - begin_); }
+  [[nodiscard]] cbor_error error() const { return error_; }
+
+private:
+  bool _fail(const cbor_error error) {
+    error_ = error;
+    return false;
+  }
+
+  [[nodiscard]] size_t _remaining() const { return static_cast<size_t>(end_ - pos_); }
+
+  bool _argument(const unsigned ai, uint64_t &arg) {
+    if (ai < 24) {
+      arg = ai;
+      return true;
+    }
+
+    if (ai > 27) return _fail(ai == 31 ? cbor_error::indefinite : cbor_error::invalid);
+
+    const size_t n = size_t(1) << (ai - 24);
+    if (_remaining() < n) return _fail(cbor_error::truncated);
+
+    switch (n) {
+      case 1: arg = pos_[0]; break;
+      case 2: arg = LIB_XCORE_NAMESPACE::detail::cbor_load_be<uint16_t>(pos_); break;
+      case 4: arg = LIB_XCORE_NAMESPACE::detail::cbor_load_be<uint32_t>(pos_); break;
+      default: arg = LIB_XCORE_NAMESPACE::detail::cbor_load_be<uint64_t>(pos_);
+    }
+    pos_ += n;
+    return true;
+  }
+
+  bool _head(cbor_item_t &item) {
+    const unsigned char ib    = *pos_++;
+    const unsigned      major = ib >> 5;
+    const unsigned      ai    = ib & 0x1F;
+
+    item.tag  = 0;
+    item.data = nullptr;
+
+    if (major == LIB_XCORE_NAMESPACE::detail::cbor_simple) return _simple(item, ai);
+
+    if (!_argument(ai, item.arg)) return false;
+
+    switch (major) {
+      case LIB_XCORE_NAMESPACE::detail::cbor_unsigned: item.type = cbor_type::unsigned_int; return true;
+      case LIB_XCORE_NAMESPACE::detail::cbor_negative: item.type = cbor_type::negative_int; return true;
+      case LIB_XCORE_NAMESPACE::detail::cbor_bytes:
+      case LIB_XCORE_NAMESPACE::detail::cbor_text:
+        if (item.arg > _remaining()) return _fail(cbor_error::truncated);
+        item.type = major == LIB_XCORE_NAMESPACE::detail::cbor_text ? cbor_type::text : cbor_type::bytes;
+        item.data = pos_;
+        pos_ += item.arg;
+        return true;
+      case LIB_XCORE_NAMESPACE::detail::cbor_array:
+      case LIB_XCORE_NAMESPACE::detail::cbor_map:
+        // Every entry takes at least one byte
+        if (item.arg > _remaining() / (major == LIB_XCORE_NAMESPACE::detail::cbor_map ? 2 : 1)) return _fail(cbor_error::truncated);
+        item.type = major == LIB_XCORE_NAMESPACE::detail::cbor_map ? cbor_type::map : cbor_type::array;
+        return true;
+      default:
+        break;
+    }
+
+    // Tag
+    const size_t element_size = LIB_XCORE_NAMESPACE::detail::cbor_typed_array_element_size(item.arg);
+    if (element_size == 0) {
+      item.type = cbor_type::tag;
+      return true;
+    }
+
+    if (pos_ == end_) return _fail(cbor_error::truncated);
+    if (*pos_ >> 5 != LIB_XCORE_NAMESPACE::detail::cbor_bytes) return _fail(cbor_error::invalid);
+
+    const auto tag = static_cast<uint8_t>(item.arg);
+    if (!_argument(*pos_++ & 0x1F, item.arg)) return false;
+    if (item.arg > _remaining()) return _fail(cbor_error::truncated);
+    if (item.arg % element_size) return _fail(cbor_error::invalid);
+
+    item.type = cbor_type::typed_array;
+    item.tag  = tag;
+    item.data = pos_;
+    pos_ += item.arg;
+    return true;
+  }
+
+  bool _simple(cbor_item_t &item, const unsigned ai) {
+    switch (ai) {
+      case 20:
+      case 21:
+        item.type = cbor_type::boolean;
+        item.arg  = ai - 20;
+        return true;
+      case 22: item.type = cbor_type::null; return true;
+      case 23: item.type = cbor_type::undefined; return true;
+      case 25:
+      case 26:
+      case 27:
+        if (!_argument(ai, item.arg)) return false;
+        item.type = cbor_type::floating;
+        if (ai == 25) {
+          item.number = LIB_XCORE_NAMESPACE::detail::cbor_half_to_double(static_cast<uint16_t>(item.arg));
+        } else if (ai == 26) {
+          const auto bits = static_cast<uint32_t>(item.arg);
+          float      f;
+          memcpy(&f, &bits, sizeof(f));
+          item.number = f;
+        } else {
+          memcpy(&item.number, &item.arg, sizeof(item.number));
+        }
+        return true;
+      case 31: return _fail(cbor_error::indefinite);  // Break
+      default:
+        if (ai > 24) return _fail(cbor_error::invalid);
+        if (!_argument(ai, item.arg)) return false;
+        item.type = cbor_type::simple;
+        return true;
+    }
+  }
+
+  template<typename T, typename Getter>
+  optional<T> _read(Getter getter) {
+    const unsigned char *start = pos_;
+    cbor_item_t          item;
+
+    if (next(item)) {
+      if (const optional<T> v = (item.*getter)()) return v;
+      pos_ = start;
+    }
+    return nullopt;
+  }
+
+  optional<size_t> _read_count(const cbor_type type) {
+    const unsigned char *start = pos_;
+    cbor_item_t          item;
+
+    if (next(item)) {
+      if (item.type == type) return static_cast<size_t>(item.arg);
+      pos_ = start;
+    }
+    return nullopt;
+  }
+};
+
+LIB_XCORE_END_NAMESPACE
+
+#endif  //LIB_XCORE_UTILS_CBOR_HPP
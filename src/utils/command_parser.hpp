@@ -2,12 +2,105 @@
 #define LIB_XCORE_UTILS_COMMAND_PARSER_HPP
 
 #include "internal/macros.hpp"
+#include "core/ported_config.hpp"
+#include "core/from_chars.hpp"
+#include "core/swar.hpp"
+#include "core/ported_optional.hpp"
 
 #include <cstring>
 #include <cstddef>
 
 LIB_XCORE_BEGIN_NAMESPACE
 
+namespace detail {
+  /** Token separator test: the default ' ' delimiter stands for blanks, so '\t' separates too. */
+  template<char Delimiter>
+  FORCE_INLINE constexpr bool is_command_delimiter(const char c) {
+    return c == Delimiter || (Delimiter == ' ' && c == '\t');
+  }
+
+  /**
+   * Token storage and accessors shared by the command parsers.
+   *
+   * @tparam MaxArgs Maximum number of tokens (command + arguments).
+   */
+  template<size_t MaxArgs>
+  class command_args_t {
+  protected:
+    const char *argv_data_[MaxArgs];
+    size_t      argc_;
+
+  public:
+    /** Subscriptable view over the parsed tokens. Returns nullptr if out of range. */
+    struct {
+      const char  **data_;
+      const size_t *argc_;
+
+      [[nodiscard]] const char *operator[](size_t i) const {
+        return (i < *argc_) ? data_[i] : nullptr;
+      }
+    } argv;
+
+    command_args_t() : argv_data_{}, argc_(0), argv{argv_data_, &argc_} {}
+
+    /** Number of tokens (command + arguments). */
+    [[nodiscard]] size_t argc() const { return argc_; }
+
+    /** Contiguous array of the argc() tokens, e.g. for command_table_t handlers. */
+    [[nodiscard]] const char *const *argv_data() const { return argv_data_; }
+
+    /** First token (the command name). Equivalent to argv[0]. */
+    [[nodiscard]] const char *command() const { return argv[0]; }
+
+    /** Returns true if the command matches the given string. */
+    [[nodiscard]] bool is(const char *cmd) const {
+      const char *c = command();
+      return c && cmd && strcmp(c, cmd) == 0;
+    }
+
+    /**
+     * Converts token i to a number with xcore::from_chars (locale-independent).
+     * Returns nullopt if the token is missing, malformed, out of range for T,
+     * or has trailing characters.
+     *
+     * @param base Radix for integral types; 0 detects a "0x" or "0b" prefix
+     *             (decimal otherwise). Ignored for floating points.
+     */
+    template<typename T>
+    [[nodiscard]] optional<T> arg(const size_t i, int base = 10) const {
+      static_assert((is_integral_v<T> && !is_same_v<remove_cv_t<T>, bool>) || is_floating_point_v<T>,
+                    "arg<T> only supports integral and floating point types");
+
+      const char *token = argv[i];
+      if (!token) return nullopt;
+
+      const char *last = token + strlen(token);
+      T           value;
+
+      if constexpr (is_integral_v<T>) {
+        if (base == 0) {
+          base = 10;
+          if (token[0] == '0' && (token[1] | 0x20) == 'x') {
+            base = 16;
+            token += 2;
+          } else if (token[0] == '0' && (token[1] | 0x20) == 'b') {
+            base = 2;
+            token += 2;
+          }
+        }
+
+        const from_chars_result res = from_chars(token, last, value, base);
+        if (!res || res.ptr != last) return nullopt;
+      } else {
+        const from_chars_result res = from_chars(token, last, value);
+        if (!res || res.ptr != last) return nullopt;
+      }
+
+      return value;
+    }
+  };
+}  // namespace detail
+
 /**
    * Simple C-string command parser with configurable delimiter.
    *
@@ -20,38 +113,27 @@ LIB_XCORE_BEGIN_NAMESPACE
    *       parser.command();   // "move"
    *       parser.argv[1];     // "10"
    *       parser.argc();      // 3
+   *       parser.arg<int>(1); // 10
    *   }
    *
    * @tparam BufferSize  Maximum input length (including null terminator).
    * @tparam MaxArgs     Maximum number of tokens (command + arguments).
-   * @tparam Delimiter   Character used to separate tokens (default: ' ').
+   * @tparam Delimiter   Character used to separate tokens (default: ' ', which also splits on '\t').
    */
 template<size_t BufferSize = 64, size_t MaxArgs = 8, char Delimiter = ' '>
-class command_parser_t {
-  char        buffer_[BufferSize];
-  const char *argv_data_[MaxArgs];
-  size_t      argc_;
+class command_parser_t : public LIB_XCORE_NAMESPACE::detail::command_args_t<MaxArgs> {
+  char buffer_[BufferSize];
 
 public:
-  /** Subscriptable view over the parsed tokens. Returns nullptr if out of range. */
-  struct {
-    const char **data_;
-    const size_t *argc_;
-
-    [[nodiscard]] const char *operator[](size_t i) const {
-      return (i < *argc_) ? data_[i] : nullptr;
-    }
-  } argv;
-
-  command_parser_t() : buffer_{}, argv_data_{}, argc_(0), argv{argv_data_, &argc_} {}
+  command_parser_t() : buffer_{} {}
 
   /**
-     * Parse a C-string command. Tokens are separated by Delimiter.
+     * Parse a C-string command. Tokens are separated by runs of Delimiter.
      * Returns true if at least one token was found.
      * Returns false if input is null or exceeds BufferSize.
      */
   bool parse(const char *input) {
-    argc_ = 0;
+    this->argc_ = 0;
 
     if (!input) return false;
 
@@ -61,32 +143,200 @@ public:
     memcpy(buffer_, input, len + 1);
 
     char *p = buffer_;
-    while (*p && argc_ < MaxArgs) {
-      while (*p == Delimiter) ++p;
+    while (*p && this->argc_ < MaxArgs) {
+      while (LIB_XCORE_NAMESPACE::detail::is_command_delimiter<Delimiter>(*p)) ++p;
       if (!*p) break;
 
-      argv_data_[argc_++] = p;
+      this->argv_data_[this->argc_++] = p;
 
-      while (*p && *p != Delimiter) ++p;
+      while (*p && !LIB_XCORE_NAMESPACE::detail::is_command_delimiter<Delimiter>(*p)) ++p;
       if (*p) *p++ = '\0';
     }
 
-    return argc_ > 0;
+    return this->argc_ > 0;
   }
+};
 
-  /** Number of tokens (command + arguments). */
-  [[nodiscard]] size_t argc() const { return argc_; }
+/**
+   * Incremental command parser for byte streams (e.g. serial links).
+   *
+   * Bytes are tokenized while they are fed, so each input byte is read and
+   * stored exactly once and a finished line needs no rescan. Lines end at
+   * '\n' or '\r'; empty lines are skipped. On little-endian targets, runs of
+   * 8 bytes without a line terminator are classified with one word operation.
+   *
+   * Tokens stay valid until the next feed() after a command was completed.
+   * Lines longer than BufferSize - 1 bytes are dropped and counted in dropped().
+   * Tokens beyond MaxArgs are ignored.
+   *
+   * Usage:
+   *   stream_command_parser_t<> parser;
+   *   while (n > 0) {
+   *       const size_t used = parser.feed(data, n);
+   *       data += used;
+   *       n -= used;
+   *       if (parser.ready()) handle(parser.command(), parser.arg<int>(1));
+   *   }
+   *
+   * @tparam BufferSize  Maximum line length (including null terminator).
+   * @tparam MaxArgs     Maximum number of tokens (command + arguments).
+   * @tparam Delimiter   Character used to separate tokens (default: ' ', which also splits on '\t').
+   */
+template<size_t BufferSize = 64, size_t MaxArgs = 8, char Delimiter = ' '>
+class stream_command_parser_t : public LIB_XCORE_NAMESPACE::detail::command_args_t<MaxArgs> {
+  static_assert(BufferSize > 1, "Buffer must hold at least one character.");
+  static_assert(Delimiter != '\n' && Delimiter != '\r', "Delimiter cannot be a line terminator.");
+
+  char   buffer_[BufferSize];
+  size_t len_      = 0;      // Bytes stored for the line in progress
+  size_t count_    = 0;      // Tokens found in the line in progress
+  size_t dropped_  = 0;      // Lines discarded for exceeding the buffer
+  bool   in_token_ = false;  // Last stored byte belongs to a token
+  bool   overflow_ = false;  // Line in progress is being discarded
+  bool   ready_    = false;  // A complete command is available
+
+public:
+  stream_command_parser_t() : buffer_{} {}
 
-  /** First token (the command name). Equivalent to argv[0]. */
-  [[nodiscard]] const char *command() const { return argv[0]; }
+  /**
+     * Consumes bytes up to and including the first line terminator that
+     * completes a command, or all n bytes otherwise.
+     *
+     * @return Number of bytes consumed. ready() tells whether a command is available.
+     */
+  size_t feed(const char *data, const size_t n) {
+    if (ready_) _clear();
+
+    size_t i = 0;
+    while (i < n) {
+#if XCORE_SWAR_ENABLED
+      if (n - i >= 8 && len_ + 8 < BufferSize && !overflow_) {
+        const uint64_t v    = LIB_XCORE_NAMESPACE::detail::swar_load(data + i);
+        const uint64_t term = LIB_XCORE_NAMESPACE::detail::swar_byte_mask(v, '\n') | LIB_XCORE_NAMESPACE::detail::swar_byte_mask(v, '\r');
+        if (!term) {
+          _push_word(v);
+          i += 8;
+          continue;
+        }
+
+        // Bytes before the terminator, then fall through to it
+        const size_t k = LIB_XCORE_NAMESPACE::detail::swar_first(term);
+        for (size_t j = 0; j < k; ++j) _push_byte(data[i + j]);
+        i += k;
+      }
+#endif
+      const char c = data[i++];
+      if (c == '\n' || c == '\r') {
+        if (_finish_line()) return i;
+      } else {
+        _push_byte(c);
+      }
+    }
+
+    return n;
+  }
+
+  size_t feed(const unsigned char *data, const size_t n) {
+    return feed(reinterpret_cast<const char *>(data), n);
+  }
+
+  /**
+     * Feeds directly from the readable spans of a byte buffer (e.g. byte_buffer_t),
+     * consuming bytes up to the end of the first completed command.
+     *
+     * @return true if a command is available.
+     */
+  template<typename ByteBuffer>
+  bool feed(ByteBuffer &source) {
+    if (ready_) _clear();
+
+    while (!source.empty()) {
+      const auto   span = source.read_span();
+      const size_t used = feed(span.first, span.second);
+      source.consume(used);
+      if (ready_) return true;
+    }
+
+    return false;
+  }
+
+  /** Returns true if the last feed() completed a command. */
+  [[nodiscard]] bool ready() const { return ready_; }
+
+  /** Number of lines discarded for exceeding BufferSize. */
+  [[nodiscard]] size_t dropped() const { return dropped_; }
+
+  /** Discards the line in progress and any completed command. */
+  void reset() { _clear(); }
+
+private:
+  void _clear() {
+    len_        = 0;
+    count_      = 0;
+    in_token_   = false;
+    overflow_   = false;
+    ready_      = false;
+    this->argc_ = 0;
+  }
+
+  void _push_byte(const char c) {
+    if (overflow_) return;
+
+    if (len_ + 1 >= BufferSize) {
+      overflow_ = true;
+      return;
+    }
+
+    if (LIB_XCORE_NAMESPACE::detail::is_command_delimiter<Delimiter>(c)) {
+      buffer_[len_++] = '\0';
+      in_token_       = false;
+      return;
+    }
+
+    if (!in_token_ && count_ < MaxArgs)
+      this->argv_data_[count_++] = buffer_ + len_;
+
+    buffer_[len_++] = c;
+    in_token_       = true;
+  }
+
+#if XCORE_SWAR_ENABLED
+  void _push_word(const uint64_t v) {
+    uint64_t delim = LIB_XCORE_NAMESPACE::detail::swar_byte_mask(v, Delimiter);
+    if constexpr (Delimiter == ' ') delim |= LIB_XCORE_NAMESPACE::detail::swar_byte_mask(v, '\t');
+    const uint64_t stored = v & ~((delim >> 7) * 0xFF);  // Delimiters become terminators
+    memcpy(buffer_ + len_, &stored, sizeof(stored));
+
+    const uint8_t d      = LIB_XCORE_NAMESPACE::detail::swar_movemask(delim);
+    unsigned      starts = static_cast<uint8_t>(~d & ((d << 1) | (in_token_ ? 0u : 1u)));
+
+    for (; starts && count_ < MaxArgs; starts &= starts - 1)
+      this->argv_data_[count_++] = buffer_ + len_ + __builtin_ctz(starts);
+
+    in_token_ = !(d & 0x80);
+    len_ += 8;
+  }
+#endif
+
+  bool _finish_line() {
+    if (overflow_) {
+      ++dropped_;
+      _clear();
+      return false;
+    }
+
+    if (count_ == 0) {
+      _clear();
+      return false;
+    }
 
-  /** Returns true if the command matches the given string. */
-  [[nodiscard]] bool is(const char *cmd) const {
-    const char *c = command();
-    return c && cmd && strcmp(c, cmd) == 0;
+    buffer_[len_] = '\0';
+    this->argc_   = count_;
+    ready_        = true;
+    return true;
   }
 };
 
 LIB_XCORE_END_NAMESPACE
 
-#endif  //LIB_XCORE_UTILS_COMMAND_PARSER_HPP
\ No newline at end of file
+#endif  //LIB_XCORE_UTILS_COMMAND_PARSER_HPP
@@ -0,0 +1,208 @@
+#ifndef LIB_XCORE_UTILS_COMMAND_TABLE_HPP
+#define LIB_XCORE_UTILS_COMMAND_TABLE_HPP
+
+#include "internal/macros.hpp"
+#include "core/ported_std.hpp"
+#include "core/builtins_bootstrap.hpp"
+#include <cstdint>
+#include <cstring>
+
+LIB_XCORE_BEGIN_NAMESPACE
+
+/**
+ * Command handler. Receives the parsed tokens, argv[0] being the command name.
+ */
+using command_handler_t = void (*)(size_t argc, const char *const *argv);
+
+struct command_entry_t {
+  const char       *name;
+  command_handler_t handler;
+};
+
+namespace detail {
+  FORCE_INLINE constexpr uint64_t command_hash_step(const uint64_t h, const char c) {
+    return (h ^ static_cast<unsigned char>(c)) * 0x100000001B3ull;
+  }
+
+  FORCE_INLINE constexpr uint64_t command_hash_mix(uint64_t h) {
+    h ^= h >> 32;
+    h *= 0xD6E8FEB86659FD93ull;
+    h ^= h >> 32;
+    return h;
+  }
+
+  FORCE_INLINE constexpr uint64_t command_hash_finish(const uint64_t h, const size_t len) {
+    return command_hash_mix(h ^ (static_cast<uint64_t>(len) << 56));
+  }
+
+  constexpr uint64_t command_hash_seed = 0xCBF29CE484222325ull;
+}  // namespace detail
+
+/**
+ * Command dispatch table with a perfect hash generated at compile time.
+ *
+ * Names are hashed once and split into buckets; each bucket gets a seed that
+ * moves its names into free slots of a table with a load factor of at most 1/2
+ * (hash and displace). A lookup costs one hash of the name, one table read and
+ * one memcmp, regardless of the number of commands.
+ *
+ * Usage:
+ *   constexpr command_entry_t commands[] = {{"move", on_move}, {"stop", on_stop}};
+ *   constexpr command_table_t table(commands);
+ *   static_assert(table.valid(), "Duplicate command names");
+ *
+ *   if (parser.parse(line) && !table.dispatch(parser)) print("unknown command");
+ *
+ * @tparam N Number of commands.
+ */
+template<size_t N>
+class command_table_t {
+  static_assert(N > 0, "Command table cannot be empty.");
+  static_assert(N < 0xFFFF, "Too many commands.");
+
+  static constexpr size_t num_slots   = builtin::next_power_of_two(2 * N);
+  static constexpr size_t num_buckets = builtin::next_power_of_two((N + 1) / 2);
+  static constexpr size_t max_seed    = 0xFFFF;
+
+  command_entry_t entries_[N]{};
+  size_t          lens_[N]{};
+  uint16_t        seeds_[num_buckets]{};
+  uint16_t        slots_[num_slots]{};  // Entry index, or N for an empty slot
+  bool            valid_ = false;
+
+  static constexpr size_t _bucket_of(const uint64_t h) {
+    return static_cast<size_t>(h >> 32) & (num_buckets - 1);
+  }
+
+  static constexpr size_t _slot_of(const uint64_t h, const uint16_t seed) {
+    return static_cast<size_t>(LIB_XCORE_NAMESPACE::detail::command_hash_mix(h ^ (seed * 0x9E3779B97F4A7C15ull))) & (num_slots - 1);
+  }
+
+  static constexpr uint64_t _hash(const char *name, const size_t len) {
+    uint64_t h = LIB_XCORE_NAMESPACE::detail::command_hash_seed;
+    for (size_t i = 0; i < len; ++i) h = LIB_XCORE_NAMESPACE::detail::command_hash_step(h, name[i]);
+    return LIB_XCORE_NAMESPACE::detail::command_hash_finish(h, len);
+  }
+
+public:
+  /**
+   * Builds the table. valid() is false if a name is null or duplicated, and an invalid
+   * table finds nothing.
+   */
+  constexpr explicit command_table_t(const command_entry_t (&entries)[N]) {
+    uint64_t hashes[N]{};
+
+    for (size_t i = 0; i < N; ++i) {
+      entries_[i] = entries[i];
+      if (!entries[i].name) return;
+      while (entries[i].name[lens_[i]]) ++lens_[i];
+      hashes[i] = _hash(entries[i].name, lens_[i]);
+    }
+
+    // Group entries by bucket (counting sort)
+    size_t bucket_begin[num_buckets + 1]{};
+    size_t members[N]{};
+
+    for (size_t i = 0; i < N; ++i) ++bucket_begin[_bucket_of(hashes[i]) + 1];
+    for (size_t b = 0; b < num_buckets; ++b) bucket_begin[b + 1] += bucket_begin[b];
+
+    size_t fill[num_buckets]{};
+    for (size_t i = 0; i < N; ++i) {
+      const size_t b = _bucket_of(hashes[i]);
+      members[bucket_begin[b] + fill[b]++] = i;
+    }
+
+    for (size_t s = 0; s < num_slots; ++s) slots_[s] = static_cast<uint16_t>(N);
+
+    // Place the largest buckets first, while the table is still sparse
+    size_t largest = 0;
+    for (size_t b = 0; b < num_buckets; ++b)
+      if (fill[b] > largest) largest = fill[b];
+
+    size_t trial[N]{};
+
+    for (size_t size = largest; size > 0; --size) {
+      for (size_t b = 0; b < num_buckets; ++b) {
+        if (fill[b] != size) continue;
+
+        const size_t *bucket = members + bucket_begin[b];
+        bool          placed = false;
+
+        for (size_t seed = 0; seed <= max_seed && !placed; ++seed) {
+          placed = true;
+          for (size_t k = 0; k < size && placed; ++k) {
+            trial[k] = _slot_of(hashes[bucket[k]], static_cast<uint16_t>(seed));
+            if (slots_[trial[k]] != N) placed = false;
+            for (size_t j = 0; j < k && placed; ++j)
+              if (trial[j] == trial[k]) placed = false;
+          }
+
+          if (placed) {
+            seeds_[b] = static_cast<uint16_t>(seed);
+            for (size_t k = 0; k < size; ++k) slots_[trial[k]] = static_cast<uint16_t>(bucket[k]);
+          }
+        }
+
+        if (!placed) return;
+      }
+    }
+
+    valid_ = true;
+  }
+
+  /** Returns false if the names could not be hashed (null or duplicated names). */
+  [[nodiscard]] constexpr bool valid() const { return valid_; }
+
+  [[nodiscard]] static constexpr size_t size() { return N; }
+
+  /**
+   * Looks up a command by name.
+   *
+   * @return The matching entry, or nullptr (always if the table is not valid()).
+   */
+  [[nodiscard]] const command_entry_t *find(const char *name, const size_t len) const {
+    // Slots and seeds are incomplete when construction stopped early
+    if (!valid_) return nullptr;
+
+    const uint64_t h   = _hash(name, len);
+    const size_t   idx = slots_[_slot_of(h, seeds_[_bucket_of(h)])];
+
+    if (idx >= N || lens_[idx] != len || memcmp(entries_[idx].name, name, len) != 0)
+      return nullptr;
+
+    return entries_ + idx;
+  }
+
+  /** Looks up a null-terminated command name. */
+  [[nodiscard]] const command_entry_t *find(const char *name) const {
+    if (!name) return nullptr;
+    return find(name, strlen(name));
+  }
+
+  /**
+   * Calls the handler of argv[0] with the given tokens.
+   *
+   * @return false if argc is zero, the command is unknown or the table is not valid().
+   */
+  bool dispatch(const size_t argc, const char *const *argv) const {
+    if (argc == 0) return false;
+
+    const command_entry_t *entry = find(argv[0]);
+    if (!entry || !entry->handler) return false;
+
+    entry->handler(argc, argv);
+    return true;
+  }
+
+  /**
+   * Dispatches the tokens of a command parser (command_parser_t, stream_command_parser_t).
+   */
+  template<typename Parser>
+  bool dispatch(const Parser &parser) const {
+    return dispatch(parser.argc(), parser.argv_data());
+  }
+};
+
+LIB_XCORE_END_NAMESPACE
+
+#endif  //LIB_XCORE_UTILS_COMMAND_TABLE_HPP
@@ -0,0 +1,807 @@
+#ifndef LIB_XCORE_UTILS_JSON_PARSER_HPP
+#define LIB_XCORE_UTILS_JSON_PARSER_HPP
+
+#include "internal/macros.hpp"
+#include "core/ported_config.hpp"
+#include "core/ported_std.hpp"
+#include "core/ported_optional.hpp"
+#include "core/ported_string_view.hpp"
+#include "core/from_chars.hpp"
+#include "core/swar.hpp"
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#  include <emmintrin.h>
+#endif
+
+LIB_XCORE_BEGIN_NAMESPACE
+
+enum class json_error : uint8_t {
+  ok = 0,
+  empty,            // No value in the input
+  capacity,         // More structural characters than the index holds, or more nodes than the document holds
+  depth,            // Nesting deeper than MaxDepth
+  unclosed_string,  // Input ends inside a string
+  control_char,     // Unescaped control character in a string
+  syntax,           // Unexpected token
+  literal,          // Malformed true, false or null
+  number,           // Malformed or out of range number
+  escape,           // Malformed escape sequence in a string
+  aborted           // A SAX handler returned false
+};
+
+namespace detail {
+  /**
+   * Character classes of a 64-byte block, one bit per byte.
+   */
+  struct json_block_t {
+    uint64_t backslash;
+    uint64_t quote;
+    uint64_t structural;  // { } [ ] : ,
+    uint64_t whitespace;  // space, \t, \n, \r
+    uint64_t control;     // < 0x20
+  };
+
+  inline json_block_t json_classify(const char *p) {
+    json_block_t b{};
+#if defined(__SSE2__)
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i quote     = _mm_set1_epi8('"');
+    const __m128i control   = _mm_set1_epi8(0x1F);
+
+    for (int i = 0; i < 4; ++i) {
+      const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 16 * i));
+
+      // Brackets differ from each other by 0x20 ('[' 0x5B, '{' 0x7B), so OR-ing 0x20 folds them
+      const __m128i folded = _mm_or_si128(v, _mm_set1_epi8(0x20));
+      const __m128i s      = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(folded, _mm_set1_epi8('{')), _mm_cmpeq_epi8(folded, _mm_set1_epi8('}'))),
+                                          _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(':')), _mm_cmpeq_epi8(v, _mm_set1_epi8(','))));
+      const __m128i w      = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'))),
+                                          _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\r'))));
+
+      const int shift = 16 * i;
+      b.backslash |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, backslash)))) << shift;
+      b.quote |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, quote)))) << shift;
+      b.structural |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(s))) << shift;
+      b.whitespace |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(w))) << shift;
+      b.control |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(v, control), control)))) << shift;
+    }
+#elif XCORE_SWAR_ENABLED
+    for (int i = 0; i < 8; ++i) {
+      const uint64_t v      = swar_load(p + 8 * i);
+      const uint64_t folded = v | (swar_ones * 0x20);
+      const uint64_t s      = swar_byte_mask(folded, '{') | swar_byte_mask(folded, '}') |
+                              swar_byte_mask(v, ':') | swar_byte_mask(v, ',');
+      const uint64_t w      = swar_byte_mask(v, ' ') | swar_byte_mask(v, '\t') |
+                              swar_byte_mask(v, '\n') | swar_byte_mask(v, '\r');
+
+      const int shift = 8 * i;
+      b.backslash |= static_cast<uint64_t>(swar_movemask(swar_byte_mask(v, '\\'))) << shift;
+      b.quote |= static_cast<uint64_t>(swar_movemask(swar_byte_mask(v, '"'))) << shift;
+      b.structural |= static_cast<uint64_t>(swar_movemask(s)) << shift;
+      b.whitespace |= static_cast<uint64_t>(swar_movemask(w)) << shift;
+      b.control |= static_cast<uint64_t>(swar_movemask(swar_less_mask(v, 0x20))) << shift;
+    }
+#else
+    for (int i = 0; i < 64; ++i) {
+      const auto     c   = static_cast<unsigned char>(p[i]);
+      const uint64_t bit = 1ull << i;
+      if (c == '\\') b.backslash |= bit;
+      if (c == '"') b.quote |= bit;
+      if (c == '{' || c == '}' || c == '[' || c == ']' || c == ':' || c == ',') b.structural |= bit;
+      if (c == ' ' || c == '\t' || c == '\n' || c == '\r') b.whitespace |= bit;
+      if (c < 0x20) b.control |= bit;
+    }
+#endif
+    return b;
+  }
+
+  /**
+   * Characters preceded by an odd number of backslashes (simdjson, Langdale & Lemire 2019).
+   *
+   * @param carry In: the first character of the block is escaped. Out: same for the next block.
+   */
+  FORCE_INLINE uint64_t json_escaped(uint64_t backslash, uint64_t &carry) {
+    constexpr uint64_t even_bits = 0x5555555555555555ull;
+
+    backslash &= ~carry;
+    const uint64_t follows_escape      = (backslash << 1) | carry;
+    const uint64_t odd_sequence_starts = backslash & ~even_bits & ~follows_escape;
+
+    uint64_t   sequences_on_even_bits;
+    const bool overflow = __builtin_add_overflow(odd_sequence_starts, backslash, &sequences_on_even_bits);
+    carry               = overflow ? 1 : 0;
+
+    const uint64_t invert_mask = sequences_on_even_bits << 1;
+    return (even_bits ^ invert_mask) & follows_escape;
+  }
+
+  /**
+   * Bit i of the result is the XOR of bits 0..i (string interiors from quote positions).
+   */
+  FORCE_INLINE constexpr uint64_t prefix_xor(uint64_t x) {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+  }
+
+  FORCE_INLINE constexpr bool json_is_delimiter(const char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == ',' || c == ':' ||
+           c == ']' || c == '}' || c == '[' || c == '{';
+  }
+
+  FORCE_INLINE constexpr int json_hex_digit(const char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if ((c | 0x20) >= 'a' && (c | 0x20) <= 'f') return (c | 0x20) - 'a' + 10;
+    return -1;
+  }
+
+  inline bool json_read_hex4(const char *p, const char *end, uint32_t &cp) {
+    if (end - p < 4) return false;
+    cp = 0;
+    for (int i = 0; i < 4; ++i) {
+      const int d = json_hex_digit(p[i]);
+      if (d < 0) return false;
+      cp = (cp << 4) | static_cast<uint32_t>(d);
+    }
+    return true;
+  }
+
+  /**
+   * Decodes the escape sequences of [src, end) in place.
+   *
+   * @return The decoded length, or -1 on a malformed escape.
+   */
+  inline ptrdiff_t json_unescape(char *src, const char *end) {
+    char *dst   = src;
+    char *begin = src;
+
+    while (src != end) {
+      if (*src != '\\') {
+        *dst++ = *src++;
+        continue;
+      }
+
+      if (end - src < 2) return -1;
+      const char e = src[1];
+      src += 2;
+
+      switch (e) {
+        case '"': *dst++ = '"'; break;
+        case '\\': *dst++ = '\\'; break;
+        case '/': *dst++ = '/'; break;
+        case 'b': *dst++ = '\b'; break;
+        case 'f': *dst++ = '\f'; break;
+        case 'n': *dst++ = '\n'; break;
+        case 'r': *dst++ = '\r'; break;
+        case 't': *dst++ = '\t'; break;
+        case 'u': {
+          uint32_t cp;
+          if (!json_read_hex4(src, end, cp)) return -1;
+          src += 4;
+
+          if (cp >= 0xD800 && cp <= 0xDBFF) {
+            // High surrogate, must be followed by \uDC00-\uDFFF
+            uint32_t low;
+            if (end - src < 6 || src[0] != '\\' || src[1] != 'u' || !json_read_hex4(src + 2, end, low) ||
+                low < 0xDC00 || low > 0xDFFF)
+              return -1;
+            src += 6;
+            cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+          } else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+            return -1;
+          }
+
+          if (cp < 0x80) {
+            *dst++ = static_cast<char>(cp);
+          } else if (cp < 0x800) {
+            *dst++ = static_cast<char>(0xC0 | (cp >> 6));
+            *dst++ = static_cast<char>(0x80 | (cp & 0x3F));
+          } else if (cp < 0x10000) {
+            *dst++ = static_cast<char>(0xE0 | (cp >> 12));
+            *dst++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            *dst++ = static_cast<char>(0x80 | (cp & 0x3F));
+          } else {
+            *dst++ = static_cast<char>(0xF0 | (cp >> 18));
+            *dst++ = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+            *dst++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            *dst++ = static_cast<char>(0x80 | (cp & 0x3F));
+          }
+          break;
+        }
+        default: return -1;
+      }
+    }
+
+    return dst - begin;
+  }
+}  // namespace detail
+
+/**
+ * SAX handler with no-op callbacks. Derive from it and hide the callbacks of
+ * interest; returning false from a callback aborts the parse.
+ * Strings are views into the parsed buffer, with escapes already decoded.
+ */
+struct json_sax_handler_t {
+  bool on_null() { return true; }
+  bool on_bool(bool) { return true; }
+  bool on_integer(int64_t) { return true; }
+  bool on_floating(double) { return true; }
+  bool on_string(string_view) { return true; }
+  bool on_key(string_view) { return true; }
+  bool on_object_begin() { return true; }
+  bool on_object_end() { return true; }
+  bool on_array_begin() { return true; }
+  bool on_array_end() { return true; }
+};
+
+/**
+ * In-situ JSON parser in two stages, after simdjson:
+ *  1. index(): classifies the input 64 bytes at a time (SSE2 or SWAR) and
+ *     records the offset of every structural character, every unescaped quote
+ *     and every scalar start, branch-free apart from the bit extraction.
+ *  2. parse(): walks the index, validates the grammar and emits SAX events.
+ *
+ * Strings with escapes are decoded in place, so the input must be writable and
+ * outlive any view handed out. Numbers without fraction or exponent that fit
+ * in int64_t are reported as integers, other numbers as doubles.
+ *
+ * The index lives in the object (4 * MaxStructurals bytes): place large
+ * parsers in static storage or in a virtual_stack_region_t, not on the stack.
+ *
+ * Usage:
+ *   static json_parser_t<1024> parser;
+ *   json_document_t<512>       doc;
+ *   if (doc.parse(parser, buffer, len) == json_error::ok)
+ *       doc.root()["rate"].to_double();
+ *
+ * @tparam MaxStructurals Capacity of the structural index
+ * @tparam MaxDepth       Maximum nesting of objects and arrays
+ */
+template<size_t MaxStructurals, size_t MaxDepth = 64>
+class json_parser_t {
+  static_assert(MaxStructurals > 0, "Index cannot be empty.");
+
+  uint32_t index_[MaxStructurals];
+  size_t   count_        = 0;
+  size_t   error_offset_ = 0;
+
+public:
+  json_parser_t() = default;
+
+  json_parser_t(const json_parser_t &)            = delete;
+  json_parser_t &operator=(const json_parser_t &) = delete;
+
+  /**
+   * Stage 1: builds the structural index of data[0, len).
+   */
+  json_error index(const char *data, const size_t len) {
+    count_        = 0;
+    error_offset_ = 0;
+
+    if (len > UINT32_MAX) return _fail(json_error::capacity, 0);
+
+    uint64_t escape_carry = 0;  // Next block starts escaped
+    uint64_t in_string    = 0;  // All ones when the previous block ends inside a string
+    uint64_t scalar_carry = 0;  // Previous block ends with a scalar character
+
+    char tail[64];
+
+    for (size_t base = 0; base < len; base += 64) {
+      const char *block = data + base;
+      if (len - base < 64) {
+        // Pad the last block with whitespace, which never starts a token
+        memset(tail, ' ', sizeof(tail));
+        memcpy(tail, block, len - base);
+        block = tail;
+      }
+
+      const LIB_XCORE_NAMESPACE::detail::json_block_t b = LIB_XCORE_NAMESPACE::detail::json_classify(block);
+
+      const uint64_t escaped = LIB_XCORE_NAMESPACE::detail::json_escaped(b.backslash, escape_carry);
+      const uint64_t quotes  = b.quote & ~escaped;
+
+      // Opening quote through the character before the closing quote
+      const uint64_t string_mask = LIB_XCORE_NAMESPACE::detail::prefix_xor(quotes) ^ in_string;
+      in_string                  = static_cast<uint64_t>(static_cast<int64_t>(string_mask) >> 63);
+
+      if (b.control & string_mask)
+        return _fail(json_error::control_char, base + static_cast<size_t>(__builtin_ctzll(b.control & string_mask)));
+
+      const uint64_t outside      = ~string_mask & ~quotes;
+      const uint64_t structural   = b.structural & outside;
+      const uint64_t scalar       = ~(b.structural | b.whitespace) & outside;
+      const uint64_t scalar_start = scalar & ~((scalar << 1) | scalar_carry);
+      scalar_carry                = scalar >> 63;
+
+      uint64_t tokens = structural | quotes | scalar_start;
+
+      if (count_ + 64 <= MaxStructurals) {
+        for (; tokens; tokens &= tokens - 1)
+          index_[count_++] = static_cast<uint32_t>(base + static_cast<size_t>(__builtin_ctzll(tokens)));
+      } else {
+        for (; tokens; tokens &= tokens - 1) {
+          if (count_ == MaxStructurals) return _fail(json_error::capacity, base + static_cast<size_t>(__builtin_ctzll(tokens)));
+          index_[count_++] = static_cast<uint32_t>(base + static_cast<size_t>(__builtin_ctzll(tokens)));
+        }
+      }
+    }
+
+    if (in_string) return _fail(json_error::unclosed_string, count_ ? index_[count_ - 1] : 0);
+
+    return json_error::ok;
+  }
+
+  /**
+   * Parses data[0, len) in place and emits the SAX events to handler.
+   * See json_sax_handler_t for the callbacks.
+   */
+  template<typename Handler>
+  json_error parse(char *data, const size_t len, Handler &handler) {
+    if (const json_error err = index(data, len); err != json_error::ok) return err;
+    return _walk(data, len, handler);
+  }
+
+  /** Number of entries in the structural index. */
+  [[nodiscard]] size_t size() const { return count_; }
+
+  /** Offsets of the structural characters, quotes and scalar starts. */
+  [[nodiscard]] const uint32_t *structurals() const { return index_; }
+
+  /** Byte offset where the last error was detected. */
+  [[nodiscard]] size_t error_offset() const { return error_offset_; }
+
+private:
+  json_error _fail(const json_error err, const size_t offset) {
+    error_offset_ = offset;
+    return err;
+  }
+
+  template<typename Handler>
+  json_error _walk(char *data, const size_t len, Handler &handler) {
+    enum class state_t : uint8_t { value, key, after_value };
+
+    if (count_ == 0) return json_error::empty;
+
+    bool    is_object[MaxDepth];
+    size_t  depth = 0;
+    size_t  i     = 0;
+    state_t state = state_t::value;
+
+    for (;;) {
+      if (state == state_t::after_value) {
+        if (depth == 0) {
+          if (i != count_) return _fail(json_error::syntax, index_[i]);
+          return json_error::ok;
+        }
+
+        if (i == count_) return _fail(json_error::syntax, len);
+
+        const size_t pos = index_[i++];
+        const char   c   = data[pos];
+
+        if (c == ',') {
+          state = is_object[depth - 1] ? state_t::key : state_t::value;
+        } else if (c == (is_object[depth - 1] ? '}' : ']')) {
+          --depth;
+          if (!(is_object[depth] ? handler.on_object_end() : handler.on_array_end()))
+            return _fail(json_error::aborted, pos);
+        } else {
+          return _fail(json_error::syntax, pos);
+        }
+        continue;
+      }
+
+      if (i == count_) return _fail(json_error::syntax, len);
+
+      const size_t pos = index_[i];
+      const char   c   = data[pos];
+
+      if (state == state_t::key) {
+        string_view key;
+        if (c != '"') return _fail(json_error::syntax, pos);
+        if (const json_error err = _string(data, i, key); err != json_error::ok) return err;
+        if (!handler.on_key(key)) return _fail(json_error::aborted, pos);
+
+        if (i == count_ || data[index_[i]] != ':') return _fail(json_error::syntax, i == count_ ? len : index_[i]);
+        ++i;
+        state = state_t::value;
+        continue;
+      }
+
+      // state_t::value
+      state = state_t::after_value;
+
+      switch (c) {
+        case '{':
+        case '[': {
+          const bool object = c == '{';
+          if (depth == MaxDepth) return _fail(json_error::depth, pos);
+          if (!(object ? handler.on_object_begin() : handler.on_array_begin())) return _fail(json_error::aborted, pos);
+          ++i;
+
+          // Empty container
+          if (i < count_ && data[index_[i]] == (object ? '}' : ']')) {
+            ++i;
+            if (!(object ? handler.on_object_end() : handler.on_array_end())) return _fail(json_error::aborted, pos);
+            break;
+          }
+
+          is_object[depth++] = object;
+          state              = object ? state_t::key : state_t::value;
+          break;
+        }
+        case '"': {
+          string_view str;
+          if (const json_error err = _string(data, i, str); err != json_error::ok) return err;
+          if (!handler.on_string(str)) return _fail(json_error::aborted, pos);
+          break;
+        }
+        case 't':
+          if (!_literal(data, len, pos, "true", 4)) return _fail(json_error::literal, pos);
+          if (!handler.on_bool(true)) return _fail(json_error::aborted, pos);
+          ++i;
+          break;
+        case 'f':
+          if (!_literal(data, len, pos, "false", 5)) return _fail(json_error::literal, pos);
+          if (!handler.on_bool(false)) return _fail(json_error::aborted, pos);
+          ++i;
+          break;
+        case 'n':
+          if (!_literal(data, len, pos, "null", 4)) return _fail(json_error::literal, pos);
+          if (!handler.on_null()) return _fail(json_error::aborted, pos);
+          ++i;
+          break;
+        case '-':
+        case '0':
+        case '1':
+        case '2':
+        case '3':
+        case '4':
+        case '5':
+        case '6':
+        case '7':
+        case '8':
+        case '9':
+          if (const json_error err = _number(data, len, pos, handler); err != json_error::ok) return err;
+          ++i;
+          break;
+        default:
+          return _fail(json_error::syntax, pos);
+      }
+    }
+  }
+
+  /**
+   * Decodes the string opened at index_[i] and closed at index_[i + 1].
+   */
+  json_error _string(char *data, size_t &i, string_view &out) {
+    // Every unescaped quote is indexed and interiors hold no entries, so the closing quote is next
+    char        *begin = data + index_[i] + 1;
+    const size_t len   = index_[i + 1] - index_[i] - 1;
+
+    if (memchr(begin, '\\', len)) {
+      const ptrdiff_t n = LIB_XCORE_NAMESPACE::detail::json_unescape(begin, begin + len);
+      if (n < 0) return _fail(json_error::escape, index_[i]);
+      out = string_view(begin, static_cast<size_t>(n));
+    } else {
+      out = string_view(begin, len);
+    }
+
+    i += 2;
+    return json_error::ok;
+  }
+
+  static bool _literal(const char *data, const size_t len, const size_t pos, const char *word, const size_t n) {
+    return len - pos >= n && memcmp(data + pos, word, n) == 0 &&
+           (len - pos == n || LIB_XCORE_NAMESPACE::detail::json_is_delimiter(data[pos + n]));
+  }
+
+  template<typename Handler>
+  json_error _number(const char *data, const size_t len, const size_t pos, Handler &handler) {
+    using LIB_XCORE_NAMESPACE::detail::is_digit;
+
+    const char *first = data + pos;
+    const char *last  = data + len;
+    const char *p     = first;
+    bool        integer = true;
+
+    // JSON grammar: -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+    if (p != last && *p == '-') ++p;
+    if (p == last || !is_digit(*p)) return _fail(json_error::number, pos);
+    if (*p == '0') {
+      ++p;
+    } else {
+      while (p != last && is_digit(*p)) ++p;
+    }
+    if (p != last && *p == '.') {
+      integer = false;
+      if (++p == last || !is_digit(*p)) return _fail(json_error::number, pos);
+      while (p != last && is_digit(*p)) ++p;
+    }
+    if (p != last && (*p | 0x20) == 'e') {
+      integer = false;
+      if (++p != last && (*p == '+' || *p == '-')) ++p;
+      if (p == last || !is_digit(*p)) return _fail(json_error::number, pos);
+      while (p != last && is_digit(*p)) ++p;
+    }
+    if (p != last && !LIB_XCORE_NAMESPACE::detail::json_is_delimiter(*p)) return _fail(json_error::number, pos);
+
+    if (integer) {
+      int64_t v;
+      if (from_chars(first, p, v)) {
+        if (!handler.on_integer(v)) return _fail(json_error::aborted, pos);
+        return json_error::ok;
+      }
+    }
+
+    double d;
+    if (!from_chars(first, p, d)) return _fail(json_error::number, pos);
+    if (!handler.on_floating(d)) return _fail(json_error::aborted, pos);
+    return json_error::ok;
+  }
+};
+
+enum class json_type : uint8_t {
+  invalid = 0,
+  null,
+  boolean,
+  integer,
+  floating,
+  string,
+  array,
+  object,
+  key,  // Tape only: member name preceding a value
+  end   // Tape only: closes an array or object
+};
+
+/**
+ * Tape entry of json_document_t (16 bytes on 64-bit targets).
+ */
+struct json_node_t {
+  json_type type;
+  uint32_t  length;  // String length, or number of nodes spanned by an array or object
+  union {
+    int64_t     integer;
+    double      floating;
+    bool        boolean;
+    const char *string;
+    size_t      count;  // Elements of an array or members of an object
+  };
+};
+
+/**
+ * Read-only view of a value in a json_document_t. Lookups that fail return an
+ * invalid view, so chains like doc.root()["a"]["b"][0] need a single check.
+ */
+class json_value_t {
+  const json_node_t *node_ = nullptr;
+
+  static const json_node_t *_skip(const json_node_t *n) {
+    return n + ((n->type == json_type::array || n->type == json_type::object) ? n->length : 1);
+  }
+
+public:
+  json_value_t() = default;
+
+  explicit json_value_t(const json_node_t *node) : node_(node) {}
+
+  [[nodiscard]] json_type type() const { return node_ ? node_->type : json_type::invalid; }
+
+  [[nodiscard]] bool valid() const { return node_ != nullptr; }
+  [[nodiscard]] bool is_null() const { return type() == json_type::null; }
+  [[nodiscard]] bool is_bool() const { return type() == json_type::boolean; }
+  [[nodiscard]] bool is_integer() const { return type() == json_type::integer; }
+  [[nodiscard]] bool is_number() const { return type() == json_type::integer || type() == json_type::floating; }
+  [[nodiscard]] bool is_string() const { return type() == json_type::string; }
+  [[nodiscard]] bool is_array() const { return type() == json_type::array; }
+  [[nodiscard]] bool is_object() const { return type() == json_type::object; }
+
+  explicit operator bool() const { return valid(); }
+
+  [[nodiscard]] optional<bool> to_bool() const {
+    if (!is_bool()) return nullopt;
+    return node_->boolean;
+  }
+
+  [[nodiscard]] optional<int64_t> to_integer() const {
+    if (!is_integer()) return nullopt;
+    return node_->integer;
+  }
+
+  /** Integers are converted. */
+  [[nodiscard]] optional<double> to_double() const {
+    if (is_integer()) return static_cast<double>(node_->integer);
+    if (type() == json_type::floating) return node_->floating;
+    return nullopt;
+  }
+
+  [[nodiscard]] optional<string_view> to_string() const {
+    if (!is_string()) return nullopt;
+    return string_view(node_->string, node_->length);
+  }
+
+  /** Member name when this value belongs to an object, empty otherwise. */
+  [[nodiscard]] string_view key() const {
+    if (!node_ || node_[-1].type != json_type::key) return {};
+    return {node_[-1].string, node_[-1].length};
+  }
+
+  /** Number of elements of an array or members of an object. */
+  [[nodiscard]] size_t size() const {
+    return (is_array() || is_object()) ? node_->count : 0;
+  }
+
+  /** First element of an array or first member value of an object. */
+  [[nodiscard]] json_value_t first() const {
+    if (!(is_array() || is_object())) return {};
+    const json_node_t *n = node_ + 1;
+    if (n->type == json_type::end) return {};
+    return json_value_t(n->type == json_type::key ? n + 1 : n);
+  }
+
+  /** Next element of the enclosing array or object. */
+  [[nodiscard]] json_value_t next() const {
+    if (!node_) return {};
+    const json_node_t *n = _skip(node_);
+    if (n->type == json_type::end) return {};
+    return json_value_t(n->type == json_type::key ? n + 1 : n);
+  }
+
+  /** Member lookup (linear in the number of members). */
+  [[nodiscard]] json_value_t operator[](const string_view name) const {
+    if (!is_object()) return {};
+    for (const json_node_t *n = node_ + 1; n->type == json_type::key; n = _skip(n + 1)) {
+      if (string_view(n->string, n->length) == name) return json_value_t(n + 1);
+    }
+    return {};
+  }
+
+  [[nodiscard]] json_value_t operator[](const char *name) const { return (*this)[string_view(name)]; }
+
+  /** Element lookup (linear in i). */
+  [[nodiscard]] json_value_t operator[](size_t i) const {
+    if (!is_array()) return {};
+    json_value_t v = first();
+    while (v && i--) v = v.next();
+    return v;
+  }
+
+  [[nodiscard]] json_value_t operator[](const int i) const { return (*this)[static_cast<size_t>(i)]; }
+};
+
+/**
+ * Fixed-capacity DOM stored as a tape of json_node_t, built by a
+ * json_parser_t. Strings are views into the parsed buffer; nothing is
+ * allocated. Containers record their span on the tape, so skipping a
+ * subtree is O(1).
+ *
+ * @tparam MaxNodes Capacity of the tape (values + member names + one end node per container)
+ */
+template<size_t MaxNodes>
+class json_document_t : public json_sax_handler_t {
+  static_assert(MaxNodes > 0, "Document must hold at least one value.");
+
+  // nodes_[0] and the node after the last one are sentinels, so views can
+  // look one node behind (key()) and one node ahead (next()) without bounds
+  json_node_t nodes_[MaxNodes + 2];
+  size_t      size_ = 1;
+  size_t      open_ = SIZE_MAX;  // Innermost open container
+
+public:
+  json_document_t() { clear(); }
+
+  json_document_t(const json_document_t &)            = delete;
+  json_document_t &operator=(const json_document_t &) = delete;
+
+  /**
+   * Parses data[0, len) in place with parser and replaces the content.
+   */
+  template<typename Parser>
+  json_error parse(Parser &parser, char *data, const size_t len) {
+    clear();
+    json_error err = parser.parse(data, len, *this);
+    if (err == json_error::aborted) err = json_error::capacity;  // Only a full tape aborts
+
+    if (err != json_error::ok) {
+      clear();
+      return err;
+    }
+
+    nodes_[size_].type = json_type::end;
+    return err;
+  }
+
+  void clear() {
+    nodes_[0].type = json_type::invalid;
+    size_          = 1;
+    open_          = SIZE_MAX;
+  }
+
+  [[nodiscard]] json_value_t root() const { return size_ > 1 ? json_value_t(nodes_ + 1) : json_value_t(); }
+
+  /** Number of tape nodes in use. */
+  [[nodiscard]] size_t size() const { return size_ - 1; }
+
+  [[nodiscard]] static constexpr size_t capacity() { return MaxNodes; }
+
+  // SAX callbacks
+  bool on_null() { return _push(json_type::null) != nullptr; }
+
+  bool on_bool(const bool b) {
+    json_node_t *n = _push(json_type::boolean);
+    if (n) n->boolean = b;
+    return n != nullptr;
+  }
+
+  bool on_integer(const int64_t v) {
+    json_node_t *n = _push(json_type::integer);
+    if (n) n->integer = v;
+    return n != nullptr;
+  }
+
+  bool on_floating(const double v) {
+    json_node_t *n = _push(json_type::floating);
+    if (n) n->floating = v;
+    return n != nullptr;
+  }
+
+  bool on_string(const string_view s) { return _push_string(json_type::string, s); }
+  bool on_key(const string_view s) { return _push_string(json_type::key, s); }
+
+  bool on_object_begin() { return _open(json_type::object); }
+  bool on_array_begin() { return _open(json_type::array); }
+  bool on_object_end() { return _close(); }
+  bool on_array_end() { return _close(); }
+
+private:
+  json_node_t *_push(const json_type type) {
+    if (size_ == MaxNodes + 1) return nullptr;
+
+    // Members of the innermost container are counted on their value
+    if (open_ != SIZE_MAX && type != json_type::key && type != json_type::end) ++nodes_[open_].count;
+
+    json_node_t *n = nodes_ + size_++;
+    n->type        = type;
+    n->length      = 0;
+    return n;
+  }
+
+  bool _push_string(const json_type type, const string_view s) {
+    json_node_t *n = _push(type);
+    if (!n) return false;
+    n->string = s.data();
+    n->length = static_cast<uint32_t>(s.size());
+    return true;
+  }
+
+  bool _open(const json_type type) {
+    json_node_t *n = _push(type);
+    if (!n) return false;
+
+    // length temporarily links to the enclosing container until _close()
+    n->count  = 0;
+    n->length = static_cast<uint32_t>(open_);
+    open_     = static_cast<size_t>(n - nodes_);
+    return true;
+  }
+
+  bool _close() {
+    if (!_push(json_type::end)) return false;
+
+    json_node_t &n = nodes_[open_];
+    const auto   parent = n.length;
+    n.length            = static_cast<uint32_t>(size_ - open_);
+    open_               = parent == UINT32_MAX ? SIZE_MAX : parent;
+    return true;
+  }
+};
+
+LIB_XCORE_END_NAMESPACE
+
+#endif  //LIB_XCORE_UTILS_JSON_PARSER_HPP
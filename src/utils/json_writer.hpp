@@ -0,0 +1,414 @@
+#ifndef LIB_XCORE_UTILS_JSON_WRITER_HPP
+#define LIB_XCORE_UTILS_JSON_WRITER_HPP
+
+#include "internal/macros.hpp"
+#include "core/ported_config.hpp"
+#include "core/ported_std.hpp"
+#include "core/to_chars.hpp"
+#include "core/swar.hpp"
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#  include <emmintrin.h>
+#endif
+
+#if __has_include(<unistd.h>)
+#  include <unistd.h>
+#  include <cerrno>
+#  define XCORE_JSON_FD_SINK 1
+#else
+#  define XCORE_JSON_FD_SINK 0
+#endif
+
+LIB_XCORE_BEGIN_NAMESPACE
+
+namespace detail {
+  /**
+   * Returns the first character of [p, end) that must be escaped in a JSON
+   * string ('"', '\\' or a control character), or end.
+   * Scans 16 bytes per step with SSE2, 8 bytes per step with SWAR otherwise.
+   */
+  inline const char *json_find_escape(const char *p, const char *end) {
+#if defined(__SSE2__)
+    const __m128i quote     = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control   = _mm_set1_epi8(0x1F);
+
+    for (; end - p >= 16; p += 16) {
+      const __m128i v    = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+      const __m128i hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+                                        _mm_cmpeq_epi8(_mm_max_epu8(v, control), control));
+      if (const int mask = _mm_movemask_epi8(hits))
+        return p + __builtin_ctz(static_cast<unsigned>(mask));
+    }
+#endif
+#if XCORE_SWAR_ENABLED
+    for (; end - p >= 8; p += 8) {
+      const uint64_t v    = swar_load(p);
+      const uint64_t hits = swar_byte_mask(v, '"') | swar_byte_mask(v, '\\') | swar_less_mask(v, 0x20);
+      if (hits) return p + swar_first(hits);
+    }
+#endif
+    for (; p != end; ++p) {
+      const auto c = static_cast<unsigned char>(*p);
+      if (c == '"' || c == '\\' || c < 0x20) return p;
+    }
+    return end;
+  }
+}  // namespace detail
+
+/**
+ * JSON sink writing into a caller-provided character array.
+ * The content is kept null-terminated, so one byte of the capacity is reserved.
+ */
+class json_buffer_sink_t {
+  char  *data_;
+  size_t capacity_;
+  size_t size_ = 0;
+
+public:
+  json_buffer_sink_t(char *data, const size_t capacity) : data_(data), capacity_(capacity) {
+    if (capacity_) data_[0] = '\0';
+  }
+
+  bool write(const char *src, const size_t n) {
+    if (size_ + n >= capacity_) return false;
+    memcpy(data_ + size_, src, n);
+    size_ += n;
+    data_[size_] = '\0';
+    return true;
+  }
+
+  bool flush() { return true; }
+
+  void clear() {
+    size_ = 0;
+    if (capacity_) data_[0] = '\0';
+  }
+
+  [[nodiscard]] const char *data() const { return data_; }
+  [[nodiscard]] size_t      size() const { return size_; }
+};
+
+/**
+ * JSON sink pushing into a byte_buffer_t (or any type with push(const unsigned char *, size_t)).
+ */
+template<typename ByteBuffer>
+class json_byte_buffer_sink_t {
+  ByteBuffer *buffer_;
+
+public:
+  explicit json_byte_buffer_sink_t(ByteBuffer &buffer) : buffer_(&buffer) {}
+
+  bool write(const char *src, const size_t n) {
+    return buffer_->push(reinterpret_cast<const unsigned char *>(src), n);
+  }
+
+  bool flush() { return true; }
+
+  [[nodiscard]] ByteBuffer &buffer() const { return *buffer_; }
+};
+
+#if XCORE_JSON_FD_SINK
+/**
+ * JSON sink writing to a file descriptor through a staging buffer,
+ * so small tokens do not each cost a system call.
+ */
+template<size_t StagingSize = 256>
+class json_fd_sink_t {
+  static_assert(StagingSize > 0, "Staging buffer cannot be empty.");
+
+  int    fd_;
+  char   staging_[StagingSize];
+  size_t size_ = 0;
+
+  bool _write_all(const char *src, size_t n) {
+    while (n > 0) {
+      const ssize_t written = ::write(fd_, src, n);
+      if (written < 0) {
+        if (errno == EINTR) continue;
+        return false;
+      }
+      src += written;
+      n -= static_cast<size_t>(written);
+    }
+    return true;
+  }
+
+public:
+  explicit json_fd_sink_t(const int fd) : fd_(fd), staging_{} {}
+
+  json_fd_sink_t(const json_fd_sink_t &)            = delete;
+  json_fd_sink_t &operator=(const json_fd_sink_t &) = delete;
+
+  ~json_fd_sink_t() { flush(); }
+
+  bool write(const char *src, const size_t n) {
+    if (size_ + n <= StagingSize) {
+      memcpy(staging_ + size_, src, n);
+      size_ += n;
+      return true;
+    }
+
+    if (!flush()) return false;
+    if (n >= StagingSize) return _write_all(src, n);
+
+    memcpy(staging_, src, n);
+    size_ = n;
+    return true;
+  }
+
+  bool flush() {
+    const bool ok = _write_all(staging_, size_);
+    size_         = 0;
+    return ok;
+  }
+};
+#endif
+
+/**
+ * Streaming JSON writer. Tokens go straight to the sink: no heap allocation and
+ * no intermediate strings. Strings are escaped while copied, clean runs being
+ * found with SIMD (SSE2) or SWAR scans and written in one piece. Numbers use
+ * xcore::to_chars; non-finite floating points are written as null.
+ *
+ * Misuse (a value without a key inside an object, unbalanced ends, nesting
+ * deeper than MaxDepth) and sink failures clear ok() and stop further output.
+ *
+ * Usage:
+ *   char out[128];
+ *   json_writer_t<json_buffer_sink_t> writer(out, sizeof(out));
+ *   writer.begin_object()
+ *         .member("id", 7)
+ *         .key("pos").begin_array().value(1.5).value(-2).end_array()
+ *         .end_object();
+ *   // out == {"id":7,"pos":[1.5,-2]}
+ *
+ * @tparam Sink      Type with bool write(const char *, size_t) and bool flush()
+ * @tparam MaxDepth  Maximum nesting of objects and arrays
+ */
+template<typename Sink, size_t MaxDepth = 16>
+class json_writer_t {
+  static_assert(MaxDepth > 0, "Depth must be greater than zero.");
+
+  Sink   sink_;
+  bool   is_object_[MaxDepth]{};
+  bool   is_first_[MaxDepth]{};
+  size_t depth_     = 0;
+  bool   after_key_ = false;
+  bool   has_root_  = false;  // A document holds a single top-level value
+  bool   ok_        = true;
+
+public:
+  template<typename... Args>
+  explicit json_writer_t(Args &&...args) : sink_(forward<Args>(args)...) {}
+
+  json_writer_t &begin_object() { return _open(true, '{'); }
+  json_writer_t &end_object() { return _close(true, '}'); }
+  json_writer_t &begin_array() { return _open(false, '['); }
+  json_writer_t &end_array() { return _close(false, ']'); }
+
+  /**
+   * Writes a member name. Must be followed by a value, an object or an array.
+   */
+  json_writer_t &key(const char *name, const size_t len) {
+    if (!ok_) return *this;
+
+    if (depth_ == 0 || !is_object_[depth_ - 1] || after_key_) {
+      ok_ = false;
+      return *this;
+    }
+
+    if (!is_first_[depth_ - 1]) _write(",", 1);
+    is_first_[depth_ - 1] = false;
+
+    _write_string(name, len);
+    _write(":", 1);
+    after_key_ = true;
+    return *this;
+  }
+
+  json_writer_t &key(const char *name) { return key(name, strlen(name)); }
+
+  json_writer_t &value(const char *str, const size_t len) {
+    if (_prefix()) _write_string(str, len);
+    return *this;
+  }
+
+  /** Writes a string, or null for a null pointer. */
+  json_writer_t &value(const char *str) {
+    if (!str) return value(nullptr);
+    return value(str, strlen(str));
+  }
+
+  json_writer_t &value(nullptr_t) {
+    if (_prefix()) _write("null", 4);
+    return *this;
+  }
+
+  json_writer_t &value(const bool b) {
+    if (_prefix()) b ? _write("true", 4) : _write("false", 5);
+    return *this;
+  }
+
+  template<typename T>
+  enable_if_t<is_integral_v<T> && !is_same_v<T, bool>, json_writer_t &> value(const T v) {
+    if (_prefix()) {
+      char                  buf[24];
+      const to_chars_result r = to_chars(buf, buf + sizeof(buf), v);
+      _write(buf, static_cast<size_t>(r.ptr - buf));
+    }
+    return *this;
+  }
+
+  template<typename T>
+  enable_if_t<is_floating_point_v<T>, json_writer_t &> value(const T v) {
+    if (_prefix()) {
+      if (v != v || v - v != v - v) {
+        _write("null", 4);  // NaN and infinities have no JSON representation
+      } else {
+        char                  buf[32];
+        const to_chars_result r = to_chars(buf, buf + sizeof(buf), static_cast<conditional_t<is_same_v<T, float>, float, double>>(v));
+        _write(buf, static_cast<size_t>(r.ptr - buf));
+      }
+    }
+    return *this;
+  }
+
+  /**
+   * Writes pre-encoded JSON as a value, without validation.
+   */
+  json_writer_t &raw_value(const char *json, const size_t len) {
+    if (_prefix()) _write(json, len);
+    return *this;
+  }
+
+  /** Shorthand for key(name).value(v). */
+  template<typename T>
+  json_writer_t &member(const char *name, T &&v) {
+    return key(name).value(forward<T>(v));
+  }
+
+  /** Flushes the sink (e.g. the staging buffer of json_fd_sink_t). */
+  bool flush() {
+    if (!sink_.flush()) ok_ = false;
+    return ok_;
+  }
+
+  /** Forgets the nesting state and errors, e.g. to start a new document. */
+  void reset() {
+    depth_     = 0;
+    after_key_ = false;
+    has_root_  = false;
+    ok_        = true;
+  }
+
+  /** Returns false after a sink failure or misuse. */
+  [[nodiscard]] bool ok() const { return ok_; }
+
+  /** Returns true if every object and array is closed. */
+  [[nodiscard]] bool complete() const { return ok_ && depth_ == 0 && !after_key_; }
+
+  [[nodiscard]] size_t depth() const { return depth_; }
+
+  [[nodiscard]] Sink       &sink() { return sink_; }
+  [[nodiscard]] const Sink &sink() const { return sink_; }
+
+private:
+  void _write(const char *src, const size_t n) {
+    if (ok_ && !sink_.write(src, n)) ok_ = false;
+  }
+
+  /**
+   * Writes the separator expected before a value.
+   *
+   * @return false if no value can be written
+   */
+  bool _prefix() {
+    if (!ok_) return false;
+
+    if (after_key_) {
+      after_key_ = false;
+      return true;
+    }
+
+    if (depth_ == 0) {
+      if (has_root_) ok_ = false;  // Second top-level value: reset() starts a new document
+      has_root_ = true;
+      return ok_;
+    }
+
+    if (is_object_[depth_ - 1]) {
+      ok_ = false;  // Value without a key
+      return false;
+    }
+
+    if (!is_first_[depth_ - 1]) _write(",", 1);
+    is_first_[depth_ - 1] = false;
+    return ok_;
+  }
+
+  json_writer_t &_open(const bool object, const char c) {
+    if (!_prefix()) return *this;
+
+    if (depth_ == MaxDepth) {
+      ok_ = false;
+      return *this;
+    }
+
+    is_object_[depth_] = object;
+    is_first_[depth_]  = true;
+    ++depth_;
+
+    _write(&c, 1);
+    return *this;
+  }
+
+  json_writer_t &_close(const bool object, const char c) {
+    if (!ok_) return *this;
+
+    if (depth_ == 0 || is_object_[depth_ - 1] != object || after_key_) {
+      ok_ = false;
+      return *this;
+    }
+
+    --depth_;
+    _write(&c, 1);
+    return *this;
+  }
+
+  void _write_string(const char *str, const size_t len) {
+    static constexpr char hex[] = "0123456789abcdef";
+
+    const char *end = str + len;
+
+    _write("\"", 1);
+    while (str != end) {
+      const char *stop = LIB_XCORE_NAMESPACE::detail::json_find_escape(str, end);
+      if (stop != str) _write(str, static_cast<size_t>(stop - str));
+      if (stop == end) break;
+
+      const auto c = static_cast<unsigned char>(*stop);
+      switch (c) {
+        case '"': _write("\\\"", 2); break;
+        case '\\': _write("\\\\", 2); break;
+        case '\b': _write("\\b", 2); break;
+        case '\f': _write("\\f", 2); break;
+        case '\n': _write("\\n", 2); break;
+        case '\r': _write("\\r", 2); break;
+        case '\t': _write("\\t", 2); break;
+        default: {
+          const char esc[6] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF]};
+          _write(esc, 6);
+        }
+      }
+      str = stop + 1;
+    }
+    _write("\"", 1);
+  }
+};
+
+LIB_XCORE_END_NAMESPACE
+
+#endif  //LIB_XCORE_UTILS_JSON_WRITER_HPP
@@ -0,0 +1,367 @@
+#ifndef LIB_XCORE_UTILS_QUANTILE_SKETCH_HPP
+#define LIB_XCORE_UTILS_QUANTILE_SKETCH_HPP
+
+#include "internal/macros.hpp"
+#include "core/ported_std.hpp"
+#include "container/array.hpp"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+LIB_XCORE_BEGIN_NAMESPACE
+
+/**
+ * Estimate of one quantile of a stream in five numbers, by the P² algorithm (Jain & Chlamtac,
+ * 1985): no sample is stored.
+ * \n
+ * Five markers track the minimum, the p/2, p and (1 + p)/2 quantiles and the maximum. Each
+ * sample moves the positions of the markers above it; a marker drifting a whole position from
+ * where its quantile should be is moved back, and its height follows the parabola through its
+ * two neighbors. push() is a few comparisons and, at most, three such adjustments.
+ *
+ *   p2_quantile_t p99(0.99);
+ *
+ *   p99.push(latency);
+ *   p99.value();  // Estimate of the 99th percentile
+ *
+ * There is no worst-case bound: the estimate assumes a smooth distribution, and adversarial
+ * orders (a sorted stream) may bias it. On i.i.d. samples of common distributions the rank of
+ * the estimate is typically within 0.5 % of p after a few thousand samples, see
+ * test_quantile_sketch. The first five samples are kept and give exact nearest-rank answers.
+ */
+class p2_quantile_t {
+protected:
+  double p_;
+  double heights_[5]   = {};  // Marker heights, ascending
+  double positions_[5] = {};  // Marker positions, 1-based ranks
+  double desired_[5]   = {};  // Ideal positions
+  double increments_[5];      // Growth of the ideal positions per sample
+  size_t count_ = 0;
+
+  [[nodiscard]] double parabolic(const size_t i, const double d) const noexcept {
+    const double *q = heights_, *n = positions_;
+    return q[i] + d / (n[i + 1] - n[i - 1]) *
+                    ((n[i] - n[i - 1] + d) * (q[i + 1] - q[i]) / (n[i + 1] - n[i]) + (n[i + 1] - n[i] - d) * (q[i] - q[i - 1]) / (n[i] - n[i - 1]));
+  }
+
+  [[nodiscard]] double linear(const size_t i, const int d) const noexcept {
+    const size_t j = d > 0 ? i + 1 : i - 1;
+    return heights_[i] + d * (heights_[j] - heights_[i]) / (positions_[j] - positions_[i]);
+  }
+
+public:
+  /** @param p  Quantile to estimate, in [0, 1] */
+  explicit p2_quantile_t(const double p) noexcept : p_(p), increments_{0, p / 2, p, (1 + p) / 2, 1} {}
+
+  // Methods
+
+  void push(const double x) noexcept {
+    if (count_ < 5) {
+      // Insertion sort of the first samples
+      size_t i = count_++;
+      for (; i > 0 && heights_[i - 1] > x; --i) heights_[i] = heights_[i - 1];
+      heights_[i] = x;
+
+      if (count_ == 5) {
+        for (size_t m = 0; m < 5; ++m) positions_[m] = static_cast<double>(m + 1);
+        desired_[0] = 1;
+        desired_[1] = 1 + 2 * p_;
+        desired_[2] = 1 + 4 * p_;
+        desired_[3] = 3 + 2 * p_;
+        desired_[4] = 5;
+      }
+      return;
+    }
+    ++count_;
+
+    // Cell k of the sample: markers above it move up one position
+    size_t k;
+    if (x < heights_[0]) {
+      heights_[0] = x;
+      k           = 0;
+    } else if (x >= heights_[4]) {
+      heights_[4] = x;
+      k           = 3;
+    } else {
+      k = 0;
+      while (x >= heights_[k + 1]) ++k;
+    }
+
+    for (size_t m = k + 1; m < 5; ++m) positions_[m] += 1;
+    for (size_t m = 0; m < 5; ++m) desired_[m] += increments_[m];
+
+    for (size_t m = 1; m < 4; ++m) {
+      const double drift = desired_[m] - positions_[m];
+      if ((drift >= 1 && positions_[m + 1] - positions_[m] > 1) || (drift <= -1 && positions_[m - 1] - positions_[m] < -1)) {
+        const int    d = drift > 0 ? 1 : -1;
+        const double q = parabolic(m, d);
+        heights_[m]    = heights_[m - 1] < q && q < heights_[m + 1] ? q : linear(m, d);
+        positions_[m] += d;
+      }
+    }
+  }
+
+  void clear() noexcept {
+    count_ = 0;
+  }
+
+  /** @return The estimate of the quantile, NaN if no sample was pushed */
+  [[nodiscard]] double value() const noexcept {
+    if (count_ >= 5) return heights_[2];
+    if (count_ == 0) return ::std::numeric_limits<double>::quiet_NaN();
+
+    const auto rank = static_cast<size_t>(::std::ceil(p_ * static_cast<double>(count_)));
+    return heights_[rank > 0 ? rank - 1 : 0];
+  }
+
+  [[nodiscard]] double min() const noexcept {
+    return heights_[0];
+  }
+
+  [[nodiscard]] double max() const noexcept {
+    return heights_[count_ >= 5 ? 4 : (count_ > 0 ? count_ - 1 : 0)];
+  }
+
+  [[nodiscard]] double quantile() const noexcept {
+    return p_;
+  }
+
+  [[nodiscard]] size_t count() const noexcept {
+    return count_;
+  }
+};
+
+/**
+ * Merging t-digest (Dunning & Ertl, 2019): all quantiles of a stream in a fixed number of
+ * centroids (mean and weight), small near the tails and large near the median, so that p99 and
+ * p999 stay accurate. Digests of separate streams merge into one.
+ * \n
+ * Samples go to a buffer of 4 Compression entries; when it is full, buffer and centroids are
+ * sorted together and swept once, each centroid absorbing its neighbors while their span of
+ * quantiles stays within one unit of the k1 scale k(q) = Compression / (2 pi) asin(2q - 1). This
+ * bounds the weight of a centroid at quantile q to about pi n sqrt(q (1 - q)) / Compression, and
+ * the number of centroids to Compression + 1. push() is O(1) amortized: the buffer is radix
+ * sorted, then swept once with the centroids.
+ *
+ *   t_digest_t<100> residuals;
+ *
+ *   residuals.push(x);
+ *   residuals.quantile(0.999);
+ *   total.merge(residuals);     // E.g. one digest per thread or per node
+ *
+ * quantile() interpolates between centroids and is exact at both ends (min and max are kept).
+ * Its rank error has no worst-case bound, but stays within about half the share of a centroid,
+ * pi sqrt(q (1 - q)) / (2 Compression): for Compression 100, 0.8 % at the median, 0.16 % at p99
+ * and 0.05 % at p999. On i.i.d. samples it is several times lower, see test_quantile_sketch.
+ * Memory is 160 Compression bytes.
+ *
+ * @tparam Compression  Accuracy parameter, the delta of the paper
+ */
+template<size_t Compression = 100>
+class t_digest_t {
+  static_assert(Compression >= 10, "Compression must be at least 10.");
+
+public:
+  struct centroid_t {
+    double mean;
+    double weight;
+  };
+
+  static constexpr size_t max_centroids = 2 * Compression;  // Twice the bound, for rounding
+  static constexpr size_t buffer_size   = 4 * Compression;
+
+protected:
+  static constexpr double pi = 3.14159265358979323846;
+
+  array_t<centroid_t, max_centroids + buffer_size> centroids_;  // Merged in [0, merged_), then buffered
+  array_t<centroid_t, buffer_size>                 scratch_;    // Radix sort and sweep output
+  size_t                                           merged_   = 0;
+  size_t                                           buffered_ = 0;
+  double                                           weight_   = 0;
+  double                                           min_      = ::std::numeric_limits<double>::infinity();
+  double                                           max_      = -::std::numeric_limits<double>::infinity();
+
+  [[nodiscard]] static double k_scale(const double q) noexcept {
+    return static_cast<double>(Compression) / (2 * pi) * ::std::asin(q < 1 ? 2 * q - 1 : 1);
+  }
+
+  [[nodiscard]] static double k_inverse(const double k) noexcept {
+    const double angle = k * 2 * pi / static_cast<double>(Compression);
+    if (angle >= pi / 2) return 1;
+    return (::std::sin(angle) + 1) / 2;
+  }
+
+  /** Bits of a double, as an unsigned integer in the same order. */
+  [[nodiscard]] static uint64_t sort_key(const double x) noexcept {
+    uint64_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    return bits & (uint64_t(1) << 63) ? ~bits : bits | (uint64_t(1) << 63);
+  }
+
+  /**
+   * LSD radix sort of the buffer by mean, a byte per pass, skipping the bytes all means share.
+   * A comparison sort mispredicts about one branch per comparison on random samples, and made
+   * push() more than twice as slow in bench_quantile_sketch.
+   */
+  void sort_buffer() noexcept {
+    uint32_t counts[8][256] = {};
+
+    centroid_t  *src = static_cast<centroid_t *>(centroids_) + merged_;
+    centroid_t  *dst = scratch_;
+    const size_t n   = buffered_;
+
+    for (size_t i = 0; i < n; ++i) {
+      const uint64_t key = sort_key(src[i].mean);
+      for (size_t pass = 0; pass < 8; ++pass) ++counts[pass][(key >> (8 * pass)) & 0xFF];
+    }
+
+    for (size_t pass = 0; pass < 8; ++pass) {
+      uint32_t *count = counts[pass];
+      if (count[(sort_key(src[0].mean) >> (8 * pass)) & 0xFF] == n) continue;
+
+      uint32_t offset = 0;
+      for (size_t d = 0; d < 256; ++d) {
+        const uint32_t c  = count[d];
+        count[d]          = offset;
+        offset           += c;
+      }
+      for (size_t i = 0; i < n; ++i) dst[count[(sort_key(src[i].mean) >> (8 * pass)) & 0xFF]++] = src[i];
+      swap(src, dst);
+    }
+
+    if (src != static_cast<centroid_t *>(centroids_) + merged_) copy(src, src + n, static_cast<centroid_t *>(centroids_) + merged_);
+  }
+
+public:
+  t_digest_t() = default;
+
+  // Methods
+
+  /** Adds a sample, or a centroid of weight samples at mean; neither may be NaN. */
+  void push(const double x, const double weight = 1) {
+    if (buffered_ == buffer_size) flush();
+
+    centroids_[merged_ + buffered_++] = {x, weight};
+    weight_                          += weight;
+    if (x < min_) min_ = x;
+    if (x > max_) max_ = x;
+  }
+
+  /** Adds the samples of another digest, as its centroids. */
+  void merge(const t_digest_t &other) {
+    for (size_t i = 0; i < other.merged_ + other.buffered_; ++i) push(other.centroids_[i].mean, other.centroids_[i].weight);
+    if (other.min_ < min_) min_ = other.min_;
+    if (other.max_ > max_) max_ = other.max_;
+  }
+
+  /** Merges the buffered samples into the centroids; quantile() and cdf() do it as needed. */
+  void flush() {
+    if (buffered_ == 0) return;
+    sort_buffer();
+
+    // Greedy sweep over the centroids and the sorted buffer, in order of mean: the current
+    // centroid absorbs the next while the quantiles they span stay within one unit of k
+    const centroid_t *a = centroids_, *a_end = a + merged_;
+    const centroid_t *b = a_end, *b_end = b + buffered_;
+    const auto        next = [&]() { return b == b_end || (a != a_end && a->mean <= b->mean) ? *a++ : *b++; };
+
+    centroid_t *out     = scratch_;
+    double      before  = 0;  // Weight of the centroids already written
+    double      limit   = weight_ * k_inverse(k_scale(0) + 1);
+    centroid_t  current = next();
+
+    while (a != a_end || b != b_end) {
+      const centroid_t c        = next();
+      const double     combined = current.weight + c.weight;
+
+      if (before + combined <= limit) {
+        current.mean  += (c.mean - current.mean) * c.weight / combined;
+        current.weight = combined;
+      } else {
+        *out++   = current;
+        before  += current.weight;
+        limit    = weight_ * k_inverse(k_scale(before / weight_) + 1);
+        current  = c;
+      }
+    }
+    *out++ = current;
+
+    merged_   = static_cast<size_t>(out - static_cast<centroid_t *>(scratch_));
+    buffered_ = 0;
+    copy(static_cast<centroid_t *>(scratch_), out, static_cast<centroid_t *>(centroids_));
+  }
+
+  void clear() noexcept {
+    merged_   = 0;
+    buffered_ = 0;
+    weight_   = 0;
+    min_      = ::std::numeric_limits<double>::infinity();
+    max_      = -::std::numeric_limits<double>::infinity();
+  }
+
+  /**
+   * @return The estimate of the q-quantile, q in [0, 1], NaN if empty. Centroid means sit at the
+   * middle of their weight, and the answer is interpolated between them, or towards min and max.
+   */
+  [[nodiscard]] double quantile(const double q) {
+    if (weight_ == 0) return ::std::numeric_limits<double>::quiet_NaN();
+    if (q <= 0) return min_;
+    if (q >= 1) return max_;
+    flush();
+
+    const double index = q * weight_;
+    double       x0 = 0, y0 = min_, cumulative = 0;
+
+    for (size_t i = 0; i < merged_; ++i) {
+      const double x = cumulative + centroids_[i].weight / 2;
+      if (index < x) return y0 + (centroids_[i].mean - y0) * (index - x0) / (x - x0);
+      x0          = x;
+      y0          = centroids_[i].mean;
+      cumulative += centroids_[i].weight;
+    }
+    return y0 + (max_ - y0) * (index - x0) / (weight_ - x0);
+  }
+
+  /** @return The estimate of the fraction of samples at or below x, NaN if empty */
+  [[nodiscard]] double cdf(const double x) {
+    if (weight_ == 0) return ::std::numeric_limits<double>::quiet_NaN();
+    if (x < min_) return 0;
+    if (x >= max_) return 1;
+    flush();
+
+    double x0 = min_, w0 = 0, cumulative = 0;
+    for (size_t i = 0; i < merged_; ++i) {
+      const double mean = centroids_[i].mean;
+      const double w    = cumulative + centroids_[i].weight / 2;
+      if (x < mean) return (w0 + (w - w0) * (x - x0) / (mean - x0)) / weight_;
+      x0          = mean;
+      w0          = w;
+      cumulative += centroids_[i].weight;
+    }
+    return (w0 + (weight_ - w0) * (x - x0) / (max_ - x0)) / weight_;
+  }
+
+  /** @return The number of samples pushed, or their total weight */
+  [[nodiscard]] double count() const noexcept {
+    return weight_;
+  }
+
+  [[nodiscard]] double min() const noexcept {
+    return min_;
+  }
+
+  [[nodiscard]] double max() const noexcept {
+    return max_;
+  }
+
+  /** @return The number of centroids, after flush() */
+  [[nodiscard]] size_t centroids() const noexcept {
+    return merged_;
+  }
+};
+
+LIB_XCORE_END_NAMESPACE
+
+#endif  //LIB_XCORE_UTILS_QUANTILE_SKETCH_HPP
@@ -150,6 +150,10 @@ namespace detail {
     size_t m_size            = {};
     Task   m_tasks[MaxTasks] = {};
 
+    // Frame arena flipped at the start of each pass, see attach_frame_arena()
+    void  *m_frame_arena           = nullptr;
+    void (*m_frame_begin)(void *) = nullptr;
+
   public:
     task_dispatcher_impl()                                 = default;
     task_dispatcher_impl(const task_dispatcher_impl &)     = default;
@@ -184,7 +188,33 @@ namespace detail {
       return *this;
     }
 
+    /**
+     * Starts a new frame of arena (a frame_arena_t, or any type with flip()) at the start of every
+     * pass of operator()(). Tasks reach the arena through their argument, either the arena itself
+     * or a context holding a pointer to it, or through frame_arena().
+     */
+    template<typename Arena>
+    task_dispatcher_impl &attach_frame_arena(Arena &arena) {
+      m_frame_arena = &arena;
+      m_frame_begin = [](void *ptr) { static_cast<Arena *>(ptr)->flip(); };
+      return *this;
+    }
+
+    void detach_frame_arena() {
+      m_frame_arena = nullptr;
+      m_frame_begin = nullptr;
+    }
+
+    template<typename Arena>
+    [[nodiscard]] Arena *frame_arena() const {
+      return static_cast<Arena *>(m_frame_arena);
+    }
+
     void operator()() {
+      if (m_frame_begin != nullptr) {
+        m_frame_begin(m_frame_arena);
+      }
+
       for (size_t i = 0; i < m_size; ++i) {
         m_tasks[i]();
       }
@@ -0,0 +1,340 @@
+#ifndef LIB_XCORE_UTILS_TIMING_WHEEL_HPP
+#define LIB_XCORE_UTILS_TIMING_WHEEL_HPP
+
+#include "internal/macros.hpp"
+#include "core/ported_std.hpp"
+#include <cstdint>
+
+LIB_XCORE_BEGIN_NAMESPACE
+
+/**
+ * Up to Capacity one-shot timers in a hierarchical timing wheel (Varghese & Lauck), for
+ * thousands of timeouts where a nonblocking_delay each would poll and compare every one of them
+ * on every loop: per-peer retransmits, cache expiry, watchdogs.
+ * \n
+ * Each level has 64 slots, each slot a list of timers. Level 0 slots are single ticks; a slot of
+ * level l spans 64^l ticks, so Levels levels cover 64^Levels ticks ahead, and timers further away
+ * wait in an overflow list. A timer goes to the lowest level whose slot tells its expiry apart
+ * from the current tick; once the wheel reaches that slot, its timers move down to finer levels,
+ * at most Levels times each, until they fire from level 0. schedule() and cancel() are O(1), and
+ * update() jumps from one non-empty slot to the next using a bitmap of each level, so idle ticks
+ * cost nothing.
+ *
+ *   uint32_t millis();
+ *   timing_wheel_t<4096, 3, millis> timers;          // 1 ms ticks, 262 s before overflow
+ *
+ *   auto h = timers.schedule(200, on_timeout, peer);  // on_timeout(peer) in 200 ms
+ *   timers.cancel(h);                                 // Acknowledged in time
+ *   timers.update();                                  // In the main loop
+ *
+ * The unit of time is that of TimeFunc, which may wrap around if unsigned. Callbacks run from
+ * update() and may schedule or cancel timers, including themselves.
+ *
+ * @tparam Capacity  Maximum number of pending timers
+ * @tparam Levels    Number of wheels, from 1 to 10
+ * @tparam TimeFunc  Function returning the current time, as an integer
+ */
+template<size_t Capacity, size_t Levels, auto TimeFunc>
+class timing_wheel_t {
+  static_assert(Capacity > 0 && Capacity < 0xFFFFFFFFu, "Capacity must be in [1, 2^32 - 1).");
+  static_assert(Levels > 0 && Levels <= 10, "Levels must be in [1, 10].");
+
+public:
+  using TimeT      = decltype(TimeFunc());
+  using callback_t = void (*)(void *);
+
+  static_assert(is_integral_v<TimeT>, "TimeFunc must return an integer.");
+
+  /**
+   * Timer and generation of the timer; stale once the timer fired or was cancelled. The default
+   * handle is null and never valid.
+   */
+  struct handle_t {
+    uint32_t index      = 0xFFFFFFFFu;
+    uint32_t generation = 0;
+
+    constexpr explicit operator bool() const noexcept {
+      return index != 0xFFFFFFFFu;
+    }
+
+    constexpr bool operator==(const handle_t &other) const noexcept {
+      return index == other.index && generation == other.generation;
+    }
+
+    constexpr bool operator!=(const handle_t &other) const noexcept {
+      return !(*this == other);
+    }
+  };
+
+protected:
+  static constexpr uint32_t slot_bits  = 6;
+  static constexpr uint32_t slots      = 1u << slot_bits;
+  static constexpr uint32_t nil        = 0xFFFFFFFFu;
+  static constexpr uint32_t overflow   = Levels * slots;  // List of timers beyond the last level
+  static constexpr uint32_t firing     = overflow + 1;    // List of timers due in update()
+  static constexpr uint32_t list_count = firing + 1;
+
+  struct node_t {
+    uint64_t   expiry;
+    callback_t callback;
+    void      *arg;
+    uint32_t   next;
+    uint32_t   prev;
+    uint32_t   list;        // List holding the timer, nil if free
+    uint32_t   generation;  // Incremented when the timer is released
+  };
+
+  node_t   nodes_[Capacity] = {};
+  uint32_t heads_[list_count];
+  uint64_t occupied_[Levels] = {};  // Non-empty slots of each level
+  uint64_t now_              = 0;   // Ticks processed, timers up to now_ have fired
+  uint64_t time_             = 0;   // Ticks at last_time_
+  TimeT    last_time_        = TimeFunc();
+  uint32_t free_head_        = nil;
+  uint32_t carved_           = 0;   // Timers used at least once
+  uint32_t size_             = 0;
+
+  FORCE_INLINE static constexpr uint32_t digit(const uint64_t ticks, const uint32_t level) noexcept {
+    return static_cast<uint32_t>(ticks >> (level * slot_bits)) & (slots - 1);
+  }
+
+  void link(const uint32_t index, const uint32_t list) noexcept {
+    node_t &node = nodes_[index];
+    node.list    = list;
+    node.prev    = nil;
+    node.next    = heads_[list];
+    if (node.next != nil) nodes_[node.next].prev = index;
+    heads_[list] = index;
+
+    if (list < overflow) occupied_[list / slots] |= uint64_t(1) << (list % slots);
+  }
+
+  void unlink(const uint32_t index) noexcept {
+    node_t &node = nodes_[index];
+    if (node.prev != nil) nodes_[node.prev].next = node.next;
+    else heads_[node.list] = node.next;
+    if (node.next != nil) nodes_[node.next].prev = node.prev;
+
+    if (node.list < overflow && heads_[node.list] == nil) occupied_[node.list / slots] &= ~(uint64_t(1) << (node.list % slots));
+  }
+
+  /**
+   * Links a timer into the lowest level telling its expiry apart from now_: the level of the
+   * highest base-64 digit where they differ, in the slot of that digit of the expiry.
+   */
+  void place(const uint32_t index) noexcept {
+    const uint64_t expiry = nodes_[index].expiry;
+    const uint64_t diff   = expiry ^ now_;
+
+    uint32_t level = 0;
+    while (level < Levels && (diff >> ((level + 1) * slot_bits)) != 0) ++level;
+
+    link(index, level < Levels ? level * slots + digit(expiry, level) : overflow);
+  }
+
+  void release(const uint32_t index) noexcept {
+    node_t &node = nodes_[index];
+    node.list    = nil;
+    ++node.generation;
+    node.next  = free_head_;
+    free_head_ = index;
+    --size_;
+  }
+
+  /** @return The first tick after now_ at which a non-empty slot, or the overflow list, is due */
+  [[nodiscard]] uint64_t next_event() const noexcept {
+    uint64_t next = ~uint64_t(0);
+
+    for (uint32_t level = 0; level < Levels; ++level) {
+      const uint32_t d    = digit(now_, level);
+      const uint64_t mask = d + 1 < slots ? occupied_[level] & (~uint64_t(0) << (d + 1)) : 0;
+      if (mask == 0) continue;
+
+      const uint32_t shift = (level + 1) * slot_bits;
+      const uint64_t at    = (now_ >> shift << shift) | static_cast<uint64_t>(__builtin_ctzll(mask)) << (level * slot_bits);
+      if (at < next) next = at;
+    }
+
+    if (heads_[overflow] != nil) {
+      const uint32_t shift = Levels * slot_bits;
+      const uint64_t at    = ((now_ >> shift) + 1) << shift;
+      if (at < next) next = at;
+    }
+    return next;
+  }
+
+  /** Moves the timers of a list to where they belong now: finer levels, or the overflow list again. */
+  void cascade(const uint32_t list) noexcept {
+    // Detached first: timers of the overflow list may go back to it
+    uint32_t index = heads_[list];
+    heads_[list]   = nil;
+    if (list < overflow) occupied_[list / slots] &= ~(uint64_t(1) << (list % slots));
+
+    while (index != nil) {
+      const uint32_t next = nodes_[index].next;
+      place(index);
+      index = next;
+    }
+  }
+
+  /** Processes tick now_: redistributes the slots reached at every level, then fires level 0. */
+  size_t process_tick() {
+    if (heads_[overflow] != nil && (now_ & ((uint64_t(1) << (Levels * slot_bits)) - 1)) == 0) cascade(overflow);
+
+    for (uint32_t level = Levels - 1; level > 0; --level) {
+      if ((now_ & ((uint64_t(1) << (level * slot_bits)) - 1)) != 0) continue;
+      const uint32_t list = level * slots + digit(now_, level);
+      if (heads_[list] != nil) cascade(list);
+    }
+
+    const uint32_t list = digit(now_, 0);
+    if (heads_[list] == nil) return 0;
+
+    // Moved aside first, so that callbacks may schedule into this slot or cancel pending timers
+    while (heads_[list] != nil) {
+      const uint32_t index = heads_[list];
+      unlink(index);
+      link(index, firing);
+    }
+
+    size_t fired = 0;
+    while (heads_[firing] != nil) {
+      const uint32_t   index    = heads_[firing];
+      const callback_t callback = nodes_[index].callback;
+      void *const      arg      = nodes_[index].arg;
+      unlink(index);
+      release(index);
+
+      if (callback != nullptr) callback(arg);
+      ++fired;
+    }
+    return fired;
+  }
+
+public:
+  timing_wheel_t() noexcept {
+    for (uint32_t &head: heads_) head = nil;
+  }
+
+  timing_wheel_t(const timing_wheel_t &)            = delete;
+  timing_wheel_t &operator=(const timing_wheel_t &) = delete;
+
+  // Methods
+
+  /**
+   * Schedules callback(arg) in delay units of time from now; a delay of 0 fires on the next
+   * update() that sees the time move.
+   *
+   * @return The handle of the timer, or a null handle if Capacity timers are pending
+   */
+  handle_t schedule(const TimeT delay, const callback_t callback, void *arg = nullptr) noexcept {
+    uint32_t index;
+
+    if (free_head_ != nil) {
+      index      = free_head_;
+      free_head_ = nodes_[index].next;
+    } else if (carved_ < Capacity) {
+      index = carved_++;
+    } else {
+      return handle_t{};
+    }
+
+    const auto elapsed = static_cast<TimeT>(TimeFunc() - last_time_);
+    node_t    &node    = nodes_[index];
+    node.expiry        = time_ + static_cast<uint64_t>(elapsed) + static_cast<uint64_t>(delay > 0 ? delay : 1);
+    node.callback      = callback;
+    node.arg           = arg;
+    place(index);
+    ++size_;
+
+    return handle_t{index, node.generation};
+  }
+
+  /**
+   * Cancels a pending timer.
+   *
+   * @return false if the handle is null, or its timer already fired or was cancelled
+   */
+  bool cancel(const handle_t handle) noexcept {
+    if (!pending(handle)) return false;
+
+    unlink(handle.index);
+    release(handle.index);
+    return true;
+  }
+
+  /**
+   * Moves a pending timer to delay units of time from now, as a watchdog kick, without changing
+   * its handle.
+   *
+   * @return false if the timer is no longer pending
+   */
+  bool reschedule(const handle_t handle, const TimeT delay) noexcept {
+    if (!pending(handle)) return false;
+
+    const auto elapsed = static_cast<TimeT>(TimeFunc() - last_time_);
+    unlink(handle.index);
+    nodes_[handle.index].expiry = time_ + static_cast<uint64_t>(elapsed) + static_cast<uint64_t>(delay > 0 ? delay : 1);
+    place(handle.index);
+    return true;
+  }
+
+  [[nodiscard]] bool pending(const handle_t handle) const noexcept {
+    return handle.index < carved_ && nodes_[handle.index].list != nil && nodes_[handle.index].generation == handle.generation;
+  }
+
+  /**
+   * Reads TimeFunc and fires every timer that expired since the last call, in order of expiry.
+   *
+   * @return The number of timers fired
+   */
+  size_t update() {
+    const TimeT time   = TimeFunc();
+    time_             += static_cast<uint64_t>(static_cast<TimeT>(time - last_time_));
+    last_time_         = time;
+
+    size_t fired = 0;
+    while (now_ < time_) {
+      const uint64_t next = next_event();
+      if (next > time_) {
+        now_ = time_;
+        break;
+      }
+
+      now_ = next;
+      fired += process_tick();
+    }
+    return fired;
+  }
+
+  /** Cancels every timer; all handles become stale. */
+  void clear() noexcept {
+    for (uint32_t i = 0; i < carved_; ++i) {
+      if (nodes_[i].list != nil) {
+        unlink(i);
+        release(i);
+      }
+    }
+  }
+
+  [[nodiscard]] constexpr size_t size() const noexcept {
+    return size_;
+  }
+
+  [[nodiscard]] constexpr bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  [[nodiscard]] constexpr size_t capacity() const noexcept {
+    return Capacity;
+  }
+
+  /** @return The number of ticks a timer can be scheduled ahead before going to the overflow list */
+  [[nodiscard]] static constexpr uint64_t horizon() noexcept {
+    return uint64_t(1) << (Levels * slot_bits);
+  }
+};
+
+LIB_XCORE_END_NAMESPACE
+
+#endif  //LIB_XCORE_UTILS_TIMING_WHEEL_HPP
@@ -0,0 +1,381 @@
+#ifndef LIB_XCORE_UTILS_WINDOW_STATS_HPP
+#define LIB_XCORE_UTILS_WINDOW_STATS_HPP
+
+#include "internal/macros.hpp"
+#include "core/ported_std.hpp"
+#include "core/ported_type_traits.hpp"
+#include "container/array.hpp"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+LIB_XCORE_BEGIN_NAMESPACE
+
+namespace detail {
+  /** Sorted copy of the window of a window_stats_t, empty without Ordered. */
+  template<typename Tp, size_t Capacity, bool Enabled>
+  struct window_stats_sorted_t {
+    array_t<Tp, Capacity> samples = {};  // Window in ascending order
+  };
+
+  template<typename Tp, size_t Capacity>
+  struct window_stats_sorted_t<Tp, Capacity, false> {};
+}  // namespace detail
+
+/**
+ * Statistics of the last Capacity samples of a stream: count, sum, mean, variance, min, max and,
+ * unlike sampler_t which counts against a single threshold, the number of samples below any
+ * threshold, without a recount when the threshold changes.
+ * \n
+ * The samples are kept in a ring. Sum, mean and variance follow Welford's update, which also
+ * runs backwards to take out the sample leaving the window. Min and max come from two monotonic
+ * deques: each holds the samples that can still become the extreme of the window, so each sample
+ * enters and leaves them once, O(1) amortized. With Ordered, a sorted copy of the window is kept
+ * as well, so counts against a threshold and quantiles are binary searches, O(log N), and any
+ * number of thresholds can be queried at once.
+ * \n
+ * push() is O(1) amortized by default. Ordered is opt-in: push() then also shifts the sorted
+ * samples between the positions of the leaving and entering ones, a single memmove, O(N) at
+ * worst, of about N / 3 samples on average for random data.
+ *
+ *   window_stats_t<float, 256> rate;                  // push() is O(1), no order statistics
+ *
+ *   window_stats_t<float, 256, true> latency;         // Ordered: push() is O(N)
+ *
+ *   latency.push(dt);
+ *   latency.mean(); latency.stddev(); latency.max();  // O(1)
+ *   latency.count_at_least(deadline);                 // O(log N), any deadline
+ *   latency.quantile(0.99);                           // O(1)
+ *
+ * Floating-point samples must not be NaN. Sums of integer samples are exact; mean and variance
+ * are computed in double.
+ *
+ * @tparam Tp        Sample Type, arithmetic
+ * @tparam Capacity  Window length, in samples
+ * @tparam Ordered   Keep the sorted window, for thresholds and quantiles, at O(N) per push();
+ *                   no storage without it
+ */
+template<typename Tp, size_t Capacity, bool Ordered = false>
+class window_stats_t {
+  static_assert(Capacity > 0, "Capacity must be greater than zero.");
+  static_assert(is_arithmetic<Tp>::value, "Tp must be an arithmetic type.");
+
+public:
+  /** Type of sum(): 64-bit integer for integer samples, double otherwise. */
+  using sum_t = conditional_t<is_integral_v<Tp>, conditional_t<is_signed_v<Tp>, int64_t, uint64_t>, double>;
+
+protected:
+  /** Sequence numbers of the samples that may still become the min (or max) of the window. */
+  struct deque_t {
+    array_t<uint64_t, Capacity> seq   = {};
+    size_t                      front = 0;
+    size_t                      size  = 0;
+
+    [[nodiscard]] uint64_t first() const noexcept {
+      return seq[front];
+    }
+
+    [[nodiscard]] uint64_t last() const noexcept {
+      return seq[(front + size - 1) % Capacity];
+    }
+  };
+
+  using sorted_t = LIB_XCORE_NAMESPACE::detail::window_stats_sorted_t<Tp, Capacity, Ordered>;
+
+  array_t<Tp, Capacity> ring_   = {};  // Sample of sequence number s at s % Capacity
+  sorted_t              sorted_ = {};  // Window in ascending order, if Ordered
+  deque_t               min_    = {};  // Increasing values
+  deque_t               max_    = {};  // Decreasing values
+  uint64_t              seq_    = 0;   // Samples pushed so far
+  size_t                size_   = 0;
+  sum_t                 sum_    = 0;
+  double                mean_   = 0;
+  double                m2_     = 0;   // Sum of squared deviations from the mean
+
+  [[nodiscard]] const Tp &sample(const uint64_t seq) const noexcept {
+    return ring_[seq % Capacity];
+  }
+
+  template<bool Min>
+  void deque_push(deque_t &d, const uint64_t seq, const Tp &x) noexcept {
+    while (d.size > 0 && (Min ? !(sample(d.last()) < x) : !(x < sample(d.last())))) --d.size;
+    d.seq[(d.front + d.size++) % Capacity] = seq;
+  }
+
+  void deque_expire(deque_t &d, const uint64_t seq) noexcept {
+    if (d.size > 0 && d.first() == seq) {
+      d.front = (d.front + 1) % Capacity;
+      --d.size;
+    }
+  }
+
+  /** @return The number of sorted samples below x */
+  [[nodiscard]] size_t lower_bound(const Tp &x) const noexcept {
+    size_t first = 0, count = size_;
+    while (count > 0) {
+      const size_t half = count / 2;
+      if (sorted_.samples[first + half] < x) {
+        first += half + 1;
+        count -= half + 1;
+      } else {
+        count = half;
+      }
+    }
+    return first;
+  }
+
+  /** @return The number of sorted samples not above x */
+  [[nodiscard]] size_t upper_bound(const Tp &x) const noexcept {
+    size_t first = 0, count = size_;
+    while (count > 0) {
+      const size_t half = count / 2;
+      if (!(x < sorted_.samples[first + half])) {
+        first += half + 1;
+        count -= half + 1;
+      } else {
+        count = half;
+      }
+    }
+    return first;
+  }
+
+  /**
+   * Moves the sorted sample at from out and x in: only the samples between the two positions
+   * shift. from == size_ inserts without removing.
+   */
+  void sorted_replace(const size_t from, const Tp &x) noexcept {
+    Tp          *s  = sorted_.samples;
+    const size_t to = lower_bound(x);
+
+    if (to > from) {
+      memmove(s + from, s + from + 1, (to - from - 1) * sizeof(Tp));
+      s[to - 1] = x;
+    } else {
+      memmove(s + to + 1, s + to, (from - to) * sizeof(Tp));
+      s[to] = x;
+    }
+  }
+
+  void sorted_erase(const size_t pos) noexcept {
+    Tp *s = sorted_.samples;
+    memmove(s + pos, s + pos + 1, (size_ - pos - 1) * sizeof(Tp));
+  }
+
+  /** Welford's update run backwards: the moments of the window without x, of n - 1 samples. */
+  void moments_remove(const double x) noexcept {
+    const size_t n = size_;
+    if (n <= 1) {
+      mean_ = 0;
+      m2_   = 0;
+      return;
+    }
+
+    const double mean = mean_ - (x - mean_) / static_cast<double>(n - 1);
+    m2_              -= (x - mean) * (x - mean_);
+    mean_             = mean;
+    if (m2_ < 0) m2_ = 0;
+  }
+
+public:
+  window_stats_t() = default;
+
+  // Methods
+
+  /** Adds a sample; once Capacity samples are held, the oldest one leaves the window. */
+  void push(const Tp &x) {
+    const uint64_t seq = seq_++;
+
+    if (size_ == Capacity) {
+      const uint64_t old_seq = seq - Capacity;
+      const Tp       old     = sample(old_seq);
+
+      deque_expire(min_, old_seq);
+      deque_expire(max_, old_seq);
+      if constexpr (Ordered) sorted_replace(lower_bound(old), x);
+
+      // Welford's update with one sample replaced by another, n unchanged
+      const double n    = static_cast<double>(size_);
+      const double xn   = static_cast<double>(x);
+      const double xo   = static_cast<double>(old);
+      const double mean = mean_ + (xn - xo) / n;
+      m2_              += (xn - xo) * (xn - mean + xo - mean_);
+      mean_             = mean;
+      if (m2_ < 0) m2_ = 0;
+
+      sum_ += static_cast<sum_t>(x) - static_cast<sum_t>(old);
+    } else {
+      if constexpr (Ordered) sorted_replace(size_, x);
+      ++size_;
+
+      const double xn  = static_cast<double>(x);
+      const double d   = xn - mean_;
+      mean_           += d / static_cast<double>(size_);
+      m2_             += d * (xn - mean_);
+
+      sum_ += static_cast<sum_t>(x);
+    }
+
+    ring_[seq % Capacity] = x;
+    deque_push<true>(min_, seq, x);
+    deque_push<false>(max_, seq, x);
+  }
+
+  /**
+   * Removes the oldest sample, e.g. to expire samples by age rather than by count.
+   *
+   * @return false if the window is empty
+   */
+  bool pop() {
+    if (size_ == 0) return false;
+
+    const uint64_t old_seq = seq_ - size_;
+    const Tp       old     = sample(old_seq);
+
+    deque_expire(min_, old_seq);
+    deque_expire(max_, old_seq);
+    if constexpr (Ordered) sorted_erase(lower_bound(old));
+    moments_remove(static_cast<double>(old));
+    sum_ -= static_cast<sum_t>(old);
+    --size_;
+    return true;
+  }
+
+  void clear() noexcept {
+    min_  = {};
+    max_  = {};
+    size_ = 0;
+    sum_  = 0;
+    mean_ = 0;
+    m2_   = 0;
+  }
+
+  /**
+   * Recomputes mean and variance from the window, O(N). Replacing samples rounds them a little
+   * each time; over many windows of large, nearly equal values, call this now and then.
+   */
+  void resync() noexcept {
+    double mean = 0, m2 = 0;
+    for (size_t i = 0; i < size_; ++i) {
+      const double x  = static_cast<double>(sample(seq_ - size_ + i));
+      const double d  = x - mean;
+      mean           += d / static_cast<double>(i + 1);
+      m2             += d * (x - mean);
+    }
+    mean_ = mean;
+    m2_   = m2;
+  }
+
+  // Moments
+
+  [[nodiscard]] sum_t sum() const noexcept {
+    return sum_;
+  }
+
+  /** @return The mean of the window, 0 if empty */
+  [[nodiscard]] double mean() const noexcept {
+    return mean_;
+  }
+
+  /** @return The population variance of the window, 0 if empty */
+  [[nodiscard]] double variance() const noexcept {
+    return size_ > 0 ? m2_ / static_cast<double>(size_) : 0;
+  }
+
+  /** @return The sample variance (n - 1 denominator), 0 below two samples */
+  [[nodiscard]] double sample_variance() const noexcept {
+    return size_ > 1 ? m2_ / static_cast<double>(size_ - 1) : 0;
+  }
+
+  [[nodiscard]] double stddev() const noexcept {
+    return ::std::sqrt(variance());
+  }
+
+  /** Unchecked: the window must not be empty. */
+  [[nodiscard]] const Tp &min() const noexcept {
+    return sample(min_.first());
+  }
+
+  /** Unchecked: the window must not be empty. */
+  [[nodiscard]] const Tp &max() const noexcept {
+    return sample(max_.first());
+  }
+
+  // Order statistics, with Ordered
+
+  /** @return The number of samples strictly below threshold, O(log N) */
+  [[nodiscard]] size_t count_below(const Tp &threshold) const noexcept {
+    static_assert(Ordered, "Order statistics need Ordered = true.");
+    return lower_bound(threshold);
+  }
+
+  /** @return The number of samples at or above threshold, as sampler_t::count_over(), O(log N) */
+  [[nodiscard]] size_t count_at_least(const Tp &threshold) const noexcept {
+    static_assert(Ordered, "Order statistics need Ordered = true.");
+    return size_ - lower_bound(threshold);
+  }
+
+  /** @return The number of samples in [low, high], O(log N) */
+  [[nodiscard]] size_t count_between(const Tp &low, const Tp &high) const noexcept {
+    static_assert(Ordered, "Order statistics need Ordered = true.");
+    const size_t below = lower_bound(low);
+    const size_t upto  = upper_bound(high);
+    return upto > below ? upto - below : 0;
+  }
+
+  /** Counts the samples below each of n thresholds into counts, O(n log N). */
+  void count_below(const Tp *thresholds, const size_t n, size_t *counts) const noexcept {
+    for (size_t i = 0; i < n; ++i) counts[i] = count_below(thresholds[i]);
+  }
+
+  /**
+   * Sample of rank k in ascending order, O(1). Unchecked: k must be below size().
+   */
+  [[nodiscard]] const Tp &nth(const size_t k) const noexcept {
+    static_assert(Ordered, "Order statistics need Ordered = true.");
+    return sorted_.samples[k];
+  }
+
+  /**
+   * @return The q-quantile of the window by nearest rank, q in [0, 1], O(1). Unchecked: the
+   * window must not be empty.
+   */
+  [[nodiscard]] const Tp &quantile(const double q) const noexcept {
+    static_assert(Ordered, "Order statistics need Ordered = true.");
+    if (!(q > 0)) return sorted_.samples[0];
+
+    const auto rank = static_cast<size_t>(::std::ceil(q * static_cast<double>(size_)));
+    return sorted_.samples[(rank < size_ ? rank : size_) - 1];
+  }
+
+  [[nodiscard]] const Tp &median() const noexcept {
+    return quantile(0.5);
+  }
+
+  /** The window in ascending order, size() samples. */
+  [[nodiscard]] const Tp *sorted() const noexcept {
+    static_assert(Ordered, "Order statistics need Ordered = true.");
+    return sorted_.samples;
+  }
+
+  // Capacity
+
+  [[nodiscard]] constexpr size_t size() const noexcept {
+    return size_;
+  }
+
+  [[nodiscard]] constexpr bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  [[nodiscard]] constexpr bool full() const noexcept {
+    return size_ == Capacity;
+  }
+
+  [[nodiscard]] constexpr size_t capacity() const noexcept {
+    return Capacity;
+  }
+};
+
+LIB_XCORE_END_NAMESPACE
+
+#endif  //LIB_XCORE_UTILS_WINDOW_STATS_HPP
@@ -0,0 +1,117 @@
+#include "lib_xcore"
+#include "../src/xcore/math_module"
+#include <cstdint>
+#include <iostream>
+
+static int pass_count = 0;
+static int fail_count = 0;
+
+static void check(const bool condition, const char *label) {
+  if (condition) {
+    std::cout << "  [PASS] " << label << "\n";
+    ++pass_count;
+  } else {
+    std::cout << "  [FAIL] " << label << "\n";
+    ++fail_count;
+  }
+}
+
+static void section(const char *title) {
+  std::cout << "\n"
+            << title << "\n";
+}
+
+static bool is_aligned(const void *p, const size_t alignment) {
+  return (reinterpret_cast<uintptr_t>(p) & (alignment - 1)) == 0;
+}
+
+int main() {
+  // -------------------------------------------------------------------------
+  section("aligned_allocator_t");
+  // -------------------------------------------------------------------------
+  {
+    using allocator = xcore::aligned_allocator_t<float>;
+
+    bool all_aligned = true;
+    float *blocks[32];
+    for (size_t i = 0; i < 32; ++i) {
+      blocks[i] = allocator::allocate(i * 3 + 1);
+      all_aligned &= blocks[i] && is_aligned(blocks[i], xcore::cache_line_size);
+    }
+    check(all_aligned, "every block is on a cache line");
+    for (float *block: blocks) allocator::deallocate(block);
+
+    float *p = allocator::allocate(5);
+    for (int i = 0; i < 5; ++i) p[i] = static_cast<float>(i) + 0.5f;
+
+    bool kept = true;
+    bool aligned = true;
+    for (size_t n = 8; n <= 1 << 16; n *= 2) {
+      p = allocator::reallocate(p, n);
+      aligned &= p && is_aligned(p, xcore::cache_line_size);
+      for (int i = 0; i < 5; ++i) kept &= p[i] == static_cast<float>(i) + 0.5f;
+      p[n - 1] = 1.0f;
+    }
+    check(aligned, "reallocate keeps the alignment while growing");
+    check(kept, "reallocate keeps the content");
+
+    p = allocator::reallocate(p, 3);
+    check(p && is_aligned(p, xcore::cache_line_size) && p[2] == 2.5f, "reallocate shrinks");
+    check(allocator::reallocate(p, 0) == nullptr, "reallocate to zero frees");
+    check(allocator::allocate(static_cast<size_t>(-1) / 2) == nullptr, "overflowing size fails");
+
+    using page_allocator = xcore::aligned_allocator_form_t<4096>::type<char>;
+    char *page           = page_allocator::allocate(100);
+    check(is_aligned(page, 4096), "custom alignment through aligned_allocator_form_t");
+    page_allocator::deallocate(page);
+  }
+
+  // -------------------------------------------------------------------------
+  section("Containers");
+  // -------------------------------------------------------------------------
+  {
+    xcore::array_t<float, 16, xcore::unused_allocator_t, 32> local(1.5f);
+    check(alignof(decltype(local)) == 32 && is_aligned(static_cast<const float *>(local), 32),
+          "array_t storage alignment");
+    check(local.sum() == 24.0f, "array_t algorithms still work");
+    check(alignof(xcore::array_t<double, 4>) == alignof(double), "default alignment is unchanged");
+
+    xcore::heap_array_t<double, 7, xcore::aligned_allocator_t> heap;
+    check(is_aligned(static_cast<const double *>(heap), xcore::cache_line_size), "heap_array_t with aligned_allocator_t");
+
+    xcore::heap_array_t<double, 7> zeroed;
+    bool                           all_zero = true;
+    for (size_t i = 0; i < 7; ++i) all_zero &= zeroed[i] == 0.0;
+    check(all_zero, "heap_array_t keeps the zero-filling default allocator");
+
+    xcore::dynamic_array_t<float, 0, xcore::aligned_allocator_t> dynamic(10);
+    for (size_t i = 0; i < 10; ++i) dynamic[i] = static_cast<float>(i);
+    dynamic.dynamic_resize(1000);
+    check(is_aligned(static_cast<const float *>(dynamic), xcore::cache_line_size) && dynamic[9] == 9.0f,
+          "dynamic_array_t resize stays aligned");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Numeric storage");
+  // -------------------------------------------------------------------------
+  {
+    xcore::aligned_numeric_vector<3, 32> a{1, 2, 3};
+    xcore::aligned_numeric_vector<3, 32> b{4, 5, 6};
+    check(alignof(decltype(a)) == 32 && is_aligned(a.data(), 32), "aligned_numeric_vector alignment");
+    check(sizeof(a) == 32, "size rounded to the alignment");
+
+    a = a + b;
+    check(a == xcore::numeric_vector<3>{5, 7, 9} && a.dot(b) == 5 * 4 + 7 * 5 + 9 * 6,
+          "operations accept and assign aligned vectors");
+
+    xcore::aligned_numeric_matrix<4, 4> m = xcore::numeric_matrix<4, 4>::identity();
+    check(is_aligned(m.data(), xcore::cache_line_size) && m(3, 3) == 1, "aligned_numeric_matrix alignment");
+
+    xcore::aligned_generic_vector<float, 8, 32> f(2.0f);
+    check(is_aligned(f.data(), 32) && f.size() == 8, "aligned_generic_vector");
+  }
+
+  std::cout << "\n"
+            << pass_count << " passed, " << fail_count << " failed\n";
+  return fail_count == 0 ? 0 : 1;
+}
@@ -0,0 +1,172 @@
+#include "lib_xcore"
+#include "../src/xcore/math_module"
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+static int pass_count = 0;
+static int fail_count = 0;
+
+static void check(const bool condition, const char *label) {
+  if (condition) {
+    std::cout << "  [PASS] " << label << "\n";
+    ++pass_count;
+  } else {
+    std::cout << "  [FAIL] " << label << "\n";
+    ++fail_count;
+  }
+}
+
+static void section(const char *title) {
+  std::cout << "\n"
+            << title << "\n";
+}
+
+using buffer_writer_t = xcore::cbor_writer_t<xcore::cbor_buffer_sink_t>;
+
+template<size_t N>
+static bool bytes_equal(const xcore::cbor_buffer_sink_t &sink, const unsigned char (&expected)[N]) {
+  return sink.size() == N && memcmp(sink.data(), expected, N) == 0;
+}
+
+int main() {
+  // -------------------------------------------------------------------------
+  section("Encoding (RFC 8949 appendix A vectors)");
+  // -------------------------------------------------------------------------
+  {
+    unsigned char   out[64];
+    buffer_writer_t writer(out, sizeof(out));
+
+    writer.value(0).value(23).value(24).value(1000).value(-1).value(-1000);
+    const unsigned char ints[] = {0x00, 0x17, 0x18, 0x18, 0x19, 0x03, 0xE8, 0x20, 0x39, 0x03, 0xE7};
+    check(bytes_equal(writer.sink(), ints), "integers use the shortest head");
+
+    writer.sink().clear();
+    writer.value(uint64_t(18446744073709551615ull)).value(int64_t(INT64_MIN));
+    const unsigned char wide[] = {0x1B, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                                  0x3B, 0x7F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+    check(bytes_equal(writer.sink(), wide), "64-bit extremes");
+
+    writer.sink().clear();
+    writer.value(1.5).value(100000.0).value(1.1).value(-4.0).value(5.960464477539063e-8).value(NAN);
+    const unsigned char floats[] = {0xF9, 0x3E, 0x00,
+                                    0xFA, 0x47, 0xC3, 0x50, 0x00,
+                                    0xFB, 0x3F, 0xF1, 0x99, 0x99, 0x99, 0x99, 0x99, 0x9A,
+                                    0xF9, 0xC4, 0x00,
+                                    0xF9, 0x00, 0x01,
+                                    0xF9, 0x7E, 0x00};
+    check(bytes_equal(writer.sink(), floats), "floats use the shortest exact precision");
+
+    writer.sink().clear();
+    writer.begin_map(2).member("a", 1).key("b").begin_array(2).value(true).value(nullptr);
+    const unsigned char nested[] = {0xA2, 0x61, 0x61, 0x01, 0x61, 0x62, 0x82, 0xF5, 0xF6};
+    check(bytes_equal(writer.sink(), nested), "maps, arrays and simple values");
+    check(writer.ok(), "writer ok");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Typed arrays");
+  // -------------------------------------------------------------------------
+  {
+    unsigned char   out[256];
+    buffer_writer_t writer(out, sizeof(out));
+
+    const xcore::generic_vector<float, 3> v{1.0f, -2.5f, 3.25f};
+    writer.value(v);
+
+    const unsigned char *p = writer.sink().data();
+    check(p[0] == 0xD8 && p[1] == xcore::detail::cbor_typed_array_tag<float>() && p[2] == 0x4C,
+          "vector is a tagged byte string of 12 bytes");
+    check(memcmp(p + 3, v.data(), 12) == 0, "elements are copied as they are in memory");
+
+    xcore::generic_matrix<double, 2, 3> m;
+    for (size_t r = 0; r < 2; ++r)
+      for (size_t c = 0; c < 3; ++c) m[r][c] = static_cast<double>(r * 10 + c) + 0.5;
+    writer.value(m);
+
+    xcore::cbor_reader_t            reader(writer.sink().data(), writer.sink().size());
+    xcore::generic_vector<float, 3> v_back;
+    xcore::generic_matrix<double, 2, 3> m_back;
+    check(reader.read(v_back) && v_back == v, "vector round trip");
+    check(reader.read(m_back) && m_back == m, "matrix round trip");
+    check(reader.at_end(), "whole input consumed");
+
+    xcore::cbor_reader_t            wrong(writer.sink().data(), writer.sink().size());
+    xcore::generic_vector<float, 4> too_long;
+    xcore::generic_vector<int, 3>   other_type;
+    check(!wrong.read(too_long) && !wrong.read(other_type) && wrong.offset() == 0,
+          "shape or type mismatch leaves the reader in place");
+
+    // Foreign byte order: 86 is float64 little-endian, 82 big-endian
+    const unsigned char be[] = {0xD8, 0x52, 0x50,
+                                0x3F, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                                0xC0, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+    xcore::cbor_item_t   item;
+    xcore::cbor_reader_t be_reader(be, sizeof(be));
+    double               values[2] = {};
+    check(be_reader.next(item) && item.is_typed_array_of<double>() && item.size() == 2, "big-endian float64 array");
+    check(item.copy_to(values, 2) == 2 && values[0] == 1.5 && values[1] == -2.5, "elements are byte swapped");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Decoding");
+  // -------------------------------------------------------------------------
+  {
+    unsigned char   out[128];
+    buffer_writer_t writer(out, sizeof(out));
+
+    writer.begin_map(4)
+      .member("id", 7)
+      .member("name", "rover")
+      .key("cov").begin_array(3).value(0.25f).value(-1).value(1e300)
+      .member("armed", false);
+
+    xcore::cbor_reader_t reader(writer.sink().data(), writer.sink().size());
+    check(reader.read_map().value_or(0) == 4, "map head");
+    check(reader.read_text().value_or("") == "id" && reader.read_integer().value_or(0) == 7, "integer member");
+    check(!reader.read_integer() && reader.read_text().value_or("") == "name", "type mismatch keeps the position");
+    check(reader.read_text().value_or("") == "rover", "text points into the input");
+    check(reader.read_text().value_or("") == "cov" && reader.read_array().value_or(0) == 3, "array head");
+    check(reader.read_double().value_or(0) == 0.25 && reader.read_double().value_or(0) == -1.0 &&
+            reader.read_double().value_or(0) == 1e300,
+          "half, integer and double read as double");
+    check(reader.read_text().value_or("") == "armed" && !reader.read_bool().value_or(true),
+          "boolean member");
+    check(reader.at_end() && reader.error() == xcore::cbor_error::ok, "end of input");
+
+    xcore::cbor_reader_t skipper(writer.sink().data(), writer.sink().size());
+    check(skipper.skip() && skipper.at_end(), "skip jumps over a whole map");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Errors");
+  // -------------------------------------------------------------------------
+  {
+    xcore::cbor_item_t item;
+
+    const unsigned char truncated[] = {0x63, 0x61, 0x62};
+    xcore::cbor_reader_t r1(truncated, sizeof(truncated));
+    check(!r1.next(item) && r1.error() == xcore::cbor_error::truncated && r1.offset() == 0, "truncated text");
+
+    const unsigned char indefinite[] = {0x9F, 0x01, 0xFF};
+    xcore::cbor_reader_t r2(indefinite, sizeof(indefinite));
+    check(!r2.next(item) && r2.error() == xcore::cbor_error::indefinite, "indefinite-length array");
+
+    const unsigned char huge[] = {0x9B, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+    xcore::cbor_reader_t r3(huge, sizeof(huge));
+    check(!r3.skip() && r3.error() == xcore::cbor_error::truncated, "count larger than the input");
+
+    const unsigned char odd[] = {0xD8, 0x56, 0x43, 0x00, 0x00, 0x00};
+    xcore::cbor_reader_t r4(odd, sizeof(odd));
+    check(!r4.next(item) && r4.error() == xcore::cbor_error::invalid, "typed array with a partial element");
+
+    unsigned char   small[4];
+    buffer_writer_t writer(small, sizeof(small));
+    writer.value("too long");
+    check(!writer.ok() && writer.sink().size() == 1, "sink overflow clears ok()");
+  }
+
+  std::cout << "\n"
+            << pass_count << " passed, " << fail_count << " failed\n";
+  return fail_count == 0 ? 0 : 1;
+}
@@ -121,6 +121,24 @@ int main() {
     check(parser.argv[2] == nullptr, "argv[2] == nullptr");
   }
 
+  // -------------------------------------------------------------------------
+  section("Typed arguments");
+  // -------------------------------------------------------------------------
+  {
+    parser.parse("move -10 2.5 0xFF abc 99999999999");
+    check(parser.arg<int>(1).value_or(0) == -10, "arg<int>(1) == -10");
+    check(parser.arg<double>(2).value_or(0.0) == 2.5, "arg<double>(2) == 2.5");
+    check(parser.arg<float>(1).value_or(0.0f) == -10.0f, "arg<float>(1) == -10.0f");
+    check(!parser.arg<int>(2), "arg<int>(2) rejects trailing \".5\"");
+    check(!parser.arg<int>(3), "arg<int>(3) rejects hex in base 10");
+    check(parser.arg<int>(3, 0).value_or(0) == 255, "arg<int>(3, 0) detects 0x prefix");
+    check(!parser.arg<double>(4), "arg<double>(4) rejects \"abc\"");
+    check(!parser.arg<int32_t>(5), "arg<int32_t>(5) out of range");
+    check(parser.arg<int64_t>(5).value_or(0) == 99999999999, "arg<int64_t>(5)");
+    check(!parser.arg<int>(6), "arg<int>(6) missing token");
+    check(!parser.arg<unsigned>(1), "arg<unsigned>(1) rejects negative");
+  }
+
   // -------------------------------------------------------------------------
   std::cout << "\n"
             << pass_count << " passed, "
@@ -0,0 +1,202 @@
+#include "lib_xcore"
+#include <cstring>
+#include <iostream>
+
+static int pass_count = 0;
+static int fail_count = 0;
+
+static void check(const bool condition, const char *label) {
+  if (condition) {
+    std::cout << "  [PASS] " << label << "\n";
+    ++pass_count;
+  } else {
+    std::cout << "  [FAIL] " << label << "\n";
+    ++fail_count;
+  }
+}
+
+static void section(const char *title) {
+  std::cout << "\n"
+            << title << "\n";
+}
+
+static const char *last_called = nullptr;
+static size_t      last_argc   = 0;
+static int         last_value  = 0;
+
+static void on_move(const size_t argc, const char *const *argv) {
+  last_called = "move";
+  last_argc   = argc;
+  last_value  = argc > 1 ? atoi(argv[1]) : 0;
+}
+
+static void on_stop(const size_t argc, const char *const *) {
+  last_called = "stop";
+  last_argc   = argc;
+}
+
+static void on_status(const size_t argc, const char *const *) {
+  last_called = "status";
+  last_argc   = argc;
+}
+
+static void on_reset(const size_t argc, const char *const *) {
+  last_called = "reset";
+  last_argc   = argc;
+}
+
+constexpr xcore::command_entry_t commands[] = {
+  {"move", on_move},
+  {"stop", on_stop},
+  {"status", on_status},
+  {"reset", on_reset},
+  {"mov", nullptr},
+};
+
+constexpr xcore::command_table_t table(commands);
+static_assert(table.valid(), "table must be built at compile time");
+
+constexpr xcore::command_entry_t duplicated[] = {
+  {"move", on_move},
+  {"stop", on_stop},
+  {"move", on_stop},
+};
+
+static_assert(!xcore::command_table_t<3>(duplicated).valid(), "duplicates must be rejected");
+
+constexpr xcore::command_entry_t null_named[] = {
+  {nullptr, on_move},
+  {"stop", on_stop},
+};
+
+// Generated names for a large table
+struct name_pool_t {
+  char names[500][8];
+
+  constexpr name_pool_t() : names{} {
+    for (size_t i = 0; i < 500; ++i) {
+      names[i][0] = 'c';
+      names[i][1] = static_cast<char>('0' + i / 100);
+      names[i][2] = static_cast<char>('0' + i / 10 % 10);
+      names[i][3] = static_cast<char>('0' + i % 10);
+    }
+  }
+};
+
+constexpr name_pool_t name_pool{};
+
+struct large_entries_t {
+  xcore::command_entry_t entries[500];
+
+  constexpr large_entries_t() : entries{} {
+    for (size_t i = 0; i < 500; ++i) entries[i] = {name_pool.names[i], on_stop};
+  }
+};
+
+constexpr large_entries_t large_entries{};
+
+int main() {
+  // -------------------------------------------------------------------------
+  section("Lookup");
+  // -------------------------------------------------------------------------
+  {
+    check(table.find("move") && table.find("move")->handler == on_move, "find(\"move\") -> on_move");
+    check(table.find("status") && table.find("status")->handler == on_status, "find(\"status\") -> on_status");
+    check(table.find("reset", 5) && table.find("reset", 5)->handler == on_reset, "find with explicit length");
+    check(table.find("resetx", 5) != nullptr, "find uses only len characters");
+    check(table.find("mo") == nullptr, "prefix is not a match");
+    check(table.find("moves") == nullptr, "longer name is not a match");
+    check(table.find("") == nullptr, "empty name is not a match");
+    check(table.find(nullptr) == nullptr, "null name is not a match");
+    check(table.find("jump") == nullptr, "unknown name is not a match");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Dispatch");
+  // -------------------------------------------------------------------------
+  {
+    xcore::command_parser_t<> parser;
+
+    parser.parse("move 42 7");
+    check(table.dispatch(parser), "dispatch(\"move 42 7\")");
+    check(last_called && strcmp(last_called, "move") == 0, "on_move called");
+    check(last_argc == 3, "handler argc == 3");
+    check(last_value == 42, "handler argv[1] == \"42\"");
+
+    parser.parse("stop");
+    check(table.dispatch(parser), "dispatch(\"stop\")");
+    check(strcmp(last_called, "stop") == 0 && last_argc == 1, "on_stop called with argc == 1");
+
+    last_called = nullptr;
+    parser.parse("jump 1");
+    check(!table.dispatch(parser), "unknown command not dispatched");
+    check(last_called == nullptr, "no handler called");
+
+    parser.parse("mov 1");
+    check(!table.dispatch(parser), "null handler not dispatched");
+
+    const char *argv[] = {"reset"};
+    check(table.dispatch(1, argv), "dispatch(argc, argv)");
+    check(strcmp(last_called, "reset") == 0, "on_reset called");
+    check(!table.dispatch(0, argv), "argc == 0 not dispatched");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Invalid tables find nothing");
+  // -------------------------------------------------------------------------
+  {
+    const xcore::command_table_t<3> dup(duplicated);
+    const xcore::command_table_t<2> null_name(null_named);
+    check(!dup.valid() && !null_name.valid(), "tables are not valid");
+
+    last_called = nullptr;
+    const char *argv[] = {"move"};
+    check(dup.find("move") == nullptr && dup.find("stop") == nullptr, "duplicated names: find() == nullptr");
+    check(!dup.dispatch(1, argv) && last_called == nullptr, "duplicated names: nothing dispatched");
+    check(null_name.find("") == nullptr && null_name.find("stop") == nullptr, "null name: find() == nullptr");
+    check(!null_name.dispatch(1, argv) && last_called == nullptr, "null name: nothing dispatched");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Dispatch from the stream parser");
+  // -------------------------------------------------------------------------
+  {
+    xcore::stream_command_parser_t<> parser;
+    const char                      *data = "status\nmove 5\n";
+    size_t                           n    = strlen(data);
+    size_t                           runs = 0;
+
+    while (n > 0) {
+      const size_t used = parser.feed(data, n);
+      data += used;
+      n -= used;
+      if (parser.ready() && table.dispatch(parser)) ++runs;
+    }
+
+    check(runs == 2, "two commands dispatched");
+    check(strcmp(last_called, "move") == 0 && last_value == 5, "last command was \"move 5\"");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Large table (500 commands)");
+  // -------------------------------------------------------------------------
+  {
+    constexpr xcore::command_table_t large(large_entries.entries);
+    static_assert(large.valid(), "500 commands must be hashable");
+
+    size_t exact = 0;
+    for (size_t i = 0; i < 500; ++i) {
+      const xcore::command_entry_t *e = large.find(name_pool.names[i]);
+      if (e && strcmp(e->name, name_pool.names[i]) == 0) ++exact;
+    }
+
+    check(exact == 500, "every name found");
+    check(large.find("c500") == nullptr && large.find("c") == nullptr, "names outside the table not found");
+  }
+
+  std::cout << "\n"
+            << pass_count << " passed, "
+            << fail_count << " failed.\n";
+
+  return fail_count == 0 ? 0 : 1;
+}
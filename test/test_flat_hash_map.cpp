@@ -0,0 +1,158 @@
+#include "lib_xcore"
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+
+static int pass_count = 0;
+static int fail_count = 0;
+
+static void check(const bool condition, const char *label) {
+  if (condition) {
+    std::cout << "  [PASS] " << label << "\n";
+    ++pass_count;
+  } else {
+    std::cout << "  [FAIL] " << label << "\n";
+    ++fail_count;
+  }
+}
+
+static void section(const char *title) {
+  std::cout << "\n"
+            << title << "\n";
+}
+
+// Sends every key to the same home slot, to exercise long clusters
+struct colliding_hash {
+  uint64_t operator()(const uint32_t key) const noexcept { return key & 0x7F; }
+};
+
+struct counted_t {
+  static inline int alive = 0;
+
+  int value;
+
+  counted_t(const int value = 0) : value(value) { ++alive; }
+  counted_t(const counted_t &other) : value(other.value) { ++alive; }
+  counted_t(counted_t &&other) noexcept : value(other.value) { ++alive; }
+  ~counted_t() { --alive; }
+
+  counted_t &operator=(const counted_t &) = default;
+};
+
+template<typename Map>
+static bool matches_model(Map &map, const size_t ops, const uint32_t key_range, const uint64_t seed) {
+  std::mt19937_64                        rng(seed);
+  std::unordered_map<uint32_t, uint64_t> model;
+  bool                                   ok = true;
+
+  for (size_t step = 0; step < ops; ++step) {
+    const auto     key   = static_cast<uint32_t>(rng() % key_range);
+    const uint64_t value = rng();
+
+    switch (rng() % 3) {
+      case 0:
+        if (map.size() < map.capacity() || model.count(key)) {
+          map.insert_or_assign(key, value);
+          model[key] = value;
+        }
+        break;
+      case 1:
+        ok &= map.erase(key) == (model.erase(key) == 1);
+        break;
+      default: {
+        const uint64_t *found = map.get(key);
+        const auto      it    = model.find(key);
+        ok &= it == model.end() ? found == nullptr : found && *found == it->second;
+      }
+    }
+  }
+
+  size_t visited = 0;
+  for (const auto &[key, value]: map) {
+    ok &= model.count(key) && model[key] == value;
+    ++visited;
+  }
+  return ok && visited == model.size() && map.size() == model.size();
+}
+
+int main() {
+  // -------------------------------------------------------------------------
+  section("Fixed capacity");
+  // -------------------------------------------------------------------------
+  {
+    xcore::flat_hash_map_t<uint32_t, int, 100> map;
+    check(map.capacity() == 100 && map.bucket_count() == 128 && map.empty(), "100 keys in 128 inline slots");
+
+    check(map.insert(7, 70) && !map.insert(7, 71) && *map.get(7) == 70, "insert keeps the first value");
+    check(map.insert_or_assign(7, 72) && map[7] == 72, "insert_or_assign overwrites");
+    map[8] += 5;
+    check(map.contains(8) && map[8] == 5 && map.size() == 2, "operator[] default-constructs");
+    check(map.find(9) == map.end() && map.find(7)->second == 72, "find");
+
+    for (uint32_t k = 100; map.size() < map.capacity(); ++k) map.insert(k, 0);
+    check(!map.insert(5000, 1) && map.try_emplace(5000).first == map.end(), "a full map refuses new keys");
+    check(map.insert_or_assign(7, 1) && map[7] == 1, "a full map still updates present keys");
+
+    check(map.erase(7) && !map.erase(7) && !map.contains(7) && map.size() == 99, "erase");
+    map.clear();
+    check(map.empty() && map.begin() == map.end() && !map.contains(8), "clear");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Backward-shift deletion");
+  // -------------------------------------------------------------------------
+  {
+    xcore::flat_hash_map_t<uint32_t, uint64_t, 200, colliding_hash> clustered;
+    check(matches_model(clustered, 50000, 400, 1), "every key in one cluster");
+
+    xcore::flat_hash_map_t<uint32_t, uint64_t, 1000> fixed;
+    check(matches_model(fixed, 200000, 3000, 2), "random operations against std::unordered_map");
+
+    // Without tombstones, a table emptied by erase() is as good as new
+    fixed.clear();
+    for (uint32_t k = 0; k < 1000; ++k) fixed.insert(k, k);
+    for (uint32_t k = 0; k < 1000; ++k) fixed.erase(k);
+    check(fixed.empty() && !fixed.contains(123), "no tombstone left behind");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Dynamic capacity");
+  // -------------------------------------------------------------------------
+  {
+    xcore::flat_hash_map_t<uint64_t, uint64_t> map;
+    check(map.bucket_count() == 0 && !map.contains(1) && map.get(1) == nullptr, "an empty map allocates nothing");
+
+    bool ok = true;
+    for (uint64_t k = 0; k < 100000; ++k) ok &= map.insert(k * 7919, k);
+    for (uint64_t k = 0; k < 100000; ++k) ok &= *map.get(k * 7919) == k;
+    check(ok && map.size() == 100000 && map.bucket_count() == 131072, "grows by rehashing");
+
+    xcore::flat_hash_map_t<uint32_t, uint64_t> churn;
+    check(matches_model(churn, 200000, 5000, 3), "random operations against std::unordered_map");
+
+    xcore::flat_hash_map_t<int *, int> pointers;
+    int                                a = 0, b = 0;
+    pointers[&a] = 1;
+    pointers[&b] = 2;
+    check(pointers.reserve(1000) && pointers.bucket_count() == 2048 && pointers[&a] == 1 && pointers[&b] == 2,
+          "reserve and pointer keys");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Object lifetime");
+  // -------------------------------------------------------------------------
+  {
+    {
+      xcore::flat_hash_map_t<uint32_t, counted_t, 0, colliding_hash> map;
+      for (uint32_t k = 0; k < 500; ++k) map.try_emplace(k, static_cast<int>(k));
+      for (uint32_t k = 0; k < 500; k += 2) map.erase(k);
+      check(counted_t::alive == 250 && map.get(301)->value == 301, "values survive shifts and rehashes");
+    }
+    check(counted_t::alive == 0, "every value is destroyed");
+  }
+
+  std::cout << "\n"
+            << pass_count << " passed, " << fail_count << " failed\n";
+  return fail_count == 0 ? 0 : 1;
+}
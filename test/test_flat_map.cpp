@@ -0,0 +1,138 @@
+#include "lib_xcore"
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+static int pass_count = 0;
+static int fail_count = 0;
+
+static void check(const bool condition, const char *label) {
+  if (condition) {
+    std::cout << "  [PASS] " << label << "\n";
+    ++pass_count;
+  } else {
+    std::cout << "  [FAIL] " << label << "\n";
+    ++fail_count;
+  }
+}
+
+static void section(const char *title) {
+  std::cout << "\n"
+            << title << "\n";
+}
+
+// Runs the same checks on both layouts
+template<bool Eytzinger>
+static void run_layout() {
+  using map_t = xcore::flat_map_t<int, int, 64, xcore::less<int>, Eytzinger>;
+
+  {
+    map_t map;
+    check(map.empty() && !map.get(1) && map.lower_bound(1) == map.end(), "starts empty");
+
+    for (const int k: {50, 10, 40, 20, 30}) map.insert(k, k * 2);
+    check(!map.insert(30, 0) && *map.get(30) == 60, "insert keeps existing keys");
+
+    std::vector<int> keys;
+    for (auto it = map.begin(); it != map.end(); ++it) keys.push_back(it->first);
+    check(keys == std::vector<int>({10, 20, 30, 40, 50}), "iterates in key order");
+
+    check(map.lower_bound(25).key() == 30 && map.lower_bound(30).key() == 30, "lower_bound");
+    check(map.upper_bound(30).key() == 40 && map.upper_bound(50) == map.end(), "upper_bound");
+    check(map.lower_bound(5) == map.begin() && map.lower_bound(51) == map.end(), "bounds at both ends");
+
+    auto [first, last] = map.equal_range(40);
+    check(first.key() == 40 && last.key() == 50, "equal_range of a present key");
+    auto [lo, hi] = map.equal_range(45);
+    check(lo == hi && lo.key() == 50, "equal_range of an absent key is empty");
+
+    map.find(20)->second = 7;
+    check(*map.get(20) == 7 && map.find(21) == map.end(), "find gives a writable value");
+
+    check(map.erase(10) && !map.erase(10) && !map.contains(10) && map.size() == 4, "erase");
+    check(map.insert_or_assign(40, 1) && *map.get(40) == 1, "insert_or_assign");
+  }
+
+  {
+    std::vector<std::pair<int, int>> table;
+    std::mt19937                     rng(Eytzinger);
+    for (int i = 0; i < 100; ++i) table.emplace_back(static_cast<int>(rng() % 200), i);
+
+    std::map<int, int> taken;
+    for (size_t i = 0; i < 64; ++i) taken.emplace(table[i].first, 0);
+
+    map_t map;
+    map.build(table.begin(), table.end());
+    check(map.size() == taken.size() && taken.size() < 64, "build takes Capacity pairs and drops duplicate keys");
+
+    bool sorted = true;
+    auto it     = taken.begin();
+    for (size_t i = 0; sorted && i < map.size(); ++i, ++it) sorted &= map.keys()[i] == it->first;
+    check(sorted, "build sorts the first Capacity pairs");
+
+    bool bounds = true;
+    for (int k = -5; k < 210; ++k) {
+      const auto lb = taken.lower_bound(k);
+      const auto it = map.lower_bound(k);
+      bounds &= lb == taken.end() ? it == map.end() : it != map.end() && it.key() == lb->first;
+    }
+    check(bounds, "lower_bound matches std::map for every key");
+  }
+}
+
+int main() {
+  // -------------------------------------------------------------------------
+  section("Sorted layout");
+  // -------------------------------------------------------------------------
+  run_layout<false>();
+
+  // -------------------------------------------------------------------------
+  section("Eytzinger layout");
+  // -------------------------------------------------------------------------
+  run_layout<true>();
+
+  // -------------------------------------------------------------------------
+  section("Every size");
+  // -------------------------------------------------------------------------
+  {
+    // Eytzinger trees of every shape, from empty to full
+    bool ok = true;
+    for (size_t n = 0; n <= 130; ++n) {
+      std::vector<std::pair<uint64_t, uint32_t>> table;
+      for (size_t i = 0; i < n; ++i) table.emplace_back(10 * i + 10, static_cast<uint32_t>(i));
+
+      auto *eyt    = new xcore::flat_map_t<uint64_t, uint32_t, 130, xcore::less<uint64_t>, true>();
+      auto *sorted = new xcore::flat_map_t<uint64_t, uint32_t, 130>();
+      eyt->build(table.begin(), table.end());
+      sorted->build(table.begin(), table.end());
+
+      for (uint64_t k = 0; k <= 10 * n + 20; ++k) {
+        const size_t expected = k <= 10 ? 0 : (k + 9) / 10 - 1;
+        const auto   a        = eyt->lower_bound(k);
+        const auto   b        = sorted->lower_bound(k);
+        ok &= expected >= n ? a == eyt->end() && b == sorted->end() : a.value() == expected && b.value() == expected;
+      }
+      delete eyt;
+      delete sorted;
+    }
+    check(ok, "both layouts agree with the expected lower bound");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Descending order");
+  // -------------------------------------------------------------------------
+  {
+    xcore::flat_map_t<int, char, 8, xcore::greater<int>, true> map;
+    map.insert(1, 'a');
+    map.insert(3, 'c');
+    map.insert(2, 'b');
+    check(map.begin().key() == 3 && map.lower_bound(2).value() == 'b' && map.lower_bound(0) == map.end(), "greater orders keys downwards");
+  }
+
+  std::cout << "\n"
+            << pass_count << " passed, " << fail_count << " failed\n";
+  return fail_count == 0 ? 0 : 1;
+}
@@ -0,0 +1,106 @@
+#include "lib_xcore"
+#include "../src/xcore/dispatcher"
+#include <cstdint>
+#include <iostream>
+
+static int pass_count = 0;
+static int fail_count = 0;
+
+static void check(const bool condition, const char *label) {
+  if (condition) {
+    std::cout << "  [PASS] " << label << "\n";
+    ++pass_count;
+  } else {
+    std::cout << "  [FAIL] " << label << "\n";
+    ++fail_count;
+  }
+}
+
+static void section(const char *title) {
+  std::cout << "\n"
+            << title << "\n";
+}
+
+using arena_t = xcore::frame_arena_t<1024, 16>;
+
+struct context_t {
+  arena_t *arena;
+  int     *last;       // Allocated in the previous pass
+  int      pass;
+  bool     kept;       // The previous pass' data survived the flip
+};
+
+static void produce(context_t *ctx) {
+  int *values = ctx->arena->allocate_ptr<int>(100);
+  for (int i = 0; i < 100; ++i) values[i] = ctx->pass * 1000 + i;
+
+  if (ctx->last) {
+    for (int i = 0; i < 100; ++i) ctx->kept &= ctx->last[i] == (ctx->pass - 1) * 1000 + i;
+  }
+
+  ctx->last = values;
+  ++ctx->pass;
+}
+
+static void scratch(arena_t *arena) {
+  auto scope = arena->current().scope();
+  (void) arena->allocate_ptr<char>(3000);  // Spills into a chained block
+}
+
+int main() {
+  // -------------------------------------------------------------------------
+  section("frame_arena_t");
+  // -------------------------------------------------------------------------
+  {
+    arena_t arena;
+    check(arena.valid() && arena.frame() == 0, "constructed");
+
+    int *a = arena.allocate_ptr<int>(4);
+    *a     = 42;
+    arena.flip();
+    int *b = arena.allocate_ptr<int>(4);
+    check(b != a && *a == 42, "the previous frame stays readable");
+    check(arena.previous().size() == 16 && arena.current().size() == 16, "each frame has its region");
+
+    arena.flip();
+    check(arena.allocate_ptr<int>(4) == a && arena.frame() == 2, "the frame before is released");
+
+    arena.flip();
+    (void) arena.allocate_ptr<char>(5000);
+    arena.flip();
+    check(arena.previous().overflow_count() == 1 && arena.previous().high_water_mark() >= 5000,
+          "statistics of the previous frame");
+    check(arena.current().overflow_count() == 0 && arena.current().size() == 0, "statistics restart each frame");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Dispatcher integration");
+  // -------------------------------------------------------------------------
+  {
+    arena_t             arena;
+    context_t           ctx{&arena, nullptr, 0, true};
+    xcore::Dispatcher<4> dispatcher;
+
+    dispatcher.attach_frame_arena(arena);
+    dispatcher << xcore::Task(produce, &ctx);
+    dispatcher << xcore::Task(scratch, &arena);
+
+    for (int pass = 0; pass < 100; ++pass) dispatcher();
+
+    check(ctx.pass == 100 && arena.frame() == 100, "the arena flips once per pass");
+    check(ctx.kept, "tasks read what they allocated in the previous pass");
+    check(dispatcher.frame_arena<arena_t>() == &arena, "the arena is reachable from the dispatcher");
+    check(arena.previous().size() == 400 && arena.previous().overflow_count() == 1,
+          "scopes inside a pass rewind their scratch memory");
+    check(arena.previous().chained_blocks() == 0 && arena.current().chained_blocks() == 0,
+          "chained blocks are released after each scope");
+
+    dispatcher.detach_frame_arena();
+    dispatcher();
+    check(arena.frame() == 100, "detached arena is left alone");
+  }
+
+  std::cout << "\n"
+            << pass_count << " passed, " << fail_count << " failed\n";
+  return fail_count == 0 ? 0 : 1;
+}
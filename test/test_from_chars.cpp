@@ -0,0 +1,245 @@
+#include "lib_xcore"
+#include <clocale>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+
+static int pass_count = 0;
+static int fail_count = 0;
+
+static void check(const bool condition, const char *label) {
+  if (condition) {
+    std::cout << "  [PASS] " << label << "\n";
+    ++pass_count;
+  } else {
+    std::cout << "  [FAIL] " << label << "\n";
+    ++fail_count;
+  }
+}
+
+static void section(const char *title) {
+  std::cout << "\n"
+            << title << "\n";
+}
+
+template<typename T>
+static xcore::from_chars_result parse(const char *s, T &value, const int base = 10) {
+  return xcore::from_chars(s, s + strlen(s), value, base);
+}
+
+template<typename T>
+static xcore::from_chars_result parse_float(const char *s, T &value) {
+  return xcore::from_chars(s, s + strlen(s), value);
+}
+
+int main() {
+  // -------------------------------------------------------------------------
+  section("Integers");
+  // -------------------------------------------------------------------------
+  {
+    int  i = 0;
+    auto r = parse("12345", i);
+    check(r && i == 12345, "\"12345\" -> 12345");
+
+    r = parse("-42abc", i);
+    check(r && i == -42 && *r.ptr == 'a', "\"-42abc\" stops at 'a'");
+
+    r = parse("1234567890", i);
+    check(r && i == 1234567890, "10 digits (SWAR chunk + tail)");
+
+    i = 7;
+    r = parse("2147483648", i);
+    check(r.ec == xcore::errc::result_out_of_range && i == 7, "INT_MAX + 1 out of range, value untouched");
+
+    r = parse("-2147483648", i);
+    check(r && i == -2147483647 - 1, "INT_MIN");
+
+    r = parse("+1", i);
+    check(r.ec == xcore::errc::invalid_argument, "'+' rejected");
+
+    unsigned u = 0;
+    r          = parse("-1", u);
+    check(r.ec == xcore::errc::invalid_argument, "'-' rejected for unsigned");
+
+    uint64_t u64 = 0;
+    r            = parse("18446744073709551615", u64);
+    check(r && u64 == 18446744073709551615ull, "UINT64_MAX");
+
+    r = parse("18446744073709551616", u64);
+    check(r.ec == xcore::errc::result_out_of_range && *r.ptr == '\0', "UINT64_MAX + 1 out of range, all digits consumed");
+
+    r = parse("00000000000000000000000042", u64);
+    check(r && u64 == 42, "long run of leading zeros");
+
+    int8_t s8 = 0;
+    r         = parse("-128", s8);
+    check(r && s8 == -128, "int8_t min");
+    r = parse("128", s8);
+    check(r.ec == xcore::errc::result_out_of_range, "int8_t overflow");
+
+    r = parse("ff", i, 16);
+    check(r && i == 255, "base 16");
+    r = parse("-101", i, 2);
+    check(r && i == -5, "base 2");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Integers: random round-trip");
+  // -------------------------------------------------------------------------
+  {
+    std::mt19937_64 rng(12345);
+    bool            ok = true;
+    for (int n = 0; n < 100000; ++n) {
+      const int64_t v = static_cast<int64_t>(rng()) >> (rng() % 64);
+      char          buf[32];
+      snprintf(buf, sizeof(buf), "%lld", static_cast<long long>(v));
+      int64_t out = 0;
+      ok &= parse(buf, out) && out == v;
+    }
+    check(ok, "100000 random int64 match snprintf");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Floating points");
+  // -------------------------------------------------------------------------
+  {
+    double d = 0;
+    auto   r = parse_float("3.14159", d);
+    check(r && d == 3.14159, "\"3.14159\"");
+
+    r = parse_float("-2.5e-3xyz", d);
+    check(r && d == -2.5e-3 && *r.ptr == 'x', "\"-2.5e-3xyz\" stops at 'x'");
+
+    r = parse_float("1e", d);
+    check(r && d == 1.0 && *r.ptr == 'e', "dangling exponent not consumed");
+
+    r = parse_float(".5", d);
+    check(r && d == 0.5, "\".5\"");
+
+    r = parse_float(".", d);
+    check(r.ec == xcore::errc::invalid_argument, "\".\" rejected");
+
+    r = parse_float("-0", d);
+    check(r && d == 0.0 && std::signbit(d), "\"-0\" keeps sign");
+
+    r = parse_float("Infinity", d);
+    check(r && std::isinf(d) && *r.ptr == '\0', "\"Infinity\"");
+
+    r = parse_float("nan", d);
+    check(r && std::isnan(d), "\"nan\"");
+
+    r = parse_float("1e400", d);
+    check(r.ec == xcore::errc::result_out_of_range, "1e400 out of range");
+
+    r = parse_float("4.9406564584124654e-324", d);
+    check(r && d == 4.9406564584124654e-324, "smallest subnormal");
+
+    r = parse_float("1.7976931348623157e308", d);
+    check(r && d == 1.7976931348623157e308, "DBL_MAX");
+
+    r = parse_float("9007199254740993", d);
+    check(r && d == 9007199254740992.0, "2^53 + 1 rounds to even");
+
+    r = parse_float("0.1000000000000000055511151231257827021181583404541015625", d);
+    check(r && d == 0.1, "more than 19 significant digits");
+
+    float f = 0;
+    r       = parse_float("3.4028235e38", f);
+    check(r && f == 3.4028235e38f, "FLT_MAX");
+
+    r = parse_float("1.17549435e-38", f);
+    check(r && f == 1.17549435e-38f, "FLT_MIN");
+
+    long double ld = 0;
+    r              = parse_float("0.25", ld);
+    check(r && ld == 0.25L, "long double");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Floating points: strtod fallback");
+  // -------------------------------------------------------------------------
+  {
+    // Halfway between 2^53 and 2^53 + 2 in 19 digits, just above it with the rest
+    const char *halfway = "9007199254740993.0000000000000000001";
+
+    double d = 0;
+    auto   r = parse_float(halfway, d);
+    check(r && d == 9007199254740994.0, "halfway-ambiguous input goes through strtod");
+
+    // Under a comma-decimal locale strtod would stop at the '.', only run where one is installed
+    const char *comma_locales[] = {"de_DE.UTF-8", "de_DE.utf8", "fr_FR.UTF-8", "fr_FR.utf8"};
+    for (const char *name : comma_locales) {
+      if (!setlocale(LC_NUMERIC, name)) continue;
+
+      d = 0;
+      r = parse_float(halfway, d);
+      check(r && d == 9007199254740994.0, "strtod fallback ignores the current locale");
+
+      long double ld = 0;
+      r              = parse_float("0.25", ld);
+      check(r && ld == 0.25L, "long double ignores the current locale");
+      setlocale(LC_NUMERIC, "C");
+      break;
+    }
+
+    // Too long for the fallback copy: reported instead of approximated
+    char long_input[640];
+    memset(long_input, '0', sizeof(long_input));
+    memcpy(long_input, "9007199254740993.", 17);
+    long_input[sizeof(long_input) - 2] = '1';
+    long_input[sizeof(long_input) - 1] = '\0';
+
+    d = 0;
+    r = parse_float(long_input, d);
+    check(r.ec == xcore::errc::value_too_large && r.ptr == long_input + strlen(long_input),
+          "512+ characters needing strtod: value_too_large");
+
+    long double ld = 0;
+    r              = parse_float(long_input, ld);
+    check(r.ec == xcore::errc::value_too_large, "512+ characters long double: value_too_large");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Floating points: random agreement with strtod/strtof");
+  // -------------------------------------------------------------------------
+  {
+    std::mt19937_64 rng(42);
+    bool            ok_d = true, ok_f = true;
+    for (int n = 0; n < 200000; ++n) {
+      uint64_t bits = rng();
+      double   v;
+      memcpy(&v, &bits, sizeof(v));
+      if (!std::isfinite(v)) continue;
+
+      char buf[64];
+      snprintf(buf, sizeof(buf), "%.*g", static_cast<int>(1 + rng() % 17), v);
+
+      const double expect_d = strtod(buf, nullptr);
+      double       d        = 0;
+      const auto   rd       = parse_float(buf, d);
+      if (std::isinf(expect_d))
+        ok_d &= rd.ec == xcore::errc::result_out_of_range;
+      else
+        ok_d &= rd && d == expect_d;
+
+      const float expect_f = strtof(buf, nullptr);
+      float       f        = 0;
+      const auto  rf       = parse_float(buf, f);
+      if (std::isinf(expect_f) || (expect_f == 0 && v != 0))
+        ok_f &= rf.ec == xcore::errc::result_out_of_range;
+      else
+        ok_f &= rf && f == expect_f;
+    }
+    check(ok_d, "200000 random doubles match strtod");
+    check(ok_f, "200000 random inputs as float match strtof");
+  }
+
+  // -------------------------------------------------------------------------
+  std::cout << "\n"
+            << pass_count << " passed, "
+            << fail_count << " failed.\n";
+
+  return fail_count == 0 ? 0 : 1;
+}
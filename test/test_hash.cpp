@@ -0,0 +1,156 @@
+#include "lib_xcore"
+#include "xcore/math_module"
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+static int pass_count = 0;
+static int fail_count = 0;
+
+static void check(const bool condition, const char *label) {
+  if (condition) {
+    std::cout << "  [PASS] " << label << "\n";
+    ++pass_count;
+  } else {
+    std::cout << "  [FAIL] " << label << "\n";
+    ++fail_count;
+  }
+}
+
+static void section(const char *title) {
+  std::cout << "\n"
+            << title << "\n";
+}
+
+enum class channel_t : uint8_t { imu, gps };
+
+// Dispatch on names known at compile time
+static int dispatch(const xcore::string_view name) {
+  switch (xcore::hash<xcore::string_view>{}(name)) {
+    case xcore::hash_bytes("imu", 3): return 1;
+    case xcore::hash_bytes("gps", 3): return 2;
+    default: return 0;
+  }
+}
+
+// Average number of output bits flipped by flipping each input bit of random inputs of n bytes
+static double avalanche(const size_t n, std::mt19937_64 &rng) {
+  std::vector<char> buf(n);
+  size_t            flipped = 0, trials = 0;
+
+  for (int round = 0; round < 200; ++round) {
+    for (char &c: buf) c = static_cast<char>(rng());
+    const uint64_t h = xcore::hash_bytes(buf.data(), n);
+
+    for (size_t bit = 0; bit < 8 * n; ++bit) {
+      buf[bit / 8] ^= static_cast<char>(1 << (bit % 8));
+      flipped += static_cast<size_t>(__builtin_popcountll(h ^ xcore::hash_bytes(buf.data(), n)));
+      buf[bit / 8] ^= static_cast<char>(1 << (bit % 8));
+      ++trials;
+    }
+  }
+  return static_cast<double>(flipped) / static_cast<double>(trials);
+}
+
+int main() {
+  // -------------------------------------------------------------------------
+  section("Compile time");
+  // -------------------------------------------------------------------------
+  {
+    constexpr uint64_t key = xcore::hash_bytes("accelerometer/x", 15);
+    static_assert(key == xcore::hash<xcore::string_view>{}("accelerometer/x"));
+    static_assert(xcore::hash<int>{}(42) == xcore::hash_int(42));
+    static_assert(xcore::hash<xcore::generic_vector<int, 3>>{}(xcore::generic_vector<int, 3>(1)) != 0);
+
+    const char *runtime = "accelerometer/x";
+    check(xcore::hash_bytes(runtime, strlen(runtime)) == key, "constexpr and run-time hashes agree");
+    check(dispatch("imu") == 1 && dispatch("gps") == 2 && dispatch("baro") == 0, "switch on hashed names");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Byte hash");
+  // -------------------------------------------------------------------------
+  {
+    // Exact-size heap buffers, so that an out-of-bounds read trips the sanitizers
+    bool     distinct = true;
+    uint64_t previous = 0;
+    for (size_t n = 0; n <= 300; ++n) {
+      char *buf = static_cast<char *>(malloc(n ? n : 1));
+      memset(buf, 'a', n);
+      const uint64_t h = xcore::hash_bytes(buf, n);
+      distinct &= n == 0 || h != previous;
+      previous = h;
+      free(buf);
+    }
+    check(distinct, "every length of the same byte differs");
+
+    std::mt19937_64 rng(1);
+    bool            mixed = true;
+    for (const size_t n: {1, 3, 4, 8, 9, 16, 17, 47, 48, 100}) {
+      const double bits = avalanche(n, rng);
+      mixed &= bits > 31.0 && bits < 33.0;
+    }
+    check(mixed, "a flipped input bit flips half of the output bits");
+
+    std::unordered_set<uint64_t> seen;
+    char                         name[32];
+    for (int i = 0; i < 200000; ++i) seen.insert(xcore::hash_bytes(name, static_cast<size_t>(snprintf(name, sizeof(name), "sensor/%d", i))));
+    check(seen.size() == 200000, "no collision among 200000 similar keys");
+
+    check(xcore::hash_bytes("key", 3, 1) != xcore::hash_bytes("key", 3, 2), "the seed changes the hash");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Function objects");
+  // -------------------------------------------------------------------------
+  {
+    xcore::string_t<32>      fixed("telemetry");
+    xcore::heap_string_t<32> heap("telemetry");
+    const xcore::string_view view("telemetry");
+    const uint64_t           h = xcore::hash<xcore::string_view>{}(view);
+    check(xcore::hash<xcore::string_t<32>>{}(fixed) == h && xcore::hash<xcore::heap_string_t<32>>{}(heap) == h,
+          "strings hash like a view of their characters");
+
+    check(xcore::hash<double>{}(0.0) == xcore::hash<double>{}(-0.0) && xcore::hash<double>{}(1.0) != xcore::hash<double>{}(2.0),
+          "0.0 and -0.0 hash equally");
+
+    const xcore::hash<long double> long_double_hash;
+    bool                           powers_differ = long_double_hash(0.0L) == long_double_hash(-0.0L);
+    for (long double x = 1.0L; x < 1e6L; x *= 2) powers_differ &= long_double_hash(x) != long_double_hash(2 * x);
+    check(powers_differ, "long double hashes the exponent, not only the mantissa");
+    check(xcore::hash<channel_t>{}(channel_t::imu) != xcore::hash<channel_t>{}(channel_t::gps), "enums");
+
+    int a = 0, b = 0;
+    check(xcore::hash<int *>{}(&a) != xcore::hash<int *>{}(&b), "pointers");
+
+    const xcore::generic_vector<double, 3> u = xcore::make_generic_vector<double, 3>({1.0, 2.0, 3.0});
+    const xcore::generic_vector<double, 3> v = xcore::make_generic_vector<double, 3>({3.0, 2.0, 1.0});
+    const xcore::hash<xcore::generic_vector<double, 3>> vector_hash;
+    check(vector_hash(u) == vector_hash(xcore::generic_vector<double, 3>(u)) && vector_hash(u) != vector_hash(v),
+          "vectors hash their elements in order");
+
+    // Consecutive integers spread over the low bits used by a power-of-2 table
+    size_t buckets[64] = {};
+    for (uint64_t k = 0; k < 64000; ++k) ++buckets[xcore::hash<uint64_t>{}(k) & 63];
+    size_t worst = 0;
+    for (const size_t count: buckets) worst = count > worst ? count : worst;
+    check(worst < 1150, "consecutive integers fill buckets evenly");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Hashed containers");
+  // -------------------------------------------------------------------------
+  {
+    xcore::flat_hash_map_t<xcore::string_t<16>, int, 64> topics;
+    topics.insert("imu", 1);
+    topics.insert("gps", 2);
+    check(topics.size() == 2 && *topics.get("gps") == 2 && !topics.contains("baro"), "flat_hash_map_t with string keys");
+  }
+
+  std::cout << "\n"
+            << pass_count << " passed, " << fail_count << " failed\n";
+  return fail_count == 0 ? 0 : 1;
+}
@@ -0,0 +1,225 @@
+#include "lib_xcore"
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+static int pass_count = 0;
+static int fail_count = 0;
+
+static void check(const bool condition, const char *label) {
+  if (condition) {
+    std::cout << "  [PASS] " << label << "\n";
+    ++pass_count;
+  } else {
+    std::cout << "  [FAIL] " << label << "\n";
+    ++fail_count;
+  }
+}
+
+static void section(const char *title) {
+  std::cout << "\n"
+            << title << "\n";
+}
+
+// Counts live objects, so that a leak or a double destruction shows
+struct tracked_t {
+  static int live;
+
+  std::string name;
+
+  explicit tracked_t(const int v = 0) : name(std::to_string(v)) { ++live; }
+  tracked_t(const tracked_t &other) : name(other.name) { ++live; }
+  tracked_t(tracked_t &&other) noexcept : name(static_cast<std::string &&>(other.name)) { ++live; }
+  tracked_t &operator=(const tracked_t &) = default;
+  tracked_t &operator=(tracked_t &&)      = default;
+  ~tracked_t() { --live; }
+
+  [[nodiscard]] int value() const { return std::stoi(name); }
+};
+
+int tracked_t::live = 0;
+
+struct point_t {
+  int32_t x, y;
+};
+
+template<typename V>
+static bool values_are(const V &v, std::initializer_list<int> expected) {
+  if (v.size() != expected.size()) return false;
+  size_t i = 0;
+  for (const int e: expected) {
+    if (v[i++].value() != e) return false;
+  }
+  return true;
+}
+
+int main() {
+  // -------------------------------------------------------------------------
+  section("Construction");
+  // -------------------------------------------------------------------------
+  {
+    xcore::inline_vector_t<tracked_t, 32> v;
+    check(tracked_t::live == 0, "empty vector constructs nothing");
+    check(v.empty() && v.size() == 0 && v.capacity() == 32, "size 0, capacity 32");
+
+    check(v.emplace_back(1) != nullptr && v.emplace_back(2) != nullptr, "emplace_back");
+    check(tracked_t::live == 2, "only pushed elements are live");
+    check(v.front().value() == 1 && v.back().value() == 2, "front and back");
+  }
+  check(tracked_t::live == 0, "destructor destroys live elements");
+
+  {
+    xcore::inline_vector_t<tracked_t, 2> v;
+    v.push_back(tracked_t(1));
+    v.push_back(tracked_t(2));
+    check(v.full() && v.emplace_back(3) == nullptr && !v.push_back(tracked_t(4)), "push_back fails when full");
+    check(tracked_t::live == 2, "failed push constructs nothing");
+  }
+
+  {
+    // Construction over dirty memory leaves the storage as it was
+    using ints_t = xcore::inline_vector_t<int, 1024>;
+    alignas(ints_t) unsigned char raw[sizeof(ints_t)];
+    memset(raw, 0xAA, sizeof(raw));
+
+    auto *v = new (raw) ints_t{};
+    v->push_back(1);
+    size_t untouched = 0;
+    for (size_t i = 1; i < v->capacity(); ++i) untouched += static_cast<uint32_t>(v->data()[i]) == 0xAAAAAAAAu;
+    check(untouched == v->capacity() - 1, "storage past size() is not initialized");
+    v->~ints_t();
+  }
+
+  // -------------------------------------------------------------------------
+  section("Insert and erase");
+  // -------------------------------------------------------------------------
+  {
+    xcore::inline_vector_t<tracked_t, 8> v;
+    for (int i = 0; i < 4; ++i) v.emplace_back(i);
+
+    check(v.insert(0, tracked_t(10)) && values_are(v, {10, 0, 1, 2, 3}), "insert at front");
+    check(v.insert(3, tracked_t(11)) && values_are(v, {10, 0, 1, 11, 2, 3}), "insert in the middle");
+    check(v.insert(v.size(), tracked_t(12)) && values_are(v, {10, 0, 1, 11, 2, 3, 12}), "insert at end");
+    check(!v.insert(9, tracked_t(13)), "insert past the end fails");
+    check(v.emplace(1, v[6]) && values_are(v, {10, 12, 0, 1, 11, 2, 3, 12}), "emplace from an element of the vector");
+    check(!v.emplace(0, 0), "insert fails when full");
+
+    v.erase(0);
+    check(values_are(v, {12, 0, 1, 11, 2, 3, 12}), "erase front");
+    v.erase(2, 4);
+    check(values_are(v, {12, 0, 2, 3, 12}), "erase range");
+    v.swap_erase(1);
+    check(values_are(v, {12, 12, 2, 3}), "swap_erase moves the last element");
+    v.swap_erase(3);
+    check(values_are(v, {12, 12, 2}), "swap_erase the last element");
+    v.erase(5);
+    v.swap_erase(5);
+    check(v.size() == 3, "erasing out of range is ignored");
+    check(tracked_t::live == 3, "no leak after inserts and erasures");
+
+    check(v.erase_if([](const tracked_t &t) { return t.value() == 12; }) == 2 && values_are(v, {2}), "erase_if");
+    check(tracked_t::live == 1, "erase_if destroys removed elements");
+
+    v.resize(4);
+    check(values_are(v, {2, 0, 0, 0}) && tracked_t::live == 4, "resize grows with new elements");
+    v.resize(1);
+    check(values_are(v, {2}) && tracked_t::live == 1, "resize shrinks");
+    v.pop_back();
+    check(v.empty() && tracked_t::live == 0, "pop_back");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Copy and move");
+  // -------------------------------------------------------------------------
+  {
+    xcore::inline_vector_t<tracked_t, 8> a;
+    for (int i = 0; i < 5; ++i) a.emplace_back(i);
+
+    xcore::inline_vector_t<tracked_t, 8> b(a);
+    check(values_are(b, {0, 1, 2, 3, 4}) && tracked_t::live == 10, "copy constructor");
+
+    xcore::inline_vector_t<tracked_t, 8> c(static_cast<xcore::inline_vector_t<tracked_t, 8> &&>(a));
+    check(values_are(c, {0, 1, 2, 3, 4}) && a.empty() && tracked_t::live == 10, "move constructor empties the source");
+
+    b.erase(0, 3);
+    c = b;
+    check(values_are(c, {3, 4}) && tracked_t::live == 4, "copy assignment");
+    a = static_cast<xcore::inline_vector_t<tracked_t, 8> &&>(c);
+    check(values_are(a, {3, 4}) && c.empty() && tracked_t::live == 4, "move assignment");
+  }
+  check(tracked_t::live == 0, "all destroyed");
+
+  // -------------------------------------------------------------------------
+  section("Trivially copyable elements");
+  // -------------------------------------------------------------------------
+  {
+    xcore::inline_vector_t<point_t, 16> v;
+    for (int32_t i = 0; i < 6; ++i) v.push_back(point_t{i, -i});
+
+    v.insert(2, point_t{100, -100});
+    v.erase(0);
+    v.swap_erase(0);
+    check(v.size() == 5 && v[0].x == 5 && v[1].x == 100 && v[2].x == 2 && v[4].x == 4, "memmove shifts");
+
+    const auto w = v;
+    bool same    = w.size() == v.size();
+    for (size_t i = 0; same && i < v.size(); ++i) same = w[i].x == v[i].x && w[i].y == v[i].y;
+    check(same, "memcpy copy");
+
+    int32_t sum = 0;
+    for (const point_t &p: v) sum += p.x;
+    check(sum == 5 + 100 + 2 + 3 + 4, "iteration");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Random operations against std::vector");
+  // -------------------------------------------------------------------------
+  for (const bool trivial: {true, false}) {
+    std::mt19937                          rng(7);
+    xcore::inline_vector_t<int, 48>       ints;
+    xcore::inline_vector_t<tracked_t, 48> objects;
+    std::vector<int>                      model;
+    bool                                  consistent = true;
+
+    for (int step = 0; step < 20000 && consistent; ++step) {
+      const int op = static_cast<int>(rng() % 5);
+      const int x  = static_cast<int>(rng() % 1000);
+
+      if (op == 0 && model.size() < 48) {
+        trivial ? ints.push_back(x) : objects.push_back(tracked_t(x));
+        model.push_back(x);
+      } else if (op == 1 && model.size() < 48) {
+        const size_t pos = rng() % (model.size() + 1);
+        trivial ? ints.insert(pos, x) : objects.insert(pos, tracked_t(x));
+        model.insert(model.begin() + static_cast<long>(pos), x);
+      } else if (op == 2 && !model.empty()) {
+        const size_t pos = rng() % model.size();
+        trivial ? ints.erase(pos) : objects.erase(pos);
+        model.erase(model.begin() + static_cast<long>(pos));
+      } else if (op == 3 && !model.empty()) {
+        const size_t pos = rng() % model.size();
+        trivial ? ints.swap_erase(pos) : objects.swap_erase(pos);
+        model[pos] = model.back();
+        model.pop_back();
+      } else if (!model.empty()) {
+        const size_t first = rng() % model.size(), last = std::min(first + rng() % 4, model.size());
+        trivial ? ints.erase(first, last) : objects.erase(first, last);
+        model.erase(model.begin() + static_cast<long>(first), model.begin() + static_cast<long>(last));
+      }
+
+      consistent &= (trivial ? ints.size() : objects.size()) == model.size();
+      for (size_t i = 0; consistent && i < model.size(); ++i) consistent &= (trivial ? ints[i] : objects[i].value()) == model[i];
+    }
+    check(consistent, trivial ? "int elements match" : "non-trivial elements match");
+    check(trivial || tracked_t::live == static_cast<int>(model.size()), "live objects match the size");
+  }
+  check(tracked_t::live == 0, "no leak");
+
+  std::cout << "\n"
+            << pass_count << " passed, " << fail_count << " failed\n";
+  return fail_count == 0 ? 0 : 1;
+}
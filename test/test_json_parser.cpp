@@ -0,0 +1,201 @@
+#include "lib_xcore"
+#include <cstring>
+#include <iostream>
+#include <string>
+
+static int pass_count = 0;
+static int fail_count = 0;
+
+static void check(const bool condition, const char *label) {
+  if (condition) {
+    std::cout << "  [PASS] " << label << "\n";
+    ++pass_count;
+  } else {
+    std::cout << "  [FAIL] " << label << "\n";
+    ++fail_count;
+  }
+}
+
+static void section(const char *title) {
+  std::cout << "\n"
+            << title << "\n";
+}
+
+static xcore::json_parser_t<256, 8> parser;
+
+template<size_t N>
+static xcore::json_error parse(xcore::json_document_t<N> &doc, std::string &text) {
+  return doc.parse(parser, text.data(), text.size());
+}
+
+// Collects SAX events as a compact trace
+struct trace_handler_t : xcore::json_sax_handler_t {
+  std::string trace;
+
+  bool on_null() { return trace += "n ", true; }
+  bool on_bool(const bool b) { return trace += b ? "t " : "f ", true; }
+  bool on_integer(const int64_t v) { return trace += "i" + std::to_string(v) + " ", true; }
+  bool on_floating(double) { return trace += "d ", true; }
+  bool on_string(const xcore::string_view s) { return trace += "s" + std::string(s.data(), s.size()) + " ", true; }
+  bool on_key(const xcore::string_view s) { return trace += "k" + std::string(s.data(), s.size()) + " ", true; }
+  bool on_object_begin() { return trace += "{ ", true; }
+  bool on_object_end() { return trace += "} ", true; }
+  bool on_array_begin() { return trace += "[ ", true; }
+  bool on_array_end() { return trace += "] ", true; }
+};
+
+int main() {
+  // -------------------------------------------------------------------------
+  section("Structural index");
+  // -------------------------------------------------------------------------
+  {
+    const char text[] = R"({"a":[1,true],"b\"{":null})";
+    check(parser.index(text, strlen(text)) == xcore::json_error::ok, "index() ok");
+
+    const uint32_t expected[] = {0, 1, 3, 4, 5, 6, 7, 8, 12, 13, 14, 19, 20, 21, 25};
+    check(parser.size() == sizeof(expected) / sizeof(expected[0]) &&
+            memcmp(parser.structurals(), expected, sizeof(expected)) == 0,
+          "quotes, structurals and scalar starts indexed, string interiors skipped");
+
+    std::string long_text = "[\"" + std::string(100, 'x') + "\\\\\", " + std::string(70, ' ') + "1]";
+    check(parser.index(long_text.data(), long_text.size()) == xcore::json_error::ok && parser.size() == 6,
+          "strings and escapes spanning 64-byte blocks");
+
+    check(parser.index("\"abc", 4) == xcore::json_error::unclosed_string, "unclosed string");
+    check(parser.index("\"a\tb\"", 5) == xcore::json_error::control_char, "raw control character in string");
+  }
+
+  // -------------------------------------------------------------------------
+  section("SAX events");
+  // -------------------------------------------------------------------------
+  {
+    std::string     text = R"( {"id": 42, "tags": ["x", "y\n"], "ok": false, "v": -1.5e3, "none": null, "e": {}, "l": []} )";
+    trace_handler_t handler;
+
+    check(parser.parse(text.data(), text.size(), handler) == xcore::json_error::ok, "parse() ok");
+    check(handler.trace == "{ kid i42 ktags [ sx sy\n ] kok f kv d knone n ke { } kl [ ] } ", "event trace matches");
+
+    struct stop_handler_t : xcore::json_sax_handler_t {
+      bool on_integer(int64_t) { return false; }
+    } stop;
+
+    std::string numbers = "[1,2,3]";
+    check(parser.parse(numbers.data(), numbers.size(), stop) == xcore::json_error::aborted, "handler can abort");
+  }
+
+  // -------------------------------------------------------------------------
+  section("DOM");
+  // -------------------------------------------------------------------------
+  {
+    xcore::json_document_t<64> doc;
+    std::string                text = R"({
+      "name": "rover \"one\"",
+      "rate": 50,
+      "gain": 0.25,
+      "big": 18446744073709551615,
+      "armed": true,
+      "home": null,
+      "waypoints": [[1, 2], [3, 4], [5, 6]],
+      "pid": {"kp": 1.2, "ki": 0.0, "kd": 0.05},
+      "unicode": "\u00e9\ud83d\ude00"
+    })";
+
+    check(parse(doc, text) == xcore::json_error::ok, "parse() ok");
+
+    const xcore::json_value_t root = doc.root();
+    check(root.is_object() && root.size() == 9, "root object with 9 members");
+    check(root["name"].to_string().value_or("") == "rover \"one\"", "escaped string decoded in place");
+    check(root["rate"].to_integer().value_or(0) == 50, "integer");
+    check(root["rate"].to_double().value_or(0) == 50.0, "integer as double");
+    check(root["gain"].to_double().value_or(0) == 0.25, "floating point");
+    check(!root["gain"].to_integer(), "floating point is not an integer");
+    check(root["big"].type() == xcore::json_type::floating, "integer beyond int64_t becomes floating");
+    check(root["armed"].to_bool().value_or(false), "boolean");
+    check(root["home"].is_null(), "null");
+    check(root["waypoints"].size() == 3 && root["waypoints"][2][1].to_integer().value_or(0) == 6, "nested arrays");
+    check(root["pid"]["kd"].to_double().value_or(0) == 0.05, "nested object");
+    check(root["unicode"].to_string().value_or("") == "\xc3\xa9\xf0\x9f\x98\x80", "\\u escapes and surrogate pairs");
+    check(!root["missing"] && !root["missing"]["deeper"][3], "missing members chain to invalid");
+    check(!root["rate"][0] && !root["waypoints"]["x"], "wrong container kind is invalid");
+
+    size_t      members = 0;
+    std::string keys;
+    for (xcore::json_value_t v = root["pid"].first(); v; v = v.next()) {
+      ++members;
+      keys += std::string(v.key().data(), v.key().size());
+    }
+    check(members == 3 && keys == "kpkikd", "member iteration with key()");
+    check(root.next().valid() == false && root.key().empty(), "root has no sibling and no key");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Errors");
+  // -------------------------------------------------------------------------
+  {
+    xcore::json_document_t<16> doc;
+
+    const struct {
+      const char       *text;
+      xcore::json_error error;
+    } cases[] = {
+      {"", xcore::json_error::empty},
+      {"[1,]", xcore::json_error::syntax},
+      {"{\"a\" 1}", xcore::json_error::syntax},
+      {"{\"a\":1,}", xcore::json_error::syntax},
+      {"[1 2]", xcore::json_error::syntax},
+      {"[1]]", xcore::json_error::syntax},
+      {"[1", xcore::json_error::syntax},
+      {"{1:2}", xcore::json_error::syntax},
+      {"01", xcore::json_error::number},
+      {"1.", xcore::json_error::number},
+      {"-", xcore::json_error::number},
+      {"1e999", xcore::json_error::number},
+      {"1x", xcore::json_error::number},
+      {"tru", xcore::json_error::literal},
+      {"nulls", xcore::json_error::literal},
+      {"\"\\x\"", xcore::json_error::escape},
+      {"\"\\ud800\"", xcore::json_error::escape},
+      {"[[[[[[[[[1]]]]]]]]]", xcore::json_error::depth},
+      {"[1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16]", xcore::json_error::capacity},
+    };
+
+    bool all_ok = true;
+    for (const auto &c: cases) {
+      std::string text = c.text;
+      if (parse(doc, text) != c.error) {
+        std::cout << "    unexpected result for " << c.text << "\n";
+        all_ok = false;
+      }
+    }
+    check(all_ok, "every malformed input reports its error");
+    check(!doc.root(), "failed parse leaves an empty document");
+
+    std::string text = "[1, 2, x]";
+    parse(doc, text);
+    check(parser.error_offset() == 7, "error_offset() points at the bad token");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Storage in a virtual_stack_region_t");
+  // -------------------------------------------------------------------------
+  {
+    xcore::virtual_stack_region_t<64 * 1024> region;
+
+    auto *big_parser = region.construct_ptr<xcore::json_parser_t<4096>>();
+    auto *doc        = region.construct_ptr<xcore::json_document_t<2048>>();
+    check(big_parser && doc, "parser and document constructed in the region");
+
+    std::string text = "[";
+    for (int i = 0; i < 1000; ++i) text += std::to_string(i) + ",";
+    text.back() = ']';
+
+    check(doc->parse(*big_parser, text.data(), text.size()) == xcore::json_error::ok, "parse() ok");
+    check(doc->root().size() == 1000 && doc->root()[999].to_integer().value_or(0) == 999, "1000 elements");
+  }
+
+  std::cout << "\n"
+            << pass_count << " passed, "
+            << fail_count << " failed.\n";
+
+  return fail_count == 0 ? 0 : 1;
+}
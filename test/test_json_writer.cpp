@@ -0,0 +1,217 @@
+#include "lib_xcore"
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+
+static int pass_count = 0;
+static int fail_count = 0;
+
+static void check(const bool condition, const char *label) {
+  if (condition) {
+    std::cout << "  [PASS] " << label << "\n";
+    ++pass_count;
+  } else {
+    std::cout << "  [FAIL] " << label << "\n";
+    ++fail_count;
+  }
+}
+
+static void section(const char *title) {
+  std::cout << "\n"
+            << title << "\n";
+}
+
+using buffer_writer_t = xcore::json_writer_t<xcore::json_buffer_sink_t>;
+
+int main() {
+  // -------------------------------------------------------------------------
+  section("Nested objects and arrays");
+  // -------------------------------------------------------------------------
+  {
+    char            out[256];
+    buffer_writer_t writer(out, sizeof(out));
+
+    writer.begin_object()
+      .member("id", 7)
+      .member("name", "rover")
+      .member("armed", false)
+      .member("target", nullptr)
+      .key("pos")
+      .begin_array()
+      .value(1.5)
+      .value(-2)
+      .begin_object()
+      .end_object()
+      .begin_array()
+      .end_array()
+      .end_array()
+      .key("imu")
+      .begin_object()
+      .member("ax", 0.25f)
+      .member("count", 18446744073709551615ull)
+      .end_object()
+      .end_object();
+
+    check(writer.ok() && writer.complete(), "ok() and complete()");
+    check(strcmp(out, R"({"id":7,"name":"rover","armed":false,"target":null,"pos":[1.5,-2,{},[]],"imu":{"ax":0.25,"count":18446744073709551615}})") == 0,
+          "document matches");
+    check(writer.sink().size() == strlen(out), "sink size matches");
+  }
+
+  // -------------------------------------------------------------------------
+  section("String escaping");
+  // -------------------------------------------------------------------------
+  {
+    char            out[256];
+    buffer_writer_t writer(out, sizeof(out));
+
+    writer.begin_array()
+      .value("plain text without any escapes at all")
+      .value("quote \" backslash \\ newline \n tab \t")
+      .value("ctrl \x01\x1f end")
+      .value("utf-8 \xc3\xa9 kept")
+      .value("a\0b", 3)
+      .end_array();
+
+    check(writer.complete(), "complete()");
+    check(strcmp(out, R"(["plain text without any escapes at all","quote \" backslash \\ newline \n tab \t","ctrl \u0001\u001f end","utf-8 )"
+                      "\xc3\xa9"
+                      R"( kept","a\u0000b"])") == 0,
+          "escapes match");
+
+    // Escapes at every position of a 16-byte block
+    bool all_ok = true;
+    for (size_t i = 0; i < 40; ++i) {
+      std::string s(40, 'x');
+      s[i] = '"';
+      char            buf[128];
+      buffer_writer_t w(buf, sizeof(buf));
+      w.value(s.c_str());
+      std::string expected = "\"" + s.substr(0, i) + "\\\"" + s.substr(i + 1) + "\"";
+      all_ok &= expected == buf;
+    }
+    check(all_ok, "escape found at every offset");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Numbers");
+  // -------------------------------------------------------------------------
+  {
+    char            out[256];
+    buffer_writer_t writer(out, sizeof(out));
+
+    writer.begin_array()
+      .value(INT64_MIN)
+      .value(0.1)
+      .value(1e300)
+      .value(NAN)
+      .value(-INFINITY)
+      .value(static_cast<unsigned char>(200))
+      .end_array();
+
+    check(strcmp(out, "[-9223372036854775808,0.1,1e+300,null,null,200]") == 0, "numbers match");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Misuse");
+  // -------------------------------------------------------------------------
+  {
+    char out[64];
+
+    buffer_writer_t a(out, sizeof(out));
+    a.begin_object().value(1);
+    check(!a.ok(), "value without key in object");
+
+    buffer_writer_t b(out, sizeof(out));
+    b.begin_array().key("k");
+    check(!b.ok(), "key in array");
+
+    buffer_writer_t c(out, sizeof(out));
+    c.begin_array().end_object();
+    check(!c.ok(), "mismatched end");
+
+    buffer_writer_t d(out, sizeof(out));
+    d.begin_object().key("k").end_object();
+    check(!d.ok(), "key without value");
+
+    xcore::json_writer_t<xcore::json_buffer_sink_t, 2> e(out, sizeof(out));
+    e.begin_array().begin_array().begin_array();
+    check(!e.ok(), "depth limit");
+
+    buffer_writer_t g(out, sizeof(out));
+    g.value(1).value(2);
+    check(!g.ok() && strcmp(out, "1") == 0, "second top-level value");
+
+    buffer_writer_t h(out, sizeof(out));
+    h.begin_array().end_array().begin_object();
+    check(!h.ok(), "second top-level container");
+
+    buffer_writer_t f(out, sizeof(out));
+    f.begin_object().member("k", 1);
+    check(f.ok() && !f.complete(), "open object is not complete");
+    f.reset();
+    f.sink().clear();
+    f.value(true);
+    check(f.complete() && strcmp(out, "true") == 0, "reset() starts a new document");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Sink overflow");
+  // -------------------------------------------------------------------------
+  {
+    char            out[16];
+    buffer_writer_t writer(out, sizeof(out));
+    writer.begin_object().member("key", "a long value").end_object();
+    check(!writer.ok(), "ok() is false");
+    check(strlen(out) < sizeof(out), "buffer stays terminated");
+  }
+
+  // -------------------------------------------------------------------------
+  section("byte_buffer_t sink");
+  // -------------------------------------------------------------------------
+  {
+    xcore::byte_buffer_t<64>                                                  buffer;
+    xcore::json_writer_t<xcore::json_byte_buffer_sink_t<xcore::byte_buffer_t<64>>> writer(buffer);
+
+    writer.begin_object().member("v", 3).end_object();
+    check(writer.complete(), "complete()");
+
+    unsigned char bytes[16] = {};
+    const size_t  n         = buffer.size();
+    buffer.pop(bytes, n);
+    check(n == 7 && memcmp(bytes, "{\"v\":3}", 7) == 0, "buffer holds the document");
+
+    xcore::byte_buffer_t<8>                                                 small;
+    xcore::json_writer_t<xcore::json_byte_buffer_sink_t<xcore::byte_buffer_t<8>>> overflow(small);
+    overflow.value("too long for eight bytes");
+    check(!overflow.ok(), "full byte buffer clears ok()");
+  }
+
+  // -------------------------------------------------------------------------
+  section("File descriptor sink");
+  // -------------------------------------------------------------------------
+  {
+    int fds[2];
+    check(pipe(fds) == 0, "pipe()");
+
+    {
+      xcore::json_writer_t<xcore::json_fd_sink_t<8>> writer(fds[1]);
+      writer.begin_array().value("staged through a small buffer").value(12).end_array();
+      check(writer.flush() && writer.complete(), "flush() and complete()");
+    }
+    close(fds[1]);
+
+    char          out[128] = {};
+    const ssize_t n        = read(fds[0], out, sizeof(out) - 1);
+    close(fds[0]);
+    check(n > 0 && strcmp(out, R"(["staged through a small buffer",12])") == 0, "pipe received the document");
+  }
+
+  std::cout << "\n"
+            << pass_count << " passed, "
+            << fail_count << " failed.\n";
+
+  return fail_count == 0 ? 0 : 1;
+}
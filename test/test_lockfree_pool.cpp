@@ -0,0 +1,114 @@
+#include "lib_xcore"
+#include <csignal>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+static int pass_count = 0;
+static int fail_count = 0;
+
+static void check(const bool condition, const char *label) {
+  if (condition) {
+    std::cout << "  [PASS] " << label << "\n";
+    ++pass_count;
+  } else {
+    std::cout << "  [FAIL] " << label << "\n";
+    ++fail_count;
+  }
+}
+
+static void section(const char *title) {
+  std::cout << "\n"
+            << title << "\n";
+}
+
+struct packet_t {
+  static inline int live = 0;
+
+  uint32_t id;
+  uint32_t owner;
+
+  packet_t(const uint32_t id, const uint32_t owner) : id(id), owner(owner) { ++live; }
+  ~packet_t() { --live; }
+};
+
+static xcore::lockfree_pool_t<packet_t, 64> pool;
+static xcore::lockfree_pool_t<uint64_t, 512> shared;
+
+static volatile sig_atomic_t handler_ok = 0;
+
+static void on_signal(int) {
+  packet_t *p = pool.construct(99u, 99u);
+  handler_ok  = p != nullptr && p->id == 99u;
+  pool.destroy(p);
+}
+
+int main() {
+  // -------------------------------------------------------------------------
+  section("Single thread");
+  // -------------------------------------------------------------------------
+  {
+    packet_t *slots[64];
+    bool      distinct = true;
+    for (uint32_t i = 0; i < 64; ++i) {
+      slots[i] = pool.acquire();
+      distinct &= slots[i] && pool.owns(slots[i]) && (i == 0 || slots[i] != slots[i - 1]);
+    }
+    check(distinct, "every slot is handed out once");
+    check(pool.acquire() == nullptr, "exhausted pool returns nullptr");
+
+    pool.release(slots[10]);
+    pool.release(slots[20]);
+    check(pool.acquire() == slots[20] && pool.acquire() == slots[10], "freelist is LIFO");
+
+    for (packet_t *slot: slots) pool.release(slot);
+
+    packet_t *p = pool.construct(7u, 1u);
+    check(p && p->id == 7u && packet_t::live == 1, "construct builds the object in place");
+    pool.destroy(p);
+    check(packet_t::live == 0, "destroy runs the destructor");
+
+    std::signal(SIGUSR1, on_signal);
+    std::raise(SIGUSR1);
+    check(handler_ok == 1, "usable from a signal handler");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Threads");
+  // -------------------------------------------------------------------------
+  {
+    std::vector<std::thread> threads;
+    bool                     exclusive[4] = {true, true, true, true};
+
+    for (int t = 0; t < 4; ++t) {
+      threads.emplace_back([t, &exclusive] {
+        const uint64_t tag = uint64_t(t + 1) << 32;
+        uint64_t      *held[64];
+
+        for (int round = 0; round < 20000; ++round) {
+          size_t n = 0;
+          for (; n < 64; ++n) {
+            held[n] = shared.acquire();
+            if (!held[n]) break;
+            *held[n] = tag | static_cast<uint64_t>(round);
+          }
+          for (size_t k = 0; k < n; ++k) {
+            exclusive[t] &= *held[k] == (tag | static_cast<uint64_t>(round));
+            shared.release(held[k]);
+          }
+        }
+      });
+    }
+    for (std::thread &thread: threads) thread.join();
+    check(exclusive[0] && exclusive[1] && exclusive[2] && exclusive[3], "no slot is held by two threads");
+
+    size_t count = 0;
+    while (shared.acquire()) ++count;
+    check(count == 512, "every slot is back in the pool");
+  }
+
+  std::cout << "\n"
+            << pass_count << " passed, " << fail_count << " failed\n";
+  return fail_count == 0 ? 0 : 1;
+}
@@ -0,0 +1,146 @@
+#include "lib_xcore"
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+
+static int pass_count = 0;
+static int fail_count = 0;
+
+static void check(const bool condition, const char *label) {
+  if (condition) {
+    std::cout << "  [PASS] " << label << "\n";
+    ++pass_count;
+  } else {
+    std::cout << "  [FAIL] " << label << "\n";
+    ++fail_count;
+  }
+}
+
+static void section(const char *title) {
+  std::cout << "\n"
+            << title << "\n";
+}
+
+static bool is_aligned(const void *p, const size_t alignment) {
+  return (reinterpret_cast<uintptr_t>(p) & (alignment - 1)) == 0;
+}
+
+static xcore::memory_resource *subsystem_resource = &xcore::malloc_resource;
+
+template<typename Tp>
+using subsystem_alloc = xcore::resource_allocator_form_t<subsystem_resource>::type<Tp>;
+
+template<typename Tp, size_t Size>
+using subsystem_heap_array = xcore::heap_array_t<Tp, Size, subsystem_alloc>;
+
+static xcore::pool_resource_t<8> pool;
+
+// Exercises any resource through the virtual interface only
+static bool round_trip(xcore::memory_resource &resource) {
+  auto *a = static_cast<unsigned char *>(resource.allocate(100));
+  auto *b = static_cast<unsigned char *>(resource.allocate(24, 64));
+  if (!a || !b || !is_aligned(a, 16) || !is_aligned(b, 64)) return false;
+
+  memset(a, 0xA5, 100);
+  memset(b, 0x5A, 24);
+  a = static_cast<unsigned char *>(resource.reallocate(a, 300));
+  if (!a || a[99] != 0xA5 || b[23] != 0x5A) return false;
+
+  a[299] = 1;
+  resource.deallocate(b);
+  resource.deallocate(a);
+  resource.deallocate(nullptr);
+  return resource.reallocate(resource.allocate(8), 0) == nullptr;
+}
+
+int main() {
+  // -------------------------------------------------------------------------
+  section("Resources");
+  // -------------------------------------------------------------------------
+  {
+    xcore::monotonic_resource_t<256>  monotonic;
+    xcore::arena_resource_t<1 << 16> arena;
+
+    check(round_trip(xcore::malloc_resource), "malloc_resource");
+    check(round_trip(monotonic), "monotonic_resource_t");
+    check(round_trip(arena), "arena_resource_t");
+    check(round_trip(pool), "pool_resource_t");
+
+    void *small = pool.allocate(40);
+    check(pool.slab().owns(small), "pool blocks come from the slab");
+    small = pool.reallocate(small, 4 * pool.slab().max_block_size);
+    check(small && !pool.slab().owns(small), "growing past the slab classes moves to malloc_resource_t");
+    pool.deallocate(small);
+  }
+
+  // -------------------------------------------------------------------------
+  section("Monotonic and arena");
+  // -------------------------------------------------------------------------
+  {
+    xcore::monotonic_resource_t<256> monotonic;
+    for (int i = 0; i < 100; ++i) (void) monotonic.allocate(64);
+    check(monotonic.region().chained_blocks() > 0, "monotonic grows with extra blocks");
+
+    monotonic.release();
+    check(monotonic.region().size() == 0 && monotonic.region().chained_blocks() == 0, "release() frees everything");
+
+    xcore::arena_resource_t<1024> arena;
+    void *first  = arena.allocate(100);
+    void *second = arena.allocate(100);
+    arena.deallocate(second);
+    check(arena.allocate(100) == second, "LIFO deallocation is given back");
+    arena.deallocate(first);
+    check(arena.region().size() > 0, "other blocks wait for release()");
+    check(arena.allocate(2000) == nullptr, "the arena does not grow");
+
+    {
+      auto  scope = arena.region().scope();
+      void *tmp   = arena.allocate(500);
+      check(tmp != nullptr && xcore::arena_resource_t<1024>::block_size(tmp) == 500, "scoped allocation");
+    }
+    arena.release();
+    check(arena.region().size() == 0, "release() rewinds the arena");
+
+    void *shrunk = arena.reallocate(arena.allocate(100), 10);
+    arena.deallocate(shrunk);
+    check(arena.region().size() == 0, "a shrunk block is given back whole");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Containers on a resource chosen at run time");
+  // -------------------------------------------------------------------------
+  {
+    xcore::monotonic_resource_t<4096> frame;
+    subsystem_resource = &frame;
+    {
+      xcore::dynamic_array_t<float, 0, subsystem_alloc> samples(10);
+      check(samples[9] == 0.0f && frame.region().size() > 0, "dynamic_array_t allocates from the monotonic resource");
+
+      for (size_t i = 0; i < 10; ++i) samples[i] = static_cast<float>(i);
+      samples.dynamic_resize(1000);
+      samples[999] = 1.0f;
+      check(samples[9] == 9.0f, "resize keeps the content");
+
+      xcore::container::impl::basic_string_t<char, 16, subsystem_heap_array> msg;
+      msg += "resource ";
+      msg += 40;
+      check(strcmp(msg.c_str(), "resource 40") == 0, "heap string on the resource");
+    }
+    frame.release();
+    check(frame.region().size() == 0, "one release() for the whole subsystem");
+
+    subsystem_resource = &pool;
+    {
+      xcore::dynamic_array_t<double, 0, subsystem_alloc> values(8);
+      check(pool.slab().owns(static_cast<double *>(values)), "the same type now allocates from the pool");
+    }
+
+    subsystem_resource = &xcore::malloc_resource;
+    xcore::dynamic_array_t<int, 0, xcore::resource_allocator_t> ints(4);
+    check(ints[3] == 0, "resource_allocator_t uses default_memory_resource");
+  }
+
+  std::cout << "\n"
+            << pass_count << " passed, " << fail_count << " failed\n";
+  return fail_count == 0 ? 0 : 1;
+}
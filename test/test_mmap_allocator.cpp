@@ -0,0 +1,85 @@
+#include "lib_xcore"
+#include <cstdint>
+#include <iostream>
+
+static int pass_count = 0;
+static int fail_count = 0;
+
+static void check(const bool condition, const char *label) {
+  if (condition) {
+    std::cout << "  [PASS] " << label << "\n";
+    ++pass_count;
+  } else {
+    std::cout << "  [FAIL] " << label << "\n";
+    ++fail_count;
+  }
+}
+
+static void section(const char *title) {
+  std::cout << "\n"
+            << title << "\n";
+}
+
+static bool is_aligned(const void *p, const size_t alignment) {
+  return (reinterpret_cast<uintptr_t>(p) & (alignment - 1)) == 0;
+}
+
+using plain_t    = xcore::mmap_allocator_form_t<xcore::mmap_flags::none>::type<uint32_t>;
+using prefault_t = xcore::mmap_allocator_form_t<xcore::mmap_flags::transparent_huge | xcore::mmap_flags::populate |
+                                                xcore::mmap_flags::lock>::type<uint64_t>;
+using explicit_t = xcore::mmap_allocator_form_t<xcore::mmap_flags::huge_tlb>::type<char>;
+
+template<typename Tp>
+using huge_alloc = xcore::mmap_allocator_t<Tp>;
+
+int main() {
+  // -------------------------------------------------------------------------
+  section("Mappings");
+  // -------------------------------------------------------------------------
+  {
+    uint32_t *small = plain_t::allocate(100);
+    bool      zero  = true;
+    for (size_t i = 0; i < 100; ++i) zero &= small[i] == 0;
+    check(small && is_aligned(small, xcore::cache_line_size) && zero, "zero-filled and cache-line aligned");
+
+    for (uint32_t i = 0; i < 100; ++i) small[i] = i;
+    check(plain_t::reallocate(small, 500) == small, "reallocate within the mapping stays in place");
+    check(plain_t::reallocate(small, (static_cast<size_t>(-1) >> 2) + 2) == nullptr && small[99] == 99, "reallocate fails on an overflowing size");
+
+    uint32_t *grown = plain_t::reallocate(small, 1 << 20);
+    bool      kept  = true;
+    for (uint32_t i = 0; i < 100; ++i) kept &= grown[i] == i;
+    grown[(1 << 20) - 1] = 1;
+    check(grown && kept, "reallocate to a new mapping keeps the content");
+    check(plain_t::reallocate(grown, 0) == nullptr, "reallocate to zero unmaps");
+
+    uint64_t *prefaulted = prefault_t::allocate(1 << 20);  // 8 MiB
+    check(prefaulted && is_aligned(prefaulted - 8, 2 << 20), "huge-page mappings start on a 2 MiB boundary");
+    prefaulted[(1 << 20) - 1] = 7;
+    prefault_t::deallocate(prefaulted);
+
+    char *explicit_huge = explicit_t::allocate(3 << 20);
+    explicit_huge[(3 << 20) - 1] = 'x';
+    check(explicit_huge != nullptr, "MAP_HUGETLB falls back when no huge page is reserved");
+    explicit_t::deallocate(explicit_huge);
+  }
+
+  // -------------------------------------------------------------------------
+  section("Containers");
+  // -------------------------------------------------------------------------
+  {
+    xcore::virtual_stack_region_t<16 << 20, 16, huge_alloc> region;
+    double *samples = region.allocate_ptr<double>(1 << 20);
+    samples[(1 << 20) - 1] = 1.5;
+    check(region.valid() && samples && region.remaining() == (8 << 20), "virtual_stack_region_t over mmap");
+
+    xcore::dynamic_array_t<float, 0, huge_alloc> values(1000);
+    values[999] = 2.0f;
+    values.dynamic_resize(1 << 22);
+    check(values[999] == 2.0f && values[(1 << 22) - 1] == 0.0f, "dynamic_array_t over mmap");
+  }
+
+  std::cout << "\n"
+            << pass_count << " passed, " << fail_count << " failed\n";
+  return fail_count == 0 ? 0 : 1;
+}
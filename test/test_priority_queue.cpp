@@ -0,0 +1,217 @@
+#include "lib_xcore"
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+static int pass_count = 0;
+static int fail_count = 0;
+
+static void check(const bool condition, const char *label) {
+  if (condition) {
+    std::cout << "  [PASS] " << label << "\n";
+    ++pass_count;
+  } else {
+    std::cout << "  [FAIL] " << label << "\n";
+    ++fail_count;
+  }
+}
+
+static void section(const char *title) {
+  std::cout << "\n"
+            << title << "\n";
+}
+
+struct item_t {
+  uint32_t distance;
+  uint32_t id;
+
+  bool operator<(const item_t &other) const {
+    return distance != other.distance ? distance < other.distance : id < other.id;
+  }
+
+  bool operator==(const item_t &other) const {
+    return distance == other.distance && id == other.id;
+  }
+};
+
+// Owning label whose move leaves the source empty, as strings or unique handles do
+struct label_t {
+  std::string text;
+
+  label_t() = default;
+  explicit label_t(std::string s) : text(static_cast<std::string &&>(s)) {}
+  label_t(const label_t &)            = default;
+  label_t &operator=(const label_t &) = default;
+  label_t(label_t &&other) noexcept : text(static_cast<std::string &&>(other.text)) { other.text.clear(); }
+  label_t &operator=(label_t &&other) noexcept {
+    text = static_cast<std::string &&>(other.text);
+    other.text.clear();
+    return *this;
+  }
+
+  bool operator<(const label_t &other) const { return text < other.text; }
+};
+
+// Dijkstra-like use: min-heap of (distance, id), distances only decrease
+template<size_t Arity>
+static bool matches_model(const uint32_t seed) {
+  using queue_t = xcore::priority_queue_t<item_t, 512, xcore::greater<item_t>, Arity>;
+  queue_t queue;
+
+  std::mt19937                                               rng(seed);
+  std::set<item_t>                                           model;
+  std::vector<std::pair<typename queue_t::handle_t, item_t>> live;
+  bool                                                       consistent = true;
+
+  for (int step = 0; step < 100000; ++step) {
+    const uint32_t op = rng() % 10;
+    if (op < 4 && model.size() < 512) {
+      const item_t item{static_cast<uint32_t>(rng() % 100000), static_cast<uint32_t>(step)};
+      live.emplace_back(queue.push(item), item);
+      model.insert(item);
+    } else if (op < 7 && !live.empty()) {
+      auto &[h, item] = live[rng() % live.size()];
+      item_t lower{static_cast<uint32_t>(item.distance - rng() % (item.distance + 1)), item.id};
+      consistent &= queue.decrease_key(h, lower);
+      model.erase(item);
+      model.insert(lower);
+      item = lower;
+    } else if (!model.empty()) {
+      const auto top = queue.pop();
+      consistent &= top && *top == *model.begin();
+      model.erase(model.begin());
+      const auto popped = std::find_if(live.begin(), live.end(), [&](const auto &l) { return l.second == *top; });
+      consistent &= !queue.contains(popped->first);
+      live.erase(popped);
+    }
+    consistent &= queue.size() == model.size();
+  }
+  return consistent;
+}
+
+int main() {
+  // -------------------------------------------------------------------------
+  section("Push and pop");
+  // -------------------------------------------------------------------------
+  {
+    xcore::priority_queue_t<int, 16> queue;
+    check(queue.empty() && !queue.pop() && !queue.peek(), "starts empty");
+
+    for (const int v: {5, 1, 9, 3, 7, 9, 2}) queue.push(v);
+    check(queue.size() == 7 && queue.top() == 9 && *queue.peek() == 9, "top is the greatest under less");
+
+    std::vector<int> out;
+    while (auto v = queue.pop()) out.push_back(*v);
+    check(out == std::vector<int>({9, 9, 7, 5, 3, 2, 1}), "pops in descending order");
+
+    xcore::priority_queue_t<int, 4, xcore::greater<int>> min_queue;
+    for (const int v: {4, 2, 8, 6}) min_queue.push(v);
+    check(min_queue.full() && min_queue.push(1) == decltype(min_queue)::null_handle, "push fails when full");
+    check(*min_queue.pop() == 2 && *min_queue.pop() == 4, "greater gives a min-heap");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Elements whose move empties the source");
+  // -------------------------------------------------------------------------
+  {
+    xcore::priority_queue_t<label_t, 16> queue;
+    for (const char *s: {"a", "m", "f", "x", "e", "d", "c", "b"}) queue.push(label_t(s));
+
+    std::string out;
+    while (auto l = queue.pop()) out += l->text;
+    check(out == "xmfedcba", "pop never compares against the moved-out top");
+
+    std::mt19937                         rng(5);
+    xcore::priority_queue_t<label_t, 64> labels;
+    std::multiset<std::string>           model;
+    bool                                 ordered = true;
+    for (int step = 0; step < 20000; ++step) {
+      if (rng() % 2 && !labels.full()) {
+        const std::string s(1 + rng() % 20, static_cast<char>('a' + rng() % 26));
+        labels.push(label_t(s));
+        model.insert(s);
+      } else if (!model.empty()) {
+        const auto top = labels.pop();
+        ordered &= top && top->text == *model.rbegin();
+        model.erase(std::prev(model.end()));
+      }
+    }
+    check(ordered, "labels pop in order under random pushes and pops");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Handles");
+  // -------------------------------------------------------------------------
+  {
+    using queue_t = xcore::priority_queue_t<int, 8, xcore::greater<int>>;
+    queue_t queue;
+
+    const auto a = queue.push(50);
+    const auto b = queue.push(40);
+    const auto c = queue.push(30);
+    check(queue.top_handle() == c && *queue.get(a) == 50, "handles reach their elements");
+
+    check(queue.decrease_key(a, 10) && queue.top() == 10 && queue.top_handle() == a, "decrease_key moves to the top");
+    check(queue.update(a, 45) && queue.top() == 30, "update moves down");
+    check(queue.erase(c) && !queue.contains(c) && queue.top_handle() == b, "erase removes anywhere");
+    check(!queue.erase(c) && !queue.decrease_key(c, 1), "removed handles are rejected");
+
+    queue.pop();
+    check(!queue.contains(b) && queue.contains(a), "pop releases the handle of the top");
+    const auto d = queue.push(5);
+    check((d.index() == b.index() || d.index() == c.index()) && d != b && d != c, "push reuses slots with a new generation");
+
+    // A handle kept after its element left must not reach the element now in its slot
+    const auto stale = d.index() == b.index() ? b : c;
+    check(!queue.contains(stale) && !queue.get(stale), "stale handles are rejected");
+    check(!queue.erase(stale) && !queue.update(stale, 1) && !queue.decrease_key(stale, 1), "stale handles change nothing");
+    check(queue.contains(d) && *queue.get(d) == 5 && queue.size() == 2, "the new element is untouched");
+    check(!queue.contains(queue_t::null_handle) && !queue.contains(queue_t::handle_t{}), "null handles are rejected");
+
+    queue.clear();
+    check(queue.empty() && !queue.contains(a) && !queue.contains(d), "clear invalidates every handle");
+    const auto e = queue.push(7);
+    check(queue.contains(e) && !queue.contains(a) && !queue.contains(d), "handles from before clear stay stale");
+  }
+
+  // -------------------------------------------------------------------------
+  section("make_heap");
+  // -------------------------------------------------------------------------
+  {
+    std::vector<int> values(100);
+    std::mt19937     rng(3);
+    for (int &v: values) v = static_cast<int>(rng() % 1000);
+
+    using queue_t = xcore::priority_queue_t<int, 64>;
+    queue_t    queue;
+    const auto before = queue.push(123456);
+
+    queue_t::handle_t handles[64];
+    check(queue.make_heap(values.begin(), values.end(), handles) == 64, "takes up to Capacity elements");
+
+    bool handles_ok = !queue.contains(before);
+    for (size_t k = 0; k < 64; ++k) handles_ok &= queue.get(handles[k]) && *queue.get(handles[k]) == values[k];
+    check(handles_ok, "handles[k] reaches the k-th element, older handles are stale");
+
+    std::vector<int> expected(values.begin(), values.begin() + 64), out;
+    std::sort(expected.rbegin(), expected.rend());
+    while (auto v = queue.pop()) out.push_back(*v);
+    check(out == expected, "pops the range sorted");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Random operations against a model");
+  // -------------------------------------------------------------------------
+  check(matches_model<4>(4), "4-ary heap matches the model");
+  check(matches_model<2>(2), "binary heap matches the model");
+
+  std::cout << "\n"
+            << pass_count << " passed, " << fail_count << " failed\n";
+  return fail_count == 0 ? 0 : 1;
+}
@@ -0,0 +1,221 @@
+#include "lib_xcore"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+static int pass_count = 0;
+static int fail_count = 0;
+
+static void check(const bool condition, const char *label) {
+  if (condition) {
+    std::cout << "  [PASS] " << label << "\n";
+    ++pass_count;
+  } else {
+    std::cout << "  [FAIL] " << label << "\n";
+    ++fail_count;
+  }
+}
+
+static void section(const char *title) {
+  std::cout << "\n"
+            << title << "\n";
+}
+
+// Fraction of the sorted samples below an estimate, i.e. the quantile it actually is
+static double rank_of(const std::vector<double> &sorted, const double estimate) {
+  const auto lo = std::lower_bound(sorted.begin(), sorted.end(), estimate) - sorted.begin();
+  const auto hi = std::upper_bound(sorted.begin(), sorted.end(), estimate) - sorted.begin();
+  return static_cast<double>(lo + hi) / 2 / static_cast<double>(sorted.size());
+}
+
+template<typename Dist>
+static std::vector<double> draw(Dist dist, const size_t n, const uint32_t seed) {
+  std::mt19937        rng(seed);
+  std::vector<double> samples(n);
+  for (double &x: samples) x = dist(rng);
+  return samples;
+}
+
+int main() {
+  const std::vector<double> normal      = draw(std::normal_distribution<double>(0, 1), 1000000, 1);
+  const std::vector<double> lognormal   = draw(std::lognormal_distribution<double>(3, 1), 1000000, 2);
+  const std::vector<double> exponential = draw(std::exponential_distribution<double>(0.01), 1000000, 3);
+
+  // -------------------------------------------------------------------------
+  section("P2");
+  // -------------------------------------------------------------------------
+  {
+    xcore::p2_quantile_t median(0.5);
+    check(std::isnan(median.value()) && median.count() == 0, "empty estimator is NaN");
+
+    for (const double x: {5.0, 1.0, 3.0}) median.push(x);
+    check(median.value() == 3.0 && median.min() == 1.0 && median.max() == 5.0, "exact below five samples");
+
+    for (const double x: {4.0, 2.0}) median.push(x);
+    check(median.value() == 3.0, "five samples");
+  }
+
+  for (const auto *samples: {&normal, &lognormal, &exponential}) {
+    std::vector<double> sorted = *samples;
+    std::sort(sorted.begin(), sorted.end());
+
+    bool accurate = true;
+    for (const double p: {0.5, 0.9, 0.99, 0.999}) {
+      xcore::p2_quantile_t estimator(p);
+      for (const double x: *samples) estimator.push(x);
+      const double error = std::fabs(rank_of(sorted, estimator.value()) - p);
+      accurate &= error < (p < 0.99 ? 0.005 : 0.001);
+      accurate &= estimator.min() == sorted.front() && estimator.max() == sorted.back();
+    }
+    check(accurate, samples == &normal ? "normal: p50 to p999 within bound" : samples == &lognormal ? "lognormal: p50 to p999 within bound" : "exponential: p50 to p999 within bound");
+  }
+
+  // -------------------------------------------------------------------------
+  section("t-digest");
+  // -------------------------------------------------------------------------
+  {
+    xcore::t_digest_t<100> digest;
+    check(std::isnan(digest.quantile(0.5)) && std::isnan(digest.cdf(0)), "empty digest is NaN");
+
+    digest.push(42);
+    check(digest.quantile(0) == 42 && digest.quantile(0.5) == 42 && digest.quantile(1) == 42, "single sample");
+
+    digest.clear();
+    for (int i = 1; i <= 100; ++i) digest.push(i);
+    check(digest.quantile(0) == 1 && digest.quantile(1) == 100 && std::fabs(digest.quantile(0.5) - 50.5) < 1, "small exact-ish set");
+    check(digest.count() == 100, "count");
+  }
+
+  for (const auto *samples: {&normal, &lognormal, &exponential}) {
+    std::vector<double> sorted = *samples;
+    std::sort(sorted.begin(), sorted.end());
+
+    xcore::t_digest_t<100> digest;
+    for (const double x: *samples) digest.push(x);
+
+    bool accurate = true;
+    for (const double q: {0.001, 0.01, 0.1, 0.5, 0.9, 0.99, 0.999}) {
+      const double error = std::fabs(rank_of(sorted, digest.quantile(q)) - q);
+      accurate &= error < 3.14159265358979323846 * std::sqrt(q * (1 - q)) / (2 * 100);
+    }
+    accurate &= digest.min() == sorted.front() && digest.max() == sorted.back();
+    accurate &= digest.centroids() <= 101;
+    check(accurate, samples == &normal ? "normal: p0.1 to p999 within bound" : samples == &lognormal ? "lognormal: p0.1 to p999 within bound" : "exponential: p0.1 to p999 within bound");
+  }
+
+  {
+    std::vector<double> sorted = lognormal;
+    std::sort(sorted.begin(), sorted.end());
+
+    // Sorted input, the worst order for P2, and merged halves
+    xcore::t_digest_t<100> ordered, left, right;
+    for (const double x: sorted) ordered.push(x);
+    for (size_t i = 0; i < lognormal.size(); ++i) (i % 2 ? left : right).push(lognormal[i]);
+    left.merge(right);
+
+    bool accurate = true;
+    for (const double q: {0.01, 0.5, 0.99, 0.999}) {
+      accurate &= std::fabs(rank_of(sorted, ordered.quantile(q)) - q) < 0.005;
+      accurate &= std::fabs(rank_of(sorted, left.quantile(q)) - q) < 0.005;
+    }
+    check(accurate, "sorted input and merged digests");
+    check(left.count() == 1000000 && left.min() == sorted.front() && left.max() == sorted.back(), "merge keeps count, min and max");
+
+    bool inverse = true;
+    for (const double q: {0.05, 0.5, 0.95}) inverse &= std::fabs(left.cdf(left.quantile(q)) - q) < 0.001;
+    check(inverse, "cdf inverts quantile");
+  }
+
+  // -------------------------------------------------------------------------
+  section("HDR histogram");
+  // -------------------------------------------------------------------------
+  using histogram_t = xcore::hdr_histogram_t<7, 40>;
+  {
+    bool layout = true;
+    for (size_t i = 0; i < histogram_t::bucket_count; ++i) {
+      const uint64_t lo = histogram_t::lowest_of(i);
+      layout &= histogram_t::index_of(lo) == i && (i == 0 || histogram_t::index_of(lo - 1) == i - 1);
+    }
+    check(layout, "buckets are contiguous and ordered");
+    check(histogram_t::index_of(histogram_t::max_trackable) == histogram_t::bucket_count - 1 && histogram_t::index_of(~uint64_t(0)) == histogram_t::bucket_count - 1, "values past the range go to the last bucket");
+
+    bool exact = true;
+    for (uint64_t v = 0; v < 2 * histogram_t::sub_buckets; ++v) exact &= histogram_t::midpoint_of(histogram_t::index_of(v)) == v;
+    check(exact, "small values are exact");
+
+    std::mt19937_64 rng(4);
+    double          worst = 0;
+    for (int i = 0; i < 1000000; ++i) {
+      const uint64_t v = (rng() >> (rng() % 40)) & histogram_t::max_trackable;
+      if (v == 0) continue;
+      const double error = std::fabs(static_cast<double>(histogram_t::midpoint_of(histogram_t::index_of(v))) - static_cast<double>(v)) / static_cast<double>(v);
+      worst              = std::max(worst, error);
+    }
+    check(worst <= 1.0 / 256, "relative error at most 2^-(Precision + 1)");
+  }
+
+  {
+    auto *h = new histogram_t();
+    check(h->count() == 0 && h->quantile(0.5) == 0 && h->min() == 0 && h->max() == 0, "empty histogram");
+
+    std::vector<double> sorted;
+    sorted.reserve(exponential.size());
+    for (const double x: exponential) {
+      const auto v = static_cast<uint64_t>(x * 1000);  // 1/100 s in us
+      h->record(v);
+      sorted.push_back(static_cast<double>(v));
+    }
+    std::sort(sorted.begin(), sorted.end());
+
+    bool accurate = true;
+    for (const double q: {0.0, 0.5, 0.9, 0.99, 0.999, 1.0}) {
+      const size_t rank  = std::max<size_t>(1, static_cast<size_t>(std::ceil(q * static_cast<double>(sorted.size()))));
+      const double exact = sorted[rank - 1];
+      accurate &= std::fabs(static_cast<double>(h->quantile(q)) - exact) <= exact / 256 + 1;
+    }
+    check(accurate, "quantiles within the bucket error");
+    check(h->min() == static_cast<uint64_t>(sorted.front()) && h->max() == static_cast<uint64_t>(sorted.back()), "exact min and max");
+    check(h->count_at_most(h->max()) == h->count() && h->count_at_most(0) == static_cast<uint64_t>(std::upper_bound(sorted.begin(), sorted.end(), 0.0) - sorted.begin()), "count_at_most");
+
+    double sum = 0;
+    for (const double x: sorted) sum += x;
+    check(std::fabs(h->mean() - sum / static_cast<double>(sorted.size())) < 1e-6 * h->mean(), "exact mean");
+
+    auto *other = new histogram_t();
+    other->record(5, 10);
+    other->record(uint64_t(1) << 50);
+    h->merge(*other);
+    check(h->count() == sorted.size() + 11 && h->min() == std::min<uint64_t>(5, static_cast<uint64_t>(sorted.front())) && h->max() == uint64_t(1) << 50, "merge");
+    check(h->quantile(1.0) == uint64_t(1) << 50, "top quantile clamped to the exact max");
+
+    h->reset();
+    check(h->count() == 0 && h->quantile(0.99) == 0 && h->count_at_most(~uint64_t(0)) == 0, "reset");
+    delete other;
+    delete h;
+  }
+
+  {
+    // Concurrent recording loses nothing
+    auto                    *h = new histogram_t();
+    std::vector<std::thread> threads;
+    for (uint64_t t = 0; t < 4; ++t) {
+      threads.emplace_back([h, t]() {
+        for (uint64_t i = 0; i < 100000; ++i) h->record(t * 1000 + i % 1000);
+      });
+    }
+    for (auto &thread: threads) thread.join();
+
+    check(h->count() == 400000 && h->count_at_most(~uint64_t(0)) == 400000, "four threads record every sample");
+    check(h->min() == 0 && h->max() == 3999, "concurrent min and max");
+    delete h;
+  }
+
+  std::cout << "\n"
+            << pass_count << " passed, " << fail_count << " failed\n";
+  return fail_count == 0 ? 0 : 1;
+}
@@ -0,0 +1,153 @@
+#include "lib_xcore"
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+static int pass_count = 0;
+static int fail_count = 0;
+
+static void check(const bool condition, const char *label) {
+  if (condition) {
+    std::cout << "  [PASS] " << label << "\n";
+    ++pass_count;
+  } else {
+    std::cout << "  [FAIL] " << label << "\n";
+    ++fail_count;
+  }
+}
+
+static void section(const char *title) {
+  std::cout << "\n"
+            << title << "\n";
+}
+
+using slab_t = xcore::slab_allocator_t<16, 4096>;
+
+static slab_t slab;
+
+template<typename Tp>
+using slab_alloc = xcore::slab_allocator_form_t<slab>::type<Tp>;
+
+template<typename Tp, size_t Size>
+using slab_heap_array = xcore::heap_array_t<Tp, Size, slab_alloc>;
+
+int main() {
+  // -------------------------------------------------------------------------
+  section("Size classes");
+  // -------------------------------------------------------------------------
+  {
+    bool smallest = true;
+    for (size_t n = 1; n <= 65536; ++n) {
+      const size_t c = xcore::slab_size_class::index(n);
+      smallest &= xcore::slab_size_class::size(c) >= n && (c == 0 || xcore::slab_size_class::size(c - 1) < n);
+    }
+    check(smallest, "index() picks the smallest class holding n bytes");
+    check(xcore::slab_size_class::size(4) == 80 && xcore::slab_size_class::size(8) == 160 &&
+            xcore::slab_size_class::size(19) == 1024,
+          "jemalloc-like spacing");
+    check(slab_t::max_block_size == 512 && slab_t::num_classes == 16, "classes up to SlabSize / 8");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Allocation");
+  // -------------------------------------------------------------------------
+  {
+    void *a = slab.allocate(24);
+    void *b = slab.allocate(24);
+    check(slab.owns(a) && slab.owns(b) && slab.block_size(a) == 32, "small blocks come from a slab");
+    check((reinterpret_cast<uintptr_t>(a) & 15) == 0 && static_cast<char *>(b) - static_cast<char *>(a) == 32,
+          "blocks are 16-byte aligned and packed");
+
+    slab.deallocate(a);
+    check(slab.allocate(30) == a, "a freed block is reused first");
+    slab.deallocate(a);
+    slab.deallocate(b);
+
+    void *big = slab.allocate(10000);
+    check(big && !slab.owns(big), "large blocks fall back to malloc");
+    slab.deallocate(big);
+    check(slab.allocate(0) == nullptr, "zero bytes");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Stress against a shadow model");
+  // -------------------------------------------------------------------------
+  {
+    struct block_t {
+      unsigned char *ptr;
+      size_t         size;
+      unsigned char  fill;
+    };
+
+    std::mt19937_64      rng(7);
+    std::vector<block_t> live;
+    bool                 intact   = true;
+    size_t               fallback = 0;
+
+    for (int step = 0; step < 200000; ++step) {
+      if (live.empty() || rng() % 100 < 55) {
+        const size_t size = 1 + rng() % 600;
+        auto        *ptr  = static_cast<unsigned char *>(slab.allocate(size));
+        const auto   fill = static_cast<unsigned char>(rng());
+        memset(ptr, fill, size);
+        fallback += !slab.owns(ptr);
+        live.push_back({ptr, size, fill});
+      } else {
+        const size_t i = rng() % live.size();
+        block_t      b = live[i];
+
+        for (size_t k = 0; k < b.size; ++k) intact &= b.ptr[k] == b.fill;
+
+        if (rng() % 4 == 0) {
+          const size_t size = 1 + rng() % 600;
+          b.ptr             = static_cast<unsigned char *>(slab.reallocate(b.ptr, size));
+          for (size_t k = 0; k < (size < b.size ? size : b.size); ++k) intact &= b.ptr[k] == b.fill;
+          b.size = size;
+          memset(b.ptr, b.fill, b.size);
+          live[i] = b;
+        } else {
+          slab.deallocate(b.ptr);
+          live[i] = live.back();
+          live.pop_back();
+        }
+      }
+    }
+
+    check(intact, "no block overlaps another, content survives reallocate");
+    check(fallback > 0, "exhausted arena falls back to malloc");
+
+    for (const block_t &b: live) slab.deallocate(b.ptr);
+    check(slab.slabs_in_use() <= slab_t::num_classes, "empty slabs go back to the arena");
+
+    // Slabs released by one class serve another
+    std::vector<void *> blocks;
+    for (int i = 0; i < 16 * 7; ++i) blocks.push_back(slab.allocate(512));
+    bool owned = true;
+    for (void *p: blocks) owned &= slab.owns(p);
+    check(owned && slab.slabs_in_use() >= 16, "the whole arena is reusable by a single class");
+    for (void *p: blocks) slab.deallocate(p);
+  }
+
+  // -------------------------------------------------------------------------
+  section("Container adapter");
+  // -------------------------------------------------------------------------
+  {
+    xcore::dynamic_array_t<float, 0, slab_alloc> samples(10);
+    check(slab.owns(static_cast<float *>(samples)) && samples[9] == 0.0f, "dynamic_array_t storage is zero-filled");
+
+    for (size_t i = 0; i < 10; ++i) samples[i] = static_cast<float>(i);
+    samples.dynamic_resize(100);
+    check(slab.owns(static_cast<float *>(samples)) && samples[9] == 9.0f, "resize moves to a larger class");
+
+    xcore::container::impl::basic_string_t<char, 48, slab_heap_array> msg;
+    msg += "telemetry ";
+    msg += 42;
+    check(slab.owns(msg.c_str()) && strcmp(msg.c_str(), "telemetry 42") == 0, "heap string on the slab");
+  }
+
+  std::cout << "\n"
+            << pass_count << " passed, " << fail_count << " failed\n";
+  return fail_count == 0 ? 0 : 1;
+}
@@ -0,0 +1,134 @@
+#include "lib_xcore"
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+static int pass_count = 0;
+static int fail_count = 0;
+
+static void check(const bool condition, const char *label) {
+  if (condition) {
+    std::cout << "  [PASS] " << label << "\n";
+    ++pass_count;
+  } else {
+    std::cout << "  [FAIL] " << label << "\n";
+    ++fail_count;
+  }
+}
+
+static void section(const char *title) {
+  std::cout << "\n"
+            << title << "\n";
+}
+
+struct entity_t {
+  static inline int alive = 0;
+
+  uint32_t id;
+  float    x;
+
+  entity_t(const uint32_t id, const float x) : id(id), x(x) { ++alive; }
+  entity_t(entity_t &&other) noexcept : id(other.id), x(other.x) { ++alive; }
+  ~entity_t() { --alive; }
+};
+
+int main() {
+  // -------------------------------------------------------------------------
+  section("Handles");
+  // -------------------------------------------------------------------------
+  {
+    using map_t = xcore::slot_map_t<int, 1000>;
+    map_t map;
+
+    check(map_t::index_bits == 10 && sizeof(map_t::handle_t) == 4, "10 index bits, 32-bit handles");
+    check(!map.contains(map_t::handle_t{}) && map.get(map_t::handle_t{}) == nullptr, "the null handle is never valid");
+
+    const auto a = map.insert(10);
+    const auto b = map.insert(20);
+    check(a && b && a != b && *map.get(a) == 10 && map[b] == 20, "insert and lookup");
+
+    check(map.erase(a) && !map.contains(a) && map.get(a) == nullptr, "erase invalidates the handle");
+    check(!map.erase(a), "a stale handle cannot erase twice");
+
+    const auto c = map.insert(30);
+    check(c.index() == a.index() && c != a && map.get(a) == nullptr && map[c] == 30,
+          "a reused slot gets a new generation");
+    check(map[b] == 20 && map.size() == 2, "other handles survive");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Dense storage");
+  // -------------------------------------------------------------------------
+  {
+    xcore::slot_map_t<entity_t, 8> entities;
+    xcore::slot_map_t<entity_t, 8>::handle_t ids[8];
+
+    for (uint32_t i = 0; i < 8; ++i) ids[i] = entities.emplace(i, static_cast<float>(i));
+    check(entities.full() && !entities.emplace(99u, 0.0f), "a full map returns a null handle");
+
+    entities.erase(ids[2]);
+    entities.erase(ids[5]);
+
+    float sum   = 0;
+    bool  found = true;
+    for (const entity_t &e: entities) sum += e.x;
+    for (uint32_t i = 0; i < 8; ++i) found &= (i == 2 || i == 5) ? !entities.get(ids[i]) : entities.get(ids[i])->id == i;
+    check(entities.size() == 6 && sum == 21.0f, "iteration covers live objects only");
+    check(found, "handles follow objects moved by erase");
+
+    bool handles = true;
+    for (size_t pos = 0; pos < entities.size(); ++pos) handles &= entities.get(entities.handle_at(pos)) == entities.begin() + pos;
+    check(handles, "handle_at() matches dense positions");
+
+    check(entity_t::alive == 6, "erase destroys the object");
+    entities.clear();
+    check(entity_t::alive == 0 && entities.empty() && !entities.get(ids[0]), "clear() destroys everything");
+  }
+  check(entity_t::alive == 0, "the destructor destroys live objects");
+
+  // -------------------------------------------------------------------------
+  section("Stress against a shadow model");
+  // -------------------------------------------------------------------------
+  {
+    using map_t = xcore::slot_map_t<uint64_t, 256>;
+    map_t map;
+
+    struct live_t {
+      map_t::handle_t handle;
+      uint64_t        value;
+    };
+
+    std::mt19937_64              rng(3);
+    std::vector<live_t>          live;
+    std::vector<map_t::handle_t> dead;
+    bool                         consistent = true;
+
+    for (int step = 0; step < 200000; ++step) {
+      if (live.empty() || (rng() % 100 < 55 && !map.full())) {
+        const uint64_t value = rng();
+        live.push_back({map.insert(value), value});
+      } else {
+        const size_t i = rng() % live.size();
+        consistent &= map.erase(live[i].handle);
+        dead.push_back(live[i].handle);
+        live[i] = live.back();
+        live.pop_back();
+      }
+
+      if (step % 1000 == 0) {
+        for (const live_t &l: live) consistent &= map.get(l.handle) && *map.get(l.handle) == l.value;
+        consistent &= map.size() == live.size();
+      }
+    }
+
+    size_t stale = 0;
+    for (const map_t::handle_t h: dead) stale += map.contains(h);
+    check(consistent, "lookups match the model");
+    check(stale * 100 < dead.size(), "stale handles are rejected, up to generation wrap-around");
+  }
+
+  std::cout << "\n"
+            << pass_count << " passed, " << fail_count << " failed\n";
+  return fail_count == 0 ? 0 : 1;
+}
@@ -0,0 +1,160 @@
+#include "lib_xcore"
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+static int pass_count = 0;
+static int fail_count = 0;
+
+static void check(const bool condition, const char *label) {
+  if (condition) {
+    std::cout << "  [PASS] " << label << "\n";
+    ++pass_count;
+  } else {
+    std::cout << "  [FAIL] " << label << "\n";
+    ++fail_count;
+  }
+}
+
+static void section(const char *title) {
+  std::cout << "\n"
+            << title << "\n";
+}
+
+// Position, velocity, flags
+using entities_t = xcore::soa_vector_t<64, float, float, uint8_t>;
+
+// Every row holds (i, 10 i, i % 256) for some i, so a mismatch shows a column out of step
+static bool rows_consistent(const entities_t &e) {
+  for (size_t i = 0; i < e.size(); ++i) {
+    const auto [x, v, flags] = e[i];
+    if (v != x * 10 || flags != static_cast<uint8_t>(static_cast<int>(x))) return false;
+  }
+  return true;
+}
+
+int main() {
+  // -------------------------------------------------------------------------
+  section("Rows and columns");
+  // -------------------------------------------------------------------------
+  {
+    entities_t e;
+    check(e.empty() && e.capacity() == 64 && entities_t::fields == 3, "starts empty");
+
+    for (int i = 0; i < 5; ++i) e.push_back(float(i), float(i * 10), uint8_t(i));
+    check(e.size() == 5 && rows_consistent(e), "push_back fills every column");
+
+    check(reinterpret_cast<uintptr_t>(e.column<0>()) % 64 == 0 && reinterpret_cast<uintptr_t>(e.column<1>()) % 64 == 0 &&
+            reinterpret_cast<uintptr_t>(e.column<2>()) % 64 == 0,
+          "columns are aligned to a cache line");
+
+    auto [x, v, flags] = e[2];
+    x                  = 7;
+    flags              = 9;
+    check(e.at<0>(2) == 7 && e.at<2>(2) == 9 && v == 20, "rows are references");
+
+    e.set(2, 2.f, 20.f, uint8_t(2));
+    e[3] = e[4];
+    check(e.at<0>(3) == 4 && e.at<1>(3) == 40 && e.at<2>(3) == 4, "row assignment copies every field");
+    e.set(3, 3.f, 30.f, uint8_t(3));
+
+    auto [vel, n] = e.column_span<1>();
+    auto *pos     = e.column<0>();
+    for (size_t i = 0; i < n; ++i) pos[i] += vel[i];
+    check(e.at<0>(4) == 44 && e.at<0>(1) == 11, "column loops update one field");
+
+    float sum = 0;
+    for (const auto [p, vv, f]: static_cast<const entities_t &>(e)) sum += vv;
+    check(sum == 100, "iteration yields rows");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Insert and erase");
+  // -------------------------------------------------------------------------
+  {
+    entities_t e;
+    for (int i = 0; i < 10; ++i) e.push_back(float(i), float(i * 10), uint8_t(i));
+
+    e.erase(2);
+    check(e.size() == 9 && e.at<0>(2) == 3 && rows_consistent(e), "erase keeps order");
+
+    e.erase(0, 3);
+    check(e.size() == 6 && e.at<0>(0) == 4 && rows_consistent(e), "erase of a range");
+
+    e.swap_erase(0);
+    check(e.size() == 5 && e.at<0>(0) == 9 && rows_consistent(e), "swap_erase moves the last row");
+
+    check(e.insert(1, 42.f, 420.f, uint8_t(42)) && e.at<0>(1) == 42 && e.at<0>(2) == 5 && rows_consistent(e), "insert shifts rows");
+    check(!e.insert(7, 1.f, 10.f, uint8_t(1)), "insert past the end fails");
+
+    const size_t removed = e.erase_if([](const auto &row) { return static_cast<int>(xcore::get<0>(row)) % 2 == 0; });
+    std::vector<float> left;
+    for (size_t i = 0; i < e.size(); ++i) left.push_back(e.at<0>(i));
+    check(removed == 3 && left == std::vector<float>({9, 5, 7}) && rows_consistent(e), "erase_if compacts in order");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Bulk push");
+  // -------------------------------------------------------------------------
+  {
+    std::vector<float>   x(100), v(100);
+    std::vector<uint8_t> f(100);
+    for (int i = 0; i < 100; ++i) x[i] = float(i), v[i] = float(i * 10), f[i] = uint8_t(i);
+
+    entities_t e;
+    e.push_back(0.f, 0.f, uint8_t(0));
+    check(e.push_back_n(50, x.data() + 1, v.data() + 1, f.data() + 1) == 50 && e.size() == 51, "push_back_n copies rows");
+    check(e.push_back_n(50, x.data(), v.data(), f.data()) == 13 && e.full(), "push_back_n stops at Capacity");
+    check(!e.push_back(1.f, 10.f, uint8_t(1)) && rows_consistent(e), "columns stay in step");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Random operations against a model");
+  // -------------------------------------------------------------------------
+  {
+    struct row_t {
+      float   x, v;
+      uint8_t f;
+    };
+
+    entities_t         e;
+    std::vector<row_t> model;
+    std::mt19937       rng(4);
+    bool               consistent = true;
+
+    for (int step = 0; step < 20000; ++step) {
+      const int   op = static_cast<int>(rng() % 5);
+      const float x  = float(rng() % 200);
+      if (op == 0 && model.size() < 64) {
+        e.push_back(x, x * 10, uint8_t(int(x)));
+        model.push_back({x, x * 10, uint8_t(int(x))});
+      } else if (op == 1 && model.size() < 64) {
+        const size_t pos = rng() % (model.size() + 1);
+        e.insert(pos, x, x * 10, uint8_t(int(x)));
+        model.insert(model.begin() + static_cast<long>(pos), {x, x * 10, uint8_t(int(x))});
+      } else if (op == 2 && !model.empty()) {
+        const size_t pos = rng() % model.size();
+        e.erase(pos);
+        model.erase(model.begin() + static_cast<long>(pos));
+      } else if (op == 3 && !model.empty()) {
+        const size_t pos = rng() % model.size();
+        e.swap_erase(pos);
+        model[pos] = model.back();
+        model.pop_back();
+      } else if (!model.empty()) {
+        const size_t first = rng() % model.size(), last = first + rng() % 4;
+        e.erase(first, last);
+        model.erase(model.begin() + static_cast<long>(first), model.begin() + static_cast<long>(std::min(last, model.size())));
+      }
+
+      consistent &= e.size() == model.size();
+      for (size_t i = 0; consistent && i < model.size(); ++i) consistent &= e.at<0>(i) == model[i].x && e.at<1>(i) == model[i].v && e.at<2>(i) == model[i].f;
+    }
+    check(consistent, "matches a vector of structs");
+  }
+
+  std::cout << "\n"
+            << pass_count << " passed, " << fail_count << " failed\n";
+  return fail_count == 0 ? 0 : 1;
+}
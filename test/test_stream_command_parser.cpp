@@ -0,0 +1,181 @@
+#include "lib_xcore"
+#include <cstring>
+#include <iostream>
+#include <string>
+
+static int pass_count = 0;
+static int fail_count = 0;
+
+static void check(const bool condition, const char *label) {
+  if (condition) {
+    std::cout << "  [PASS] " << label << "\n";
+    ++pass_count;
+  } else {
+    std::cout << "  [FAIL] " << label << "\n";
+    ++fail_count;
+  }
+}
+
+static void section(const char *title) {
+  std::cout << "\n"
+            << title << "\n";
+}
+
+template<typename Parser>
+static size_t feed_str(Parser &parser, const char *s) {
+  return parser.feed(s, strlen(s));
+}
+
+int main() {
+  // -------------------------------------------------------------------------
+  section("Single line in one chunk");
+  // -------------------------------------------------------------------------
+  {
+    xcore::stream_command_parser_t<> parser;
+    const size_t                     used = feed_str(parser, "move 10 20\n");
+    check(used == 11, "consumed the whole line");
+    check(parser.ready(), "ready()");
+    check(parser.argc() == 3, "argc == 3");
+    check(parser.is("move"), "command == \"move\"");
+    check(strcmp(parser.argv[2], "20") == 0, "argv[2] == \"20\"");
+    check(parser.arg<int>(1).value_or(0) == 10, "arg<int>(1) == 10");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Byte-by-byte feeding");
+  // -------------------------------------------------------------------------
+  {
+    xcore::stream_command_parser_t<> parser;
+    const char                      *line  = "  set   gain 0.25  \r\n";
+    size_t                           ready = 0;
+    for (const char *p = line; *p; ++p) {
+      parser.feed(p, 1);
+      if (parser.ready()) {
+        ++ready;
+        check(parser.argc() == 3, "argc == 3");
+        check(parser.is("set"), "command == \"set\"");
+        check(strcmp(parser.argv[1], "gain") == 0, "argv[1] == \"gain\"");
+        check(parser.arg<double>(2).value_or(0.0) == 0.25, "arg<double>(2) == 0.25");
+      }
+    }
+    check(ready == 1, "exactly one command (CRLF, blank lines skipped)");
+    check(parser.argc() == 0, "argc == 0 after the next feed");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Several lines and partial tail");
+  // -------------------------------------------------------------------------
+  {
+    xcore::stream_command_parser_t<> parser;
+    const char                      *data  = "alpha one\nbravo two three\n\nchar";
+    size_t                           n     = strlen(data);
+    const char                      *p     = data;
+    std::string                      names[2];
+    size_t                           count = 0;
+
+    while (n > 0) {
+      const size_t used = parser.feed(p, n);
+      p += used;
+      n -= used;
+      if (parser.ready() && count < 2) names[count++] = parser.command();
+    }
+
+    check(count == 2, "two complete commands");
+    check(names[0] == "alpha", "first command == \"alpha\"");
+    check(names[1] == "bravo", "second command == \"bravo\"");
+    check(!parser.ready(), "tail \"char\" not complete");
+
+    feed_str(parser, "lie 9\n");
+    check(parser.ready() && parser.is("charlie"), "tail completed across feeds");
+    check(parser.arg<int>(1).value_or(0) == 9, "arg<int>(1) == 9");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Word-sized runs and delimiter boundaries");
+  // -------------------------------------------------------------------------
+  {
+    xcore::stream_command_parser_t<128, 16> parser;
+    feed_str(parser, "abcdefgh ijklmnop qr  stuvwxyz0123456789 x\n");
+    check(parser.argc() == 5, "argc == 5");
+    check(strcmp(parser.argv[0], "abcdefgh") == 0, "argv[0] == \"abcdefgh\"");
+    check(strcmp(parser.argv[1], "ijklmnop") == 0, "argv[1] == \"ijklmnop\"");
+    check(strcmp(parser.argv[2], "qr") == 0, "argv[2] == \"qr\"");
+    check(strcmp(parser.argv[3], "stuvwxyz0123456789") == 0, "argv[3] spans two words");
+    check(strcmp(parser.argv[4], "x") == 0, "argv[4] == \"x\"");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Tab separation");
+  // -------------------------------------------------------------------------
+  {
+    xcore::stream_command_parser_t<128, 16> parser;
+    feed_str(parser, "write\t0x40001000\t \tff\n");
+    check(parser.argc() == 3, "argc == 3");
+    check(strcmp(parser.argv[1], "0x40001000") == 0, "argv[1] == \"0x40001000\" (word-sized run)");
+    check(strcmp(parser.argv[2], "ff") == 0, "argv[2] == \"ff\" after mixed blanks");
+
+    xcore::stream_command_parser_t<64, 8, ','> csv;
+    feed_str(csv, "a\tb,c\n");
+    check(csv.argc() == 2 && strcmp(csv.argv[0], "a\tb") == 0, "custom delimiter keeps tabs");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Custom delimiter");
+  // -------------------------------------------------------------------------
+  {
+    xcore::stream_command_parser_t<64, 8, ','> parser;
+    feed_str(parser, "pid,1.5,0.1,0.05\n");
+    check(parser.argc() == 4, "argc == 4");
+    check(parser.arg<float>(3).value_or(0.0f) == 0.05f, "arg<float>(3) == 0.05f");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Overlong line is dropped");
+  // -------------------------------------------------------------------------
+  {
+    xcore::stream_command_parser_t<16> parser;
+    feed_str(parser, "this line is much too long for the buffer\n");
+    check(parser.dropped() == 1, "dropped() == 1");
+    check(!parser.ready(), "overlong line not reported");
+    feed_str(parser, "ok 1\n");
+    check(parser.ready() && parser.is("ok"), "next line parsed");
+  }
+
+  // -------------------------------------------------------------------------
+  section("MaxArgs clamping");
+  // -------------------------------------------------------------------------
+  {
+    xcore::stream_command_parser_t<64, 3> parser;
+    feed_str(parser, "a b c d e\n");
+    check(parser.argc() == 3, "argc clamped to MaxArgs (3)");
+    check(strcmp(parser.argv[2], "c") == 0, "argv[2] == \"c\"");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Feeding from byte_buffer_t spans");
+  // -------------------------------------------------------------------------
+  {
+    xcore::byte_buffer_t<16>         rx;
+    xcore::stream_command_parser_t<> parser;
+    unsigned char                    sink[10];
+
+    // Advance the ring so the next line wraps around
+    rx.push(reinterpret_cast<const unsigned char *>("0123456789"), 10);
+    rx.pop(sink, 10);
+
+    const char *line = "led on 3\nx";
+    rx.push(reinterpret_cast<const unsigned char *>(line), strlen(line));
+
+    check(parser.feed(rx), "command completed from wrapped buffer");
+    check(parser.is("led") && parser.arg<int>(2).value_or(0) == 3, "tokens intact across the wrap");
+    check(rx.size() == 1, "bytes after the terminator left in the buffer");
+    check(!parser.feed(rx) && rx.empty(), "partial line consumed, not ready");
+  }
+
+  // -------------------------------------------------------------------------
+  std::cout << "\n"
+            << pass_count << " passed, "
+            << fail_count << " failed.\n";
+
+  return fail_count == 0 ? 0 : 1;
+}
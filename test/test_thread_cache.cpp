@@ -0,0 +1,133 @@
+#include "lib_xcore"
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+static int pass_count = 0;
+static int fail_count = 0;
+
+static void check(const bool condition, const char *label) {
+  if (condition) {
+    std::cout << "  [PASS] " << label << "\n";
+    ++pass_count;
+  } else {
+    std::cout << "  [FAIL] " << label << "\n";
+    ++fail_count;
+  }
+}
+
+static void section(const char *title) {
+  std::cout << "\n"
+            << title << "\n";
+}
+
+struct message_t {
+  uint64_t id;
+  double   values[5];
+};
+
+static xcore::bitmap_cache_backend_t<message_t, 1024> pool;
+
+using message_cache = xcore::thread_cache_t<pool>;
+using malloc_cache  = xcore::malloc_thread_cache_t;
+
+static bool is_aligned(const void *p) {
+  return (reinterpret_cast<uintptr_t>(p) & 15) == 0;
+}
+
+int main() {
+  // -------------------------------------------------------------------------
+  section("Single thread");
+  // -------------------------------------------------------------------------
+  {
+    void *a = malloc_cache::allocate(24);
+    void *b = malloc_cache::allocate(24);
+    check(a && b && a != b && is_aligned(a) && is_aligned(b), "16-byte aligned blocks");
+    check(malloc_cache::usable_size(a) == 32, "size classes of slab_allocator_t");
+
+    malloc_cache::deallocate(b);
+    check(malloc_cache::allocate(30) == b, "a freed block is reused from the freelist");
+
+    void *big = malloc_cache::allocate(5000);
+    memset(big, 1, 5000);
+    check(big && malloc_cache::usable_size(big) == 5000, "large blocks bypass the cache");
+
+    auto *grown = static_cast<unsigned char *>(malloc_cache::reallocate(a, 20));
+    check(grown == a, "reallocate within the class stays in place");
+    memset(grown, 7, 20);
+    grown = static_cast<unsigned char *>(malloc_cache::reallocate(grown, 300));
+    check(grown != a && grown[19] == 7 && malloc_cache::usable_size(grown) >= 300, "reallocate to a larger class");
+
+    malloc_cache::deallocate(grown);
+    malloc_cache::deallocate(b);
+    malloc_cache::deallocate(big);
+    check(malloc_cache::allocate(0) == nullptr, "zero bytes");
+
+    void *msg = message_cache::allocate(sizeof(message_t));
+    check(msg && pool.in_use() > 1 && message_cache::cached() == pool.in_use() - 1, "cells come in batches");
+    check(message_cache::allocate(sizeof(message_t) + 1) == nullptr, "bitmap backend serves one size");
+    message_cache::deallocate(msg);
+  }
+
+  // -------------------------------------------------------------------------
+  section("Threads");
+  // -------------------------------------------------------------------------
+  {
+    const size_t held = pool.in_use();
+
+    std::vector<void *> produced;
+    std::thread producer([&] {
+      for (int i = 0; i < 500; ++i) {
+        auto *msg = static_cast<message_t *>(message_cache::allocate(sizeof(message_t)));
+        msg->id   = static_cast<uint64_t>(i);
+        produced.push_back(msg);
+      }
+    });
+    producer.join();
+
+    bool ids = produced.size() == 500;
+    for (size_t i = 0; i < produced.size(); ++i) ids &= static_cast<message_t *>(produced[i])->id == i;
+    check(ids, "blocks allocated by another thread");
+    check(pool.in_use() == held + 500, "an exiting thread gives its freelists back");
+
+    // Frees from this thread go to the remote queue of the producer's cache
+    for (void *msg: produced) message_cache::deallocate(msg);
+    check(pool.in_use() == held + 500, "remote frees wait in the owner's queue");
+
+    std::thread adopter([] {
+      message_cache::deallocate(message_cache::allocate(sizeof(message_t)));
+    });
+    adopter.join();
+    check(pool.in_use() == held, "the next thread takes over the cache and its remote frees");
+
+    std::vector<std::thread> workers;
+    bool                     intact[4] = {true, true, true, true};
+    for (int t = 0; t < 4; ++t) {
+      workers.emplace_back([t, &intact] {
+        std::vector<unsigned char *> live;
+        for (int step = 0; step < 20000; ++step) {
+          if (live.size() < 64 && (step % 3 != 0 || live.empty())) {
+            const size_t size = 1 + (step * 37 + t * 11) % 900;
+            auto        *p    = static_cast<unsigned char *>(malloc_cache::allocate(size));
+            memset(p, t + 1, size);
+            live.push_back(p);
+          } else {
+            unsigned char *p = live.back();
+            live.pop_back();
+            intact[t] &= p[0] == t + 1;
+            malloc_cache::deallocate(p);
+          }
+        }
+        for (unsigned char *p: live) malloc_cache::deallocate(p);
+      });
+    }
+    for (std::thread &w: workers) w.join();
+    check(intact[0] && intact[1] && intact[2] && intact[3], "concurrent threads do not share blocks");
+  }
+
+  std::cout << "\n"
+            << pass_count << " passed, " << fail_count << " failed\n";
+  return fail_count == 0 ? 0 : 1;
+}
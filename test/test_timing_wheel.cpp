@@ -0,0 +1,239 @@
+#include "lib_xcore"
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <random>
+#include <vector>
+
+static int pass_count = 0;
+static int fail_count = 0;
+
+static void check(const bool condition, const char *label) {
+  if (condition) {
+    std::cout << "  [PASS] " << label << "\n";
+    ++pass_count;
+  } else {
+    std::cout << "  [FAIL] " << label << "\n";
+    ++fail_count;
+  }
+}
+
+static void section(const char *title) {
+  std::cout << "\n"
+            << title << "\n";
+}
+
+static uint32_t fake_now = 0;
+static uint32_t fake_millis() { return fake_now; }
+
+static uint16_t fake_now16 = 0;
+static uint16_t fake_millis16() { return fake_now16; }
+
+struct record_t {
+  std::vector<int> fired;
+};
+
+struct tag_t {
+  record_t *record;
+  int       id;
+};
+
+static void on_fire(void *arg) {
+  auto *tag = static_cast<tag_t *>(arg);
+  tag->record->fired.push_back(tag->id);
+}
+
+int main() {
+  // -------------------------------------------------------------------------
+  section("Schedule and fire");
+  // -------------------------------------------------------------------------
+  {
+    fake_now = 1000;
+    xcore::timing_wheel_t<16, 3, fake_millis> wheel;
+    record_t                                  record;
+    tag_t                                     a{&record, 1}, b{&record, 2}, c{&record, 3};
+
+    wheel.schedule(10, on_fire, &a);
+    wheel.schedule(5, on_fire, &b);
+    wheel.schedule(5000, on_fire, &c);  // Beyond level 1
+    check(wheel.size() == 3, "three timers pending");
+
+    fake_now += 4;
+    check(wheel.update() == 0 && record.fired.empty(), "nothing fires early");
+
+    fake_now += 1;
+    check(wheel.update() == 1 && record.fired == std::vector<int>({2}), "fires at its expiry");
+
+    fake_now += 100;
+    check(wheel.update() == 1 && record.fired == std::vector<int>({2, 1}), "fires late ones on the next update");
+
+    fake_now += 4894;
+    wheel.update();
+    check(record.fired.size() == 2, "long timer waits through cascades");
+    fake_now += 1;
+    wheel.update();
+    check(record.fired == std::vector<int>({2, 1, 3}) && wheel.empty(), "long timer fires on time");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Cancel and reschedule");
+  // -------------------------------------------------------------------------
+  {
+    fake_now = 0;
+    xcore::timing_wheel_t<4, 2, fake_millis> wheel;
+    record_t                                 record;
+    tag_t                                    a{&record, 1}, b{&record, 2};
+
+    const auto h1 = wheel.schedule(50, on_fire, &a);
+    const auto h2 = wheel.schedule(60, on_fire, &b);
+    check(wheel.pending(h1) && wheel.cancel(h1) && !wheel.pending(h1), "cancel removes a timer");
+    check(!wheel.cancel(h1) && !wheel.cancel({}), "stale and null handles are rejected");
+
+    fake_now = 55;
+    check(wheel.reschedule(h2, 20), "reschedule a pending timer");
+    fake_now = 70;
+    wheel.update();
+    check(record.fired.empty(), "rescheduled timer does not fire at its old expiry");
+    fake_now = 75;
+    wheel.update();
+    check(record.fired == std::vector<int>({2}) && !wheel.pending(h2), "fires at its new expiry");
+
+    const auto h3 = wheel.schedule(10, on_fire, &a);
+    check(h3.index == h1.index || h3.index == h2.index, "freed timers are reused");
+    check(h3 != h1 && h3 != h2, "reused timers get a new generation");
+
+    for (int i = 0; i < 3; ++i) wheel.schedule(10, on_fire, &a);
+    check(!wheel.schedule(10, on_fire, &a), "schedule fails when full");
+    wheel.clear();
+    check(wheel.empty() && !wheel.pending(h3), "clear cancels everything");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Callbacks");
+  // -------------------------------------------------------------------------
+  {
+    using wheel_t = xcore::timing_wheel_t<8, 2, fake_millis>;
+    fake_now      = 0;
+
+    struct periodic_t {
+      wheel_t *wheel;
+      int      count;
+
+      static void tick(void *arg) {
+        auto *self = static_cast<periodic_t *>(arg);
+        if (++self->count < 5) self->wheel->schedule(10, tick, self);
+      }
+    };
+
+    wheel_t    wheel;
+    periodic_t periodic{&wheel, 0};
+
+    wheel.schedule(10, periodic_t::tick, &periodic);
+    for (fake_now = 1; fake_now <= 100; ++fake_now) {
+      wheel.update();
+      if (fake_now == 35) check(periodic.count == 3, "a callback may re-arm itself");
+    }
+    check(periodic.count == 5 && wheel.empty(), "stops once it no longer re-arms");
+
+    static wheel_t::handle_t victim;
+    wheel.clear();
+    record_t record;
+    tag_t    v{&record, 7};
+    wheel.schedule(
+      5, [](void *arg) { static_cast<wheel_t *>(arg)->cancel(victim); }, &wheel);
+    victim = wheel.schedule(5, on_fire, &v);  // Same slot, fires after the canceller (LIFO)
+    wheel.schedule(
+      5, [](void *arg) { static_cast<wheel_t *>(arg)->cancel(victim); }, &wheel);
+    fake_now += 5;
+    wheel.update();
+    check(record.fired.empty() && wheel.empty(), "callbacks may cancel timers due in the same tick");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Clock wrap-around");
+  // -------------------------------------------------------------------------
+  {
+    fake_now16 = 65530;
+    xcore::timing_wheel_t<4, 2, fake_millis16> wheel;
+    record_t                                   record;
+    tag_t                                      a{&record, 1};
+
+    wheel.schedule(20, on_fire, &a);
+    fake_now16 = static_cast<uint16_t>(fake_now16 + 19);
+    wheel.update();
+    check(record.fired.empty(), "no early fire across the wrap");
+    fake_now16 = static_cast<uint16_t>(fake_now16 + 1);
+    wheel.update();
+    check(record.fired.size() == 1, "fires across the wrap");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Random operations against a model");
+  // -------------------------------------------------------------------------
+  {
+    // 2 levels: 4096 ticks ahead, so long delays go through the overflow list
+    using wheel_t = xcore::timing_wheel_t<2048, 2, fake_millis>;
+    fake_now      = 123456;
+
+    static std::vector<std::pair<uint32_t, int>> fired;  // Time seen, id
+    static uint32_t                              seen = 0;
+
+    struct timer_t {
+      wheel_t::handle_t handle;
+      uint32_t          expiry;
+      int               id;
+    };
+
+    auto *wheel = new wheel_t();
+    std::mt19937                   rng(11);
+    std::map<int, timer_t>         live;
+    std::vector<int>               ids(100000);
+    bool                           consistent = true;
+    int                            next_id    = 0;
+
+    for (int step = 0; step < 100000; ++step) {
+      const uint32_t op = rng() % 10;
+      if (op < 5 && live.size() < 2048) {
+        const uint32_t delay = rng() % 4 == 0 ? rng() % 20000 : rng() % 300;
+        const int      id    = next_id++;
+        ids[id]              = id;
+        const auto h         = wheel->schedule(delay, [](void *arg) { fired.emplace_back(seen, *static_cast<int *>(arg)); }, &ids[id]);
+        live[id]             = timer_t{h, fake_now + (delay > 0 ? delay : 1), id};
+      } else if (op < 6 && !live.empty()) {
+        auto it = live.lower_bound(static_cast<int>(rng() % static_cast<uint32_t>(next_id)));
+        if (it == live.end()) it = live.begin();
+        consistent &= wheel->cancel(it->second.handle);
+        live.erase(it);
+      } else if (op < 7 && !live.empty()) {
+        auto it = live.lower_bound(static_cast<int>(rng() % static_cast<uint32_t>(next_id)));
+        if (it == live.end()) it = live.begin();
+        const uint32_t delay = rng() % 5000;
+        consistent &= wheel->reschedule(it->second.handle, delay);
+        it->second.expiry = fake_now + (delay > 0 ? delay : 1);
+      } else {
+        fake_now += rng() % 4 == 0 ? rng() % 3000 : rng() % 20;
+        seen = fake_now;
+        fired.clear();
+        wheel->update();
+
+        uint32_t last = 0;
+        for (const auto &[time, id]: fired) {
+          auto it = live.find(id);
+          consistent &= it != live.end() && it->second.expiry <= fake_now && it->second.expiry >= last;
+          if (it != live.end()) {
+            last = it->second.expiry;
+            live.erase(it);
+          }
+        }
+        for (const auto &[id, t]: live) consistent &= t.expiry > fake_now;
+      }
+      consistent &= wheel->size() == live.size();
+    }
+    check(consistent, "fires every timer once, on time, in order of expiry");
+    delete wheel;
+  }
+
+  std::cout << "\n"
+            << pass_count << " passed, " << fail_count << " failed\n";
+  return fail_count == 0 ? 0 : 1;
+}
@@ -0,0 +1,128 @@
+#include "lib_xcore"
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+
+static int pass_count = 0;
+static int fail_count = 0;
+
+static void check(const bool condition, const char *label) {
+  if (condition) {
+    std::cout << "  [PASS] " << label << "\n";
+    ++pass_count;
+  } else {
+    std::cout << "  [FAIL] " << label << "\n";
+    ++fail_count;
+  }
+}
+
+static void section(const char *title) {
+  std::cout << "\n"
+            << title << "\n";
+}
+
+template<typename T>
+static std::string format(const T value, const int base = 10) {
+  char buf[80];
+  if constexpr (std::is_floating_point_v<T>) {
+    const auto r = xcore::to_chars(buf, buf + sizeof(buf), value);
+    return r ? std::string(buf, r.ptr) : "<error>";
+  } else {
+    const auto r = xcore::to_chars(buf, buf + sizeof(buf), value, base);
+    return r ? std::string(buf, r.ptr) : "<error>";
+  }
+}
+
+int main() {
+  // -------------------------------------------------------------------------
+  section("Integers");
+  // -------------------------------------------------------------------------
+  {
+    check(format(0) == "0", "0");
+    check(format(7) == "7", "7");
+    check(format(-42) == "-42", "-42");
+    check(format(1234567890) == "1234567890", "1234567890");
+    check(format(INT64_MIN) == "-9223372036854775808", "INT64_MIN");
+    check(format(UINT64_MAX) == "18446744073709551615", "UINT64_MAX");
+    check(format(static_cast<int8_t>(-128)) == "-128", "int8_t -128");
+    check(format(255, 16) == "ff", "255 in base 16");
+    check(format(-5, 2) == "-101", "-5 in base 2");
+    check(format(35, 36) == "z", "35 in base 36");
+
+    char buf[4];
+    auto r = xcore::to_chars(buf, buf + sizeof(buf), 12345);
+    check(r.ec == xcore::errc::value_too_large && r.ptr == buf + sizeof(buf), "too small range -> value_too_large");
+    r = xcore::to_chars(buf, buf + sizeof(buf), 1234);
+    check(r && r.ptr == buf + 4 && memcmp(buf, "1234", 4) == 0, "exact fit");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Floating points");
+  // -------------------------------------------------------------------------
+  {
+    check(format(0.0) == "0", "0.0 -> \"0\"");
+    check(format(-0.0) == "-0", "-0.0 -> \"-0\"");
+    check(format(1.0) == "1", "1.0 -> \"1\"");
+    check(format(0.1) == "0.1", "0.1");
+    check(format(0.3) == "0.3", "0.3");
+    check(format(-1.5) == "-1.5", "-1.5");
+    check(format(123.456) == "123.456", "123.456");
+    check(format(1e20) == "100000000000000000000", "1e20 in fixed notation");
+    check(format(1e21) == "1e+21", "1e21 in scientific notation");
+    check(format(0.000001) == "0.000001", "1e-6 in fixed notation");
+    check(format(1e-7) == "1e-7", "1e-7 in scientific notation");
+    check(format(5e-324) == "5e-324", "smallest subnormal");
+    check(format(1.7976931348623157e308) == "1.7976931348623157e+308", "DBL_MAX");
+    check(format(0.1f) == "0.1", "0.1f (float boundaries)");
+    check(format(1.0f / 3) == "0.33333334", "1/3 as float");
+    check(format(INFINITY) == "inf" && format(-INFINITY) == "-inf", "infinities");
+    check(format(NAN) == "nan", "nan");
+
+    char buf[3];
+    const auto r = xcore::to_chars(buf, buf + sizeof(buf), 0.125);
+    check(r.ec == xcore::errc::value_too_large, "too small range -> value_too_large");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Round trip through from_chars");
+  // -------------------------------------------------------------------------
+  {
+    std::mt19937_64 rng(42);
+    int             bad_double = 0, bad_float = 0;
+
+    for (int i = 0; i < 200'000; ++i) {
+      const uint64_t bits = rng();
+      double         d;
+      memcpy(&d, &bits, sizeof(d));
+      if (std::isfinite(d)) {
+        char       buf[32];
+        const auto r = xcore::to_chars(buf, buf + sizeof(buf), d);
+        double     back;
+        if (!xcore::from_chars(buf, r.ptr, back) || back != d) ++bad_double;
+      }
+
+      const auto bits32 = static_cast<uint32_t>(bits);
+      float      f;
+      memcpy(&f, &bits32, sizeof(f));
+      if (std::isfinite(f)) {
+        char       buf[32];
+        const auto r = xcore::to_chars(buf, buf + sizeof(buf), f);
+        float      back;
+        if (!xcore::from_chars(buf, r.ptr, back) || back != f) ++bad_float;
+      }
+    }
+
+    check(bad_double == 0, "200k random doubles round-trip");
+    check(bad_float == 0, "200k random floats round-trip");
+  }
+
+  std::cout << "\n"
+            << pass_count << " passed, "
+            << fail_count << " failed.\n";
+
+  return fail_count == 0 ? 0 : 1;
+}
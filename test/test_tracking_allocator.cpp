@@ -0,0 +1,117 @@
+#include "lib_xcore"
+#include <cstring>
+#include <iostream>
+
+static int pass_count = 0;
+static int fail_count = 0;
+
+static void check(const bool condition, const char *label) {
+  if (condition) {
+    std::cout << "  [PASS] " << label << "\n";
+    ++pass_count;
+  } else {
+    std::cout << "  [FAIL] " << label << "\n";
+    ++fail_count;
+  }
+}
+
+static void section(const char *title) {
+  std::cout << "\n"
+            << title << "\n";
+}
+
+struct samples_tag {
+  static constexpr const char *name = "samples";
+};
+
+struct text_tag {
+  static constexpr const char *name = "text";
+};
+
+struct scratch_tag {
+  static constexpr const char *name = "scratch";
+};
+
+template<typename Tp>
+using samples_alloc = xcore::tracking_allocator_form_t<xcore::default_allocator_t, samples_tag>::type<Tp>;
+
+template<typename Tp>
+using text_alloc = xcore::tracking_allocator_form_t<xcore::default_allocator_t, text_tag>::type<Tp>;
+
+template<typename Tp>
+using scratch_alloc = xcore::tracking_allocator_form_t<xcore::malloc_allocator_t, scratch_tag>::type<Tp>;
+
+template<typename Tp>
+using tracked_aligned = xcore::tracking_allocator_form_t<xcore::aligned_allocator_t>::type<Tp>;
+
+template<typename Tp, size_t Size>
+using text_heap_array = xcore::heap_array_t<Tp, Size, text_alloc>;
+
+int main() {
+  xcore::allocation_stats_t &samples = xcore::allocation_stats<samples_tag>();
+  xcore::allocation_stats_t &text    = xcore::allocation_stats<text_tag>();
+  xcore::allocation_stats_t &scratch = xcore::allocation_stats<scratch_tag>();
+
+  // -------------------------------------------------------------------------
+  section("Containers");
+  // -------------------------------------------------------------------------
+  {
+    {
+      xcore::heap_array_t<double, 16, samples_alloc> fixed;
+      check(samples.live_bytes() == 128 && static_cast<const double *>(fixed) != nullptr, "heap_array_t");
+
+      xcore::dynamic_array_t<float, 0, samples_alloc> dynamic(10);
+      check(samples.live_bytes() == 128 + 40, "dynamic_array_t");
+
+      dynamic.dynamic_resize(1000);
+      check(samples.live_bytes() == 128 + 4000 && samples.peak_bytes() == 128 + 4000, "resize is tracked");
+
+      dynamic.dynamic_resize(100);
+      const xcore::allocation_snapshot_t s = samples.snapshot();
+      check(s.live_bytes == 128 + 400 && s.peak_bytes == 128 + 4000 && s.live_blocks == 2, "peak survives shrinking");
+      check(s.allocations == 2 && s.reallocations == 2 && s.histogram[3] == 1 && s.histogram[8] == 1,
+            "counts and size histogram");
+    }
+    check(samples.live_bytes() == 0 && samples.snapshot().deallocations == 2, "destructors give everything back");
+
+    {
+      xcore::container::impl::basic_string_t<char, 64, text_heap_array> msg;
+      msg += "tracked";
+      check(text.live_bytes() == 64 && strcmp(msg.c_str(), "tracked") == 0, "heap string");
+    }
+    check(text.live_bytes() == 0, "heap string released");
+
+    {
+      xcore::virtual_stack_region_t<4096, 16, scratch_alloc> region;
+      check(scratch.live_bytes() == 4096, "virtual_stack_region_t");
+    }
+
+    float *block = tracked_aligned<float>::allocate(8);
+    check((reinterpret_cast<uintptr_t>(block) & (xcore::cache_line_size - 1)) == 0, "aligned base keeps its alignment");
+    tracked_aligned<float>::deallocate(block);
+  }
+
+  // -------------------------------------------------------------------------
+  section("Snapshot");
+  // -------------------------------------------------------------------------
+  {
+    samples.reset();
+    check(samples.snapshot().allocations == 0 && samples.peak_bytes() == 0, "reset");
+
+    size_t tags = 0;
+    xcore::allocation_stats_t::for_each([&](const xcore::allocation_stats_t &) { ++tags; });
+    check(tags >= 3, "every tag is registered");
+
+    char                                            out[4096];
+    xcore::json_writer_t<xcore::json_buffer_sink_t> writer(out, sizeof(out));
+    xcore::write_allocation_stats(writer);
+    check(strstr(out, "{\"name\":\"scratch\",\"live_bytes\":0,\"peak_bytes\":4096,") != nullptr,
+          "JSON dump of every tag");
+    check(strstr(out, "\"histogram\":[{\"le\":4096,\"count\":1}]") != nullptr, "histogram buckets");
+    std::cout << "  " << out << "\n";
+  }
+
+  std::cout << "\n"
+            << pass_count << " passed, " << fail_count << " failed\n";
+  return fail_count == 0 ? 0 : 1;
+}
@@ -0,0 +1,103 @@
+#include "lib_xcore"
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+
+static int pass_count = 0;
+static int fail_count = 0;
+
+static void check(const bool condition, const char *label) {
+  if (condition) {
+    std::cout << "  [PASS] " << label << "\n";
+    ++pass_count;
+  } else {
+    std::cout << "  [FAIL] " << label << "\n";
+    ++fail_count;
+  }
+}
+
+static void section(const char *title) {
+  std::cout << "\n"
+            << title << "\n";
+}
+
+int main() {
+  // -------------------------------------------------------------------------
+  section("Markers");
+  // -------------------------------------------------------------------------
+  {
+    xcore::virtual_stack_region_t<1024, 16> region;
+
+    int *first = region.allocate_ptr<int>(4);
+    check(first && region.size() == 16, "allocation rounded to the alignment");
+
+    const auto mark = region.marker();
+    char      *a    = region.allocate_ptr<char>(100);
+    double    *b    = region.allocate_ptr<double>(3);
+    check(a && b && region.size() == 16 + 112 + 32, "mixed types");
+
+    region.rewind(mark);
+    check(region.size() == 16 && region.allocate_ptr<char>(100) == a, "rewind releases everything after the marker");
+    region.rewind(mark);
+
+    {
+      auto scope = region.scope();
+      for (int i = 0; i < 8; ++i) (void) region.allocate_ptr<uint64_t>(8);
+      check(region.size() == 16 + 8 * 64, "allocations inside a scope");
+    }
+    check(region.size() == 16, "scope_marker rewinds on exit");
+
+    check(region.allocate_ptr<char>(2000) == nullptr && region.size() == 16, "overflow returns nullptr");
+    check(region.overflow_count() == 1, "overflow is counted");
+    check(region.high_water_mark() == 16 + 8 * 64, "high-water mark");
+
+    region.reset_stats();
+    check(region.overflow_count() == 0 && region.high_water_mark() == 16, "reset_stats starts a new period");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Chained mode");
+  // -------------------------------------------------------------------------
+  {
+    xcore::chained_stack_region_t<256, 16> region;
+
+    unsigned char *blocks[6];
+    for (int i = 0; i < 6; ++i) {
+      blocks[i] = region.allocate_ptr<unsigned char>(100);
+      memset(blocks[i], i + 1, 100);
+    }
+    check(region.chained_blocks() == 1 && region.overflow_count() == 1, "full blocks chain a new one");
+    check(region.size() == 6 * 112 && region.high_water_mark() == 6 * 112, "size spans all blocks");
+
+    bool intact = true;
+    for (int i = 0; i < 6; ++i)
+      for (int k = 0; k < 100; ++k) intact &= blocks[i][k] == i + 1;
+    check(intact, "blocks do not overlap");
+
+    unsigned char *huge = region.allocate_ptr<unsigned char>(10000);
+    check(huge && region.chained_blocks() == 2, "a block fits a large allocation");
+
+    region.deallocate<unsigned char>(10000);
+    check(region.chained_blocks() == 1 && region.size() == 6 * 112, "deallocating the first object leaves its block");
+
+    const auto mark = region.marker();
+    (void) region.allocate_ptr<unsigned char>(5000);
+    region.rewind(mark);
+    check(region.chained_blocks() == 1 && region.size() == 6 * 112, "rewind across blocks");
+
+    region.clear();
+    check(region.size() == 0 && region.chained_blocks() == 0 && region.remaining() == 256, "clear drops every block");
+
+    // The largest block is kept: the next frames do not call the allocator
+    region.reset_stats();
+    for (int frame = 0; frame < 3; ++frame) {
+      auto scope = region.scope();
+      for (int i = 0; i < 20; ++i) (void) region.allocate_ptr<unsigned char>(100);
+    }
+    check(region.overflow_count() == 3 && region.size() == 0, "frames reuse the spare block");
+  }
+
+  std::cout << "\n"
+            << pass_count << " passed, " << fail_count << " failed\n";
+  return fail_count == 0 ? 0 : 1;
+}
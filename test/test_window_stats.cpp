@@ -0,0 +1,199 @@
+#include "lib_xcore"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <random>
+#include <vector>
+
+static int pass_count = 0;
+static int fail_count = 0;
+
+static void check(const bool condition, const char *label) {
+  if (condition) {
+    std::cout << "  [PASS] " << label << "\n";
+    ++pass_count;
+  } else {
+    std::cout << "  [FAIL] " << label << "\n";
+    ++fail_count;
+  }
+}
+
+static void section(const char *title) {
+  std::cout << "\n"
+            << title << "\n";
+}
+
+static bool near(const double a, const double b, const double tolerance = 1e-9) {
+  return std::fabs(a - b) <= tolerance * (1 + std::fabs(b));
+}
+
+// Recomputes every statistic from a copy of the window and compares
+template<typename Stats, typename T>
+static bool matches(const Stats &s, const std::deque<T> &window) {
+  if (s.size() != window.size()) return false;
+  if (window.empty()) return s.empty() && s.mean() == 0 && s.variance() == 0;
+
+  double sum = 0;
+  for (const T x: window) sum += static_cast<double>(x);
+  const double mean = sum / static_cast<double>(window.size());
+  double       m2   = 0;
+  for (const T x: window) m2 += (static_cast<double>(x) - mean) * (static_cast<double>(x) - mean);
+
+  std::vector<T> sorted(window.begin(), window.end());
+  std::sort(sorted.begin(), sorted.end());
+
+  return near(static_cast<double>(s.sum()), sum) && near(s.mean(), mean, 1e-7) && near(s.variance(), m2 / static_cast<double>(window.size()), 1e-6) &&
+         s.min() == sorted.front() && s.max() == sorted.back() && std::equal(sorted.begin(), sorted.end(), s.sorted());
+}
+
+int main() {
+  // -------------------------------------------------------------------------
+  section("Moments");
+  // -------------------------------------------------------------------------
+  {
+    xcore::window_stats_t<int, 4> s;
+    check(s.empty() && s.mean() == 0 && s.variance() == 0 && s.capacity() == 4, "empty window");
+
+    for (const int x: {2, 4, 4, 4}) s.push(x);
+    check(s.full() && s.sum() == 14 && s.mean() == 3.5, "sum and mean");
+    check(near(s.variance(), 0.75) && near(s.sample_variance(), 1.0), "population and sample variance");
+    check(s.min() == 2 && s.max() == 4, "min and max");
+
+    s.push(5);  // {4, 4, 4, 5}
+    check(s.size() == 4 && s.sum() == 17 && s.mean() == 4.25, "oldest sample leaves the window");
+    check(near(s.variance(), 0.1875) && s.min() == 4 && s.max() == 5, "moments after replacement");
+
+    check(s.pop() && s.pop() && s.size() == 2 && s.sum() == 9 && s.mean() == 4.5, "pop removes the oldest");
+    check(near(s.variance(), 0.25) && s.min() == 4 && s.max() == 5, "moments after pop");
+    check(s.pop() && s.pop() && !s.pop() && s.empty() && s.mean() == 0, "pop until empty");
+
+    s.push(-7);
+    check(s.sum() == -7 && s.min() == -7 && s.max() == -7 && s.variance() == 0, "single sample");
+    s.clear();
+    check(s.empty() && s.sum() == 0, "clear");
+  }
+
+  {
+    xcore::window_stats_t<uint8_t, 3> s;
+    for (const uint8_t x: {200, 250, 255, 10}) s.push(x);
+    check(s.sum() == 515u, "integer sums do not overflow the sample type");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Thresholds and quantiles");
+  // -------------------------------------------------------------------------
+  {
+    xcore::window_stats_t<float, 8, true> s;
+    for (const float x: {5.f, 1.f, 4.f, 1.f, 3.f, 9.f, 2.f, 6.f}) s.push(x);
+
+    check(s.count_below(3.f) == 3 && s.count_at_least(3.f) == 5, "count_below and count_at_least");
+    check(s.count_below(0.f) == 0 && s.count_at_least(100.f) == 0, "thresholds out of range");
+    check(s.count_between(2.f, 5.f) == 4 && s.count_between(5.f, 2.f) == 0, "count_between");
+
+    const float thresholds[3] = {1.f, 4.f, 10.f};
+    size_t      counts[3]     = {};
+    s.count_below(thresholds, 3, counts);
+    check(counts[0] == 0 && counts[1] == 4 && counts[2] == 8, "many thresholds at once");
+
+    check(s.quantile(0) == 1.f && s.median() == 3.f && s.quantile(1) == 9.f && s.quantile(0.9) == 9.f, "nearest-rank quantiles");
+    check(s.nth(0) == 1.f && s.nth(1) == 1.f && s.nth(7) == 9.f, "nth");
+
+    s.push(0.5f);  // 5 leaves
+    check(s.count_below(3.f) == 4 && s.min() == 0.5f && s.max() == 9.f, "order kept across replacement");
+  }
+
+  {
+    // Matches sampler_t: count_over() is the number of samples at or above the threshold
+    xcore::sampler_t<16, int>            sampler;
+    xcore::window_stats_t<int, 16, true> stats;
+    std::mt19937                         rng(3);
+    for (int i = 0; i < 100; ++i) {
+      const int x = static_cast<int>(rng() % 50);
+      sampler.add_sample(x);
+      stats.push(x);
+    }
+
+    bool same = true;
+    for (int t = -1; t <= 51; ++t) {
+      sampler.set_threshold(t);
+      same &= sampler.count_over() == stats.count_at_least(t) && sampler.count_under() == stats.count_below(t);
+    }
+    check(same, "agrees with sampler_t for every threshold");
+  }
+
+  // -------------------------------------------------------------------------
+  section("Random streams against a recomputed window");
+  // -------------------------------------------------------------------------
+  {
+    std::mt19937                            rng(11);
+    std::normal_distribution<double>        dist(100.0, 15.0);
+    xcore::window_stats_t<double, 37, true> s;
+    std::deque<double>                      window;
+    bool                                    consistent = true;
+
+    for (int step = 0; step < 20000 && consistent; ++step) {
+      if (rng() % 8 == 0) {
+        consistent &= s.pop() == !window.empty();
+        if (!window.empty()) window.pop_front();
+      } else {
+        const double x = dist(rng);
+        s.push(x);
+        window.push_back(x);
+        if (window.size() > 37) window.pop_front();
+      }
+      consistent &= matches(s, window);
+    }
+    check(consistent, "double samples with pops");
+  }
+
+  {
+    std::mt19937                             rng(5);
+    xcore::window_stats_t<int16_t, 64, true> s;
+    std::deque<int16_t>                      window;
+    bool                                     consistent = true;
+
+    // Few distinct values, so that duplicates and ties fill the deques and the sorted window
+    for (int step = 0; step < 20000 && consistent; ++step) {
+      const auto x = static_cast<int16_t>(static_cast<int>(rng() % 9) - 4);
+      s.push(x);
+      window.push_back(x);
+      if (window.size() > 64) window.pop_front();
+      consistent &= matches(s, window);
+    }
+    check(consistent, "integer samples with ties");
+  }
+
+  {
+    // A long stream drifts a little; resync() restores the exact moments
+    xcore::window_stats_t<double, 100>     s;
+    std::mt19937                           rng(9);
+    std::uniform_real_distribution<double> dist(1e6, 1e6 + 1);
+    std::deque<double>                     window;
+
+    for (int i = 0; i < 1000000; ++i) {
+      const double x = dist(rng);
+      s.push(x);
+      window.push_back(x);
+      if (window.size() > 100) window.pop_front();
+    }
+
+    double mean = 0, m2 = 0;
+    for (const double x: window) mean += x;
+    mean /= 100;
+    for (const double x: window) m2 += (x - mean) * (x - mean);
+
+    check(near(s.mean(), mean, 1e-12) && near(s.variance(), m2 / 100, 1e-3), "unordered window after 10^6 samples");
+    s.resync();
+    check(near(s.variance(), m2 / 100, 1e-9), "resync");
+    check(s.min() == *std::min_element(window.begin(), window.end()) && s.max() == *std::max_element(window.begin(), window.end()), "min and max without the sorted window");
+  }
+
+  // Ring and two deques, without the sorted copy
+  check(sizeof(xcore::window_stats_t<double, 1024>) < 1024 * sizeof(double) + 2 * 1024 * sizeof(uint64_t) + 128, "no sorted storage by default");
+
+  std::cout << "\n"
+            << pass_count << " passed, " << fail_count << " failed\n";
+  return fail_count == 0 ? 0 : 1;
+}